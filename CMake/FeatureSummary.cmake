@@ -108,6 +108,9 @@ endif ()
 if (OGRE_BUILD_RENDERSYSTEM_GLES2)
 	set(_rendersystems "${_rendersystems}  + OpenGL ES2/ ES3\n")
 endif ()
+if (OGRE_BUILD_RENDERSYSTEM_NULL)
+	set(_rendersystems "${_rendersystems}  + Null\n")
+endif ()
 
 if (DEFINED _rendersystems)
 	set(_features "${_features}Building rendersystems:\n${_rendersystems}")
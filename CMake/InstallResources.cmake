@@ -78,6 +78,9 @@ endif ()
 if (NOT OGRE_BUILD_RENDERSYSTEM_GLES2)
   set(OGRE_COMMENT_RENDERSYSTEM_GLES2 "#")
 endif ()
+if (NOT OGRE_BUILD_RENDERSYSTEM_NULL)
+  set(OGRE_COMMENT_RENDERSYSTEM_NULL "#")
+endif ()
 if (NOT OGRE_BUILD_PLUGIN_BSP)
   set(OGRE_COMMENT_PLUGIN_BSP "#")
 endif ()
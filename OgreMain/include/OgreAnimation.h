@@ -234,8 +234,11 @@ namespace Ogre {
           other animations.
         @param scale The scale to apply to translations and scalings, useful for 
             adapting an animation to a different size target.
+        @param cursors Optional keyframe cursors to speed up the keyframe search, usually
+            those of the AnimationState being applied (see AnimationState::_getKeyFrameCursors)
         */
-        void apply(Real timePos, Real weight = 1.0, Real scale = 1.0f);
+        void apply(Real timePos, Real weight = 1.0, Real scale = 1.0f,
+                   AnimationState::KeyFrameCursorList* cursors = 0);
 
         /** Applies all node tracks given a specific time point and weight to the specified node.
         @remarks
@@ -260,8 +263,11 @@ namespace Ogre {
             other animations.
         @param scale The scale to apply to translations and scalings, useful for 
             adapting an animation to a different size target.
+        @param cursors Optional keyframe cursors to speed up the keyframe search, usually
+            those of the AnimationState being applied (see AnimationState::_getKeyFrameCursors)
         */
-        void apply(Skeleton* skeleton, Real timePos, Real weight = 1.0, Real scale = 1.0f);
+        void apply(Skeleton* skeleton, Real timePos, Real weight = 1.0, Real scale = 1.0f,
+                   AnimationState::KeyFrameCursorList* cursors = 0);
 
         /** Applies all node tracks given a specific time point and weight to a given skeleton.
         @remarks
@@ -275,9 +281,12 @@ namespace Ogre {
             be modulated with the weight factor.
         @param scale The scale to apply to translations and scalings, useful for 
             adapting an animation to a different size target.
+        @param cursors Optional keyframe cursors to speed up the keyframe search, usually
+            those of the AnimationState being applied (see AnimationState::_getKeyFrameCursors)
         */
         void apply(Skeleton* skeleton, Real timePos, float weight,
-          const AnimationState::BoneBlendMask* blendMask, Real scale);
+          const AnimationState::BoneBlendMask* blendMask, Real scale,
+          AnimationState::KeyFrameCursorList* cursors = 0);
 
         /** Applies all vertex tracks given a specific time point and weight to a given entity.
         @param entity The Entity to which this animation should be applied
@@ -286,9 +295,11 @@ namespace Ogre {
             (only affects pose animation)
         @param software Whether to populate the software morph vertex data
         @param hardware Whether to populate the hardware morph vertex data
+        @param cursors Optional keyframe cursors to speed up the keyframe search, usually
+            those of the AnimationState being applied (see AnimationState::_getKeyFrameCursors)
         */
         void apply(Entity* entity, Real timePos, Real weight, bool software, 
-            bool hardware);
+            bool hardware, AnimationState::KeyFrameCursorList* cursors = 0);
 
         /** Applies all numeric tracks given a specific time point and weight to the specified animable value.
         @remarks
@@ -439,6 +450,30 @@ namespace Ogre {
         */
         void _destroyNodeTracks(const TrackHandleList& tracks);
 
+        /** Builds a compressed copy of the node tracks, which apply() uses from then on.
+        @remarks
+            The node tracks are resampled at the union of their keyframe times,
+            quantised and stored in structure of arrays form, see
+            CompressedNodeAnimation. Applying the animation to a skeleton then
+            samples all tracks at once, with slightly lower precision and
+            linear interpolation between the keys whatever the interpolation
+            modes. Compress after creating the keyframes and optimise(); the
+            compressed copy does not follow later changes to the node tracks.
+        @param destroyNodeTracks Whether to destroy the node tracks afterwards
+            to save memory. Note that Skeleton::_mergeSkeletonAnimations only
+            merges node tracks.
+        */
+        void compressNodeTracks(bool destroyNodeTracks = false);
+
+        /// Destroys the compressed copy of the node tracks, if any
+        void destroyCompressedNodeTracks(void);
+
+        /// The compressed copy of the node tracks, or NULL if there is none
+        const CompressedNodeAnimation* getCompressedNodeTracks(void) const { return mCompressedNodeTracks; }
+
+        /// Internal method to set the compressed node tracks, takes ownership
+        void _setCompressedNodeTracks(CompressedNodeAnimation* tracks);
+
         /** Clone this animation.
         @note
             The pointer returned from this method is the only one recorded, 
@@ -446,22 +481,20 @@ namespace Ogre {
             object.
         */
         Animation* clone(const String& newName) const OGRE_NODISCARD;
-        
-        /** Internal method used to tell the animation that keyframe list has been
-            changed, which may cause it to rebuild some internal data */
-        void _keyFrameListChanged(void) { mKeyFrameTimesDirty = true; }
 
         /** Internal method used to convert time position to time index object.
-        @note
-            The time index returns by this function are associated with state of
-            the animation object, if the animation object altered (e.g. create/remove
-            keyframe or track), all related time index will invalidated.
         @param timePos The time position.
+        @param cursors Optional keyframe cursors, which are grown to hold one
+            entry per track of this animation
         @return The time index object which contains wrapped time position (in
-            relation to the whole animation sequence) and lower bound index of
-            global keyframe time list.
+            relation to the whole animation sequence) and the keyframe cursors.
+        */
+        TimeIndex _getTimeIndex(Real timePos, AnimationState::KeyFrameCursorList* cursors = 0) const;
+
+        /** Internal method to assign a keyframe cursor to a new track.
+        @return The index of the cursor of the track in the cursor lists, see TimeIndex
         */
-        TimeIndex _getTimeIndex(Real timePos) const;
+        unsigned short _createKeyFrameCursor(void) { return mNumKeyFrameCursors++; }
         
         /** Sets a base keyframe which for the skeletal / pose keyframes 
             in this animation. 
@@ -500,6 +533,14 @@ namespace Ogre {
         
         /// Internal method to adjust keyframes relative to a base keyframe (@see setUseBaseKeyFrame) */
         void _applyBaseKeyFrame();
+
+        /** Internal method to perform the lazy initialisation done by apply() up front.
+        @remarks
+            Applies the base keyframe and builds the interpolation splines if needed, after which the animation can be
+            applied to several skeletons from different threads at once, as long
+            as it is not modified in the meantime.
+        */
+        void _prepareForConcurrentApply(void);
         
         void _notifyContainer(AnimationContainer* c);
         /** Retrieve the container of this animation. */
@@ -522,22 +563,21 @@ namespace Ogre {
         static InterpolationMode msDefaultInterpolationMode;
         static RotationInterpolationMode msDefaultRotationInterpolationMode;
 
-        /// Global keyframe time list used to search global keyframe index.
-        typedef std::vector<Real> KeyFrameTimeList;
-        mutable KeyFrameTimeList mKeyFrameTimes;
-        /// Dirty flag indicate that keyframe time list need to rebuild
-        mutable bool mKeyFrameTimesDirty;
+        /// Number of keyframe cursors handed out to tracks, see _createKeyFrameCursor
+        unsigned short mNumKeyFrameCursors;
 
         bool mUseBaseKeyFrame;
         Real mBaseKeyFrameTime;
         String mBaseKeyFrameAnimationName;
         AnimationContainer* mContainer;
+        /// Compressed copy of the node tracks, used by apply() if present
+        CompressedNodeAnimation* mCompressedNodeTracks;
 
         void optimiseNodeTracks(bool discardIdentityTracks);
         void optimiseVertexTracks(void);
 
-        /// Internal method to build global keyframe time list
-        void buildKeyFrameTimeList(void) const;
+        /// Wraps a time position into the length of the animation
+        Real _wrapTimePos(Real timePos) const;
     };
 
     /** @} */
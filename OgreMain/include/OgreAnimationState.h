@@ -58,6 +58,9 @@ namespace Ogre {
         /// Typedef for an array of float values used as a bone blend mask
         typedef std::vector<float> BoneBlendMask;
 
+        /// Typedef for the keyframe positions found last in each track, see TimeIndex
+        typedef std::vector<ushort> KeyFrameCursorList;
+
         /** Normal constructor with all params supplied
             @param
                 animName The name of this state.
@@ -168,6 +171,13 @@ namespace Ogre {
           assert(mBlendMask && mBlendMask->size() > boneHandle);
           return (*mBlendMask)[boneHandle];
       }
+
+        /** Internal method to get the keyframe cursors of this state.
+        @remarks
+            Animation::apply uses them to resume the keyframe search of each
+            track where it ended the last time this state was applied.
+        */
+        KeyFrameCursorList* _getKeyFrameCursors(void) const { return &mKeyFrameCursors; }
     protected:
         /// The blend mask (containing per bone weights)
         BoneBlendMask* mBlendMask;
@@ -180,6 +190,8 @@ namespace Ogre {
         bool mEnabled;
         bool mLoop;
 
+        /// Keyframe search positions, merely a cache for applying the animation
+        mutable KeyFrameCursorList mKeyFrameCursors;
     };
 
     // A map of animation states
@@ -47,6 +47,12 @@ namespace Ogre
     *  @{
     */
     /** Time index object used to search keyframe at the given position.
+    @remarks
+        May carry keyframe cursors, one per track of the animation, holding
+        the position of the keyframe found the last time. As playback usually
+        moves forward by less than a keyframe between frames, tracks resume
+        their search from there, and only search all their keyframes after
+        seeking or looping.
     */
     class _OgreExport TimeIndex
     {
@@ -54,40 +60,34 @@ namespace Ogre
         /** The time position (in relation to the whole animation sequence)
         */
         Real mTimePos;
-        /** The global keyframe index (in relation to the whole animation sequence)
-            that used to convert to local keyframe index, or INVALID_KEY_INDEX which
-            means global keyframe index unavailable, and then slight slow method will
-            used to search local keyframe index.
-        */
-        uint mKeyIndex;
-
-        /** Indicate it's an invalid global keyframe index.
+        /** The keyframe cursors, indexed by AnimationTrack::_getKeyFrameCursorIndex,
+            or NULL to search all keyframes.
         */
-        static const uint INVALID_KEY_INDEX = (uint)-1;
+        ushort* mKeyFrameCursors;
 
     public:
         /** Construct time index object by the given time position.
         */
         TimeIndex(Real timePos)
             : mTimePos(timePos)
-            , mKeyIndex(INVALID_KEY_INDEX)
+            , mKeyFrameCursors(0)
         {
         }
 
         /** Construct time index object by the given time position and
-            global keyframe index.
+            keyframe cursors.
         @note In normally, you don't need to use this constructor directly, use
             Animation::_getTimeIndex instead.
         */
-        TimeIndex(Real timePos, uint keyIndex)
+        TimeIndex(Real timePos, ushort* keyFrameCursors)
             : mTimePos(timePos)
-            , mKeyIndex(keyIndex)
+            , mKeyFrameCursors(keyFrameCursors)
         {
         }
 
-        bool hasKeyIndex(void) const
+        bool hasKeyFrameCursors(void) const
         {
-            return mKeyIndex != INVALID_KEY_INDEX;
+            return mKeyFrameCursors != 0;
         }
 
         Real getTimePos(void) const
@@ -95,9 +95,9 @@ namespace Ogre
             return mTimePos;
         }
 
-        uint getKeyIndex(void) const
+        ushort* getKeyFrameCursors(void) const
         {
-            return mKeyIndex;
+            return mKeyFrameCursors;
         }
     };
 
@@ -225,13 +225,10 @@ namespace Ogre
         /** Optimise the current track by removing any duplicate keyframes. */
         virtual void optimise(void) {}
 
-        /** Internal method to collect keyframe times, in unique, ordered format. */
-        virtual void _collectKeyFrameTimes(std::vector<Real>& keyFrameTimes);
+        /** Internal method to get the index of the keyframe cursor of this
+            track, see TimeIndex. */
+        unsigned short _getKeyFrameCursorIndex(void) const { return mKeyFrameCursorIndex; }
 
-        /** Internal method to build keyframe time index map to translate global lower
-            bound index to local lower bound index. */
-        virtual void _buildKeyFrameIndexMap(const std::vector<Real>& keyFrameTimes);
-        
         /** Internal method to re-base the keyframes relative to a given keyframe. */
         virtual void _applyBaseKeyFrame(const KeyFrame* base);
 
@@ -246,10 +243,7 @@ namespace Ogre
         Animation* mParent;
         unsigned short mHandle;
         Listener* mListener;
-
-        /// Map used to translate global keyframe time lower bound index to local lower bound index
-        typedef std::vector<ushort> KeyFrameIndexMap;
-        KeyFrameIndexMap mKeyFrameIndexMap;
+        unsigned short mKeyFrameCursorIndex;
 
         /// Create a keyframe implementation - must be overridden
         virtual KeyFrame* createKeyFrameImpl(Real time) = 0;
@@ -384,6 +378,13 @@ namespace Ogre
         NodeAnimationTrack* _clone(Animation* newParent) const;
         
         void _applyBaseKeyFrame(const KeyFrame* base);
+
+        /// Internal method to build the interpolation splines now rather than on first use
+        void _buildInterpolationSplines(void) const
+        {
+            if (mSplineBuildNeeded)
+                buildInterpolationSplines();
+        }
         
     protected:
         /// Specialised keyframe creation
@@ -200,6 +200,18 @@ namespace Ogre {
         /** Retrieve the modification time of a given file */
         virtual time_t getModifiedTime(const String& filename) const = 0;
 
+        /** Retrieve the modification time and the size of a given file at once.
+        @param filename The fully qualified name of the file
+        @param size Set to the size in bytes, or to ~size_t(0) if the archive can not
+            tell without opening the file, which is what the default implementation does
+        @return The modification time, as getModifiedTime
+        */
+        virtual time_t getModifiedTimeAndSize(const String& filename, size_t& size) const
+        {
+            size = ~size_t(0);
+            return getModifiedTime(filename);
+        }
+
 
         /** Find all files or directories matching a given pattern in this
             archive and get some detailed information about them.
@@ -54,10 +54,40 @@ namespace Ogre {
         will calculate concatenated matrices etc only when required, passing back precalculated
         matrices when they are requested more than once when the underlying information has
         not altered.
+    @par
+        In addition every setter records when the inputs it sets last changed, grouped by
+        ChangeSource, so GpuProgramParameters::_updateAutoParams can skip constants whose
+        inputs did not change since they were last written.
     */
     class _OgreExport AutoParamDataSource : public SceneMgtAlloc
     {
+    public:
+        /// Groups of inputs the automatic constants are derived from
+        enum ChangeSource
+        {
+            /// Current renderable and its world matrices
+            CS_WORLD = 1 << 0,
+            /// Camera, view and projection matrices
+            CS_CAMERA = 1 << 1,
+            /// Light list and shadow extrusion distances
+            CS_LIGHTS = 1 << 2,
+            /// Texture projectors (shadow cameras)
+            CS_TEXTURE_PROJECTORS = 1 << 3,
+            /// Render target and viewport
+            CS_TARGET = 1 << 4,
+            /// Current pass and pass number
+            CS_PASS = 1 << 5,
+            /// Ambient light, fog, point parameters, scene bounds and time
+            CS_SCENE = 1 << 6,
+
+            CS_ALL = (1 << 7) - 1
+        };
     protected:
+        static const int NUM_CHANGE_SOURCES = 7;
+
+        /// Mark the given ChangeSource bits as changed
+        void markChanged(uint16 sources);
+
         const Light& getLight(size_t index) const;
         mutable Affine3 mWorldMatrix[256];
         mutable size_t mWorldMatrixCount;
@@ -123,6 +153,12 @@ namespace Ogre {
         const SceneManager* mCurrentSceneManager;
         const VisibleObjectsBoundsInfo* mMainCamBoundsInfo;
         const Pass* mCurrentPass;
+        bool mIdentityView;
+        bool mIdentityProjection;
+
+        /// Tick of the last change of each ChangeSource
+        uint64 mChangeTicks[NUM_CHANGE_SOURCES];
+        bool mChangeTrackingEnabled;
 
         Light mBlankLight;
     public:
@@ -152,6 +188,31 @@ namespace Ogre {
         /** Sets the current pass */
         void setCurrentPass(const Pass* pass);
 
+        /** Tick of the last change of any of the given ChangeSource bits.
+        @remarks
+            Ticks are drawn from a counter shared by all data sources, so they
+            only ever increase.
+        */
+        uint64 getChangeTick(uint16 sources) const
+        {
+            uint64 tick = 0;
+            for (int s = 0; sources; ++s, sources >>= 1)
+            {
+                if (sources & 1)
+                    tick = std::max(tick, mChangeTicks[s]);
+            }
+            return tick;
+        }
+
+        /** Enables skipping of automatic constants whose inputs did not change.
+        @remarks
+            Enabled by default. Disabling it rewrites all automatic constants on
+            every update, as older versions did.
+        */
+        void setChangeTrackingEnabled(bool enabled) { mChangeTrackingEnabled = enabled; }
+        /// @copydoc setChangeTrackingEnabled
+        bool isChangeTrackingEnabled(void) const { return mChangeTrackingEnabled; }
+
 		/** Returns the current bounded camera */
 		const Camera* getCurrentCamera() const;
 
@@ -314,6 +314,11 @@ namespace Ogre {
         Real mOtherTexCoordRange[2];
         /// Camera last used to build the vertex buffer
         Camera *mVertexCameraUsed;
+        /** Whether the vertices are written to the streaming buffers of the
+            HardwareBufferManager, see StreamingBufferAllocator. */
+        bool mStreamingBuffers;
+        /// StreamingBufferAllocator frame the vertices were last written in
+        unsigned long mVertexStreamFrame;
         /// When true, the billboards always face the camera
         bool mFaceCamera;
         /// Used when mFaceCamera == false; determines the billboard's "normal". i.e.
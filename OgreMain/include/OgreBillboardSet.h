@@ -178,7 +178,7 @@ namespace Ogre {
 
         /// The vertex position data for all billboards in this set.
         std::unique_ptr<VertexData> mVertexData;
-        /// Shortcut to main buffer (positions, colours, texture coords)
+        /// Shortcut to main buffer (positions, colours, texture coords), unused when streaming
         HardwareVertexBufferSharedPtr mMainBuf;
         /// Locked pointer to buffer
         float* mLockPtr;
@@ -280,8 +280,6 @@ namespace Ogre {
             float operator()(Billboard* bill) const;
         };
 
-        static RadixSort<ActiveBillboardList, Billboard*, float> mRadixSorter;
-
         /// Use point rendering?
         bool mPointRendering;
 
@@ -298,6 +296,9 @@ namespace Ogre {
         bool mAutoUpdate;
         /// True if the billboard data changed. Will cause vertex buffer update.
         bool mBillboardDataChanged;
+        /** Whether the vertices are written to the streaming buffers of the
+            HardwareBufferManager instead of mMainBuf, see StreamingBufferAllocator. */
+        bool mStreamingBuffers;
 
         /** Internal method creates vertex and index buffers.
         */
@@ -92,6 +92,13 @@ namespace Ogre
         */
         void reset(void);
 
+        /** Copies the position, orientation and scale of another bone.
+        @remarks
+            Internal use only. Unlike the setters, this keeps the orientation exactly
+            as an animation left it, without normalising it.
+        */
+        void _copyLocalTransform(const Bone* bone);
+
         /** Sets whether or not this bone is manually controlled. 
         @remarks
             Manually controlled bones can be altered by the application at runtime, 
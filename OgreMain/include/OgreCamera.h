@@ -595,6 +595,9 @@ namespace Ogre {
         bool isVisible(const Sphere& bound, FrustumPlane* culledBy = 0) const;
         /// @copydoc Frustum::isVisible(const Vector3&, FrustumPlane*) const
         bool isVisible(const Vector3& vert, FrustumPlane* culledBy = 0) const;
+        /// @copydoc Frustum::calculateVisibility
+        void calculateVisibility(const float* centres, const float* halfSizes,
+                                 uint32* visibility, size_t numBoxes) const;
         /// @copydoc Frustum::getWorldSpaceCorners
         const Vector3* getWorldSpaceCorners(void) const;
         /// @copydoc Frustum::getFrustumPlane
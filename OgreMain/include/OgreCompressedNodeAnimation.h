@@ -0,0 +1,164 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#ifndef __CompressedNodeAnimation_H__
+#define __CompressedNodeAnimation_H__
+
+#include "OgrePrerequisites.h"
+#include "OgreAnimation.h"
+#include "OgreHeaderPrefix.h"
+
+namespace Ogre
+{
+    /** \addtogroup Core
+    *  @{
+    */
+    /** \addtogroup Animation
+    *  @{
+    */
+    /** Compact copy of the node tracks of an Animation, sampled all at once.
+    @remarks
+        NodeAnimationTrack keeps every keyframe as a separately allocated object
+        and is sampled one track at a time, each searching its own keyframes.
+        This class resamples all node tracks of an animation at the union of
+        their keyframe times and stores the keys in structure of arrays form:
+        a single array of key times, and per key the rotations, translations and
+        scales of all tracks next to each other, quantised to 16 bit per
+        component. Sampling takes one search for the key and then interpolates
+        four tracks at a time, with SSE2 where available.
+    @par
+        Rotations are stored with a precision of about 3e-5 per component,
+        translations and scales with 1/65535 of the range each track covers.
+        Translations or scales which no track changes over time are stored
+        once per track instead of per key.
+    @par
+        Between the keys, translations and scales are interpolated linearly and
+        rotations with Quaternion::nlerp, whatever the interpolation modes of
+        the animation. The compressed copy does not follow later changes to the
+        node tracks, nor does it invoke their listeners.
+    @see Animation::compressNodeTracks
+    */
+    class _OgreExport CompressedNodeAnimation : public AnimationAlloc
+    {
+    public:
+        /// Creates an empty copy, see SkeletonSerializer
+        CompressedNodeAnimation();
+
+        /** Compresses the node tracks of an animation.
+        @remarks
+            Tracks without keyframes are left out, as they do not affect the
+            nodes either.
+        */
+        explicit CompressedNodeAnimation(const Animation* animation);
+
+        /// Number of tracks
+        size_t getNumTracks(void) const { return mHandles.size(); }
+
+        /// Handle of the bone a track applies to
+        unsigned short getTrackHandle(size_t track) const { return mHandles[track]; }
+
+        /// Number of distinct key times over all tracks
+        size_t getNumKeys(void) const { return mTimes.empty() ? 0 : mTimes.size() - 1; }
+
+        /// Whether any track changes its translation over time
+        bool hasTranslationKeys(void) const { return !mTranslations.empty(); }
+
+        /// Whether any track changes its scale over time
+        bool hasScaleKeys(void) const { return !mScales.empty(); }
+
+        /** Samples all tracks at a time position.
+        @param timePos Time position, within the length of the animation
+        @param translations, rotations, scales Arrays of getNumTracks() entries
+            receiving the transforms of the tracks
+        */
+        void sample(Real timePos, Vector3* translations, Quaternion* rotations, Vector3* scales) const;
+
+        /** Samples all tracks and applies them to the bones of a skeleton.
+        @remarks
+            Applies the transforms the same way as NodeAnimationTrack::applyToNode.
+        @param skeleton The skeleton to apply to
+        @param timePos Time position, within the length of the animation
+        @param weight The influence to give to this animation
+        @param blendMask Optional weights per bone, indexed by bone handle
+        @param scale Scale to apply to translations and scalings
+        @param rim How to blend the rotations with the weight
+        */
+        void apply(Skeleton* skeleton, Real timePos, Real weight,
+                   const AnimationState::BoneBlendMask* blendMask, Real scale,
+                   Animation::RotationInterpolationMode rim) const;
+
+        /// Memory used by the keys, in bytes
+        size_t calculateSize(void) const;
+
+    private:
+        friend class SkeletonSerializer;
+
+        /// Components of a sampled transform
+        enum Component
+        {
+            ROTATION_W, ROTATION_X, ROTATION_Y, ROTATION_Z,
+            TRANSLATION_X, TRANSLATION_Y, TRANSLATION_Z,
+            SCALE_X, SCALE_Y, SCALE_Z,
+            NUM_COMPONENTS
+        };
+
+        /// Number of groups of four tracks
+        size_t getNumGroups(void) const { return (mHandles.size() + 3) / 4; }
+
+        /// Finds the key before a time position and the parametric time towards the next one
+        void findKey(Real timePos, size_t& key, float& t) const;
+
+        /// Interpolates the transforms of the tracks of a group, by component and track
+        void sampleGroup(size_t group, size_t key, float t, float out[NUM_COMPONENTS][4]) const;
+
+        /// Bone handle of each track
+        std::vector<unsigned short> mHandles;
+        /// Whether each track rotates along the shortest path, when blending with the weight
+        std::vector<uint8> mUseShortestRotationPath;
+        /** Key times, followed by the first one wrapped around by the length of the
+            animation, so that the last key interpolates towards the first */
+        std::vector<float> mTimes;
+        /** Per group of four tracks, the offset and step (range / 65535) of the
+            quantised translations and scales, by component and track */
+        std::vector<float> mTranslationBase;
+        std::vector<float> mTranslationStep;
+        std::vector<float> mScaleBase;
+        std::vector<float> mScaleStep;
+        /// Per key and group of four tracks, rotations as signed normalised values
+        std::vector<int16> mRotations;
+        /// Per key and group of four tracks, empty if no track changes them
+        std::vector<uint16> mTranslations;
+        std::vector<uint16> mScales;
+    };
+    /** @} */
+    /** @} */
+}
+
+#include "OgreHeaderSuffix.h"
+
+#endif
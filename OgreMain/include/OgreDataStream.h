@@ -471,6 +471,53 @@ namespace Ogre {
 
         /** Sets whether or not to free the encapsulated memory on close. */
         void setFreeOnClose(bool free) { mFreeOnClose = free; }
+        /** Whether the encapsulated memory is freed on close, i.e. owned by the stream. */
+        bool isFreeOnClose(void) const { return mFreeOnClose; }
+    };
+
+    /** Common subclass of DataStream for handling data from memory mapped files.
+    @remarks
+        The file is not read up front, the operating system pages it in as it
+        is accessed and can drop the pages again under memory pressure, since
+        they are backed by the file. Being a MemoryDataStream, consumers can
+        use getPtr and getCurrentPtr to work on the file contents directly
+        instead of reading them into buffers of their own.
+    @par
+        The mapping is private and copy on write: the stream is read only, but
+        writing to the memory it points to only changes a private copy of the
+        affected pages, never the file.
+    @see MappedFileSystemArchiveFactory
+    */
+    class _OgreExport MappedFileDataStream : public MemoryDataStream
+    {
+    public:
+        /** Maps the whole file.
+        @param name The name to give the stream
+        @param path The path of the file to map
+        */
+        MappedFileDataStream(const String& name, const String& path);
+
+        /** Creates a stream of a part of another mapped stream.
+        @remarks
+            Both share the mapping, which stays alive as long as either uses it.
+            This lets data like the pixels of an image refer into the file.
+        @param name The name to give the stream
+        @param source The stream whose mapping to use
+        @param offset Offset in bytes of the part in the source stream
+        @param size The size of the part in bytes
+        */
+        MappedFileDataStream(const String& name, const MappedFileDataStream& source,
+                             size_t offset, size_t size);
+
+        ~MappedFileDataStream();
+
+        /** @copydoc DataStream::close
+        */
+        void close(void);
+
+    private:
+        struct Mapping;
+        std::shared_ptr<Mapping> mMapping;
     };
 
     /** Common subclass of DataStream for handling data from 
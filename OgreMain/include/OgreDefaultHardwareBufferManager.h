@@ -67,6 +67,8 @@ namespace Ogre {
         void* lock(size_t offset, size_t length, LockOptions options);
         /** Override HardwareBuffer to turn off all shadowing. */
         void unlock(void);
+        /** System memory is always mapped, see HardwareBuffer. */
+        void* _getPersistentMapping(void) { return mData; }
 
 
     };
@@ -92,6 +94,8 @@ namespace Ogre {
         void* lock(size_t offset, size_t length, LockOptions options);
         /** Override HardwareBuffer to turn off all shadowing. */
         void unlock(void);
+        /** System memory is always mapped, see HardwareBuffer. */
+        void* _getPersistentMapping(void) { return mData; }
 
     };
 
@@ -185,6 +189,8 @@ namespace Ogre {
         std::unique_ptr<HardwareBufferManagerBase> mImpl;
     public:
         DefaultHardwareBufferManager() : mImpl(new DefaultHardwareBufferManagerBase()) {}
+        // the streaming rings hold buffers of mImpl
+        ~DefaultHardwareBufferManager() { _releaseStreamingBuffers(); }
 
         HardwareVertexBufferSharedPtr
             createVertexBuffer(size_t vertexSize, size_t numVerts, HardwareBuffer::Usage usage,
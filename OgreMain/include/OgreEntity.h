@@ -205,6 +205,17 @@ namespace Ogre {
         /// a shared skeleton.
         unsigned long *mFrameBonesLastUpdated;
 
+        /// LOD values from which the skeleton is evaluated less often, transformed by the mesh LodStrategy
+        std::vector<Real> mAnimationLodValues;
+        /// Number of frames between skeleton evaluations for each entry of mAnimationLodValues
+        std::vector<ushort> mAnimationLodIntervals;
+        /// Animation LOD of the most detailed camera in mAnimationLodFrame, 0 for every frame
+        ushort mAnimationLodIndex;
+        /// Frame in which mAnimationLodIndex was computed
+        unsigned long mAnimationLodFrame;
+        /// Offset of the frames in which the skeleton is evaluated, spreads entities across frames
+        uint32 mAnimationLodPhase;
+
         /** A set of all the entities which shares a single SkeletonInstance.
             This is only created if the entity is in fact sharing it's SkeletonInstance with
             other Entities.
@@ -443,6 +454,10 @@ namespace Ogre {
         */
         void _updateRenderQueue(RenderQueue* queue);
 
+        /** @copydoc MovableObject::_canQueueConcurrently
+        */
+        bool _canQueueConcurrently(void) const;
+
         /** @copydoc MovableObject::getMovableType */
         const String& getMovableType(void) const;
 
@@ -555,6 +570,35 @@ namespace Ogre {
         */
         void setMaterialLodBias(Real factor, ushort maxDetailIndex = 0, ushort minDetailIndex = 99);
 #endif
+        /** Sets the levels of detail at which the skeleton of this entity is evaluated less often.
+        @remarks
+            Skeletal animation is normally evaluated every frame, however small the
+            entity is on screen. Animation LOD uses the LodStrategy of the mesh (e.g.
+            DistanceLodStrategy or PixelCountLodStrategy), including the mesh LOD bias
+            of this entity, to only evaluate the skeleton every few frames once the
+            entity gets far enough. In between, the entity keeps the last evaluated
+            pose; it is not interpolated. Entities are assigned different frames to
+            evaluate in, so large numbers of them are spread evenly across frames.
+        @par
+            The most detailed level seen by any camera in the previous or current
+            frame is used. Moving manual bones always evaluates the skeleton, as do
+            entities with vertex animation. Entities sharing their skeleton instance
+            update it whenever one of them is due. Has no effect with OGRE_NO_MESHLOD.
+        @param lodValues
+            User values of the mesh LodStrategy (e.g. distances or pixel counts)
+            from which the lower update rates apply, in order of decreasing detail.
+            Pass an empty list to evaluate every frame again.
+        @param updateIntervals
+            Number of frames between two evaluations of the skeleton for each entry
+            of lodValues, at least 1.
+        */
+        void setAnimationLodLevels(const std::vector<Real>& lodValues, const std::vector<ushort>& updateIntervals);
+
+        /** Gets the number of frames between two evaluations of the skeleton at the current animation LOD. */
+        ushort getAnimationLodUpdateInterval(void) const
+        {
+            return mAnimationLodIndex ? mAnimationLodIntervals[mAnimationLodIndex - 1] : 1;
+        }
         /** Sets whether the polygon mode of this entire entity may be
             overridden by the camera detail settings.
         */
@@ -752,6 +796,37 @@ namespace Ogre {
         */
         bool _isSkeletonAnimated(void) const;
 
+        /** Whether the skeleton of this entity may be evaluated ahead of queueing,
+            concurrently with other entities.
+        @remarks
+            Not the case for entities with objects or tag points attached to bones,
+            as those depend on the transform of the scene node, nor for entities
+            which still have to reinitialise themselves after a mesh reload.
+        */
+        bool _canUpdateBonesConcurrently(void) const;
+
+        /** Evaluate the skeleton and cache the bone matrices for the current frame.
+        @remarks
+            Internal method used by SceneManager to animate entities ahead of
+            queueing, which would otherwise do this lazily. Nothing happens if the
+            bone matrices are up to date already.
+        @return Whether the bone matrices were updated
+        */
+        bool _updateBoneMatrices(void) { return cacheBoneMatrices(); }
+
+        /** Whether the animation LOD keeps the skeleton pose of an earlier frame this frame.
+        @see setAnimationLodLevels
+        */
+        bool _isAnimationLodHeld(void) const;
+
+        /** Take over the skeleton pose and bone matrices another entity evaluated this frame.
+        @remarks
+            Internal method used by SceneManager to evaluate entities with the same
+            skeleton and identical animation states only once. The source entity must
+            have been updated by _updateBoneMatrices this frame.
+        */
+        void _copyBoneMatrices(const Entity* source);
+
         /** Advanced method to get the temporarily blended skeletal vertex information
             for entities which are software skinned.
         @remarks
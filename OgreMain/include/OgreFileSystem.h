@@ -69,6 +69,25 @@ namespace Ogre {
         static bool getIgnoreHidden();
     };
 
+    /** Specialisation of FileSystemArchiveFactory whose archives memory map the
+        files they open read only.
+    @remarks
+        Use the "MappedFileSystem" type for resource locations holding large
+        assets. Their streams are MappedFileDataStreams, which meshes and DDS
+        images are loaded from without copying the file contents to memory
+        first. Files opened for writing are streamed as usual.
+    */
+    class _OgreExport MappedFileSystemArchiveFactory : public FileSystemArchiveFactory
+    {
+    public:
+        /// @copydoc FactoryObj::getType
+        const String& getType(void) const;
+
+        using ArchiveFactory::createInstance;
+
+        Archive *createInstance( const String& name, bool readOnly );
+    };
+
     class APKFileSystemArchiveFactory : public ArchiveFactory
     {
     public:
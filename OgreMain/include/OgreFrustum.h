@@ -472,6 +472,26 @@ namespace Ogre
         */
         virtual bool isVisible(const Vector3& vert, FrustumPlane* culledBy = 0) const;
 
+        /** Tests a batch of bounding boxes for visibility in the Frustum.
+        @remarks
+            Gives the same results as isVisible(const AxisAlignedBox&, FrustumPlane*) for
+            each box, but tests several boxes at once with
+            OptimisedUtil::calculateBoxVisibility. Subclasses overriding the single box
+            test have to override this as well.
+        @param centres
+            Box centres (world space), packed in (x, y, z) format.
+        @param halfSizes
+            Box half-sizes, packed in (x, y, z) format. Null and infinite boxes can't be
+            represented and have to be handled by the caller.
+        @param visibility
+            Receives the results, bit (i % 32) of element (i / 32) is set if box i is
+            visible. Must hold (numBoxes + 31) / 32 elements.
+        @param numBoxes
+            Number of boxes to test.
+        */
+        virtual void calculateVisibility(const float* centres, const float* halfSizes,
+                                         uint32* visibility, size_t numBoxes) const;
+
         /// Overridden from MovableObject::getTypeFlags
         uint32 getTypeFlags(void) const;
 
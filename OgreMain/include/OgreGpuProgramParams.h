@@ -303,7 +303,99 @@ namespace Ogre {
             , arraySize(1)
             , variability(GPV_GLOBAL) {}
     };
-    typedef std::map<String, GpuConstantDefinition> GpuConstantDefinitionMap;
+    /** Map of parameter names to GpuConstantDefinition.
+        @remarks
+        This is still an ordered std::map, so iteration order is unchanged, but
+        name lookups go through a flat open addressing table keyed by the
+        MurmurHash3 of the name rather than doing string comparisons down the tree.
+        The map is inherited privately so that entries can only be added or removed
+        through the members provided here, which keep that table in sync.
+    */
+    class GpuConstantDefinitionMap : private std::map<String, GpuConstantDefinition>
+    {
+        typedef std::map<String, GpuConstantDefinition> BaseMap;
+    public:
+        using BaseMap::key_type;
+        using BaseMap::mapped_type;
+        using BaseMap::value_type;
+        using BaseMap::size_type;
+        using BaseMap::difference_type;
+        using BaseMap::key_compare;
+        using BaseMap::reference;
+        using BaseMap::const_reference;
+        using BaseMap::iterator;
+        using BaseMap::const_iterator;
+        using BaseMap::reverse_iterator;
+        using BaseMap::const_reverse_iterator;
+
+        using BaseMap::begin;
+        using BaseMap::end;
+        using BaseMap::rbegin;
+        using BaseMap::rend;
+        using BaseMap::cbegin;
+        using BaseMap::cend;
+        using BaseMap::empty;
+        using BaseMap::size;
+        using BaseMap::lower_bound;
+        using BaseMap::upper_bound;
+
+        GpuConstantDefinitionMap() : mSerial(0) {}
+        GpuConstantDefinitionMap(const GpuConstantDefinitionMap& rhs)
+            : BaseMap(rhs), mSerial(0) { rebuildIndex(); }
+        GpuConstantDefinitionMap& operator=(const GpuConstantDefinitionMap& rhs)
+        {
+            BaseMap::operator=(rhs);
+            ++mSerial;
+            rebuildIndex();
+            return *this;
+        }
+
+        /// Hash used for name lookups, see GpuConstantHandle
+        static _OgreExport uint32 hashName(const String& name);
+
+        iterator find(const String& name) { return find(name, hashName(name)); }
+        const_iterator find(const String& name) const { return find(name, hashName(name)); }
+        /// Looks up a name whose hashName has already been computed
+        _OgreExport iterator find(const String& name, uint32 hash);
+        const_iterator find(const String& name, uint32 hash) const
+        {
+            return const_cast<GpuConstantDefinitionMap*>(this)->find(name, hash);
+        }
+        size_type count(const String& name) const { return find(name) == end() ? 0 : 1; }
+
+        _OgreExport std::pair<iterator, bool> insert(const value_type& val);
+        iterator insert(iterator hint, const value_type& val) { (void)hint; return insert(val).first; }
+        template <typename InputIt> void insert(InputIt first, InputIt last)
+        {
+            for (; first != last; ++first)
+                insert(*first);
+        }
+        _OgreExport mapped_type& operator[](const String& name);
+
+        _OgreExport void erase(iterator pos);
+        _OgreExport size_type erase(const String& name);
+        _OgreExport void erase(iterator first, iterator last);
+        _OgreExport void clear();
+        _OgreExport void swap(GpuConstantDefinitionMap& rhs);
+
+        /** Incremented whenever entries are removed, i.e. whenever previously
+            obtained pointers to definitions in this map may have been invalidated.
+        */
+        uint32 getSerial() const { return mSerial; }
+    private:
+        struct IndexSlot
+        {
+            uint32 hash;
+            bool used;
+            iterator pos;
+        };
+        /// Power of two sized, at most half full, linear probing
+        std::vector<IndexSlot> mIndex;
+        uint32 mSerial;
+
+        void addToIndex(iterator pos, uint32 hash);
+        _OgreExport void rebuildIndex();
+    };
     typedef ConstMapIterator<GpuConstantDefinitionMap> GpuConstantDefinitionIterator;
 
     /// Struct collecting together the information for named constants.
@@ -360,6 +452,35 @@ namespace Ogre {
         static bool msGenerateAllConstantDefinitionArrayEntries;
     };
 
+    /** A named constant resolved ahead of time, for parameters updated very often.
+        @remarks
+        Obtain one from GpuProgramParameters::getConstantHandle and keep it instead of
+        the name. The name is hashed only once, and while the parameters are backed by
+        the same constant definitions the definition itself is cached, so setting a
+        value through the handle needs no lookup at all. A handle may also be used with
+        parameters of other programs declaring the same name, in which case it falls
+        back to a hashed lookup.
+    */
+    class _OgreExport GpuConstantHandle
+    {
+    public:
+        GpuConstantHandle() : mHash(0), mDefinition(0), mSerial(0) {}
+        explicit GpuConstantHandle(const String& name);
+
+        /// The name of the constant this handle refers to
+        const String& getName(void) const { return mName; }
+    private:
+        friend class GpuProgramParameters;
+
+        String mName;
+        uint32 mHash;
+        /// Definitions mDefinition was found in, held to keep it alive
+        GpuNamedConstantsPtr mConstants;
+        const GpuConstantDefinition* mDefinition;
+        /// GpuConstantDefinitionMap::getSerial at the time mDefinition was found
+        uint32 mSerial;
+    };
+
     /// Simple class for loading / saving GpuNamedConstants
     class _OgreExport GpuNamedConstantsSerializer : public Serializer
     {
@@ -1290,21 +1411,59 @@ namespace Ogre {
             };
             /// The variability of this parameter (see GpuParamVariability)
             uint16 variability;
+            /** The inputs of this parameter (see AutoParamDataSource::ChangeSource),
+                0 if it has to be written on every update */
+            uint16 changeSources;
+            /// Change tick of the inputs when this parameter was last written
+            uint64 lastUpdateTick;
 
         AutoConstantEntry(AutoConstantType theType, size_t theIndex, size_t theData,
                           uint16 theVariability, size_t theElemCount = 4)
             : paramType(theType), physicalIndex(theIndex), elementCount(theElemCount),
-                data(theData), variability(theVariability) {}
+                data(theData), variability(theVariability),
+                changeSources(deriveChangeSources(theType)), lastUpdateTick(0) {}
 
         AutoConstantEntry(AutoConstantType theType, size_t theIndex, Real theData,
                           uint16 theVariability, size_t theElemCount = 4)
             : paramType(theType), physicalIndex(theIndex), elementCount(theElemCount),
-                fData(theData), variability(theVariability) {}
+                fData(theData), variability(theVariability),
+                changeSources(deriveChangeSources(theType)), lastUpdateTick(0) {}
 
         };
         // Auto parameter storage
         typedef std::vector<AutoConstantEntry> AutoConstantList;
 
+        /** Range of a constant buffer written since the last call to _clearDirtyRanges.
+        @remarks
+            Render systems may use this to upload only the part of the buffers
+            which changed. The range is [begin; end) in physical indices.
+        */
+        struct DirtyRange
+        {
+            size_t begin;
+            size_t end;
+
+            DirtyRange() : begin(0), end(0) {}
+
+            bool empty(void) const { return begin >= end; }
+            size_t size(void) const { return empty() ? 0 : end - begin; }
+            void add(size_t start, size_t count)
+            {
+                if (!count)
+                    return;
+                if (empty())
+                {
+                    begin = start;
+                    end = start + count;
+                }
+                else
+                {
+                    begin = std::min(begin, start);
+                    end = std::max(end, start + count);
+                }
+            }
+        };
+
         typedef std::vector<GpuSharedParametersUsage> GpuSharedParamUsageList;
 
         // Map that store subroutines associated with slots
@@ -1362,9 +1521,26 @@ namespace Ogre {
         bool mIgnoreMissingParams;
         /// physical index for active pass iteration parameter real constant entry;
         size_t mActivePassIterationIndex;
+        /// Data source of the last _updateAutoParams, whose change ticks the entries refer to
+        const AutoParamDataSource* mLastAutoParamSource;
 
         /// Return the variability for an auto constant
         static uint16 deriveVariability(AutoConstantType act);
+        /// Return the AutoParamDataSource::ChangeSource bits an auto constant is derived from
+        static uint16 deriveChangeSources(AutoConstantType act);
+
+        /// Mark the whole float, double and int buffers as written
+        void markAllDirty(void);
+
+        /// Binds the auto constant behind a named parameter definition
+        void setDefinitionAutoConstant(const GpuConstantDefinition& def, AutoConstantType acType,
+                                       size_t extraInfo);
+        /// @copydoc setDefinitionAutoConstant
+        void setDefinitionAutoConstantReal(const GpuConstantDefinition& def, AutoConstantType acType,
+                                           Real rData);
+        /// Shared tail of both _findNamedConstantDefinition overloads
+        const GpuConstantDefinition* findNamedConstantDefinition(
+            const String& name, uint32 hash, bool throwExceptionIfMissing) const;
 
         void copySharedParamSetUsage(const GpuSharedParamUsageList& srcList);
 
@@ -1373,6 +1549,10 @@ namespace Ogre {
         // Optional data the rendersystem might want to store
         mutable Any mRenderSystemData;
 
+        /// Parts of the buffers written since the last _clearDirtyRanges
+        DirtyRange mFloatDirtyRange;
+        DirtyRange mDoubleDirtyRange;
+        DirtyRange mIntDirtyRange;
 
     public:
         GpuProgramParameters();
@@ -1533,6 +1713,26 @@ namespace Ogre {
             @param count The number of ints to write
         */
         void _writeRawConstants(size_t physicalIndex, const uint* val, size_t count);
+
+        /// Part of the float buffer written since the last _clearDirtyRanges
+        const DirtyRange& _getFloatDirtyRange(void) const { return mFloatDirtyRange; }
+        /// Part of the double buffer written since the last _clearDirtyRanges
+        const DirtyRange& _getDoubleDirtyRange(void) const { return mDoubleDirtyRange; }
+        /// Part of the int buffer written since the last _clearDirtyRanges
+        const DirtyRange& _getIntDirtyRange(void) const { return mIntDirtyRange; }
+        /// Called by the render system once it uploaded the dirty ranges
+        void _clearDirtyRanges(void)
+        {
+            mFloatDirtyRange = mDoubleDirtyRange = mIntDirtyRange = DirtyRange();
+        }
+        /// Replaces the dirty ranges by those of a copy of this with the same layout
+        void _copyDirtyRanges(const GpuProgramParameters& src)
+        {
+            mFloatDirtyRange = src.mFloatDirtyRange;
+            mDoubleDirtyRange = src.mDoubleDirtyRange;
+            mIntDirtyRange = src.mIntDirtyRange;
+        }
+
         /** Read a series of floating point values from the underlying float
             constant buffer at the given physical index.
             @param physicalIndex The buffer position to start reading
@@ -1700,19 +1900,31 @@ namespace Ogre {
         /// Get a reference to the list of float constants
         const FloatConstantList& getFloatConstantList() const { return mFloatConstants; }
         /// Get a pointer to the 'nth' item in the float buffer
-        float* getFloatPointer(size_t pos) { return &mFloatConstants[pos]; }
+        float* getFloatPointer(size_t pos)
+        {
+            mFloatDirtyRange.add(pos, mFloatConstants.size() - pos);
+            return &mFloatConstants[pos];
+        }
         /// Get a pointer to the 'nth' item in the float buffer
         const float* getFloatPointer(size_t pos) const { return &mFloatConstants[pos]; }
         /// Get a reference to the list of double constants
         const DoubleConstantList& getDoubleConstantList() const { return mDoubleConstants; }
         /// Get a pointer to the 'nth' item in the double buffer
-        double* getDoublePointer(size_t pos) { return &mDoubleConstants[pos]; }
+        double* getDoublePointer(size_t pos)
+        {
+            mDoubleDirtyRange.add(pos, mDoubleConstants.size() - pos);
+            return &mDoubleConstants[pos];
+        }
         /// Get a pointer to the 'nth' item in the double buffer
         const double* getDoublePointer(size_t pos) const { return &mDoubleConstants[pos]; }
         /// Get a reference to the list of int constants
         const IntConstantList& getIntConstantList() const { return mIntConstants; }
         /// Get a pointer to the 'nth' item in the int buffer
-        int* getIntPointer(size_t pos) { return &mIntConstants[pos]; }
+        int* getIntPointer(size_t pos)
+        {
+            mIntDirtyRange.add(pos, mIntConstants.size() - pos);
+            return &mIntConstants[pos];
+        }
         /// Get a pointer to the 'nth' item in the int buffer
         const int* getIntPointer(size_t pos) const { return &mIntConstants[pos]; }
         /// @deprecated use getIntConstantList
@@ -1724,7 +1936,7 @@ namespace Ogre {
             return tmp;
         }
         /// Get a pointer to the 'nth' item in the uint buffer
-        uint* getUnsignedIntPointer(size_t pos) { return (uint*)&mIntConstants[pos]; }
+        uint* getUnsignedIntPointer(size_t pos) { return (uint*)getIntPointer(pos); }
         /// Get a pointer to the 'nth' item in the uint buffer
         const uint* getUnsignedIntPointer(size_t pos) const { return (const uint*)&mIntConstants[pos]; }
         /// Get a reference to the list of auto constant bindings
@@ -1850,11 +2062,28 @@ namespace Ogre {
         const AutoConstantEntry* _findRawAutoConstantEntryBool(size_t physicalIndex) const;
 
         /** Update automatic parameters.
+            @remarks
+            Parameters whose inputs did not change since they were last written by
+            the same source are skipped, see AutoParamDataSource::getChangeTick.
             @param source The source of the parameters
             @param variabilityMask A mask of GpuParamVariability which identifies which autos will need updating
         */
         void _updateAutoParams(const AutoParamDataSource* source, uint16 variabilityMask);
 
+        /** Whether the auto constants varying per object can be packed into a constant block.
+            @remarks
+            This is not the case if some of them also vary with something else (e.g. the
+            lights), or are arrays sized by the renderable (e.g. skinning matrices).
+            @see RenderSystem::_bindPerObjectConstantBlock
+        */
+        bool _canPackPerObjectConstants(void) const;
+        /// Number of floats written by _packPerObjectConstants
+        size_t _getPerObjectConstantCount(void) const;
+        /** Copies the current values of the auto constants varying per object to dest,
+            tightly packed in the order of the auto constant entries.
+        */
+        void _packPerObjectConstants(float* dest) const;
+
         /** Tells the program whether to ignore missing parameters or not.
          */
         void setIgnoreMissingParams(bool state) { mIgnoreMissingParams = state; }
@@ -1974,6 +2203,52 @@ namespace Ogre {
         /** Unbind an auto constant so that the constant is manually controlled again. */
         void clearNamedAutoConstant(const String& name);
 
+        /** Resolves a named parameter once so that it can be set repeatedly without a name lookup.
+            @remarks
+            The setNamedConstant and setNamedAutoConstant overloads taking a GpuConstantHandle
+            behave exactly like their named counterparts.
+            @note
+            If the parameter does not exist, this throws unless missing parameters are
+            ignored, in which case setting through the handle does nothing.
+        */
+        GpuConstantHandle getConstantHandle(const String& name) const;
+        /// @copydoc setNamedConstant(const String&, Real)
+        void setNamedConstant(const GpuConstantHandle& handle, Real val);
+        /// @overload
+        void setNamedConstant(const GpuConstantHandle& handle, int val);
+        /// @overload
+        void setNamedConstant(const GpuConstantHandle& handle, uint val);
+        /// @overload
+        void setNamedConstant(const GpuConstantHandle& handle, const Vector4& val);
+        /// @overload
+        void setNamedConstant(const GpuConstantHandle& handle, const Vector3& val);
+        /// @overload
+        void setNamedConstant(const GpuConstantHandle& handle, const Vector2& val);
+        /// @overload
+        void setNamedConstant(const GpuConstantHandle& handle, const Matrix4& val);
+        /// @overload
+        void setNamedConstant(const GpuConstantHandle& handle, const ColourValue& colour);
+        /// @copydoc setNamedConstant(const String&, const Matrix4*, size_t)
+        void setNamedConstant(const GpuConstantHandle& handle, const Matrix4* m, size_t numEntries);
+        /// @copydoc setNamedConstant(const String&, const float*, size_t, size_t)
+        void setNamedConstant(const GpuConstantHandle& handle, const float *val, size_t count,
+                              size_t multiple = 4);
+        /// @overload
+        void setNamedConstant(const GpuConstantHandle& handle, const double *val, size_t count,
+                              size_t multiple = 4);
+        /// @overload
+        void setNamedConstant(const GpuConstantHandle& handle, const int *val, size_t count,
+                              size_t multiple = 4);
+        /// @overload
+        void setNamedConstant(const GpuConstantHandle& handle, const uint *val, size_t count,
+                              size_t multiple = 4);
+        /// @copydoc setNamedAutoConstant(const String&, AutoConstantType, size_t)
+        void setNamedAutoConstant(const GpuConstantHandle& handle, AutoConstantType acType,
+                                  size_t extraInfo = 0);
+        /// @overload
+        void setNamedAutoConstantReal(const GpuConstantHandle& handle, AutoConstantType acType,
+                                      Real rData);
+
         /** Find a constant definition for a named parameter.
             @remarks
             This method returns null if the named parameter did not exist, unlike
@@ -1985,6 +2260,9 @@ namespace Ogre {
         */
         const GpuConstantDefinition* _findNamedConstantDefinition(
             const String& name, bool throwExceptionIfMissing = false) const;
+        /// @overload
+        const GpuConstantDefinition* _findNamedConstantDefinition(
+            const GpuConstantHandle& handle, bool throwExceptionIfMissing = false) const;
         /** Gets the physical buffer index associated with a logical float constant index.
             @note Only applicable to low-level programs.
             @param logicalIndex The logical parameter index
@@ -353,6 +353,21 @@ namespace Ogre {
                 }
             }
 
+            /** Returns a pointer to the start of the buffer which stays valid, and
+                writable, for the whole lifetime of the buffer.
+            @remarks
+                Used by StreamingBufferAllocator to write into sub ranges of the
+                buffer without locking it. The caller is responsible for not
+                writing to a range the GPU may still read from, and must call
+                _flushPersistentRange once it finished writing to a range.
+            @return
+                NULL if the buffer can not be mapped persistently, which is the default.
+            */
+            virtual void* _getPersistentMapping(void) { return NULL; }
+
+            /// Makes the writes through _getPersistentMapping to the given range visible to the GPU
+            virtual void _flushPersistentRange(size_t offset, size_t length) {}
+
             /// Returns the size of this buffer in bytes
             size_t getSizeInBytes(void) const { return mSizeInBytes; }
             /// Returns the Usage flags with which this buffer was created
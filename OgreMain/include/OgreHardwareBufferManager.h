@@ -203,6 +203,9 @@ namespace Ogre {
         // Mutexes
         OGRE_MUTEX(mTempBuffersMutex);
 
+        /// Created on first use, see getStreamingBuffers
+        std::unique_ptr<StreamingBufferAllocator> mStreamingBuffers;
+
 
         /// Creates a new buffer as a copy of the source, does not copy data.
         virtual HardwareVertexBufferSharedPtr makeBufferCopy(
@@ -407,6 +410,19 @@ namespace Ogre {
         */
         void _forceReleaseBufferCopies(HardwareVertexBuffer* sourceBuffer);
 
+        /** Returns the allocator handing out per frame space for dynamic vertex
+            and index data from buffers of this manager.
+        @see StreamingBufferAllocator
+        */
+        StreamingBufferAllocator& getStreamingBuffers(void);
+        /// The streaming allocator, or NULL if getStreamingBuffers was never called
+        StreamingBufferAllocator* _getStreamingBuffersPtr(void) const { return mStreamingBuffers.get(); }
+        /** Releases the buffers of the streaming allocator, if any.
+        @remarks
+            Render systems call this (through RenderSystem::shutdown) before
+            the manager owning the actual buffers goes away.
+        */
+        void _releaseStreamingBuffers(void);
         /// Notification that a hardware vertex buffer has been destroyed.
         void _notifyVertexBufferDestroyed(HardwareVertexBuffer* buf);
         /// Notification that a hardware index buffer has been destroyed.
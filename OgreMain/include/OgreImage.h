@@ -31,6 +31,7 @@ THE SOFTWARE.
 #include "OgrePrerequisites.h"
 #include "OgreCommon.h"
 #include "OgrePixelFormat.h"
+#include "OgreSharedPtr.h"
 
 namespace Ogre {
     /** \addtogroup Core
@@ -440,6 +441,9 @@ namespace Ogre {
 
         /// A bool to determine if we delete the buffer or the calling app does
         bool mAutoDelete;
+
+        /// Stream owning mBuffer if the codec did not copy the data, e.g. from a mapped file
+        DataStreamPtr mBufferStream;
     };
 
     typedef std::vector<Image*> ImagePtrList;
@@ -30,6 +30,7 @@ THE SOFTWARE.
 
 #include "OgrePrerequisites.h"
 #include "OgreRenderOperation.h"
+#include "Threading/OgreThreadHeaders.h"
 #include "OgreHeaderPrefix.h"
 
 namespace Ogre
@@ -106,6 +107,7 @@ namespace Ogre
         size_t                  mIdCount;
 
         InstanceBatchVec        mDirtyBatches;
+        OGRE_WQ_MUTEX(mDirtyBatchesMutex);
 
         RenderOperation         mSharedRenderOperation;
 
@@ -0,0 +1,98 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#ifndef __LightGrid_H__
+#define __LightGrid_H__
+
+#include "OgrePrerequisites.h"
+#include "OgreCommon.h"
+#include "OgreHeaderPrefix.h"
+
+namespace Ogre
+{
+    /** \addtogroup Core
+    *  @{
+    */
+    /** \addtogroup Scene
+    *  @{
+    */
+    /** Uniform grid over the range spheres of a list of lights.
+    @remarks
+        SceneManager::_populateLightList tests every light affecting the
+        frustum against every object, which does not scale to scenes with many
+        local lights. The grid is built once from the light list and returns the
+        lights whose range may overlap a sphere, so only those have to be
+        tested exactly.
+    @par
+        Lights spanning too many cells, e.g. with a huge attenuation range, and
+        directional lights are returned for every query. Queries covering too
+        many cells return all lights.
+    */
+    class _OgreExport LightGrid : public SceneMgtAlloc
+    {
+    public:
+        LightGrid();
+
+        /** Rebuild the grid from the given lights.
+        @remarks
+            The lights are referred to by their index in this list, their
+            positions and ranges are read once here.
+        */
+        void build(const LightList& lights);
+
+        /** Find the lights which may affect a sphere.
+        @param bounds The sphere to test
+        @param indices Cleared and filled with the indices, in the list given
+            to build(), of the lights which may affect the sphere, in ascending
+            order. Lights not in the result are guaranteed out of range.
+        */
+        void findLights(const Sphere& bounds, std::vector<uint32>& indices) const;
+
+        /// Edge length of the grid cells, derived from the light ranges
+        Real getCellSize(void) const { return mCellSize; }
+    private:
+        typedef std::pair<uint64, uint32> CellEntry;
+
+        /// Cell coordinates of a world position, clamped to the representable range
+        void getCell(const Vector3& pos, int32* cell) const;
+
+        /// Cells referring to each light, sorted by cell key
+        std::vector<CellEntry> mCells;
+        /// Lights returned by every query
+        std::vector<uint32> mUnboundedLights;
+        size_t mNumLights;
+        Real mCellSize;
+        Real mInvCellSize;
+    };
+    /** @} */
+    /** @} */
+}
+
+#include "OgreHeaderSuffix.h"
+
+#endif
@@ -107,6 +107,10 @@ namespace Ogre {
 
         typedef std::vector<LogListener*> mtLogListener;
         mtLogListener mListeners;
+#if OGRE_THREAD_SUPPORT == 3
+        /// Serialises messages from worker threads, as this configuration leaves out the auto mutex
+        OGRE_WQ_MUTEX(mMessageMutex);
+#endif
     public:
 
         class Stream;
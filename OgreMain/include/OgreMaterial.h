@@ -675,6 +675,13 @@ namespace Ogre {
             return mCompilationRequired;
         }
 
+        /** Internal method: returns whether the material can be used by several threads at once.
+        @remarks
+            True when the material is loaded, compiled and has techniques for the active
+            scheme, so that neither touch nor getBestTechnique change it or call listeners.
+        */
+        bool _isReadyForConcurrentUse(void) const;
+
 
     };
     /** @} */
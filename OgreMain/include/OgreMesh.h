@@ -814,11 +814,14 @@ namespace Ogre {
             as a hint for optimisation.
         @param blendNormals
             If @c true, normals are blended as well as positions.
+        @param pool
+            If given, the vertices are split into even ranges which are blended
+            concurrently by the threads of this pool.
         */
         static void softwareVertexBlend(const VertexData* sourceVertexData, 
             const VertexData* targetVertexData,
             const Affine3* const* blendMatrices, size_t numMatrices,
-            bool blendNormals);
+            bool blendNormals, WorkerThreadPool* pool = NULL);
 
         /** Performs a software vertex morph, of the kind used for
             morph animation although it can be used for other purposes. 
@@ -58,6 +58,11 @@ namespace Ogre {
     enum MeshChunkID {
         M_HEADER                = 0x1000,
             // char*          version           : Version number check
+        M_BUFFER_DATA         = 0x2000, // v2.0+, precedes M_MESH
+            // unsigned int numBuffers
+            // unsigned int alignment
+            // unsigned int offset, size (numBuffers) : offsets from the start of this chunk
+            // raw buffer data, each buffer starting at a multiple of alignment
         M_MESH                = 0x3000,
             // bool skeletallyAnimated   // important flag which affects h/w buffer policies
             // Optional M_GEOMETRY chunk
@@ -69,6 +74,8 @@ namespace Ogre {
                 // unsigned int* faceVertexIndices (indexCount)
                 // OR
                 // unsigned short* faceVertexIndices (indexCount)
+                // OR (v2.0+)
+                // unsigned int bufferIndex     : into M_BUFFER_DATA
                 // M_GEOMETRY chunk (Optional: present only if useSharedVertices = false)
                 M_SUBMESH_OPERATION = 0x4010, // optional, trilist assumed if missing
                     // unsigned short operationType
@@ -98,6 +105,8 @@ namespace Ogre {
                     // unsigned short vertexSize;   // Per-vertex size, must agree with declaration at this index
                     M_GEOMETRY_VERTEX_BUFFER_DATA = 0x5210,
                         // raw buffer data
+                        // OR (v2.0+)
+                        // unsigned int bufferIndex : into M_BUFFER_DATA
             M_MESH_SKELETON_LINK = 0x6000,
                 // Optional link to skeleton
                 // char* skeletonName           : name of .skeleton to use
@@ -44,6 +44,8 @@ namespace Ogre {
         /// Latest version available
         MESH_VERSION_LATEST,
         
+        /// Mesh format v2.0 (OGRE v1.11+), vertex and index data ready for direct upload
+        MESH_VERSION_2_0,
         /// OGRE version v1.10+
         MESH_VERSION_1_10,
         /// OGRE version v1.8+
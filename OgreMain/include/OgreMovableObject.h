@@ -272,6 +272,15 @@ namespace Ogre {
         */
         virtual void _updateRenderQueue(RenderQueue* queue) = 0;
 
+        /** Internal method to tell whether this object can be queued concurrently with others.
+            @remarks
+                When the SceneManager culls in parallel (see SceneManager::setParallelCullingEnabled),
+                _notifyCurrentCamera and _updateRenderQueue of the objects returning true are called
+                from several threads at once, each with its own render queue. They must then only
+                modify the object itself. The other objects are queued by the calling thread.
+        */
+        virtual bool _canQueueConcurrently(void) const { return false; }
+
         /** Tells this object whether to be visible or not, if it has a renderable component. 
         @note An alternative approach of making an object invisible is to detach it
             from it's SceneNode, or to remove the SceneNode entirely. 
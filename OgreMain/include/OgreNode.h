@@ -220,6 +220,17 @@ namespace Ogre {
 
         typedef std::vector<Node*> QueuedUpdates;
         static QueuedUpdates msQueuedUpdates;
+        /// Guards msQueuedUpdates, listeners queue updates from the threads of a
+        /// parallel scene graph update. Wrapped as OGRE_WQ_MUTEX declares a mutable member.
+        struct QueuedUpdatesMutex { OGRE_WQ_MUTEX(mutex); };
+        static QueuedUpdatesMutex msQueuedUpdatesMutex;
+
+        friend class NodeTransformStore;
+        /// Packed transform store mirroring this node, if any
+        NodeTransformStore* mTransformStore;
+        /// Position of this node within mTransformStore, maintained by the store
+        uint32 mTransformLevel;
+        uint32 mTransformIndex;
 
     public:
         /** Constructor, should only be called by parent, not directly.
@@ -568,6 +579,27 @@ namespace Ogre {
         */
         virtual void _update(bool updateChildren, bool parentHasChanged);
 
+        /** Internal method to update this Node only, without cascading down.
+        @remarks
+            This is the first half of _update, split out so that a SceneManager can
+            update independent branches of the graph concurrently. Each node appended
+            to @c children must then be brought up to date with _update(true, fullUpdate),
+            where fullUpdate is the return value, before calling _updateChildrenDone.
+        @param parentHasChanged See _update
+        @param children List the children requiring an update are appended to
+        @return Whether the children must retrieve their parent transform
+        */
+        bool _updateSelf(bool parentHasChanged, ChildNodeMap& children);
+
+        /** Internal method to mirror the transform of this node in a NodeTransformStore.
+        @remarks
+            Called by the SceneManager, pass null to stop mirroring.
+        */
+        void _setTransformStore(NodeTransformStore* store);
+
+        /** Internal method to complete _updateSelf, once all children are up to date. */
+        virtual void _updateChildrenDone(void);
+
         /** Sets a listener for this Node.
         @remarks
             Note for size and performance reasons only one listener per node is
@@ -656,6 +688,7 @@ namespace Ogre {
             response to a Node::Listener hook, because the graph is already being 
             updated, and update flag changes cannot be made reliably in that context. 
             Call this method if you need to queue a needUpdate call in this case.
+            It may be called from several threads at once.
         */
         static void queueNeedUpdate(Node* n);
         /** Process queued 'needUpdate' calls. */
@@ -0,0 +1,168 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#ifndef __NodeTransformStore_H__
+#define __NodeTransformStore_H__
+
+#include "OgrePrerequisites.h"
+#include "OgreHeaderPrefix.h"
+
+namespace Ogre
+{
+    /** \addtogroup Core
+    *  @{
+    */
+    /** \addtogroup Scene
+    *  @{
+    */
+    /** Packed storage for the transforms of a node hierarchy.
+    @remarks
+        Node keeps its local and derived transforms as members of a large
+        object, so updating a hierarchy touches a new cache line for every node
+        and every parent it reads from. The store keeps a copy of the local
+        transforms in structure of arrays form, grouped by depth in the
+        hierarchy, and computes the derived transforms (including the full
+        transform matrix) level by level over the packed arrays, four nodes at
+        a time with SSE where available.
+    @par
+        The nodes remain the authority for their local transforms and push
+        every change to the store (see Node::needUpdate). When the hierarchy
+        is then updated, nodes whose derived transform has already been
+        computed by the store copy it instead of recomputing it. Results are
+        identical to the scalar code path.
+    @par
+        Only the nodes attached below the root node given to update() are
+        stored. Attaching, detaching or destroying nodes invalidates the
+        packed layout, which is rebuilt on the next update, so this pays off
+        for hierarchies which change shape less often than they move.
+    @note
+        Not available with OGRE_NODE_INHERIT_TRANSFORM, where the derived
+        transform is decomposed from the full matrix instead.
+    */
+    class _OgreExport NodeTransformStore : public NodeAlloc
+    {
+    public:
+        NodeTransformStore();
+        ~NodeTransformStore();
+
+        /** Compute the derived transforms of all nodes which changed since the last update.
+        @remarks
+            Marks the beginning of a hierarchy update; Node::_update will pick up
+            the derived transforms computed here until endUpdate() is called.
+        @param root Root of the hierarchy to store
+        @param pool Optional pool used to split large levels across threads
+        */
+        void beginUpdate(Node* root, WorkerThreadPool* pool = NULL);
+
+        /// Marks the end of the hierarchy update started by beginUpdate()
+        void endUpdate(void) { mUpdating = false; }
+
+        /// Number of nodes currently in the packed layout
+        size_t getNumNodes(void) const;
+
+        /// Number of levels (depth of the hierarchy + 1) in the packed layout
+        size_t getNumLevels(void) const { return mLevels.size(); }
+
+        /// Notification from a node that its local transform or inheritance changed
+        void _notifyNodeChanged(const Node* node);
+
+        /// Notification from a node that it was attached to or detached from a parent
+        void _notifyHierarchyChanged(void) { mLayoutOutOfDate = true; }
+
+        /// Notification from a node that it is being destroyed or moved to another store
+        void _notifyNodeRemoved(Node* node);
+
+        /** Fetch the derived transform of a node computed by the current update.
+        @return false if the store has no up to date transform for this node, in
+            which case the node has to compute it itself
+        */
+        bool _getDerivedTransform(const Node* node, Quaternion& orientation, Vector3& position,
+                                  Vector3& scale, Affine3& fullTransform) const;
+
+        /// Compute the derived transforms of the entries [begin; end) of a level
+        void _updateRange(size_t level, size_t begin, size_t end);
+    private:
+        /// Component arrays of a level
+        enum Component
+        {
+            ORIENTATION_W, ORIENTATION_X, ORIENTATION_Y, ORIENTATION_Z,
+            POSITION_X, POSITION_Y, POSITION_Z,
+            SCALE_X, SCALE_Y, SCALE_Z,
+            NUM_COMPONENTS
+        };
+
+        /// Per node flags
+        enum Flags
+        {
+            /// The local transform changed since the last update
+            FLAG_DIRTY = 1 << 0,
+            /// The derived transform was computed by the current update
+            FLAG_UPDATED = 1 << 1,
+            FLAG_INHERIT_ORIENTATION = 1 << 2,
+            FLAG_INHERIT_SCALE = 1 << 3
+        };
+
+        /** Nodes of the same depth.
+        @remarks
+            The arrays are padded to a multiple of 4 entries, padding entries
+            have no flags set and a valid parent index.
+        */
+        struct Level
+        {
+            std::vector<Real> local[NUM_COMPONENTS];
+            std::vector<Real> derived[NUM_COMPONENTS];
+            /// Rows 0 to 2 of the derived full transform, in row major order
+            std::vector<Real> transform[12];
+            /// Index of the parent in the previous level
+            std::vector<uint32> parent;
+            std::vector<uint8> flags;
+            std::vector<Node*> nodes;
+
+            size_t size(void) const { return nodes.size(); }
+            void clear(void);
+            void push_back(Node* node, uint32 parentIdx);
+            void pad(void);
+        };
+
+        void rebuildLayout(Node* root);
+        void storeLocalTransform(size_t level, size_t idx, const Node* node);
+        void storeFullTransform(Level& level, size_t idx);
+
+        typedef std::vector<Level> LevelList;
+        LevelList mLevels;
+        bool mLayoutOutOfDate;
+        bool mUpdating;
+        bool mUseSSE;
+    };
+    /** @} */
+    /** @} */
+}
+
+#include "OgreHeaderSuffix.h"
+
+#endif
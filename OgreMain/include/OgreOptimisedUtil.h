@@ -203,6 +203,31 @@ namespace Ogre {
             const float* srcPositions,
             float* destPositions,
             size_t numVertices) = 0;
+
+        /** Test a batch of axis aligned boxes against a set of planes.
+        @remarks
+            A box is visible unless it lies completely on the negative side of
+            any of the planes, the same test as Frustum::isVisible does for a
+            single box.
+        @param planes The planes to test against, e.g. those of a frustum.
+        @param numPlanes Number of planes.
+        @param centres Pointer to the box centres, which packed in (x, y, z)
+            format. No alignment requirement.
+        @param halfSizes Pointer to the box half-sizes, which packed in
+            (x, y, z) format. No alignment requirement.
+        @param visibility Pointer to the visibility bitmask, bit (i % 32) of
+            element (i / 32) is set if box i is visible. Must hold
+            (numBoxes + 31) / 32 elements, unused bits are cleared.
+        @param numBoxes Number of boxes to test. Null and infinite boxes can't
+            be represented and have to be handled by the caller.
+        */
+        virtual void calculateBoxVisibility(
+            const Plane* planes,
+            size_t numPlanes,
+            const float* centres,
+            const float* halfSizes,
+            uint32* visibility,
+            size_t numBoxes) = 0;
     };
 
     /** Returns raw offseted of the given pointer.
@@ -726,8 +726,6 @@ namespace Ogre {
             float operator()(Particle* p) const;
         };
 
-        static RadixSort<ActiveParticleList, Particle*, float> mRadixSorter;
-
         /** Active particle list.
             @remarks
                 This is a linked list of pointers to particles in the particle pool.
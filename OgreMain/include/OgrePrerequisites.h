@@ -89,6 +89,7 @@ namespace Ogre {
     class Camera;
     class Codec;
     class ColourValue;
+    class CompressedNodeAnimation;
     class ConfigDialog;
     template <typename T> class Controller;
     template <typename T> class ControllerFunction;
@@ -137,6 +138,7 @@ namespace Ogre {
     class Image;
     class KeyFrame;
     class Light;
+    class LightGrid;
     class Log;
     class LogManager;
     class LodStrategy;
@@ -157,6 +159,7 @@ namespace Ogre {
     class MovablePlane;
     class Node;
     class NodeAnimationTrack;
+    class NodeTransformStore;
     class NodeKeyFrame;
     class NumericAnimationTrack;
     class NumericKeyFrame;
@@ -185,6 +188,7 @@ namespace Ogre {
     class RaySceneQuery;
     class RaySceneQueryListener;
     class Renderable;
+    class RenderCommandList;
     class RenderPriorityGroup;
     class RenderQueue;
     class RenderQueueGroup;
@@ -232,6 +236,7 @@ namespace Ogre {
     class SphereSceneQuery;
     class StaticGeometry;
     class StreamSerialiser;
+    class StreamingBufferAllocator;
     class StringConverter;
     class StringInterface;
     class SubEntity;
@@ -245,6 +250,7 @@ namespace Ogre {
     class TextureManager;
     class TransformKeyFrame;
     class Timer;
+    class UniformScalableTask;
     class UserObjectBindings;
     template <int dims, typename T> class Vector;
     typedef Vector<2, Real> Vector2;
@@ -259,6 +265,7 @@ namespace Ogre {
     class VertexDeclaration;
     class VertexMorphKeyFrame;
     class WireBoundingBox;
+    class WorkerThreadPool;
     class WorkQueue;
     class Compositor;
     class CompositorManager;
@@ -82,7 +82,12 @@ namespace Ogre {
         implementation can handle both unsigned and signed integers, as well as
         floats (which are often not supported by other radix sorters). doubles
         are not supported; you will need to implement your functor object to convert
-        to float if you wish to use this sort routine.
+        to float if you wish to use this sort routine. 64 bit unsigned integers
+        are supported too, which allows combining several sort criteria into one
+        key and sorting by all of them in a single call.
+    @par
+        RadixSort instances keep internal state while sorting, so an instance must
+        not be used by more than one thread at a time.
     */
     template <class TContainer, class TContainerValueType, typename TCompValueType>
     class RadixSort
@@ -91,8 +96,8 @@ namespace Ogre {
         typedef typename TContainer::iterator ContainerIter;
     protected:
         /// Alpha-pass counters of values (histogram)
-        /// 4 of them so we can radix sort a maximum of a 32bit value
-        int mCounters[4][256];
+        /// one per byte of the sort value
+        int mCounters[sizeof(TCompValueType)][256];
         /// Beta-pass offsets 
         int mOffsets[256];
         /// Sort area size
@@ -0,0 +1,197 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __RenderCommandList_H__
+#define __RenderCommandList_H__
+
+#include "OgrePrerequisites.h"
+#include "OgreBlendMode.h"
+#include "OgreCommon.h"
+#include "OgreGpuProgram.h"
+#include "OgreGpuProgramParams.h"
+#include "OgreMatrix4.h"
+#include "OgreRenderOperation.h"
+#include "OgreHeaderPrefix.h"
+
+namespace Ogre {
+    /** \addtogroup Core
+    *  @{
+    */
+    /** \addtogroup RenderSystem
+    *  @{
+    */
+
+    /** A recorded stream of state changes, constant updates and draws.
+    @remarks
+        RenderSystem is an immediate mode interface, all of its methods must be
+        called from the thread owning the rendering context. A command list
+        instead only records the calls, independently of the rendering API, so
+        several threads can record the lists of different parts of a frame
+        (e.g. render queue groups) in parallel. The rendering thread then
+        replays them in order with RenderSystem::_executeCommandList.
+    @par
+        Everything the replay needs is captured when recording: the GPU program
+        parameters are copied, so their owner may change them for the next
+        object right away. Objects only referenced (programs, textures and the
+        vertex and index data of render operations) must stay alive and
+        unchanged until the list was executed.
+    @par
+        Recording into one list is not thread safe, use one list per thread.
+        Clearing a list keeps its memory, so lists reused every frame do not
+        allocate once they reached their working size.
+    @note
+        SceneManager does not record its render queue, it still renders in
+        immediate mode: its pass setup changes more state than a list records
+        (e.g. texture unit settings and fixed function state) and updates the
+        auto constants through state shared by the whole frame. Command lists are
+        meant for geometry issued by the application, e.g. recorded by worker
+        threads and executed from RenderQueueListener::renderQueueEnded.
+    */
+    class _OgreExport RenderCommandList : public RenderSysAlloc
+    {
+    public:
+        enum CommandType
+        {
+            RCT_BIND_GPU_PROGRAM,
+            RCT_UNBIND_GPU_PROGRAM,
+            RCT_BIND_GPU_PROGRAM_PARAMETERS,
+            RCT_SET_WORLD_MATRIX,
+            RCT_SET_CULLING_MODE,
+            RCT_SET_DEPTH_BUFFER_PARAMS,
+            RCT_SET_SCENE_BLENDING,
+            RCT_SET_POLYGON_MODE,
+            RCT_SET_TEXTURE,
+            RCT_RENDER
+        };
+
+        RenderCommandList();
+        ~RenderCommandList();
+
+        /// @copydoc RenderSystem::bindGpuProgram
+        void bindGpuProgram(GpuProgram* prg);
+        /// @copydoc RenderSystem::unbindGpuProgram
+        void unbindGpuProgram(GpuProgramType gptype);
+        /** Records binding a copy of the parameters as they are now.
+        @remarks
+            The dirty ranges of the parameters move to the copy, as if they were
+            bound right away.
+        @see RenderSystem::bindGpuProgramParameters
+        */
+        void bindGpuProgramParameters(GpuProgramType gptype, const GpuProgramParametersSharedPtr& params,
+                                      uint16 variabilityMask);
+        /// @copydoc RenderSystem::_setWorldMatrix
+        void setWorldMatrix(const Matrix4& m);
+        /// @copydoc RenderSystem::_setCullingMode
+        void setCullingMode(CullingMode mode);
+        /// @copydoc RenderSystem::_setDepthBufferParams
+        void setDepthBufferParams(bool depthTest, bool depthWrite, CompareFunction depthFunction);
+        /// @copydoc RenderSystem::_setSeparateSceneBlending
+        void setSceneBlending(SceneBlendFactor sourceFactor, SceneBlendFactor destFactor,
+                              SceneBlendFactor sourceFactorAlpha, SceneBlendFactor destFactorAlpha,
+                              SceneBlendOperation op = SBO_ADD, SceneBlendOperation alphaOp = SBO_ADD);
+        /// @copydoc RenderSystem::_setPolygonMode
+        void setPolygonMode(PolygonMode mode);
+        /// @copydoc RenderSystem::_setTexture
+        void setTexture(size_t unit, bool enabled, const TexturePtr& tex);
+        /// Records drawing the operation, see RenderSystem::_render
+        void render(const RenderOperation& op);
+
+        /// Removes all commands, keeping the memory for the next recording
+        void clear(void);
+
+        /// Number of recorded commands
+        size_t getNumCommands(void) const { return mCommands.size(); }
+        /// Number of recorded draws
+        size_t getNumDraws(void) const { return mOperations.size(); }
+        /// Type of the command at the given position
+        CommandType getCommandType(size_t i) const { return mCommands[i].type; }
+
+        /** Issues the recorded commands to the given render system in order.
+        @remarks
+            This is the portable replay RenderSystem::_executeCommandList uses by
+            default. Must be called from the rendering thread.
+        */
+        void _replay(RenderSystem* rs) const;
+
+    private:
+        struct Command
+        {
+            struct Parameters
+            {
+                GpuProgramType type;
+                uint16 variabilityMask;
+                uint32 index;
+            };
+            struct DepthParams
+            {
+                bool test;
+                bool write;
+                CompareFunction function;
+            };
+            struct Blending
+            {
+                SceneBlendFactor source, dest, sourceAlpha, destAlpha;
+                SceneBlendOperation op, alphaOp;
+            };
+            struct Texture
+            {
+                uint32 unit;
+                bool enabled;
+                uint32 index;
+            };
+
+            CommandType type;
+            union
+            {
+                GpuProgram* program;
+                GpuProgramType programType;
+                Parameters parameters;
+                DepthParams depth;
+                Blending blending;
+                Texture texture;
+                CullingMode cullingMode;
+                PolygonMode polygonMode;
+                /// Index into mMatrices or mOperations
+                uint32 index;
+            };
+        };
+
+        std::vector<Command> mCommands;
+        std::vector<Matrix4> mMatrices;
+        std::vector<RenderOperation> mOperations;
+        std::vector<TexturePtr> mTextures;
+        /// Copies of the recorded parameters, the first mNumParameters are in use
+        std::vector<GpuProgramParametersSharedPtr> mParameters;
+        size_t mNumParameters;
+    };
+    /** @} */
+    /** @} */
+} // namespace Ogre
+
+#include "OgreHeaderSuffix.h"
+
+#endif // __RenderCommandList_H__
@@ -140,6 +140,11 @@ namespace Ogre {
         bool mShadowCastersCannotBeReceivers;
 
         RenderableListener* mRenderableListener;
+
+        /// Whether processVisibleObject measures the time spent queueing objects
+        bool mQueueingTimed;
+        /// Nanoseconds spent in MovableObject::_updateRenderQueue by processVisibleObject
+        uint64 mQueueingTime;
     public:
         RenderQueue();
         virtual ~RenderQueue();
@@ -287,6 +292,15 @@ namespace Ogre {
         /** Merge render queue.
         */
         void merge( const RenderQueue* rhs );
+
+        /** Prepares this queue to collect renderables to be merged into another queue.
+        @remarks
+            Destroys the contents of this queue and copies the settings of rhs and
+            of each of its queue groups, so renderables are organised exactly as
+            if they were added to rhs. The renderable listener is shared, it is
+            called with this queue.
+        */
+        void _copySettings( const RenderQueue* rhs );
         /** Utility method to perform the standard actions associated with 
             getting a visible object to add itself to the queue. This is 
             a replacement for SceneManager implementations of the associated
@@ -297,6 +311,13 @@ namespace Ogre {
             bool onlyShadowCasters, 
             VisibleObjectsBoundsInfo* visibleBounds);
 
+        /** Sets whether processVisibleObject measures the time objects take to queue themselves.
+        @see SceneManager::setStageTimingEnabled
+        */
+        void _setQueueingTimed(bool timed) { mQueueingTimed = timed; }
+
+        /// Nanoseconds spent queueing objects in processVisibleObject while timed
+        uint64 _getQueueingTime(void) const { return mQueueingTime; }
     };
 
     /** @} */
@@ -123,22 +123,40 @@ namespace Ogre {
         };
 
     protected:
+        /** Entry of the pass grouped list.
+        @remarks
+            The sort key holds the pass hash in the upper 32 bits and the lower 32 bits
+            of the pass address in the lower ones, so sorting on it brings the
+            renderables of each pass together, ordered by pass hash. Passes with the
+            same hash are then ordered by their full address, see PassGroupLess.
+        */
+        struct PassGroupEntry
+        {
+            uint64 sortKey;
+            Renderable* renderable;
+            Pass* pass;
+
+            PassGroupEntry(Pass* p, Renderable* rend)
+                : sortKey((uint64(p->getHash()) << 32) | uint32(reinterpret_cast<size_t>(p)))
+                , renderable(rend), pass(p)
+            {
+            }
+        };
         /// Comparator to order pass groups
         struct PassGroupLess
         {
-            bool operator()(const Pass* a, const Pass* b) const
+            bool operator()(const PassGroupEntry& a, const PassGroupEntry& b) const
             {
                 // Sort by passHash, which is pass, then texture unit changes
-                uint32 hasha = a->getHash();
-                uint32 hashb = b->getHash();
-                if (hasha == hashb)
+                uint32 hashA = uint32(a.sortKey >> 32), hashB = uint32(b.sortKey >> 32);
+                if (hashA == hashB)
                 {
-                    // Must differentTransparentQueueItemLessiate by pointer incase 2 passes end up with the same hash
-                    return a < b;
+                    // Must differentiate by pointer incase 2 passes end up with the same hash
+                    return a.pass < b.pass;
                 }
                 else
                 {
-                    return hasha < hashb;
+                    return hashA < hashB;
                 }
             }
         };
@@ -183,50 +201,63 @@ namespace Ogre {
          vectors only ever increase in size, so even if we do clear() the memory stays
          allocated, ie fast */
         typedef std::vector<RenderablePass> RenderablePassList;
-        /** Map of pass to renderable lists, this is a grouping by pass. */
-        typedef std::map<Pass*, RenderableList, PassGroupLess> PassGroupRenderableMap;
+        /** Vector of PassGroupEntry objects, a grouping by pass once sorted. Like
+         RenderablePassList it keeps its memory when cleared, so that queueing does not
+         allocate once the capacity needed by the scene is reached */
+        typedef std::vector<PassGroupEntry> PassGroupList;
 
-        /// Functor for accessing sort value 1 for radix sort (Pass)
-        struct RadixSortFunctorPass
+        /// Functor for accessing the sort key of pass group entries for radix sort
+        struct RadixSortFunctorPassGroup
         {
-            uint32 operator()(const RenderablePass& p) const
+            uint64 operator()(const PassGroupEntry& e) const
             {
-                return p.pass->getHash();
+                return e.sortKey;
             }
         };
 
-        /// Radix sorter for accessing sort value 1 (Pass)
-        static RadixSort<RenderablePassList, RenderablePass, uint32> msRadixSorter1;
-
-        /// Functor for descending sort value 2 for radix sort (distance)
-        struct RadixSortFunctorDistance
+        /** Functor for the combined radix sort key (distance, then pass)
+        @remarks
+            The upper 32 bits hold the negated view depth, remapped so that it orders
+            correctly as an unsigned integer, and the lower 32 bits hold the pass hash.
+            Sorting on this key gives the same order as sorting by pass first and by
+            distance afterwards, with a single radix sort.
+        */
+        struct RadixSortFunctorDistancePass
         {
             const Camera* camera;
 
-            RadixSortFunctorDistance(const Camera* cam)
+            RadixSortFunctorDistancePass(const Camera* cam)
                 : camera(cam)
             {
             }
 
-            float operator()(const RenderablePass& p) const
+            uint64 operator()(const RenderablePass& p) const
             {
                 // Sort DESCENDING by depth (ie far objects first), use negative distance
                 // here because radix sorter always dealing with accessing sort
-                return static_cast<float>(- p.renderable->getSquaredViewDepth(camera));
+                union { float f; uint32 u; } depth;
+                depth.f = static_cast<float>(- p.renderable->getSquaredViewDepth(camera));
+                // flip all bits of negative values and only the sign bit of positive ones
+                depth.u ^= (depth.u & 0x80000000) ? 0xFFFFFFFF : 0x80000000;
+                return (uint64(depth.u) << 32) | p.pass->getHash();
             }
         };
 
-        /// Radix sorter for sort value 2 (distance)
-        static RadixSort<RenderablePassList, RenderablePass, float> msRadixSorter2;
-
         /// Bitmask of the organisation modes requested
         uint8 mOrganisationMode;
 
-        /// Grouped 
-        PassGroupRenderableMap mGrouped;
+        /// Grouped by pass (once sorted)
+        PassGroupList mGrouped;
+        /// Whether renderables were added to mGrouped since it was last sorted
+        bool mGroupedNeedsSorting;
+        /// Renderables of the pass group currently visited
+        mutable RenderableList mVisitedGroup;
         /// Sorted descending (can iterate backwards to get ascending)
         RenderablePassList mSortedDescending;
 
+        /// Sort mGrouped so that the entries of each pass are adjacent
+        void sortGrouped(void);
+
         /// Internal visitor implementation
         void acceptVisitorGrouped(QueuedRenderableVisitor* visitor) const;
         /// Internal visitor implementation
@@ -271,6 +302,10 @@ namespace Ogre {
         void addRenderable(Pass* pass, Renderable* rend);
         
         /** Perform any sorting that is required on this collection.
+        @remarks
+            This includes the grouping by pass, so it has to be called before visiting
+            the collection in OM_PASS_GROUP mode. Otherwise passes may be visited more
+            than once.
         @param cam The camera
         */
         void sort(const Camera* cam);
@@ -707,6 +742,21 @@ namespace Ogre {
                 pDstPriorityGrp->merge( pSrcPriorityGrp );
             }
         }
+
+        /** Destroys the contents of this group and takes over the settings of another one.
+        @remarks
+            Used to collect renderables in a separate group, e.g. on another
+            thread, which are later merged into rhs.
+        */
+        void _copySettings( const RenderQueueGroup* rhs )
+        {
+            clear(true);
+            mSplitPassesByLightingType = rhs->mSplitPassesByLightingType;
+            mSplitNoShadowPasses = rhs->mSplitNoShadowPasses;
+            mShadowCastersNotReceivers = rhs->mShadowCastersNotReceivers;
+            mShadowsEnabled = rhs->mShadowsEnabled;
+            mOrganisationMode = rhs->mOrganisationMode;
+        }
     };
 
     /** @} */
@@ -939,6 +939,17 @@ namespace Ogre
         */
         virtual void _render(const RenderOperation& op);
 
+        /** Executes a command list recorded with RenderCommandList.
+        @remarks
+        The lists of a frame may be recorded on several threads, but must be
+        executed from the rendering thread in the order they are to be drawn.
+        The default implementation replays the commands through the immediate
+        mode methods; render systems with native deferred contexts may override it.
+        Can only be called between _beginScene and _endScene. SceneManager does not
+        use command lists for its own rendering.
+        */
+        virtual void _executeCommandList(const RenderCommandList& list);
+
         virtual void _dispatchCompute(const Vector3i& workgroupDim) {}
 
         /** Gets the capabilities of the render system. */
@@ -977,6 +988,32 @@ namespace Ogre
         /** Only binds Gpu program parameters used for passes that have more than one iteration rendering
         */
         virtual void bindGpuProgramPassIterationParameters(GpuProgramType gptype) = 0;
+
+        /** Whether per-object constants can be sourced from a constant block.
+        @remarks
+        If so, SceneManager packs the per-object auto constants of all the renderables
+        sharing a pass into one ring buffered uniform buffer, so that each draw only
+        binds an offset through _bindPerObjectConstantBlock.
+        @par
+        A render system returning true must make the programs read their per-object
+        constants from the bound block. Only the Null render system does so at the moment.
+        @see SceneManager::setPerObjectConstantBatchingEnabled
+        */
+        virtual bool _supportsPerObjectConstantBlocks(void) const { return false; }
+
+        /** Binds the per-object constants of the following draws from a constant block.
+        @remarks
+        These constants are then no longer bound by bindGpuProgramParameters, which is
+        called without GPV_PER_OBJECT in the variability mask.
+        @param gptype The type of program to bind the constants to
+        @param params The parameters of that program
+        @param block The buffer holding the constants
+        @param offset Offset in bytes of the constants, as written by
+        GpuProgramParameters::_packPerObjectConstants
+        */
+        virtual void _bindPerObjectConstantBlock(GpuProgramType gptype,
+            const GpuProgramParametersSharedPtr& params, const HardwareUniformBufferSharedPtr& block,
+            size_t offset) {}
         /** Unbinds GpuPrograms of a given GpuProgramType.
         @remarks
         This returns the pipeline to fixed-function processing for this type.
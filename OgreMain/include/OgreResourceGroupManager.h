@@ -35,6 +35,8 @@ THE SOFTWARE.
 #include "OgreIteratorWrappers.h"
 #include "OgreCommon.h"
 #include "Threading/OgreThreadHeaders.h"
+#include "OgreWorkerThreadPool.h"
+#include "OgreAtomicScalar.h"
 #include <ctime>
 #include "OgreHeaderPrefix.h"
 
@@ -297,6 +299,8 @@ namespace Ogre {
             Archive* archive;
             /// Whether this location was added recursively
             bool recursive;
+            /// All files of the location, if they are cached (see setIndexCachePath)
+            FileInfoListPtr files;
         };
         /// List of possible file locations
         typedef std::vector<ResourceLocation> LocationList;
@@ -439,6 +443,19 @@ namespace Ogre {
 
         /// Stored current group - optimisation for when bulk loading a group
         ResourceGroup* mCurrentGroup;
+
+        /// Incremented whenever a group is created or destroyed
+        AtomicScalar<uint32> mGroupsVersion;
+
+        /// Directory of the file lists cached across runs, empty if disabled
+        String mIndexCachePath;
+        /** Lists all files of a location, from the index cache if it is up to date. */
+        FileInfoListPtr listLocationFiles(Archive* arch, bool recursive) const;
+
+        /// Threads preparing resources in loadResourceGroup, null if serial
+        std::unique_ptr<WorkerThreadPool> mWorkerThreadPool;
+        /** Prepares the resources of the group which allow it concurrently on mWorkerThreadPool. */
+        void prepareResourcesConcurrently(ResourceGroup* grp);
     public:
         ResourceGroupManager();
         virtual ~ResourceGroupManager();
@@ -569,6 +586,33 @@ namespace Ogre {
         void loadResourceGroup(const String& name, bool loadMainResources = true, 
             bool loadWorldGeom = true);
 
+        /** Sets the number of threads preparing resources in loadResourceGroup.
+        @remarks
+            With more than one thread, loadResourceGroup (and prepareResourceGroup)
+            first prepares the resources
+            of the group whose ResourceManager allows it (see
+            ResourceManager::isConcurrentPrepareSafe) concurrently, picking them up in
+            loading order, e.g. reading meshes and decoding texture images. Then all
+            resources are loaded one after the other on the calling thread as before,
+            which includes everything touching the RenderSystem, and the
+            ResourceGroupListener events fire in the same order as without threads.
+            Manually loaded resources are always prepared by the calling thread.
+        @par
+            The calling thread counts as one of them, so 1 (the default) disables
+            threading and 0 picks one thread per hardware thread.
+        @note
+            The resource system is only thread safe with OGRE_THREAD_SUPPORT 1 or 2,
+            i.e. when building with OGRE_CONFIG_THREADS set to 1 or 2. The default of 3
+            leaves out the locks of archives, resources and managers, so with it, as
+            without thread support, this option is ignored and the resources are
+            prepared by the calling thread.
+        */
+        void setNumWorkerThreads(size_t numThreads);
+
+        /** Gets the number of threads preparing resources in loadResourceGroup. */
+        size_t getNumWorkerThreads(void) const
+        { return mWorkerThreadPool ? mWorkerThreadPool->getNumThreads() : 1; }
+
         /** Unloads a resource group.
         @remarks
             This method unloads all the resources that have been declared as
@@ -689,6 +733,36 @@ namespace Ogre {
         */
         void addResourceLocation(const String& name, const String& locType, 
             const String& resGroup = DEFAULT_RESOURCE_GROUP_NAME, bool recursive = false, bool readOnly = true);
+
+        /** Gets a number which changes whenever a resource group is created or destroyed.
+        @remarks
+            Allows caching the properties of groups, e.g. isResourceGroupInGlobalPool,
+            without taking the lock of this class to validate them.
+        */
+        uint32 _getResourceGroupsVersion(void) const { return mGroupsVersion.load(); }
+
+        /** Sets a directory to cache the file lists of resource locations in.
+        @remarks
+            By default addResourceLocation lists all files of the archive, and
+            initialising a group searches its locations once more for every script
+            pattern, which adds up with large archives. With a cache directory set,
+            the file list of each location is stored in a small binary file there,
+            together with the modification times of the archive, its (listed)
+            directories and its files. Later runs read the list back instead of
+            scanning, unless one of these times or the size of a file changed, and
+            match the script patterns against it.
+        @par
+            Only locations added after calling this are affected. The directory must
+            exist and be writable, otherwise the locations are scanned as usual.
+            Archives which do not report modification times are never cached. Note
+            that a directory, or a file keeping its size, modified twice within the
+            resolution of its timestamp might go unnoticed.
+        @param path The directory, or an empty string to disable the cache (the default)
+        */
+        void setIndexCachePath(const String& path) { mIndexCachePath = path; }
+
+        /** Gets the directory the file lists of resource locations are cached in. */
+        const String& getIndexCachePath(void) const { return mIndexCachePath; }
         /** Removes a resource location from the search path. */ 
         void removeResourceLocation(const String& name, 
             const String& resGroup = DEFAULT_RESOURCE_GROUP_NAME);
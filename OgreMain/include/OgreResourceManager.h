@@ -334,9 +334,23 @@ namespace Ogre {
         virtual void removeUnreferencedResources(bool reloadableOnly = true);
 
         /** Retrieves a pointer to a resource by name, or null if the resource does not exist.
+        @remarks
+            Lookups do not take the lock of the manager, only a lock of the part of
+            the name index the name hashes to, so threads looking up resources do
+            not wait for each other or for resources being created.
         */
         virtual ResourcePtr getResourceByName(const String& name, const String& groupName OGRE_RESOURCE_GROUP_INIT);
 
+        /** Looks up a resource whose name was hashed with hashName before.
+        @remarks
+            Saves hashing the name on every call for resources which are looked
+            up repeatedly.
+        */
+        ResourcePtr getResourceByName(const String& name, uint32 hash, const String& groupName);
+
+        /// Hash used for name lookups, see getResourceByName
+        static uint32 hashName(const String& name) { return FastHash(name.c_str(), name.size()); }
+
         /** Retrieves a pointer to a resource by handle, or null if the resource does not exist.
         */
         virtual ResourcePtr getByHandle(ResourceHandle handle);
@@ -447,6 +461,16 @@ namespace Ogre {
         /** Gets whether this manager and its resources habitually produce log output */
         bool getVerbose(void) { return mVerbose; }
 
+        /** Gets whether resources of this type may be prepared concurrently.
+        @remarks
+            If true, Resource::prepare of resources which are not manually loaded
+            only reads and decodes their data, without touching the RenderSystem or
+            other resources, so ResourceGroupManager::loadResourceGroup may prepare
+            several of them at once.
+        @see ResourceGroupManager::setNumWorkerThreads
+        */
+        bool isConcurrentPrepareSafe(void) const { return mConcurrentPrepare; }
+
         /** Definition of a pool of resources, which users can use to reuse similar
             resources many times without destroying and recreating them.
         @remarks
@@ -528,6 +552,42 @@ namespace Ogre {
         AtomicScalar<size_t> mMemoryUsage; /// In bytes
 
         bool mVerbose;
+        /// Whether resources of this type may be prepared concurrently
+        bool mConcurrentPrepare;
+
+        /// Number of independently locked parts of the name index
+        static const size_t NUM_NAME_INDEX_SHARDS = 16;
+        struct NameIndexEntry
+        {
+            String name;
+            /// Group whose pool holds the resource, empty for the global pool
+            String pool;
+            ResourcePtr resource;
+        };
+        typedef std::unordered_multimap<uint32, NameIndexEntry> NameIndexShardMap;
+        /// Part of the name index, the entries are keyed by hashName
+        struct NameIndexShard
+        {
+            NameIndexShardMap entries;
+            OGRE_RW_MUTEX(mutex);
+        };
+        /** Index of mResources and mResourcesWithGroup for lookups by name.
+        @remarks
+            Split into parts by the hash of the names, so concurrent lookups
+            only contend when hitting the same part.
+        */
+        NameIndexShard mNameIndex[NUM_NAME_INDEX_SHARDS];
+
+        /// Whether groups are in the global pool, valid for mGroupPoolsVersion
+        std::unordered_map<String, bool> mGroupPools;
+        uint32 mGroupPoolsVersion;
+        OGRE_RW_MUTEX(mGroupPoolsMutex);
+
+        void addToNameIndex(const ResourcePtr& res, bool inGlobalPool, uint32 groupsVersion);
+        void removeFromNameIndex(const ResourcePtr& res, bool inGlobalPool);
+        /** Same as ResourceGroupManager::isResourceGroupInGlobalPool, from the groups of added resources
+            without taking the lock of the ResourceGroupManager. */
+        bool isGroupInGlobalPool(const String& group);
 
         // IMPORTANT - all subclasses must populate the fields below
 
@@ -93,6 +93,7 @@ namespace Ogre
         std::unique_ptr<SkeletonManager> mSkeletonManager;
 
         std::unique_ptr<ArchiveFactory> mFileSystemArchiveFactory;
+        std::unique_ptr<ArchiveFactory> mMappedFileSystemArchiveFactory;
         std::unique_ptr<ArchiveFactory> mEmbeddedZipArchiveFactory;
         std::unique_ptr<ArchiveFactory> mZipArchiveFactory;
         std::unique_ptr<ArchiveManager> mArchiveManager;
@@ -48,6 +48,10 @@ Torus Knot Software Ltd.
 #include "OgreManualObject.h"
 #include "OgreRenderSystem.h"
 #include "OgreLodListener.h"
+#include "OgreWorkerThreadPool.h"
+#include "OgreNodeTransformStore.h"
+#include "OgreLightGrid.h"
+#include "OgreAtomicScalar.h"
 #include "OgreHeaderPrefix.h"
 #include "OgreNameGenerator.h"
 
@@ -102,6 +106,8 @@ namespace Ogre {
         */
         void mergeNonRenderedButInFrustum(const AxisAlignedBox& boxBounds, 
             const Sphere& sphereBounds, const Camera* cam);
+        /** Merge the bounds of objects gathered separately, e.g. on another thread. */
+        void merge(const VisibleObjectsBoundsInfo& rhs);
 
 
     };
@@ -175,6 +181,28 @@ namespace Ogre {
             IRS_RENDER_RECEIVER_PASS
         };
 
+        /** Stages of rendering a scene whose CPU time can be measured.
+        @see SceneManager::setStageTimingEnabled
+        */
+        enum FrameStage
+        {
+            /// Controllers and scene animations
+            FS_ANIMATION,
+            /// Skeletons evaluated ahead of culling, see setSkeletalAnimationStageEnabled
+            FS_SKELETAL_ANIMATION,
+            /// Scene graph update, including node tracking
+            FS_UPDATE_SCENE_GRAPH,
+            /// Search for visible objects, excluding FS_QUEUEING
+            FS_CULLING,
+            /// Visible objects adding themselves to the render queue
+            FS_QUEUEING,
+            /// Sorting of the render queue groups
+            FS_SORTING,
+            /// Update and binding of the GPU program parameters
+            FS_AUTO_PARAMS,
+            FS_COUNT
+        };
+
         /** Enumeration of the possible modes allowed for processing the special case
         render queue list.
         @see SceneManager::setSpecialCaseRenderQueueMode
@@ -569,6 +597,13 @@ namespace Ogre {
         LightInfoList mTestLightInfos; // potentially new list
         ulong mLightsDirtyCounter;
 
+        /// Spatial index over mLightsAffectingFrustum, null unless enabled
+        std::unique_ptr<LightGrid> mLightGrid;
+        /// Value of mLightsDirtyCounter when mLightGrid was last built
+        ulong mLightGridDirtyCounter;
+        /// Indices of the lights found by mLightGrid
+        std::vector<uint32> mLightGridResults;
+
         typedef std::map<String, MovableObject*> MovableObjectMap;
         /// Simple structure to hold MovableObject map and a mutex to go with it.
         struct MovableObjectCollection
@@ -922,11 +957,66 @@ namespace Ogre {
         typedef std::vector<InstanceManager*>      InstanceManagerVec;
         InstanceManagerVec mDirtyInstanceManagers;
         InstanceManagerVec mDirtyInstanceMgrsTmp;
+        /// Guards mDirtyInstanceManagers, which is filled while updating the scene graph
+        OGRE_WQ_MUTEX(mDirtyInstanceManagersMutex);
 
         /** Updates all instance managaers with dirty instance batches. @see _addDirtyInstanceManager */
         void updateDirtyInstanceManagers(void);
         
         void _destroySceneNode(SceneNodeList::iterator it);
+
+        /// Threads used to split per-frame work, null when running single threaded
+        std::unique_ptr<WorkerThreadPool> mWorkerThreadPool;
+
+        typedef std::vector<std::pair<Node*, bool> > NodeUpdateList;
+        /// Branches of the scene graph updated concurrently, with their parentHasChanged flag
+        NodeUpdateList mSubtreesToUpdate;
+        NodeUpdateList mSubtreesToUpdateTmp;
+        /// Nodes above mSubtreesToUpdate, updated on the calling thread
+        std::vector<Node*> mSplitNodes;
+        std::vector<Node*> mSplitChildrenTmp;
+
+        /** Whether the scene graph can be updated by several threads at once.
+        @remarks
+            This requires that updating a node only touches the node itself and its attached
+            objects. Scene managers whose nodes maintain a shared spatial structure while
+            updating (e.g. an octree) must override this to return false.
+        */
+        virtual bool isSceneGraphUpdateThreadSafe(void) const { return true; }
+
+        /** Updates the scene graph, splitting independent branches across mWorkerThreadPool. */
+        void updateSceneGraphParallel(void);
+
+        /// Packed copy of the scene node transforms, null unless enabled
+        std::unique_ptr<NodeTransformStore> mNodeTransformStore;
+
+        /// Branches of the scene graph culled concurrently
+        std::vector<SceneNode*> mCullingSubtrees;
+        std::vector<SceneNode*> mCullingSubtreesTmp;
+        /// Per thread render queues of the parallel culling, merged into mRenderQueue
+        std::vector<std::unique_ptr<RenderQueue> > mCullingRenderQueues;
+        /// Per thread bounds of the visible objects
+        std::vector<VisibleObjectsBoundsInfo> mCullingBounds;
+        /// Per thread objects which must be queued by the calling thread
+        std::vector<std::vector<MovableObject*> > mCullingDeferredObjects;
+
+        /** Finds the visible objects, splitting independent branches across mWorkerThreadPool. */
+        void findVisibleObjectsParallel(Camera* cam, VisibleObjectsBoundsInfo* visibleBounds,
+                                        bool onlyShadowCasters);
+
+        typedef std::vector<std::pair<Entity*, const Entity*> > SkeletonUpdateList;
+        /// Entities whose skeleton is evaluated by updateSkeletalAnimations
+        SkeletonUpdateList mSkeletonUpdates;
+        /// Entities taking over the skeleton pose of an entity in mSkeletonUpdates
+        SkeletonUpdateList mSkeletonCopies;
+        /// Animated entities with the hash of their animation state
+        std::vector<std::pair<uint32, Entity*> > mAnimatedEntitiesTmp;
+        std::vector<Entity*> mSharedSkeletonEntitiesTmp;
+        std::vector<Skeleton*> mAnimatedSkeletonsTmp;
+
+        /** Evaluates the skeletons of the visible animated entities, splitting them
+            across mWorkerThreadPool. */
+        void updateSkeletalAnimations(void);
     public:
         /// Method for preparing shadow textures ready for use in a regular render
         /// Do not call manually unless before frame start or rendering is paused
@@ -962,6 +1052,20 @@ namespace Ogre {
         /// Visibility mask used to show / hide objects
         uint32 mVisibilityMask;
         bool mFindVisibleObjects;
+        /// Whether _findVisibleObjects splits the work across mWorkerThreadPool
+        bool mParallelCulling;
+        /// Whether skeletons are evaluated by updateSkeletalAnimations
+        bool mSkeletalAnimationStage;
+        /// Vertex count from which software skinning is split across mWorkerThreadPool, 0 for never
+        size_t mParallelSkinningThreshold;
+        /// Skeletons evaluated since the last resetAnimationStats
+        AtomicScalar<size_t> mNumSkeletonsEvaluated;
+        /// Bones of the skeletons in mNumSkeletonsEvaluated
+        AtomicScalar<size_t> mNumBonesEvaluated;
+        /// Whether the time spent in each FrameStage is measured
+        bool mStageTimingEnabled;
+        /// Nanoseconds spent in each FrameStage since the last resetStageTimes
+        uint64 mStageTimes[FS_COUNT];
         /// Suppress render state changes?
         bool mSuppressRenderStateChanges;
         /// Suppress shadows?
@@ -1060,6 +1164,29 @@ namespace Ogre {
         void bindGpuProgram(GpuProgram* prog);
         void updateGpuProgramParameters(const Pass* p);
 
+        /// Whether per-object constants of passes shared by several renderables are batched
+        bool mPerObjectConstantBatching;
+        /// Ring buffer the per-object constants are packed into, see preparePerObjectConstantBlock
+        HardwareUniformBufferSharedPtr mPerObjectConstantBlock;
+        /// Where the next group of per-object constants is written in mPerObjectConstantBlock
+        size_t mPerObjectBlockWritePos;
+        /// Staging area for one group of per-object constants
+        std::vector<float> mPerObjectBlockStaging;
+        /// Renderables of the group being batched which passed validateRenderableForRendering
+        RenderableList mPerObjectBlockRenderables;
+        /// Whether the pass being rendered takes its per-object constants from the block
+        bool mPerObjectBlockActive;
+        /// Offset of the constants of the current renderable in mPerObjectConstantBlock
+        size_t mPerObjectBlockSlot;
+        /// Offset of the constants of each program type in a slot, if it has any
+        size_t mPerObjectBlockOffsets[GPT_COUNT];
+
+        /** Packs the per-object constants of all the renderables of a pass group into
+            mPerObjectConstantBlock, if the pass and the render system allow it.
+        @return The size in bytes of the constants of each renderable, 0 if not batched
+        */
+        size_t preparePerObjectConstantBlock(const Pass* pass, const RenderableList& rs);
+
 
 
 
@@ -1083,6 +1210,9 @@ namespace Ogre {
         typedef std::vector<EntityMaterialLodChangedEvent> EntityMaterialLodChangedEventList;
         EntityMaterialLodChangedEventList mEntityMaterialLodChangedEvents;
 
+        /// Guards the LOD changed event lists, which are filled while culling
+        OGRE_WQ_MUTEX(mLodChangedEventsMutex);
+
     public:
         /** Constructor.
         */
@@ -3252,6 +3382,183 @@ namespace Ogre {
         */
         bool getFindVisibleObjects(void) { return mFindVisibleObjects; }
 
+        /** Sets the number of threads used to process the scene each frame.
+        @remarks
+            With more than one thread, _updateSceneGraph splits the graph into
+            independent branches below the root and updates them concurrently. The
+            resulting transforms and bounds are identical to the single threaded
+            update. Note that Node::Listener and MovableObject::Listener callbacks
+            are then invoked from several threads at once.
+        @par
+            The calling thread counts as one of them, so 1 (the default) disables
+            threading and 0 picks one thread per hardware thread. Scene managers
+            maintaining their own spatial structures may keep updating serially.
+        */
+        void setNumWorkerThreads(size_t numThreads);
+
+        /** Gets the number of threads used to process the scene each frame. */
+        size_t getNumWorkerThreads(void) const
+        { return mWorkerThreadPool ? mWorkerThreadPool->getNumThreads() : 1; }
+
+        /** Runs the given task on all threads set through setNumWorkerThreads.
+        @remarks
+            Blocks until the task is done. This is useful to split custom per-frame
+            work, e.g. in a Listener, without spawning additional threads.
+        */
+        void executeUserScalableTask(UniformScalableTask* task);
+
+        /** Sets whether the derived transforms of the scene nodes are computed in packed form.
+        @remarks
+            When enabled, the local transforms of the nodes below the root node are
+            mirrored into a NodeTransformStore, which computes the derived transforms
+            level by level over contiguous arrays before the regular scene graph
+            traversal. This speeds up the update of large, mostly moving hierarchies,
+            but adds a rebuild of the packed layout on every frame in which nodes are
+            attached, detached or destroyed.
+        @par
+            Not available when OGRE was built with OGRE_NODE_INHERIT_TRANSFORM.
+        */
+        void setNodeTransformStoreEnabled(bool enabled);
+
+        /** Gets whether the derived transforms of the scene nodes are computed in packed form. */
+        bool isNodeTransformStoreEnabled(void) const { return mNodeTransformStore.get() != NULL; }
+
+        /** Sets whether the lights affecting an object are looked up in a spatial index.
+        @remarks
+            By default _populateLightList tests every light affecting the frustum
+            against every object. When enabled, a LightGrid is built over those lights
+            whenever they change, and only the lights found close to the object are
+            tested. This pays off for scenes with many local lights, the resulting
+            light lists are the same either way.
+        */
+        void setLightGridEnabled(bool enabled);
+
+        /** Gets whether the lights affecting an object are looked up in a spatial index. */
+        bool isLightGridEnabled(void) const { return mLightGrid.get() != NULL; }
+
+        /** Sets whether the visible objects are searched for by several threads.
+        @remarks
+            When enabled and more than one thread is set through setNumWorkerThreads,
+            _findVisibleObjects splits the scene graph into independent branches below
+            the root and culls them concurrently. Each thread queues the visible objects
+            it finds into a render queue of its own, which are merged into the main
+            render queue in a fixed order once all threads are done, so the result does
+            not depend on the timing of the threads.
+        @par
+            Only objects which can be queued concurrently with others (see
+            MovableObject::_canQueueConcurrently) are queued by the worker threads,
+            the others, e.g. animated entities, are queued by the calling thread after
+            the merge. Objects whose materials are not yet loaded, need compiling or
+            lack a technique for the active scheme are queued by the calling thread too.
+            LodListener, RenderQueue::RenderableListener and MaterialManager::Listener
+            callbacks are invoked from several threads at once.
+        @par
+            Scene managers implementing their own _findVisibleObjects ignore this option.
+        */
+        void setParallelCullingEnabled(bool enabled) { mParallelCulling = enabled; }
+
+        /** Gets whether the visible objects are searched for by several threads. */
+        bool isParallelCullingEnabled(void) const { return mParallelCulling; }
+
+        /** Sets whether skeletal animation is evaluated in a stage of its own.
+        @remarks
+            By default entities evaluate their skeleton lazily while being queued,
+            one after the other. When enabled, the skeletons of all visible entities
+            in the scene with skeletal animation are evaluated once per frame ahead
+            of the scene graph update, split across the threads set through
+            setNumWorkerThreads. Entities using the same skeleton with identical
+            enabled animation states (name, time, weight and blend mask, in the same
+            order) are evaluated once, the others copy the resulting pose.
+        @par
+            As this happens before culling, entities outside of the view are
+            evaluated as well. Entities with objects or tag points attached to
+            their bones are still updated while being queued. Entities with manual
+            bones or skipped animation state updates are evaluated, but never share
+            the result with others. Entities holding their pose this frame because of
+            their animation LOD (see Entity::setAnimationLodLevels) are skipped. No
+            animation may be modified while the stage runs.
+        */
+        void setSkeletalAnimationStageEnabled(bool enabled) { mSkeletalAnimationStage = enabled; }
+
+        /** Gets whether skeletal animation is evaluated in a stage of its own. */
+        bool isSkeletalAnimationStageEnabled(void) const { return mSkeletalAnimationStage; }
+
+        /** Sets the number of vertices from which software skinning is split across threads.
+        @remarks
+            Entities blending their vertices on the CPU (see Entity::hasSkeleton and
+            Mesh::softwareVertexBlend) split every vertex buffer holding at least this
+            many vertices into even ranges, which are blended concurrently by the
+            threads set through setNumWorkerThreads. The results are identical to the
+            single threaded blend. Small buffers are not worth the synchronisation.
+        @param numVertices The minimum number of vertices, 0 (the default) never splits
+        */
+        void setParallelSkinningThreshold(size_t numVertices) { mParallelSkinningThreshold = numVertices; }
+
+        /** Gets the number of vertices from which software skinning is split across threads. */
+        size_t getParallelSkinningThreshold(void) const { return mParallelSkinningThreshold; }
+
+        /** Gets the pool to split the software skinning of the given number of vertices across.
+        @return NULL if the vertices should be blended by the calling thread
+        */
+        WorkerThreadPool* _getParallelSkinningPool(size_t numVertices) const
+        {
+            return mParallelSkinningThreshold && numVertices >= mParallelSkinningThreshold ?
+                mWorkerThreadPool.get() : NULL;
+        }
+
+        /** Gets the number of skeletons evaluated since the last resetAnimationStats.
+        @remarks
+            Counts every evaluation of a skeleton instance by an entity of this
+            scene manager, e.g. to tune Entity::setAnimationLodLevels. Entities
+            taking over the pose of another one in the skeletal animation stage
+            (see setSkeletalAnimationStageEnabled) or holding their pose because
+            of their animation LOD are not counted.
+        */
+        size_t getNumSkeletonsEvaluated(void) const { return mNumSkeletonsEvaluated; }
+
+        /** Gets the number of bones of the skeletons evaluated since the last resetAnimationStats. */
+        size_t getNumBonesEvaluated(void) const { return mNumBonesEvaluated; }
+
+        /** Resets the numbers of skeletons and bones evaluated, e.g. once per frame. */
+        void resetAnimationStats(void)
+        {
+            mNumSkeletonsEvaluated = 0;
+            mNumBonesEvaluated = 0;
+        }
+
+        /// Notification from an entity that it evaluated its skeleton, may be called by any thread
+        void _notifySkeletonEvaluated(size_t numBones)
+        {
+            mNumSkeletonsEvaluated.fetch_add(1, std::memory_order_relaxed);
+            mNumBonesEvaluated.fetch_add(numBones, std::memory_order_relaxed);
+        }
+
+        /** Sets whether the CPU time spent in the stages of rendering is measured.
+        @remarks
+            When enabled, the wall clock time the rendering thread spends in each
+            FrameStage is accumulated over all cameras rendered by this scene manager,
+            until reset with resetStageTimes. Work handed to worker threads counts
+            towards the stage waiting for it, e.g. objects queued by the threads of
+            the parallel culling count as FS_CULLING. Entities whose animation is
+            updated lazily while being queued count as FS_QUEUEING, those handled by
+            the skeletal animation stage as FS_SKELETAL_ANIMATION.
+        @par
+            Measuring adds clock reads for every queued object and every parameter
+            update, so this is meant for profiling and benchmarks.
+        */
+        void setStageTimingEnabled(bool enabled);
+
+        /** Gets whether the CPU time spent in the stages of rendering is measured. */
+        bool isStageTimingEnabled(void) const { return mStageTimingEnabled; }
+
+        /** Gets the time spent in a stage of rendering, in nanoseconds.
+        @see setStageTimingEnabled
+        */
+        uint64 getStageTime(FrameStage stage) const { return mStageTimes[stage]; }
+
+        /** Resets the times of all stages of rendering to zero. */
+        void resetStageTimes(void);
+
         /** Set whether to automatically normalise normals on objects whenever they
             are scaled.
         @remarks
@@ -3282,6 +3589,36 @@ namespace Ogre {
         */
         bool getFlipCullingOnNegativeScale() const { return mFlipCullingOnNegativeScale; }
 
+        /** Set whether per-object constants are batched into a uniform buffer.
+        @remarks
+            If the render system supports it (see RenderSystem::_supportsPerObjectConstantBlocks),
+            the per-object auto constants of all the renderables grouped under one pass are
+            computed up front and uploaded at once into a ring buffered uniform buffer, so
+            that each draw only binds an offset into it instead of its own constants.
+            Passes iterating per light or whose per-object constants depend on the lights
+            are always rendered one object at a time. Disabled by default.
+        @note
+            Only the Null render system, which counts the binds without drawing anything,
+            supports constant blocks at the moment. With other render systems, including
+            GL3Plus, this option has no effect.
+        @note
+            The constants are computed before Renderable::preRender is called, so
+            renderables changing their transforms or custom parameters there must not
+            be rendered with this option enabled.
+        */
+        void setPerObjectConstantBatchingEnabled(bool enabled) { mPerObjectConstantBatching = enabled; }
+
+        /// Get whether per-object constants are batched into a uniform buffer
+        bool isPerObjectConstantBatchingEnabled() const { return mPerObjectConstantBatching; }
+
+        /** Set whether automatic GPU program constants whose inputs did not change are skipped.
+        @see AutoParamDataSource::setChangeTrackingEnabled
+        */
+        void setAutoParamChangeTrackingEnabled(bool enabled) { mAutoParamDataSource->setChangeTrackingEnabled(enabled); }
+
+        /// Get whether automatic GPU program constants whose inputs did not change are skipped
+        bool isAutoParamChangeTrackingEnabled() const { return mAutoParamDataSource->isChangeTrackingEnabled(); }
+
         /** Render something as if it came from the current queue.
             @param pass     Material pass to use for setting up this quad.
             @param rend     Renderable to render
@@ -183,6 +183,9 @@ namespace Ogre {
         */
         void _update(bool updateChildren, bool parentHasChanged);
 
+        /// @copydoc Node::_updateChildrenDone
+        void _updateChildrenDone(void);
+
         /** Tells the SceneNode to update the world bound info it stores.
         */
         virtual void _updateBounds(void);
@@ -204,10 +207,17 @@ namespace Ogre {
             @param
                 displayNodes If true, the nodes themselves are rendered as a set of 3 axes as well
                     as the objects being rendered. For debugging purposes.
+            @param
+                onlyShadowCasters If true, only objects casting shadows are queued
+            @param
+                deferredObjects If not NULL, visible objects which cannot be queued concurrently
+                    (see MovableObject::_canQueueConcurrently) are added to this list instead of
+                    the queue, for the caller to process later.
         */
         void _findVisibleObjects(Camera* cam, RenderQueue* queue,
             VisibleObjectsBoundsInfo* visibleBounds, 
-            bool includeChildren = true, bool displayNodes = false, bool onlyShadowCasters = false);
+            bool includeChildren = true, bool displayNodes = false, bool onlyShadowCasters = false,
+            std::vector<MovableObject*>* deferredObjects = NULL);
 
         /** Gets the axis-aligned bounding box of this node (and hence all subnodes).
         @remarks
@@ -273,6 +273,12 @@ namespace Ogre {
         */
         virtual void _refreshAnimationState(AnimationStateSet* animSet);
 
+        /** Prepare all animations, including those of linked skeletons, to be
+            applied from several threads at once.
+        @see Animation::_prepareForConcurrentApply
+        */
+        virtual void _prepareAnimationsForConcurrentApply(void);
+
         /** Populates the passed in array with the bone matrices based on the current position.
         @remarks
             Internal use only. The array pointed to by the passed in pointer must
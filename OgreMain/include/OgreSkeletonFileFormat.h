@@ -101,6 +101,25 @@ namespace Ogre {
                     // Quaternion rotate            : Rotation to apply at this keyframe
                     // Vector3 translate            : Translation to apply at this keyframe
                     // Vector3 scale                : Scale to apply at this keyframe
+
+            SKELETON_ANIMATION_COMPRESSED = 0x4200,
+            // [Optional, v1.11+] compressed node tracks, see CompressedNodeAnimation
+            // Follows the tracks (within SKELETON_ANIMATION)
+
+                // unsigned short numTracks
+                // unsigned int numKeys             : including the first key wrapped around
+                // bool hasTranslations
+                // bool hasScales
+                // unsigned short handles[numTracks]
+                // unsigned char useShortestRotationPath[numTracks]
+                // float times[numKeys]
+                // float translationBase[numGroups * 12] : numGroups = (numTracks + 3) / 4
+                // float translationStep[numGroups * 12]
+                // float scaleBase[numGroups * 12]
+                // float scaleStep[numGroups * 12]
+                // short rotations[numKeys * numGroups * 16]
+                // unsigned short translations[numKeys * numGroups * 12] : if hasTranslations
+                // unsigned short scales[numKeys * numGroups * 12] : if hasScales
         SKELETON_ANIMATION_LINK         = 0x5000
         // Link to another skeleton, to re-use its animations
 
@@ -110,6 +110,12 @@ namespace Ogre {
         /// @copydoc Skeleton::_refreshAnimationState
         void _refreshAnimationState(AnimationStateSet* animSet);
 
+        /// @copydoc Skeleton::_prepareAnimationsForConcurrentApply
+        void _prepareAnimationsForConcurrentApply(void);
+
+        /// Whether any tag points are currently attached to the bones of this instance
+        bool _hasActiveTagPoints(void) const { return !mActiveTagPoints.empty(); }
+
         /// @copydoc Resource::getName
         const String& getName(void) const;
         /// @copydoc Resource::getHandle
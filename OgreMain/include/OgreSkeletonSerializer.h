@@ -43,6 +43,8 @@ namespace Ogre {
         SKELETON_VERSION_1_0,
         /// OGRE version v1.8+
         SKELETON_VERSION_1_8,
+        /// OGRE version v1.11+, adds compressed node animation tracks
+        SKELETON_VERSION_1_11,
         
         /// Latest version available
         SKELETON_VERSION_LATEST = 100
@@ -115,6 +117,7 @@ namespace Ogre {
         void writeAnimation(const Skeleton* pSkel, const Animation* anim, SkeletonVersion ver);
         void writeAnimationTrack(const Skeleton* pSkel, const NodeAnimationTrack* track);
         void writeKeyFrame(const Skeleton* pSkel, const TransformKeyFrame* key);
+        void writeCompressedNodeAnimation(const CompressedNodeAnimation* tracks);
         void writeSkeletonAnimationLink(const Skeleton* pSkel, 
             const LinkedSkeletonAnimationSource& link);
 
@@ -125,6 +128,7 @@ namespace Ogre {
         void readAnimation(DataStreamPtr& stream, Skeleton* pSkel);
         void readAnimationTrack(DataStreamPtr& stream, Animation* anim, Skeleton* pSkel);
         void readKeyFrame(DataStreamPtr& stream, NodeAnimationTrack* track, Skeleton* pSkel);
+        void readCompressedNodeAnimation(DataStreamPtr& stream, Animation* anim);
         void readSkeletonAnimationLink(DataStreamPtr& stream, Skeleton* pSkel);
 
         size_t calcBoneSize(const Skeleton* pSkel, const Bone* pBone);
@@ -134,6 +138,7 @@ namespace Ogre {
         size_t calcAnimationTrackSize(const Skeleton* pSkel, const NodeAnimationTrack* pTrack);
         size_t calcKeyFrameSize(const Skeleton* pSkel, const TransformKeyFrame* pKey);
         size_t calcKeyFrameSizeWithoutScale(const Skeleton* pSkel, const TransformKeyFrame* pKey);
+        size_t calcCompressedNodeAnimationSize(const CompressedNodeAnimation* pTracks);
         size_t calcSkeletonAnimationLinkSize(const Skeleton* pSkel, 
             const LinkedSkeletonAnimationSource& link);
 
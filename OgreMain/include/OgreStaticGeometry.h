@@ -368,6 +368,8 @@ namespace Ogre {
             typedef MapIterator<MaterialBucketMap> MaterialIterator;
             /// Get an iterator over the materials in this LOD
             MaterialIterator getMaterialIterator(void);
+            /// Get the materials in this LOD
+            const MaterialBucketMap& getMaterialBucketMap(void) const { return mMaterialBucketMap; }
             /// Dump contents for diagnostics
             void dump(std::ofstream& of) const;
             void visitRenderables(Renderable::Visitor* visitor, bool debugRenderables);
@@ -450,6 +452,7 @@ namespace Ogre {
             const AxisAlignedBox& getBoundingBox(void) const;
             Real getBoundingRadius(void) const;
             void _updateRenderQueue(RenderQueue* queue);
+            bool _canQueueConcurrently(void) const;
             /// @copydoc MovableObject::visitRenderables
             void visitRenderables(Renderable::Visitor* visitor, 
                 bool debugRenderables = false);
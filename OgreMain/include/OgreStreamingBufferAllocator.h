@@ -0,0 +1,202 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __StreamingBufferAllocator_H__
+#define __StreamingBufferAllocator_H__
+
+#include "OgrePrerequisites.h"
+#include "OgreHardwareIndexBuffer.h"
+#include "OgreHardwareVertexBuffer.h"
+#include "OgreHeaderPrefix.h"
+
+namespace Ogre {
+    /** \addtogroup Core
+    *  @{
+    */
+    /** \addtogroup RenderSystem
+    *  @{
+    */
+
+    /** Hands out per frame space for dynamic vertex and index data.
+    @remarks
+        Geometry which is regenerated every frame (billboards, particles, ribbon
+        trails) traditionally locks its own HBU_DYNAMIC_WRITE_ONLY_DISCARDABLE
+        buffer with HBL_DISCARD, which costs a lock, an unlock and usually a
+        driver side buffer rename per object and frame. This class instead
+        sub-allocates a few large buffers, one ring per vertex size and index
+        type, and returns a pointer the caller writes the data to directly.
+    @par
+        The rings are fenced by frame: space handed out in a frame is not reused
+        until getFramesInFlight frames have ended, which is what a GPU lagging
+        behind the CPU by that many frames needs. If a ring runs out of space
+        before, it is replaced by one twice the size; the old buffer stays alive
+        as long as something is bound to it.
+    @par
+        Buffers which support HardwareBuffer::_getPersistentMapping are written
+        directly and flush only tells the buffer which ranges changed. Other
+        buffers are written through a system memory copy, which flush uploads
+        with a single writeData per ring.
+    @note
+        The allocations of the current frame must be flushed before they are
+        rendered; SceneManager does so after the scene was queued. The allocator
+        is not thread safe and must only be used from the thread rendering the frame.
+    */
+    class _OgreExport StreamingBufferAllocator : public BufferAlloc
+    {
+    public:
+        /// Creates the rings through the given manager
+        StreamingBufferAllocator(HardwareBufferManagerBase* mgr);
+        ~StreamingBufferAllocator();
+
+        /** Allocates space for vertices, valid until getFramesInFlight frames have ended.
+        @param vertexSize
+            The size of each vertex in bytes.
+        @param numVertices
+            The number of vertices to allocate.
+        @param buffer
+            Set to the buffer the vertices live in, to be bound to the VertexBufferBinding.
+        @param vertexStart
+            Set to the index of the first allocated vertex in that buffer, to be
+            used as VertexData::vertexStart.
+        @return
+            Where the vertices have to be written to.
+        */
+        void* allocateVertices(size_t vertexSize, size_t numVertices,
+                               HardwareVertexBufferSharedPtr& buffer, size_t& vertexStart);
+
+        /** Allocates space for indexes, valid until getFramesInFlight frames have ended.
+        @see allocateVertices
+        */
+        void* allocateIndexes(HardwareIndexBuffer::IndexType itype, size_t numIndexes,
+                              HardwareIndexBufferSharedPtr& buffer, size_t& indexStart);
+
+        /// Makes everything written to the allocations so far visible to the GPU
+        void flush(void);
+
+        /** Ends the current frame, the space allocated getFramesInFlight frames
+            ago can be reused from now on. Called by Root.
+        */
+        void _notifyFrameEnded(void);
+
+        /** Number of frames whose allocations must stay intact, including the
+            current one (default 3).
+        @remarks
+            Set this to 1 if the data is consumed right away, e.g. by a software
+            render system.
+        */
+        void setFramesInFlight(size_t frames);
+        size_t getFramesInFlight(void) const { return mFramesInFlight; }
+
+        /// Number of frames ended so far, see isAllocationValid
+        unsigned long getFrameNumber(void) const { return mFrameNumber; }
+
+        /** Whether space allocated during the given frame is still intact.
+        @remarks
+            Lets objects which do not regenerate their data every frame know
+            when they have to allocate and write it again.
+        */
+        bool isAllocationValid(unsigned long frame) const
+        {
+            return mFrameNumber - frame < mFramesInFlight;
+        }
+
+        /** Whether objects use this allocator for their per frame data (default false).
+        @remarks
+            Only affects buffers created afterwards.
+        @note
+            The rings are only recycled when Root fires the frame ended event, e.g. in
+            Root::renderOneFrame. Applications updating their render targets directly
+            must not enable this, or the rings grow without bound.
+        */
+        void setEnabled(bool enabled) { mEnabled = enabled; }
+        bool isEnabled(void) const { return mEnabled; }
+
+        /// Size in bytes of newly created rings (default 1MB), grown if an allocation is larger
+        void setInitialSize(size_t bytes) { mInitialSize = bytes; }
+        size_t getInitialSize(void) const { return mInitialSize; }
+
+        /// Number of buffers currently used as rings
+        size_t getBufferCount(void) const;
+
+        /// Releases all rings, called before the hardware buffer manager goes away
+        void _releaseBuffers(void);
+
+    private:
+        struct Ring
+        {
+            HardwareVertexBufferSharedPtr vertexBuffer;
+            HardwareIndexBufferSharedPtr indexBuffer;
+            /// vertexBuffer or indexBuffer
+            HardwareBuffer* buffer;
+            /// Persistent mapping of the buffer, or the start of staging
+            uchar* data;
+            std::vector<uchar> staging;
+            /// Vertex size, or index size of an index ring
+            size_t elementSize;
+            bool isIndexRing;
+            /// Number of elements in the buffer
+            size_t capacity;
+            /** Positions count elements and only ever increase, they are wrapped
+                into the buffer modulo the capacity. */
+            uint64 head;
+            /// Oldest position which may still be in use
+            uint64 tail;
+            /// First position not flushed yet
+            uint64 flushed;
+            /// First position of the current frame
+            uint64 frameStart;
+            /// First positions of the ended frames still in flight, oldest first
+            std::deque<uint64> frameStarts;
+
+            Ring()
+                : buffer(0), data(0), elementSize(0), isIndexRing(false), capacity(0),
+                  head(0), tail(0), flushed(0), frameStart(0) {}
+        };
+        typedef std::map<size_t, Ring> VertexRingMap;
+
+        /// Returns where the allocation starts in the ring's (possibly new) buffer, in elements
+        size_t allocate(Ring& ring, size_t count);
+        /// Replaces the buffer of the ring by one which can hold at least count elements
+        void grow(Ring& ring, size_t count);
+        void flush(Ring& ring);
+        void endFrame(Ring& ring);
+
+        HardwareBufferManagerBase* mMgr;
+        VertexRingMap mVertexRings;
+        Ring mIndexRings[2];
+        size_t mFramesInFlight;
+        unsigned long mFrameNumber;
+        size_t mInitialSize;
+        bool mEnabled;
+    };
+    /** @} */
+    /** @} */
+} // namespace Ogre
+
+#include "OgreHeaderSuffix.h"
+
+#endif // __StreamingBufferAllocator_H__
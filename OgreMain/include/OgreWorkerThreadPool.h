@@ -0,0 +1,127 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __WorkerThreadPool_H__
+#define __WorkerThreadPool_H__
+
+#include "OgrePrerequisites.h"
+#include "Threading/OgreThreadHeaders.h"
+#include "OgreHeaderPrefix.h"
+
+namespace Ogre
+{
+    /** \addtogroup Core
+    *  @{
+    */
+    /** \addtogroup General
+    *  @{
+    */
+    /** A task which is split uniformly across all the threads of a WorkerThreadPool.
+    @remarks
+        Every thread of the pool calls execute once with its own index, so the
+        implementation is expected to partition its work by threadIdx. All the
+        calls run concurrently, they must not throw.
+    */
+    class _OgreExport UniformScalableTask
+    {
+    public:
+        virtual ~UniformScalableTask() {}
+
+        /** Process the share of the work belonging to the given thread.
+        @param threadIdx Index of the calling thread, in the range [0; numThreads)
+        @param numThreads Total number of threads executing the task
+        */
+        virtual void execute(size_t threadIdx, size_t numThreads) = 0;
+    };
+
+    /** A fixed set of threads cooperating on UniformScalableTask instances.
+    @remarks
+        Unlike WorkQueue, which queues requests for background processing and
+        hands results back asynchronously, this is a fork / join primitive: the
+        calling thread takes part in the work and execute() only returns once
+        every thread is done. It is meant for splitting per-frame work, where
+        the overhead of queueing requests would outweigh the gain.
+    @par
+        Without thread support (OGRE_THREAD_SUPPORT=0) the pool always has
+        a single thread, and tasks are simply executed by the caller.
+    */
+    class _OgreExport WorkerThreadPool : public UtilityAlloc
+    {
+    public:
+        /** Constructor.
+        @param numThreads Number of threads working on each task, including
+            the thread calling execute(). 0 means one per hardware thread.
+        */
+        WorkerThreadPool(size_t numThreads);
+        ~WorkerThreadPool();
+
+        /// Number of threads working on each task, including the calling thread
+        size_t getNumThreads() const { return mNumThreads; }
+
+        /** Run the given task on all threads and wait for them to finish.
+        @remarks
+            The calling thread executes the task with index 0.
+            Must not be called concurrently from several threads.
+        */
+        void execute(UniformScalableTask* task);
+
+        /// Main function for each thread spawned.
+        void _threadMain(size_t threadIdx);
+    private:
+        struct WorkerFunc
+        {
+            WorkerThreadPool* mPool;
+            size_t mThreadIdx;
+
+            WorkerFunc(WorkerThreadPool* pool, size_t threadIdx) : mPool(pool), mThreadIdx(threadIdx) {}
+            void operator()() { mPool->_threadMain(mThreadIdx); }
+        };
+
+        size_t mNumThreads;
+        /// The task currently being executed
+        UniformScalableTask* mTask;
+        /// Incremented with every execute() call, so workers can tell new tasks apart
+        uint32 mTaskCounter;
+        /// Number of spawned threads still working on mTask
+        size_t mPendingThreads;
+        bool mShuttingDown;
+
+        OGRE_WQ_MUTEX(mMutex);
+        OGRE_WQ_THREAD_SYNCHRONISER(mTaskAvailableSync);
+        OGRE_WQ_THREAD_SYNCHRONISER(mTaskDoneSync);
+#if OGRE_THREAD_SUPPORT
+        typedef std::vector<OGRE_THREAD_TYPE*> WorkerThreadList;
+        WorkerThreadList mWorkers;
+#endif
+    };
+    /** @} */
+    /** @} */
+}
+
+#include "OgreHeaderSuffix.h"
+
+#endif
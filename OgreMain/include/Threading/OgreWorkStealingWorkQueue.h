@@ -0,0 +1,225 @@
+/*-------------------------------------------------------------------------
+This source file is a part of OGRE
+(Object-oriented Graphics Rendering Engine)
+
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE
+-------------------------------------------------------------------------*/
+#ifndef __OgreWorkStealingWorkQueue_H__
+#define __OgreWorkStealingWorkQueue_H__
+
+#include "../OgreWorkQueue.h"
+#include "../OgreAtomicScalar.h"
+
+namespace Ogre
+{
+    /** \addtogroup Core
+    *  @{
+    */
+    /** \addtogroup General
+    *  @{
+    */
+    /** Work queue for large numbers of small requests.
+    @remarks
+        DefaultWorkQueue passes every request through a single request queue,
+        a single in-process list and a single response queue, each behind its
+        own mutex, which the submitting thread, all the workers and the main
+        thread contend for. This implementation keeps the WorkQueue API and
+        abort semantics but removes the shared hot spots:
+        - every worker thread owns a deque of requests. Requests are spread
+          over the deques in turn, and a worker which runs out of requests
+          steals from the deques of the others, so submitters and workers only
+          ever contend for the lock of a single deque.
+        - workers hand responses to the main thread through a lock free stack,
+          which processResponses() drains in one go.
+        - request handlers are looked up in a snapshot of the handler list
+          which is only rebuilt when handlers are added or removed, and they
+          are called concurrently from all workers instead of one at a time.
+        - idle workers sleep, but submitting a request only touches the
+          wake up mutex when a worker actually is asleep.
+    @par
+        In addition, channels can be given a priority with setChannelPriority.
+        Workers always take pending requests of higher priority channels before
+        those of lower priority channels; requests of the same priority are
+        taken in submission order per deque.
+    @par
+        Unlike DefaultWorkQueue, this queue does not log every request at
+        LML_TRIVIAL level, as the log mutex would serialise the workers again.
+    */
+    class _OgreExport WorkStealingWorkQueue : public DefaultWorkQueueBase
+    {
+    public:
+        /// Number of distinct channel priorities
+        enum { NUM_PRIORITIES = 4 };
+
+        WorkStealingWorkQueue(const String& name = BLANKSTRING);
+        virtual ~WorkStealingWorkQueue();
+
+        /** Set the priority of the requests of a channel.
+        @param channel The channel
+        @param priority The priority, from 0 (default) to NUM_PRIORITIES - 1.
+            Pending requests of higher priority are processed first.
+        */
+        void setChannelPriority(uint16 channel, uint8 priority);
+
+        /// Get the priority of the requests of a channel
+        uint8 getChannelPriority(uint16 channel) const;
+
+        /// Main function for each thread spawned.
+        virtual void _threadMain();
+
+        /// @copydoc DefaultWorkQueueBase::_processNextRequest
+        virtual void _processNextRequest();
+
+        /// @copydoc WorkQueue::shutdown
+        virtual void shutdown();
+
+        /** @copydoc WorkQueue::startup
+        @note
+            Must not be called while other threads are adding requests.
+        */
+        virtual void startup(bool forceRestart = true);
+
+        /// @copydoc WorkQueue::addRequestHandler
+        virtual void addRequestHandler(uint16 channel, RequestHandler* rh);
+        /** @copydoc WorkQueue::removeRequestHandler
+        @note
+            Waits for the workers to finish the requests they are processing,
+            so must not be called from a request handler of this queue.
+        */
+        virtual void removeRequestHandler(uint16 channel, RequestHandler* rh);
+
+        /// @copydoc WorkQueue::addRequest
+        virtual RequestID addRequest(uint16 channel, uint16 requestType, const Any& rData, uint8 retryCount = 0,
+            bool forceSynchronous = false, bool idleThread = false);
+        /// @copydoc WorkQueue::abortRequest
+        virtual void abortRequest(RequestID id);
+        /// @copydoc WorkQueue::abortPendingRequest
+        virtual bool abortPendingRequest(RequestID id);
+        /// @copydoc WorkQueue::abortRequestsByChannel
+        virtual void abortRequestsByChannel(uint16 channel);
+        /// @copydoc WorkQueue::abortPendingRequestsByChannel
+        virtual void abortPendingRequestsByChannel(uint16 channel);
+        /// @copydoc WorkQueue::abortAllRequests
+        virtual void abortAllRequests();
+        /// @copydoc WorkQueue::processResponses
+        virtual void processResponses();
+
+    protected:
+        /** Requests queued on, or taken from, the deque of a worker.
+        @remarks
+            A request stays in the processing list of the deque it was taken
+            from until its response has been handed over, so aborts always
+            find it in one of the lists or in the responses.
+        */
+        struct RequestDeque : public UtilityAlloc
+        {
+            OGRE_WQ_MUTEX(mutex);
+            RequestQueue requests[NUM_PRIORITIES];
+            RequestQueue processing;
+        };
+        typedef std::vector<RequestDeque*> RequestDequeList;
+
+        /// Entry of the lock free response stack
+        struct ResponseNode : public UtilityAlloc
+        {
+            Response* response;
+            ResponseNode* next;
+        };
+
+        /// Which requests an abort applies to
+        struct RequestFilter
+        {
+            enum Type { ALL, ID, CHANNEL } type;
+            RequestID id;
+            uint16 channel;
+
+            bool matches(const Request* r) const;
+        };
+
+        typedef std::map<uint16, std::vector<RequestHandler*> > RequestHandlerSnapshot;
+        typedef std::map<uint16, uint8> ChannelPriorityMap;
+
+        virtual void notifyWorkers();
+
+        /// Suspend the calling worker until there are requests to process
+        void waitForWork();
+        /// Whether any worker could currently take a request
+        bool hasPendingWork() const;
+        /// Notify that a thread has registered itself with the render system
+        void notifyThreadRegistered();
+
+        /** Process the next request, looking at the deque of the given worker first.
+        @return false if there was no request to process
+        */
+        bool processNextRequest(size_t workerIdx);
+        /// Process the requests queued for the idle thread, one worker at a time
+        bool processIdleQueue();
+        /// Take the next request of highest priority, stealing from other workers if needed
+        Request* takeRequest(size_t workerIdx, RequestDeque*& owner);
+        /// Queue a request on the given deque, or the next one in turn if NULL
+        void queueRequest(Request* r, RequestDeque* deque);
+        /** Run a request through its handlers and hand over the response.
+        @param owner The deque the request was taken from, or NULL for idle and
+            synchronous requests
+        */
+        void executeRequest(Request* r, RequestDeque* owner, bool synchronous);
+        /// Call the request handlers of the channel of a request
+        Response* handleRequest(const Request* r);
+        /// Move the responses handed over by the workers to mResponseQueue, guarded by mResponseMutex
+        void collectResponses();
+        /// Mark the matching requests as aborted
+        bool abortRequests(const RequestFilter& filter, bool pendingOnly);
+        /// Recreate the request deques for the current thread count, keeping queued requests
+        void resizeDeques(size_t count);
+
+        RequestDequeList mDeques;
+        AtomicScalar<size_t> mNextDeque;
+        AtomicScalar<size_t> mNextWorker;
+        AtomicScalar<RequestID> mNextRequestID;
+        /// Number of queued requests per priority, to skip empty priorities without locking
+        AtomicScalar<size_t> mPendingRequests[NUM_PRIORITIES];
+        AtomicScalar<size_t> mPendingIdleRequests;
+        AtomicScalar<bool> mIdleRequestsRunning;
+        AtomicScalar<ResponseNode*> mResponseStack;
+
+        shared_ptr<const RequestHandlerSnapshot> mRequestHandlerSnapshot;
+
+        ChannelPriorityMap mChannelPriorities;
+        OGRE_WQ_MUTEX(mChannelPriorityMutex);
+
+        AtomicScalar<size_t> mSleepingWorkers;
+        OGRE_WQ_MUTEX(mWakeMutex);
+        OGRE_WQ_THREAD_SYNCHRONISER(mWakeSync);
+
+        size_t mNumThreadsRegisteredWithRS;
+        OGRE_WQ_MUTEX(mInitMutex);
+        OGRE_WQ_THREAD_SYNCHRONISER(mInitSync);
+#if OGRE_THREAD_SUPPORT
+        typedef std::vector<OGRE_THREAD_TYPE*> WorkerThreadList;
+        WorkerThreadList mWorkers;
+#endif
+    };
+    /** @} */
+    /** @} */
+}
+
+#endif
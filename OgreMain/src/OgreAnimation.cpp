@@ -30,6 +30,7 @@ THE SOFTWARE.
 #include "OgreKeyFrame.h"
 #include "OgreEntity.h"
 #include "OgreSubEntity.h"
+#include "OgreCompressedNodeAnimation.h"
 
 namespace Ogre {
 
@@ -42,17 +43,19 @@ namespace Ogre {
         , mLength(length)
         , mInterpolationMode(msDefaultInterpolationMode)
         , mRotationInterpolationMode(msDefaultRotationInterpolationMode)
-        , mKeyFrameTimesDirty(false)
+        , mNumKeyFrameCursors(0)
         , mUseBaseKeyFrame(false)
         , mBaseKeyFrameTime(0.0f)
         , mBaseKeyFrameAnimationName(BLANKSTRING)
         , mContainer(0)
+        , mCompressedNodeTracks(0)
     {
     }
     //---------------------------------------------------------------------
     Animation::~Animation()
     {
         destroyAllTracks();
+        destroyCompressedNodeTracks();
     }
     //---------------------------------------------------------------------
     Real Animation::getLength(void) const
@@ -124,7 +127,6 @@ namespace Ogre {
         {
             OGRE_DELETE i->second;
             mNodeTrackList.erase(i);
-            _keyFrameListChanged();
         }
     }
     //---------------------------------------------------------------------
@@ -136,7 +138,6 @@ namespace Ogre {
             OGRE_DELETE i->second;
         }
         mNodeTrackList.clear();
-        _keyFrameListChanged();
     }
     //---------------------------------------------------------------------
     NumericAnimationTrack* Animation::createNumericTrack(unsigned short handle)
@@ -199,7 +200,6 @@ namespace Ogre {
         {
             OGRE_DELETE i->second;
             mNumericTrackList.erase(i);
-            _keyFrameListChanged();
         }
     }
     //---------------------------------------------------------------------
@@ -211,7 +211,6 @@ namespace Ogre {
             OGRE_DELETE i->second;
         }
         mNumericTrackList.clear();
-        _keyFrameListChanged();
     }
     //---------------------------------------------------------------------
     VertexAnimationTrack* Animation::createVertexTrack(unsigned short handle, 
@@ -276,7 +275,6 @@ namespace Ogre {
         {
             OGRE_DELETE  i->second;
             mVertexTrackList.erase(i);
-            _keyFrameListChanged();
         }
     }
     //---------------------------------------------------------------------
@@ -288,7 +286,6 @@ namespace Ogre {
             OGRE_DELETE  i->second;
         }
         mVertexTrackList.clear();
-        _keyFrameListChanged();
     }
     //---------------------------------------------------------------------
     void Animation::destroyAllTracks(void)
@@ -303,12 +300,13 @@ namespace Ogre {
         return mName;
     }
     //---------------------------------------------------------------------
-    void Animation::apply(Real timePos, Real weight, Real scale)
+    void Animation::apply(Real timePos, Real weight, Real scale,
+        AnimationState::KeyFrameCursorList* cursors)
     {
         _applyBaseKeyFrame();
 
         // Calculate time index for fast keyframe search
-        TimeIndex timeIndex = _getTimeIndex(timePos);
+        TimeIndex timeIndex = _getTimeIndex(timePos, cursors);
 
         NodeTrackList::iterator i;
         for (i = mNodeTrackList.begin(); i != mNodeTrackList.end(); ++i)
@@ -343,12 +341,19 @@ namespace Ogre {
     }
     //---------------------------------------------------------------------
     void Animation::apply(Skeleton* skel, Real timePos, Real weight, 
-        Real scale)
+        Real scale, AnimationState::KeyFrameCursorList* cursors)
     {
+        if (mCompressedNodeTracks)
+        {
+            mCompressedNodeTracks->apply(skel, _wrapTimePos(timePos), weight, 0, scale,
+                                         mRotationInterpolationMode);
+            return;
+        }
+
         _applyBaseKeyFrame();
 
         // Calculate time index for fast keyframe search
-        TimeIndex timeIndex = _getTimeIndex(timePos);
+        TimeIndex timeIndex = _getTimeIndex(timePos, cursors);
 
         NodeTrackList::iterator i;
         for (i = mNodeTrackList.begin(); i != mNodeTrackList.end(); ++i)
@@ -362,8 +367,16 @@ namespace Ogre {
     }
     //---------------------------------------------------------------------
     void Animation::apply(Skeleton* skel, Real timePos, float weight,
-      const AnimationState::BoneBlendMask* blendMask, Real scale)
+      const AnimationState::BoneBlendMask* blendMask, Real scale,
+      AnimationState::KeyFrameCursorList* cursors)
     {
+        if (mCompressedNodeTracks)
+        {
+            mCompressedNodeTracks->apply(skel, _wrapTimePos(timePos), weight, blendMask, scale,
+                                         mRotationInterpolationMode);
+            return;
+        }
+
         _applyBaseKeyFrame();
 
         // Calculate time index for fast keyframe search
@@ -379,12 +392,12 @@ namespace Ogre {
     }
     //---------------------------------------------------------------------
     void Animation::apply(Entity* entity, Real timePos, Real weight, 
-        bool software, bool hardware)
+        bool software, bool hardware, AnimationState::KeyFrameCursorList* cursors)
     {
         _applyBaseKeyFrame();
 
         // Calculate time index for fast keyframe search
-        TimeIndex timeIndex = _getTimeIndex(timePos);
+        TimeIndex timeIndex = _getTimeIndex(timePos, cursors);
 
         VertexTrackList::iterator i;
         for (i = mVertexTrackList.begin(); i != mVertexTrackList.end(); ++i)
@@ -624,74 +637,58 @@ namespace Ogre {
             i->second->_clone(newAnim);
         }
 
-        newAnim->_keyFrameListChanged();
+        if (mCompressedNodeTracks)
+            newAnim->mCompressedNodeTracks = OGRE_NEW CompressedNodeAnimation(*mCompressedNodeTracks);
+
         return newAnim;
 
     }
     //-----------------------------------------------------------------------
-    TimeIndex Animation::_getTimeIndex(Real timePos) const
+    void Animation::compressNodeTracks(bool destroyNodeTracks)
     {
-        // Uncomment following statement for work as previous
-        //return timePos;
-
-        // Build keyframe time list on demand
-        if (mKeyFrameTimesDirty)
-        {
-            buildKeyFrameTimeList();
-        }
-
-        // Wrap time
-        Real totalAnimationLength = mLength;
-
-        if( timePos > totalAnimationLength && totalAnimationLength > 0.0f )
-            timePos = std::fmod( timePos, totalAnimationLength );
+        // Compress the keyframes as apply() would see them
+        _applyBaseKeyFrame();
 
-        // Search for global index
-        KeyFrameTimeList::iterator it =
-            std::lower_bound(mKeyFrameTimes.begin(), mKeyFrameTimes.end(), timePos);
+        _setCompressedNodeTracks(OGRE_NEW CompressedNodeAnimation(this));
 
-        return TimeIndex(timePos, static_cast<uint>(std::distance(mKeyFrameTimes.begin(), it)));
+        if (destroyNodeTracks)
+            destroyAllNodeTracks();
     }
     //-----------------------------------------------------------------------
-    void Animation::buildKeyFrameTimeList(void) const
+    void Animation::destroyCompressedNodeTracks(void)
     {
-        NodeTrackList::const_iterator i;
-        NumericTrackList::const_iterator j;
-        VertexTrackList::const_iterator k;
-
-        // Clear old keyframe times
-        mKeyFrameTimes.clear();
-
-        // Collect all keyframe times from each track
-        for (i = mNodeTrackList.begin(); i != mNodeTrackList.end(); ++i)
-        {
-            i->second->_collectKeyFrameTimes(mKeyFrameTimes);
-        }
-        for (j = mNumericTrackList.begin(); j != mNumericTrackList.end(); ++j)
-        {
-            j->second->_collectKeyFrameTimes(mKeyFrameTimes);
-        }
-        for (k = mVertexTrackList.begin(); k != mVertexTrackList.end(); ++k)
+        OGRE_DELETE mCompressedNodeTracks;
+        mCompressedNodeTracks = 0;
+    }
+    //-----------------------------------------------------------------------
+    void Animation::_setCompressedNodeTracks(CompressedNodeAnimation* tracks)
+    {
+        if (tracks != mCompressedNodeTracks)
         {
-            k->second->_collectKeyFrameTimes(mKeyFrameTimes);
+            destroyCompressedNodeTracks();
+            mCompressedNodeTracks = tracks;
         }
+    }
+    //-----------------------------------------------------------------------
+    Real Animation::_wrapTimePos(Real timePos) const
+    {
+        if (timePos > mLength && mLength > 0.0f)
+            timePos = std::fmod(timePos, mLength);
+        return timePos;
+    }
+    //-----------------------------------------------------------------------
+    TimeIndex Animation::_getTimeIndex(Real timePos, AnimationState::KeyFrameCursorList* cursors) const
+    {
+        timePos = _wrapTimePos(timePos);
 
-        // Build global index to local index map for each track
-        for (i = mNodeTrackList.begin(); i != mNodeTrackList.end(); ++i)
-        {
-            i->second->_buildKeyFrameIndexMap(mKeyFrameTimes);
-        }
-        for (j = mNumericTrackList.begin(); j != mNumericTrackList.end(); ++j)
-        {
-            j->second->_buildKeyFrameIndexMap(mKeyFrameTimes);
-        }
-        for (k = mVertexTrackList.begin(); k != mVertexTrackList.end(); ++k)
-        {
-            k->second->_buildKeyFrameIndexMap(mKeyFrameTimes);
-        }
+        if (!cursors || !mNumKeyFrameCursors)
+            return TimeIndex(timePos);
+
+        // Tracks may have been created since the cursors were last used
+        if (cursors->size() < mNumKeyFrameCursors)
+            cursors->resize(mNumKeyFrameCursors, 0);
 
-        // Reset dirty flag
-        mKeyFrameTimesDirty = false;
+        return TimeIndex(timePos, &(*cursors)[0]);
     }
     //-----------------------------------------------------------------------
     void Animation::setUseBaseKeyFrame(bool useBaseKeyFrame, Real keyframeTime, const String& baseAnimName)
@@ -773,6 +770,17 @@ namespace Ogre {
         
     }
     //-----------------------------------------------------------------------
+    void Animation::_prepareForConcurrentApply(void)
+    {
+        _applyBaseKeyFrame();
+
+        if (mInterpolationMode == IM_SPLINE)
+        {
+            for (NodeTrackList::iterator i = mNodeTrackList.begin(); i != mNodeTrackList.end(); ++i)
+                i->second->_buildInterpolationSplines();
+        }
+    }
+    //-----------------------------------------------------------------------
     void Animation::_notifyContainer(AnimationContainer* c)
     {
         mContainer = c;
@@ -41,11 +41,15 @@ namespace Ogre {
                 return kf->getTime() < kf2->getTime();
             }
         };
+
+        /// Keyframes a cursor steps over before searching the remaining ones
+        const int MAX_KEYFRAME_CURSOR_STEPS = 4;
     }
     //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     AnimationTrack::AnimationTrack(Animation* parent, unsigned short handle) :
-        mParent(parent), mHandle(handle), mListener(0)
+        mParent(parent), mHandle(handle), mListener(0),
+        mKeyFrameCursorIndex(parent->_createKeyFrameCursor())
     {
     }
     //---------------------------------------------------------------------
@@ -77,15 +81,41 @@ namespace Ogre {
 
         Real timePos = timeIndex.getTimePos();
 
+        // Wrap time
+        Real totalAnimationLength = mParent->getLength();
+        OgreAssertDbg(totalAnimationLength > 0.0f, "Invalid animation length!");
+
+        if( timePos > totalAnimationLength && totalAnimationLength > 0.0f )
+            timePos = std::fmod( timePos, totalAnimationLength );
+
         // Find first keyframe after or on current time
+        KeyFrame timeKey(0, timePos);
         KeyFrameList::const_iterator i;
-        if (timeIndex.hasKeyIndex())
+        if (timeIndex.hasKeyFrameCursors())
         {
-            // Global keyframe index available, map to local keyframe index directly.
-            assert(timeIndex.getKeyIndex() < mKeyFrameIndexMap.size());
-            i = mKeyFrames.begin() + mKeyFrameIndexMap[timeIndex.getKeyIndex()];
+            // Resume from the keyframe found last time, the cursor may be out of
+            // date if keyframes were added or removed since
+            ushort& cursor = timeIndex.getKeyFrameCursors()[mKeyFrameCursorIndex];
+            i = mKeyFrames.begin() + std::min<size_t>(cursor, mKeyFrames.size());
+            if (i != mKeyFrames.begin() && timePos <= (*(i - 1))->getTime())
+            {
+                // Moved backwards, by seeking or looping
+                i = std::lower_bound(mKeyFrames.begin(), i, &timeKey, KeyFrameTimeLess());
+            }
+            else
+            {
+                // Step over the keyframes passed since, unless that is more than a few
+                for (int steps = 0; i != mKeyFrames.end() && (*i)->getTime() < timePos; ++steps, ++i)
+                {
+                    if (steps == MAX_KEYFRAME_CURSOR_STEPS)
+                    {
+                        i = std::lower_bound(i, mKeyFrames.end(), &timeKey, KeyFrameTimeLess());
+                        break;
+                    }
+                }
+            }
+            cursor = static_cast<ushort>(std::distance(mKeyFrames.begin(), i));
 #if OGRE_DEBUG_MODE
-            KeyFrame timeKey(0, timePos);
             if (i != std::lower_bound(mKeyFrames.begin(), mKeyFrames.end(), &timeKey, KeyFrameTimeLess()))
             {
                 OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR,
@@ -96,15 +126,7 @@ namespace Ogre {
         }
         else
         {
-            // Wrap time
-            Real totalAnimationLength = mParent->getLength();
-            OgreAssertDbg(totalAnimationLength > 0.0f, "Invalid animation length!");
-
-            if( timePos > totalAnimationLength && totalAnimationLength > 0.0f )
-                timePos = std::fmod( timePos, totalAnimationLength );
-
-            // No global keyframe index, need to search with local keyframes.
-            KeyFrame timeKey(0, timePos);
+            // No cursor, need to search all keyframes.
             i = std::lower_bound(mKeyFrames.begin(), mKeyFrames.end(), &timeKey, KeyFrameTimeLess());
         }
 
@@ -160,7 +182,6 @@ namespace Ogre {
         mKeyFrames.insert(i, kf);
 
         _keyFrameDataChanged();
-        mParent->_keyFrameListChanged();
 
         return kf;
 
@@ -180,7 +201,6 @@ namespace Ogre {
         mKeyFrames.erase(i);
 
         _keyFrameDataChanged();
-        mParent->_keyFrameListChanged();
 
 
     }
@@ -195,41 +215,10 @@ namespace Ogre {
         }
 
         _keyFrameDataChanged();
-        mParent->_keyFrameListChanged();
 
         mKeyFrames.clear();
 
     }
-    //---------------------------------------------------------------------
-    void AnimationTrack::_collectKeyFrameTimes(std::vector<Real>& keyFrameTimes)
-    {
-        for (KeyFrameList::const_iterator i = mKeyFrames.begin(); i != mKeyFrames.end(); ++i)
-        {
-            Real timePos = (*i)->getTime();
-
-            std::vector<Real>::iterator it =
-                std::lower_bound(keyFrameTimes.begin(), keyFrameTimes.end(), timePos);
-            if (it == keyFrameTimes.end() || *it != timePos)
-            {
-                keyFrameTimes.insert(it, timePos);
-            }
-        }
-    }
-    //---------------------------------------------------------------------
-    void AnimationTrack::_buildKeyFrameIndexMap(const std::vector<Real>& keyFrameTimes)
-    {
-        // Pre-allocate memory
-        mKeyFrameIndexMap.resize(keyFrameTimes.size() + 1);
-
-        size_t i = 0, j = 0;
-        while (j <= keyFrameTimes.size())
-        {
-            mKeyFrameIndexMap[j] = static_cast<ushort>(i);
-            while (i < mKeyFrames.size() && mKeyFrames[i]->getTime() <= keyFrameTimes[j])
-                ++i;
-            ++j;
-        }
-    }
     //--------------------------------------------------------------------------
     void AnimationTrack::_applyBaseKeyFrame(const KeyFrame*)
     {}
@@ -32,12 +32,17 @@ THE SOFTWARE.
 #include "OgreRenderTarget.h"
 #include "OgreControllerManager.h"
 #include "OgreViewport.h"
+#include "OgreAtomicScalar.h"
 
 namespace Ogre {
+    /// Shared by all data sources, so ticks never repeat across them
+    static AtomicScalar<uint64> gChangeTick(0);
     //-----------------------------------------------------------------------------
     AutoParamDataSource::AutoParamDataSource()
         : mWorldMatrixCount(0),
          mWorldMatrixArray(0),
+         mDirLightExtrusionDistance(0),
+         mPointLightExtrusionDistance(0),
          mWorldMatrixDirty(true),
          mViewMatrixDirty(true),
          mProjMatrixDirty(true),
@@ -52,6 +57,9 @@ namespace Ogre {
          mCameraPositionDirty(true),
          mCameraPositionObjectSpaceDirty(true),
          mAmbientLight(ColourValue::Black),
+         mFogColour(ColourValue::Black),
+         mFogParams(Vector4::ZERO),
+         mPointParams(Vector4::ZERO),
          mPassNumber(0),
          mSceneDepthRangeDirty(true),
          mLodCameraPositionDirty(true),
@@ -64,7 +72,10 @@ namespace Ogre {
          mCurrentViewport(0), 
          mCurrentSceneManager(0),
          mMainCamBoundsInfo(0),
-         mCurrentPass(0)
+         mCurrentPass(0),
+         mIdentityView(false),
+         mIdentityProjection(false),
+         mChangeTrackingEnabled(true)
     {
         mBlankLight.setDiffuseColour(ColourValue::Black);
         mBlankLight.setSpecularColour(ColourValue::Black);
@@ -78,7 +89,17 @@ namespace Ogre {
             mCurrentTextureProjector[i] = 0;
             mShadowCamDepthRangesDirty[i] = false;
         }
-
+        markChanged(CS_ALL);
+    }
+    //-----------------------------------------------------------------------------
+    void AutoParamDataSource::markChanged(uint16 sources)
+    {
+        uint64 tick = ++gChangeTick;
+        for (int s = 0; sources; ++s, sources >>= 1)
+        {
+            if (sources & 1)
+                mChangeTicks[s] = tick;
+        }
     }
     //-----------------------------------------------------------------------------
 	const Camera* AutoParamDataSource::getCurrentCamera() const
@@ -121,6 +142,17 @@ namespace Ogre {
             mSpotlightWorldViewProjMatrixDirty[i] = true;
         }
 
+        // view and projection only change if the renderable overrides them
+        uint16 changed = CS_WORLD;
+        bool identityView = rend && rend->getUseIdentityView();
+        bool identityProjection = rend && rend->getUseIdentityProjection();
+        if (identityView != mIdentityView || identityProjection != mIdentityProjection)
+        {
+            mIdentityView = identityView;
+            mIdentityProjection = identityProjection;
+            changed |= CS_CAMERA;
+        }
+        markChanged(changed);
     }
     //-----------------------------------------------------------------------------
     void AutoParamDataSource::setCurrentCamera(const Camera* cam, bool useCameraRelative)
@@ -140,6 +172,8 @@ namespace Ogre {
         mCameraPositionDirty = true;
         mLodCameraPositionObjectSpaceDirty = true;
         mLodCameraPositionDirty = true;
+        // once per viewport and frame, also catches everything that moved in between
+        markChanged(CS_ALL);
     }
     //-----------------------------------------------------------------------------
     void AutoParamDataSource::setCurrentLightList(const LightList* ll)
@@ -150,7 +184,7 @@ namespace Ogre {
             mSpotlightViewProjMatrixDirty[i] = true;
             mSpotlightWorldViewProjMatrixDirty[i] = true;
         }
-
+        markChanged(CS_LIGHTS);
     }
     //---------------------------------------------------------------------
     float AutoParamDataSource::getLightNumber(size_t index) const
@@ -250,11 +284,16 @@ namespace Ogre {
     {
         mMainCamBoundsInfo = info;
         mSceneDepthRangeDirty = true;
+        markChanged(CS_SCENE);
     }
     //-----------------------------------------------------------------------------
     void AutoParamDataSource::setCurrentSceneManager(const SceneManager* sm)
     {
-        mCurrentSceneManager = sm;
+        if (sm != mCurrentSceneManager)
+        {
+            mCurrentSceneManager = sm;
+            markChanged(CS_SCENE | CS_TEXTURE_PROJECTORS);
+        }
     }
     //-----------------------------------------------------------------------------
     void AutoParamDataSource::setWorldMatrices(const Affine3* m, size_t count)
@@ -262,6 +301,7 @@ namespace Ogre {
         mWorldMatrixArray = m;
         mWorldMatrixCount = count;
         mWorldMatrixDirty = false;
+        markChanged(CS_WORLD);
     }
     //-----------------------------------------------------------------------------
     const Affine3& AutoParamDataSource::getWorldMatrix(void) const
@@ -505,7 +545,11 @@ namespace Ogre {
     //-----------------------------------------------------------------------------
     void AutoParamDataSource::setAmbientLightColour(const ColourValue& ambient)
     {
-        mAmbientLight = ambient;
+        if (ambient != mAmbientLight)
+        {
+            mAmbientLight = ambient;
+            markChanged(CS_SCENE);
+        }
     }
     //---------------------------------------------------------------------
     float AutoParamDataSource::getLightCount() const
@@ -526,7 +570,11 @@ namespace Ogre {
     //-----------------------------------------------------------------------------
     void AutoParamDataSource::setCurrentPass(const Pass* pass)
     {
-        mCurrentPass = pass;
+        if (pass != mCurrentPass)
+        {
+            mCurrentPass = pass;
+            markChanged(CS_PASS);
+        }
     }
     //-----------------------------------------------------------------------------
     const Pass* AutoParamDataSource::getCurrentPass(void) const
@@ -611,11 +659,14 @@ namespace Ogre {
         Real expDensity, Real linearStart, Real linearEnd)
     {
         (void)mode; // ignored
-        mFogColour = colour;
-        mFogParams.x = expDensity;
-        mFogParams.y = linearStart;
-        mFogParams.z = linearEnd;
-        mFogParams.w = linearEnd != linearStart ? 1 / (linearEnd - linearStart) : 0;
+        Vector4 params(expDensity, linearStart, linearEnd,
+                       linearEnd != linearStart ? 1 / (linearEnd - linearStart) : 0);
+        if (colour != mFogColour || params != mFogParams)
+        {
+            mFogColour = colour;
+            mFogParams = params;
+            markChanged(CS_SCENE);
+        }
     }
     //-----------------------------------------------------------------------------
     const ColourValue& AutoParamDataSource::getFogColour(void) const
@@ -631,12 +682,14 @@ namespace Ogre {
     void AutoParamDataSource::setPointParameters(Real size, bool attenuation, Real constant,
                                                  Real linear, Real quadratic)
     {
-        mPointParams.x = size;
+        Vector4 params(size, constant, linear, quadratic);
         if(attenuation)
-            mPointParams.x *= getViewportHeight();
-        mPointParams.y = constant;
-        mPointParams.z = linear;
-        mPointParams.w = quadratic;
+            params.x *= getViewportHeight();
+        if (params != mPointParams)
+        {
+            mPointParams = params;
+            markChanged(CS_SCENE);
+        }
     }
 
     const Vector4& AutoParamDataSource::getPointParams() const
@@ -648,6 +701,8 @@ namespace Ogre {
     {
         if (index < OGRE_MAX_SIMULTANEOUS_LIGHTS)
         {
+            if (frust != mCurrentTextureProjector[index])
+                markChanged(CS_TEXTURE_PROJECTORS);
             mCurrentTextureProjector[index] = frust;
             mTextureViewProjMatrixDirty[index] = true;
             mTextureWorldViewProjMatrixDirty[index] = true;
@@ -801,7 +856,12 @@ namespace Ogre {
     //-----------------------------------------------------------------------------
     void AutoParamDataSource::setCurrentRenderTarget(const RenderTarget* target)
     {
-        mCurrentRenderTarget = target;
+        if (target != mCurrentRenderTarget)
+        {
+            mCurrentRenderTarget = target;
+            // the projection matrix depends on texture flipping
+            markChanged(CS_TARGET | CS_CAMERA);
+        }
     }
     //-----------------------------------------------------------------------------
     const RenderTarget* AutoParamDataSource::getCurrentRenderTarget(void) const
@@ -811,17 +871,29 @@ namespace Ogre {
     //-----------------------------------------------------------------------------
     void AutoParamDataSource::setCurrentViewport(const Viewport* viewport)
     {
-        mCurrentViewport = viewport;
+        if (viewport != mCurrentViewport)
+        {
+            mCurrentViewport = viewport;
+            markChanged(CS_TARGET);
+        }
     }
     //-----------------------------------------------------------------------------
     void AutoParamDataSource::setShadowDirLightExtrusionDistance(Real dist)
     {
-        mDirLightExtrusionDistance = dist;
+        if (dist != mDirLightExtrusionDistance)
+        {
+            mDirLightExtrusionDistance = dist;
+            markChanged(CS_LIGHTS);
+        }
     }
     //-----------------------------------------------------------------------------
     void AutoParamDataSource::setShadowPointLightExtrusionDistance(Real dist)
     {
-        mPointLightExtrusionDistance = dist;
+        if (dist != mPointLightExtrusionDistance)
+        {
+            mPointLightExtrusionDistance = dist;
+            markChanged(CS_LIGHTS);
+        }
     }
     //-----------------------------------------------------------------------------
     Real AutoParamDataSource::getShadowExtrusionDistance(void) const
@@ -1051,12 +1123,17 @@ namespace Ogre {
     //-----------------------------------------------------------------------------
     void AutoParamDataSource::setPassNumber(const int passNumber)
     {
-        mPassNumber = passNumber;
+        if (passNumber != mPassNumber)
+        {
+            mPassNumber = passNumber;
+            markChanged(CS_PASS);
+        }
     }
     //-----------------------------------------------------------------------------
     void AutoParamDataSource::incPassNumber(void)
     {
         ++mPassNumber;
+        markChanged(CS_PASS);
     }
     //-----------------------------------------------------------------------------
     const Vector4& AutoParamDataSource::getSceneDepthRange() const
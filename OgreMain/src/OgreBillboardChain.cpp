@@ -32,6 +32,7 @@ THE SOFTWARE.
 #include "OgreStableHeaders.h"
 #include "OgreBillboardChain.h"
 #include "OgreViewport.h"
+#include "OgreStreamingBufferAllocator.h"
 
 #include <limits>
 
@@ -71,6 +72,8 @@ namespace Ogre {
         mRadius(0.0f),
         mTexCoordDir(TCD_U),
         mVertexCameraUsed(0),
+        mStreamingBuffers(false),
+        mVertexStreamFrame(0),
         mFaceCamera(true),
         mNormalBase(Vector3::UNIT_X)
     {
@@ -151,16 +154,30 @@ namespace Ogre {
         setupVertexDeclaration();
         if (mBuffersNeedRecreating)
         {
-            // Create the vertex buffer (always dynamic due to the camera adjust)
-            HardwareVertexBufferSharedPtr pBuffer =
-                HardwareBufferManager::getSingleton().createVertexBuffer(
-                mVertexData->vertexDeclaration->getVertexSize(0),
-                mVertexData->vertexCount,
-                HardwareBuffer::HBU_DYNAMIC_WRITE_ONLY_DISCARDABLE);
-
-            // (re)Bind the buffer
-            // Any existing buffer will lose its reference count and be destroyed
-            mVertexData->vertexBufferBinding->setBinding(0, pBuffer);
+            // Dynamic chains are usually rebuilt every frame, so they can use the
+            // shared streaming buffers, which are bound in updateVertexBuffer
+            StreamingBufferAllocator* streaming = HardwareBufferManager::getSingleton()._getStreamingBuffersPtr();
+            mStreamingBuffers = mDynamic && streaming && streaming->isEnabled();
+            if (mStreamingBuffers)
+            {
+                mVertexData->vertexBufferBinding->unsetAllBindings();
+            }
+            else
+            {
+                // Create the vertex buffer (always dynamic due to the camera adjust)
+                HardwareVertexBufferSharedPtr pBuffer =
+                    HardwareBufferManager::getSingleton().createVertexBuffer(
+                    mVertexData->vertexDeclaration->getVertexSize(0),
+                    mVertexData->vertexCount,
+                    HardwareBuffer::HBU_DYNAMIC_WRITE_ONLY_DISCARDABLE);
+
+                // (re)Bind the buffer
+                // Any existing buffer will lose its reference count and be destroyed
+                mVertexData->vertexBufferBinding->setBinding(0, pBuffer);
+                mVertexData->vertexStart = 0;
+            }
+            // the new buffer has no content yet
+            mVertexContentDirty = true;
 
             mIndexData->indexBuffer =
                 HardwareBufferManager::getSingleton().createIndexBuffer(
@@ -485,15 +502,32 @@ namespace Ogre {
     {
         setupBuffers();
         
+        StreamingBufferAllocator* streaming = mStreamingBuffers ?
+            &HardwareBufferManager::getSingleton().getStreamingBuffers() : 0;
+
         // The contents of the vertex buffer are correct if they are not dirty
         // and the camera used to build the vertex buffer is still the current 
-        // camera.
-        if (!mVertexContentDirty && mVertexCameraUsed == cam)
+        // camera. Streamed vertices also have to be recent enough not to be
+        // overwritten yet.
+        if (!mVertexContentDirty && mVertexCameraUsed == cam &&
+            (!streaming || streaming->isAllocationValid(mVertexStreamFrame)))
             return;
 
-        HardwareVertexBufferSharedPtr pBuffer =
-            mVertexData->vertexBufferBinding->getBuffer(0);
-        void* pBufferStart = pBuffer->lock(HardwareBuffer::HBL_DISCARD);
+        HardwareVertexBufferSharedPtr pBuffer;
+        void* pBufferStart;
+        if (streaming)
+        {
+            pBufferStart = streaming->allocateVertices(
+                mVertexData->vertexDeclaration->getVertexSize(0), mVertexData->vertexCount,
+                pBuffer, mVertexData->vertexStart);
+            mVertexData->vertexBufferBinding->setBinding(0, pBuffer);
+            mVertexStreamFrame = streaming->getFrameNumber();
+        }
+        else
+        {
+            pBuffer = mVertexData->vertexBufferBinding->getBuffer(0);
+            pBufferStart = pBuffer->lock(HardwareBuffer::HBL_DISCARD);
+        }
 
         const Vector3& camPos = cam->getDerivedPosition();
         Vector3 eyePos = mParentNode->convertWorldToLocalPosition(camPos);
@@ -633,7 +667,11 @@ namespace Ogre {
 
 
 
-        pBuffer->unlock();
+        // This runs while rendering, after the SceneManager flushed the streaming buffers
+        if (streaming)
+            streaming->flush();
+        else
+            pBuffer->unlock();
         mVertexCameraUsed = cam;
         mVertexContentDirty = false;
 
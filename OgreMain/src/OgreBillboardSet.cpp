@@ -29,13 +29,11 @@ THE SOFTWARE.
 
 #include "OgreBillboardSet.h"
 #include "OgreBillboard.h"
+#include "OgreStreamingBufferAllocator.h"
 
 #include <algorithm>
 
 namespace Ogre {
-    // Init statics
-    RadixSort<BillboardSet::ActiveBillboardList, Billboard*, float> BillboardSet::mRadixSorter;
-
     //-----------------------------------------------------------------------
     BillboardSet::BillboardSet() :
         mBoundingRadius(0.0f), 
@@ -56,7 +54,8 @@ namespace Ogre {
         mPoolSize(0),
         mExternalData(false),
         mAutoUpdate(true),
-        mBillboardDataChanged(true)
+        mBillboardDataChanged(true),
+        mStreamingBuffers(false)
     {
         setDefaultDimensions( 100, 100 );
         mMaterial = MaterialManager::getSingleton().getDefaultMaterial();
@@ -89,7 +88,8 @@ namespace Ogre {
         mPoolSize(poolSize),
         mExternalData(externalData),
         mAutoUpdate(true),
-        mBillboardDataChanged(true)
+        mBillboardDataChanged(true),
+        mStreamingBuffers(false)
     {
         setDefaultDimensions( 100, 100 );
         mMaterial = MaterialManager::getSingleton().getDefaultMaterial();
@@ -311,13 +311,17 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void BillboardSet::_sortBillboards( Camera* cam)
     {
+        // One sorter per thread, so that sets can be sorted concurrently without
+        // each of them holding the counters and scratch buffers of its own
+        static thread_local RadixSort<ActiveBillboardList, Billboard*, float> radixSorter;
+
         switch (_getSortMode())
         {
         case SM_DIRECTION:
-            mRadixSorter.sort(mActiveBillboards, SortByDirectionFunctor(-mCamDir));
+            radixSorter.sort(mActiveBillboards, SortByDirectionFunctor(-mCamDir));
             break;
         case SM_DISTANCE:
-            mRadixSorter.sort(mActiveBillboards, SortByDistanceFunctor(mCamPos));
+            radixSorter.sort(mActiveBillboards, SortByDistanceFunctor(mCamPos));
             break;
         }
     }
@@ -429,8 +433,21 @@ namespace Ogre {
         // Init num visible
         mNumVisibleBillboards = 0;
 
+        if (mStreamingBuffers)
+        {
+            // Write straight to this frame's space in the streaming buffers, no lock needed
+            numBillboards = numBillboards ? std::min(mPoolSize, numBillboards) : mPoolSize;
+            size_t numVertices = mPointRendering ? numBillboards : numBillboards * 4;
+
+            HardwareVertexBufferSharedPtr buf;
+            mLockPtr = static_cast<float*>(
+                HardwareBufferManager::getSingleton().getStreamingBuffers().allocateVertices(
+                    mVertexData->vertexDeclaration->getVertexSize(0), numVertices, buf,
+                    mVertexData->vertexStart));
+            mVertexData->vertexBufferBinding->setBinding(0, buf);
+        }
         // Lock the buffer
-        if (numBillboards) // optimal lock
+        else if (numBillboards) // optimal lock
         {
             // clamp to max
             numBillboards = std::min(mPoolSize, numBillboards);
@@ -521,7 +538,9 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void BillboardSet::endBillboards(void)
     {
-        mMainBuf->unlock();
+        // streamed vertices are flushed by the SceneManager once everything is queued
+        if (!mStreamingBuffers)
+            mMainBuf->unlock();
     }
     //-----------------------------------------------------------------------
     void BillboardSet::setBounds(const AxisAlignedBox& box, Real radius)
@@ -648,8 +667,8 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void BillboardSet::getRenderOperation(RenderOperation& op)
     {
+        // vertexStart is 0, or where the streamed vertices of this frame start
         op.vertexData = mVertexData.get();
-        op.vertexData->vertexStart = 0;
 
         if (mPointRendering)
         {
@@ -783,14 +802,21 @@ namespace Ogre {
             decl->addElement(0, offset, VET_FLOAT2, VES_TEXTURE_COORDINATES, 0);
         }
 
-        mMainBuf =
-            HardwareBufferManager::getSingleton().createVertexBuffer(
-                decl->getVertexSize(0),
-                mVertexData->vertexCount,
-                mAutoUpdate ? HardwareBuffer::HBU_DYNAMIC_WRITE_ONLY_DISCARDABLE : 
-                HardwareBuffer::HBU_STATIC_WRITE_ONLY);
-        // bind position and diffuses
-        binding->setBinding(0, mMainBuf);
+        // Vertices updated every frame can use the shared streaming buffers,
+        // which are bound in beginBillboards
+        StreamingBufferAllocator* streaming = HardwareBufferManager::getSingleton()._getStreamingBuffersPtr();
+        mStreamingBuffers = mAutoUpdate && streaming && streaming->isEnabled();
+        if (!mStreamingBuffers)
+        {
+            mMainBuf =
+                HardwareBufferManager::getSingleton().createVertexBuffer(
+                    decl->getVertexSize(0),
+                    mVertexData->vertexCount,
+                    mAutoUpdate ? HardwareBuffer::HBU_DYNAMIC_WRITE_ONLY_DISCARDABLE :
+                    HardwareBuffer::HBU_STATIC_WRITE_ONLY);
+            // bind position and diffuses
+            binding->setBinding(0, mMainBuf);
+        }
 
         if (!mPointRendering)
         {
@@ -850,6 +876,7 @@ namespace Ogre {
         mMainBuf.reset();
 
         mBuffersCreated = false;
+        mStreamingBuffers = false;
     }
     //-----------------------------------------------------------------------
     unsigned int BillboardSet::getPoolSize(void) const
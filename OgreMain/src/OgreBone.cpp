@@ -79,6 +79,14 @@ namespace Ogre {
         resetToInitialState();
     }
     //---------------------------------------------------------------------
+    void Bone::_copyLocalTransform(const Bone* bone)
+    {
+        mPosition = bone->mPosition;
+        mOrientation = bone->mOrientation;
+        mScale = bone->mScale;
+        needUpdate();
+    }
+    //---------------------------------------------------------------------
     void Bone::setManuallyControlled(bool manuallyControlled) 
     {
         mManuallyControlled = manuallyControlled;
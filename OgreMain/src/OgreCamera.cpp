@@ -872,6 +872,19 @@ namespace Ogre {
         }
     }
     //-----------------------------------------------------------------------
+    void Camera::calculateVisibility(const float* centres, const float* halfSizes,
+                                     uint32* visibility, size_t numBoxes) const
+    {
+        if (mCullFrustum)
+        {
+            mCullFrustum->calculateVisibility(centres, halfSizes, visibility, numBoxes);
+        }
+        else
+        {
+            Frustum::calculateVisibility(centres, halfSizes, visibility, numBoxes);
+        }
+    }
+    //-----------------------------------------------------------------------
     bool Camera::isVisible(const Sphere& bound, FrustumPlane* culledBy) const
     {
         if (mCullFrustum)
@@ -0,0 +1,420 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgreCompressedNodeAnimation.h"
+#include "OgreKeyFrame.h"
+#include "OgreSkeleton.h"
+#include "OgreBone.h"
+#include "OgrePlatformInformation.h"
+
+#if __OGRE_HAVE_SSE
+// Keep this include last to avoid potential "xmmintrin.h" included by other
+// headers being incompatible with the ones included here
+#include "OgreSIMDHelper.h"
+#include <emmintrin.h>
+#endif
+
+namespace Ogre
+{
+    namespace
+    {
+        const float ROTATION_QUANTISATION = 32767.0f;
+        const float RANGE_QUANTISATION = 65535.0f;
+
+        int16 quantiseSigned(Real value)
+        {
+            Real q = std::floor(Math::Clamp<Real>(value, -1, 1) * ROTATION_QUANTISATION + Real(0.5));
+            return static_cast<int16>(Math::Clamp<Real>(q, -ROTATION_QUANTISATION, ROTATION_QUANTISATION));
+        }
+
+        uint16 quantiseRange(Real value, float base, float step)
+        {
+            if (step <= 0)
+                return 0;
+            Real q = std::floor((value - base) / step + Real(0.5));
+            return static_cast<uint16>(Math::Clamp<Real>(q, 0, RANGE_QUANTISATION));
+        }
+
+#if __OGRE_HAVE_SSE
+        bool hasSSE2(void)
+        {
+            static const bool sse2 =
+                (PlatformInformation::getCpuFeatures() & PlatformInformation::CPU_FEATURE_SSE2) != 0;
+            return sse2;
+        }
+#endif
+    }
+    //-----------------------------------------------------------------------
+    CompressedNodeAnimation::CompressedNodeAnimation()
+    {
+    }
+    //-----------------------------------------------------------------------
+    CompressedNodeAnimation::CompressedNodeAnimation(const Animation* animation)
+    {
+        // Tracks which affect their node, and the union of their keyframe times
+        std::vector<const NodeAnimationTrack*> tracks;
+        Animation::NodeTrackIterator it = animation->getNodeTrackIterator();
+        while (it.hasMoreElements())
+        {
+            const NodeAnimationTrack* track = it.getNext();
+            if (!track->getNumKeyFrames())
+                continue;
+
+            tracks.push_back(track);
+            for (unsigned short k = 0; k < track->getNumKeyFrames(); ++k)
+                mTimes.push_back(track->getKeyFrame(k)->getTime());
+        }
+        if (tracks.empty())
+            return;
+
+        std::sort(mTimes.begin(), mTimes.end());
+        mTimes.erase(std::unique(mTimes.begin(), mTimes.end()), mTimes.end());
+        const size_t numKeys = mTimes.size();
+        mTimes.push_back(animation->getLength() + mTimes.front());
+
+        const size_t numTracks = tracks.size();
+        const size_t numGroups = (numTracks + 3) / 4;
+
+        // Sample every track at every key time, as the tracks themselves would
+        std::vector<Quaternion> rotations((numKeys + 1) * numTracks);
+        std::vector<Vector3> translations((numKeys + 1) * numTracks);
+        std::vector<Vector3> scales((numKeys + 1) * numTracks);
+        TransformKeyFrame kf(0, 0);
+        for (size_t j = 0; j < numTracks; ++j)
+        {
+            const NodeAnimationTrack* track = tracks[j];
+            mHandles.push_back(track->getHandle());
+            mUseShortestRotationPath.push_back(track->getUseShortestRotationPath());
+
+            for (size_t k = 0; k <= numKeys; ++k)
+            {
+                size_t idx = k * numTracks + j;
+                if (k < numKeys)
+                {
+                    track->getInterpolatedKeyFrame(TimeIndex(mTimes[k]), &kf);
+                    rotations[idx] = kf.getRotation();
+                    rotations[idx].normalise();
+                    translations[idx] = kf.getTranslate();
+                    scales[idx] = kf.getScale();
+                }
+                else
+                {
+                    // wrap around towards the first key
+                    rotations[idx] = rotations[j];
+                    translations[idx] = translations[j];
+                    scales[idx] = scales[j];
+                }
+
+                // Keep successive rotations in the same hemisphere, so that interpolating
+                // them componentwise takes the shortest path like the track would
+                if (k > 0 && track->getUseShortestRotationPath() &&
+                    rotations[idx].Dot(rotations[idx - numTracks]) < 0)
+                {
+                    rotations[idx] = -rotations[idx];
+                }
+            }
+        }
+
+        // Quantise the translations and scales to the range of each track
+        mTranslationBase.assign(numGroups * 12, 0);
+        mTranslationStep.assign(numGroups * 12, 0);
+        mScaleBase.assign(numGroups * 12, 0);
+        mScaleStep.assign(numGroups * 12, 0);
+        bool animatedTranslations = false;
+        bool animatedScales = false;
+        for (size_t j = 0; j < numTracks; ++j)
+        {
+            for (size_t c = 0; c < 3; ++c)
+            {
+                float minTranslation = translations[j][c], maxTranslation = minTranslation;
+                float minScale = scales[j][c], maxScale = minScale;
+                for (size_t k = 1; k <= numKeys; ++k)
+                {
+                    float translation = translations[k * numTracks + j][c];
+                    float scale = scales[k * numTracks + j][c];
+                    minTranslation = std::min(minTranslation, translation);
+                    maxTranslation = std::max(maxTranslation, translation);
+                    minScale = std::min(minScale, scale);
+                    maxScale = std::max(maxScale, scale);
+                }
+
+                size_t idx = (j / 4) * 12 + c * 4 + j % 4;
+                mTranslationBase[idx] = minTranslation;
+                mTranslationStep[idx] = (maxTranslation - minTranslation) / RANGE_QUANTISATION;
+                mScaleBase[idx] = minScale;
+                mScaleStep[idx] = (maxScale - minScale) / RANGE_QUANTISATION;
+                animatedTranslations |= maxTranslation > minTranslation;
+                animatedScales |= maxScale > minScale;
+            }
+        }
+
+        // Padding tracks get identity rotations, so that normalising them is safe
+        mRotations.assign((numKeys + 1) * numGroups * 16, 0);
+        for (size_t k = 0; k <= numKeys; ++k)
+        {
+            for (size_t j = numTracks; j < numGroups * 4; ++j)
+                mRotations[((k * numGroups + j / 4) * 4 + ROTATION_W) * 4 + j % 4] = int16(ROTATION_QUANTISATION);
+        }
+        if (animatedTranslations)
+            mTranslations.assign((numKeys + 1) * numGroups * 12, 0);
+        if (animatedScales)
+            mScales.assign((numKeys + 1) * numGroups * 12, 0);
+
+        for (size_t k = 0; k <= numKeys; ++k)
+        {
+            for (size_t j = 0; j < numTracks; ++j)
+            {
+                size_t group = k * numGroups + j / 4;
+                size_t lane = j % 4;
+                const Quaternion& rotation = rotations[k * numTracks + j];
+                for (size_t c = 0; c < 4; ++c)
+                    mRotations[(group * 4 + c) * 4 + lane] = quantiseSigned(rotation[c]);
+
+                for (size_t c = 0; c < 3; ++c)
+                {
+                    size_t range = (j / 4) * 12 + c * 4 + lane;
+                    if (animatedTranslations)
+                    {
+                        mTranslations[group * 12 + c * 4 + lane] = quantiseRange(
+                            translations[k * numTracks + j][c], mTranslationBase[range], mTranslationStep[range]);
+                    }
+                    if (animatedScales)
+                    {
+                        mScales[group * 12 + c * 4 + lane] = quantiseRange(
+                            scales[k * numTracks + j][c], mScaleBase[range], mScaleStep[range]);
+                    }
+                }
+            }
+        }
+    }
+    //-----------------------------------------------------------------------
+    void CompressedNodeAnimation::findKey(Real timePos, size_t& key, float& t) const
+    {
+        // Before the first key hold it, like AnimationTrack::getKeyFramesAtTime
+        key = 0;
+        t = 0;
+        if (timePos <= mTimes.front())
+            return;
+
+        // The wrap around key only ever follows the last one
+        std::vector<float>::const_iterator i =
+            std::upper_bound(mTimes.begin(), mTimes.end() - 1, float(timePos));
+        key = std::distance(mTimes.begin(), i) - 1;
+
+        float t1 = mTimes[key];
+        float t2 = mTimes[key + 1];
+        if (t2 > t1)
+            t = std::min((float(timePos) - t1) / (t2 - t1), 1.0f);
+    }
+    //-----------------------------------------------------------------------
+    void CompressedNodeAnimation::sampleGroup(size_t group, size_t key, float t,
+                                              float out[NUM_COMPONENTS][4]) const
+    {
+        const size_t numGroups = getNumGroups();
+        const int16* rotation1 = &mRotations[(key * numGroups + group) * 16];
+        const int16* rotation2 = rotation1 + numGroups * 16;
+        const float* translationBase = &mTranslationBase[group * 12];
+        const float* translationStep = &mTranslationStep[group * 12];
+        const float* scaleBase = &mScaleBase[group * 12];
+        const float* scaleStep = &mScaleStep[group * 12];
+        const uint16* translation1 = mTranslations.empty() ? NULL : &mTranslations[(key * numGroups + group) * 12];
+        const uint16* scale1 = mScales.empty() ? NULL : &mScales[(key * numGroups + group) * 12];
+
+#if __OGRE_HAVE_SSE
+        if (hasSSE2())
+        {
+            const __m128 vt = _mm_set1_ps(t);
+            const __m128i zero = _mm_setzero_si128();
+
+            __m128 rotation[4];
+            for (size_t c = 0; c < 4; ++c)
+            {
+                __m128i q1 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(rotation1 + c * 4));
+                __m128i q2 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(rotation2 + c * 4));
+                // sign extend to 32 bit
+                __m128 r1 = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(q1, q1), 16));
+                __m128 r2 = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(q2, q2), 16));
+                rotation[c] = _mm_add_ps(r1, _mm_mul_ps(_mm_sub_ps(r2, r1), vt));
+            }
+            // normalising also undoes the quantisation scale
+            __m128 length = _mm_sqrt_ps(_mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(rotation[0], rotation[0]), _mm_mul_ps(rotation[1], rotation[1])),
+                _mm_add_ps(_mm_mul_ps(rotation[2], rotation[2]), _mm_mul_ps(rotation[3], rotation[3]))));
+            __m128 invLength = _mm_div_ps(_mm_set1_ps(1.0f), length);
+            for (size_t c = 0; c < 4; ++c)
+                _mm_storeu_ps(out[ROTATION_W + c], _mm_mul_ps(rotation[c], invLength));
+
+            const uint16* ranges[2] = {translation1, scale1};
+            const float* bases[2] = {translationBase, scaleBase};
+            const float* steps[2] = {translationStep, scaleStep};
+            const size_t outputs[2] = {TRANSLATION_X, SCALE_X};
+            for (size_t s = 0; s < 2; ++s)
+            {
+                for (size_t c = 0; c < 3; ++c)
+                {
+                    __m128 value = _mm_loadu_ps(bases[s] + c * 4);
+                    if (ranges[s])
+                    {
+                        const uint16* q1 = ranges[s] + c * 4;
+                        const uint16* q2 = q1 + numGroups * 12;
+                        __m128 v1 = _mm_cvtepi32_ps(_mm_unpacklo_epi16(
+                            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(q1)), zero));
+                        __m128 v2 = _mm_cvtepi32_ps(_mm_unpacklo_epi16(
+                            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(q2)), zero));
+                        __m128 q = _mm_add_ps(v1, _mm_mul_ps(_mm_sub_ps(v2, v1), vt));
+                        value = _mm_add_ps(value, _mm_mul_ps(q, _mm_loadu_ps(steps[s] + c * 4)));
+                    }
+                    _mm_storeu_ps(out[outputs[s] + c], value);
+                }
+            }
+            return;
+        }
+#endif
+        for (size_t lane = 0; lane < 4; ++lane)
+        {
+            float rotation[4];
+            float squaredLength = 0;
+            for (size_t c = 0; c < 4; ++c)
+            {
+                float r1 = rotation1[c * 4 + lane];
+                float r2 = rotation2[c * 4 + lane];
+                rotation[c] = r1 + (r2 - r1) * t;
+                squaredLength += rotation[c] * rotation[c];
+            }
+            float invLength = 1.0f / std::sqrt(squaredLength);
+            for (size_t c = 0; c < 4; ++c)
+                out[ROTATION_W + c][lane] = rotation[c] * invLength;
+
+            for (size_t c = 0; c < 3; ++c)
+            {
+                size_t idx = c * 4 + lane;
+                out[TRANSLATION_X + c][lane] = translationBase[idx];
+                if (translation1)
+                {
+                    float q1 = translation1[idx];
+                    float q2 = translation1[idx + numGroups * 12];
+                    out[TRANSLATION_X + c][lane] += (q1 + (q2 - q1) * t) * translationStep[idx];
+                }
+
+                out[SCALE_X + c][lane] = scaleBase[idx];
+                if (scale1)
+                {
+                    float q1 = scale1[idx];
+                    float q2 = scale1[idx + numGroups * 12];
+                    out[SCALE_X + c][lane] += (q1 + (q2 - q1) * t) * scaleStep[idx];
+                }
+            }
+        }
+    }
+    //-----------------------------------------------------------------------
+    void CompressedNodeAnimation::sample(Real timePos, Vector3* translations, Quaternion* rotations,
+                                         Vector3* scales) const
+    {
+        if (mTimes.empty())
+            return;
+
+        size_t key;
+        float t;
+        findKey(timePos, key, t);
+
+        float sampled[NUM_COMPONENTS][4];
+        const size_t numTracks = mHandles.size();
+        for (size_t group = 0; group < getNumGroups(); ++group)
+        {
+            sampleGroup(group, key, t, sampled);
+            for (size_t lane = 0, track = group * 4; lane < 4 && track < numTracks; ++lane, ++track)
+            {
+                rotations[track] = Quaternion(sampled[ROTATION_W][lane], sampled[ROTATION_X][lane],
+                                              sampled[ROTATION_Y][lane], sampled[ROTATION_Z][lane]);
+                translations[track] = Vector3(sampled[TRANSLATION_X][lane], sampled[TRANSLATION_Y][lane],
+                                              sampled[TRANSLATION_Z][lane]);
+                scales[track] = Vector3(sampled[SCALE_X][lane], sampled[SCALE_Y][lane], sampled[SCALE_Z][lane]);
+            }
+        }
+    }
+    //-----------------------------------------------------------------------
+    void CompressedNodeAnimation::apply(Skeleton* skeleton, Real timePos, Real weight,
+                                        const AnimationState::BoneBlendMask* blendMask, Real scl,
+                                        Animation::RotationInterpolationMode rim) const
+    {
+        if (mTimes.empty() || !weight)
+            return;
+
+        size_t key;
+        float t;
+        findKey(timePos, key, t);
+
+        float sampled[NUM_COMPONENTS][4];
+        const size_t numTracks = mHandles.size();
+        for (size_t group = 0; group < getNumGroups(); ++group)
+        {
+            sampleGroup(group, key, t, sampled);
+            for (size_t lane = 0, track = group * 4; lane < 4 && track < numTracks; ++lane, ++track)
+            {
+                Real trackWeight = blendMask ? (*blendMask)[mHandles[track]] * weight : weight;
+                if (!trackWeight)
+                    continue;
+
+                // Same as NodeAnimationTrack::applyToNode
+                Bone* bone = skeleton->getBone(mHandles[track]);
+                Vector3 translate(sampled[TRANSLATION_X][lane], sampled[TRANSLATION_Y][lane],
+                                  sampled[TRANSLATION_Z][lane]);
+                bone->translate(translate * trackWeight * scl);
+
+                Quaternion rotation(sampled[ROTATION_W][lane], sampled[ROTATION_X][lane],
+                                    sampled[ROTATION_Y][lane], sampled[ROTATION_Z][lane]);
+                bool shortestPath = mUseShortestRotationPath[track] != 0;
+                if (rim == Animation::RIM_LINEAR)
+                    bone->rotate(Quaternion::nlerp(trackWeight, Quaternion::IDENTITY, rotation, shortestPath));
+                else
+                    bone->rotate(Quaternion::Slerp(trackWeight, Quaternion::IDENTITY, rotation, shortestPath));
+
+                Vector3 scale(sampled[SCALE_X][lane], sampled[SCALE_Y][lane], sampled[SCALE_Z][lane]);
+                if (scale != Vector3::UNIT_SCALE)
+                {
+                    if (scl != 1.0f)
+                        scale = Vector3::UNIT_SCALE + (scale - Vector3::UNIT_SCALE) * scl;
+                    else if (trackWeight != 1.0f)
+                        scale = Vector3::UNIT_SCALE + (scale - Vector3::UNIT_SCALE) * trackWeight;
+                }
+                bone->scale(scale);
+            }
+        }
+    }
+    //-----------------------------------------------------------------------
+    size_t CompressedNodeAnimation::calculateSize(void) const
+    {
+        return sizeof(*this) +
+            mHandles.size() * sizeof(unsigned short) +
+            mUseShortestRotationPath.size() * sizeof(uint8) +
+            mTimes.size() * sizeof(float) +
+            (mTranslationBase.size() + mTranslationStep.size() + mScaleBase.size() + mScaleStep.size()) * sizeof(float) +
+            mRotations.size() * sizeof(int16) +
+            (mTranslations.size() + mScales.size()) * sizeof(uint16);
+    }
+}
@@ -900,6 +900,21 @@ namespace Ogre {
         imgData->size = Image::calculateSize(imgData->num_mipmaps, numFaces, 
             imgData->width, imgData->height, imgData->depth, imgData->format);
 
+        MappedFileDataStream* mappedStream = dynamic_cast<MappedFileDataStream*>(stream.get());
+        if (mappedStream && !decompressDXT && stream->tell() + imgData->size <= stream->size())
+        {
+            // the file stores the faces and mips in the layout of the image, so the
+            // image can use the mapped data instead of a copy
+            output.reset(OGRE_NEW MappedFileDataStream(stream->getName(), *mappedStream, stream->tell(),
+                                                       imgData->size));
+            stream->skip(static_cast<long>(imgData->size));
+
+            DecodeResult ret;
+            ret.first = output;
+            ret.second = CodecDataPtr(imgData);
+            return ret;
+        }
+
         // Bind output buffer
         output.reset(OGRE_NEW MemoryDataStream(imgData->size));
 
@@ -27,6 +27,19 @@ THE SOFTWARE.
 */
 #include "OgreStableHeaders.h"
 
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+#  define WIN32_LEAN_AND_MEAN
+#  if !defined(NOMINMAX) && defined(_MSC_VER)
+#   define NOMINMAX // required to stop windows.h messing up std::min
+#  endif
+#  include <windows.h>
+#elif OGRE_PLATFORM != OGRE_PLATFORM_WINRT
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
 namespace Ogre {
 
     //-----------------------------------------------------------------------
@@ -467,6 +480,106 @@ namespace Ogre {
     }
     //-----------------------------------------------------------------------
     //-----------------------------------------------------------------------
+    struct MappedFileDataStream::Mapping
+    {
+        void* data;
+        size_t size;
+
+        Mapping() : data(0), size(0) {}
+        ~Mapping()
+        {
+            if (!data)
+                return;
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+            UnmapViewOfFile(data);
+#elif OGRE_PLATFORM != OGRE_PLATFORM_WINRT
+            munmap(data, size);
+#endif
+        }
+    };
+    //-----------------------------------------------------------------------
+    MappedFileDataStream::MappedFileDataStream(const String& name, const String& path)
+        : MemoryDataStream(name, static_cast<void*>(0), 0, false, true), mMapping(new Mapping())
+    {
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL, NULL);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            OGRE_EXCEPT(Exception::ERR_FILE_NOT_FOUND, "Cannot open file: " + path,
+                        "MappedFileDataStream::MappedFileDataStream");
+        }
+
+        LARGE_INTEGER fileSize;
+        GetFileSizeEx(file, &fileSize);
+        mMapping->size = static_cast<size_t>(fileSize.QuadPart);
+        if (mMapping->size)
+        {
+            // the view keeps the mapping and the file open
+            HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+            if (mapping)
+            {
+                mMapping->data = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+                CloseHandle(mapping);
+            }
+        }
+        CloseHandle(file);
+#elif OGRE_PLATFORM != OGRE_PLATFORM_WINRT
+        int fd = open(path.c_str(), O_RDONLY);
+        struct stat tagStat;
+        if (fd == -1 || fstat(fd, &tagStat) != 0)
+        {
+            if (fd != -1)
+                ::close(fd);
+            OGRE_EXCEPT(Exception::ERR_FILE_NOT_FOUND, "Cannot open file: " + path,
+                        "MappedFileDataStream::MappedFileDataStream");
+        }
+
+        mMapping->size = static_cast<size_t>(tagStat.st_size);
+        if (mMapping->size)
+        {
+            // the mapping keeps the file open
+            void* data = mmap(NULL, mMapping->size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+            if (data != MAP_FAILED)
+                mMapping->data = data;
+        }
+        ::close(fd);
+#else
+        OGRE_EXCEPT(Exception::ERR_NOT_IMPLEMENTED, "Memory mapped files are not supported on this platform",
+                    "MappedFileDataStream::MappedFileDataStream");
+#endif
+
+        if (mMapping->size && !mMapping->data)
+        {
+            OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, "Cannot map file: " + path,
+                        "MappedFileDataStream::MappedFileDataStream");
+        }
+
+        mData = mPos = static_cast<uchar*>(mMapping->data);
+        mSize = mMapping->size;
+        mEnd = mData + mSize;
+    }
+    //-----------------------------------------------------------------------
+    MappedFileDataStream::MappedFileDataStream(const String& name, const MappedFileDataStream& source,
+                                               size_t offset, size_t size)
+        : MemoryDataStream(name, source.mData + offset, size, false, true), mMapping(source.mMapping)
+    {
+        OgreAssert(offset + size <= source.mSize, "part exceeds the source stream");
+    }
+    //-----------------------------------------------------------------------
+    MappedFileDataStream::~MappedFileDataStream()
+    {
+        close();
+    }
+    //-----------------------------------------------------------------------
+    void MappedFileDataStream::close(void)
+    {
+        mAccess = 0;
+        mMapping.reset();
+        mData = mPos = mEnd = 0;
+    }
+    //-----------------------------------------------------------------------
+    //-----------------------------------------------------------------------
     FileStreamDataStream::FileStreamDataStream(std::ifstream* s, bool freeOnClose)
         : DataStream(), mInStream(s), mFStreamRO(s), mFStream(0), mFreeOnClose(freeOnClose)
     {
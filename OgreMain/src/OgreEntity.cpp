@@ -33,6 +33,7 @@ Copyright (c) 2000-2014 Torus Knot Software Ltd
 #include "OgreOptimisedUtil.h"
 #include "OgreLodStrategy.h"
 #include "OgreLodListener.h"
+#include "OgreAtomicScalar.h"
 
 
 namespace Ogre {
@@ -56,6 +57,9 @@ namespace Ogre {
           mBoneMatrices(NULL),
           mFrameAnimationLastUpdated(std::numeric_limits<unsigned long>::max()),
           mFrameBonesLastUpdated(NULL),
+          mAnimationLodIndex(0),
+          mAnimationLodFrame(std::numeric_limits<unsigned long>::max()),
+          mAnimationLodPhase(0),
           mSharedSkeletonEntities(NULL),
         mSoftwareAnimationRequests(0),
         mSoftwareAnimationNormalsRequests(0),
@@ -378,6 +382,19 @@ namespace Ogre {
             // Bias the LOD value
             Real biasedMeshLodValue = lodValue * mMeshLodFactorTransformed;
 
+            // Animation LOD, the most detailed one of all cameras this frame
+            if (!mAnimationLodValues.empty())
+            {
+                ushort animationLodIndex = meshStrategy->getIndex(biasedMeshLodValue, mAnimationLodValues);
+                unsigned long frameNumber = Root::getSingleton().getNextFrameNumber();
+                if (mAnimationLodFrame != frameNumber)
+                {
+                    mAnimationLodFrame = frameNumber;
+                    mAnimationLodIndex = animationLodIndex;
+                }
+                else
+                    mAnimationLodIndex = std::min(mAnimationLodIndex, animationLodIndex);
+            }
 
             // Get the index at this biased depth
             ushort newMeshLodIndex = mMesh->getLodIndex(biasedMeshLodValue);
@@ -822,6 +839,25 @@ namespace Ogre {
         return true;
     }
     //-----------------------------------------------------------------------
+    bool Entity::_canQueueConcurrently(void) const
+    {
+        // Animation is updated while queueing, using shared skeleton instances and
+        // temporary buffers. A reloaded mesh makes the entity reinitialise itself.
+        if (hasSkeleton() || hasVertexAnimation() || !mChildObjectList.empty() ||
+            mMesh->getStateCount() != mMeshStateCount)
+            return false;
+
+        // Queueing touches the materials, which must not load or compile them
+        for (SubEntityList::const_iterator i = mSubEntityList.begin();
+             i != mSubEntityList.end(); ++i)
+        {
+            const MaterialPtr& mat = (*i)->getMaterial();
+            if (mat && !mat->_isReadyForConcurrentUse())
+                return false;
+        }
+        return true;
+    }
+    //-----------------------------------------------------------------------
     void Entity::updateAnimation(void)
     {
         // Do nothing if not initialised yet
@@ -840,9 +876,11 @@ namespace Ogre {
         // Blend normals in s/w only if we're not using h/w animation,
         // since shadows only require positions
         bool blendNormals = !hwAnimation || forcedNormals;
+        // Animation LOD keeps the last pose, so changes of the animation state wait
+        bool animationLodHeld = _isAnimationLodHeld();
         // Animation dirty if animation state modified or manual bones modified
         bool animationDirty =
-            (mFrameAnimationLastUpdated != mAnimationState->getDirtyFrameNumber()) ||
+            (!animationLodHeld && mFrameAnimationLastUpdated != mAnimationState->getDirtyFrameNumber()) ||
             (hasSkeleton() && getSkeleton()->getManualBonesDirty());
         
         //update the current hardware animation state
@@ -920,7 +958,7 @@ namespace Ogre {
                             mSoftwareVertexAnimVertexData.get() : mMesh->sharedVertexData,
                             mSkelAnimVertexData.get(),
                             blendMatrices, mMesh->sharedBlendIndexToBoneIndexMap.size(),
-                            blendNormals);
+                            blendNormals, mManager->_getParallelSkinningPool(mSkelAnimVertexData->vertexCount));
                     }
                     SubEntityList::iterator i, iend;
                     iend = mSubEntityList.end();
@@ -942,7 +980,7 @@ namespace Ogre {
                                 se->mSoftwareVertexAnimVertexData.get() : se->mSubMesh->vertexData,
                                 se->mSkelAnimVertexData.get(),
                                 blendMatrices, se->mSubMesh->blendIndexToBoneIndexMap.size(),
-                                blendNormals);
+                                blendNormals, mManager->_getParallelSkinningPool(se->mSkelAnimVertexData->vertexCount));
                         }
 
                     }
@@ -954,7 +992,8 @@ namespace Ogre {
             if (!mChildObjectList.empty())
                 mParentNode->needUpdate();
 
-            mFrameAnimationLastUpdated = mAnimationState->getDirtyFrameNumber();
+            if (!animationLodHeld)
+                mFrameAnimationLastUpdated = mAnimationState->getDirtyFrameNumber();
         }
 
         // Need to update the child object's transforms when animation dirty
@@ -1124,7 +1163,7 @@ namespace Ogre {
             if (anim)
             {
                 anim->apply(this, state->getTimePosition(), state->getWeight(),
-                    swAnim, hardwareAnimation);
+                    swAnim, hardwareAnimation, state->_getKeyFrameCursors());
             }
         }
         // Deal with cases where no animation applied
@@ -1405,17 +1444,59 @@ namespace Ogre {
         return &mTempVertexAnimInfo;
     }
     //-----------------------------------------------------------------------
+    bool Entity::_canUpdateBonesConcurrently(void) const
+    {
+        return mInitialised && hasSkeleton() && mChildObjectList.empty() &&
+            !mSkeletonInstance->_hasActiveTagPoints() && mMesh->getStateCount() == mMeshStateCount;
+    }
+    //-----------------------------------------------------------------------
+    void Entity::_copyBoneMatrices(const Entity* source)
+    {
+        unsigned long currentFrameNumber = Root::getSingleton().getNextFrameNumber();
+        if (*mFrameBonesLastUpdated == currentFrameNumber)
+            return;
+
+        // Copy the local transforms only, derived ones are recomputed on demand
+        const SkeletonInstance* sourceSkeleton = source->getSkeleton();
+        unsigned short numBones = mSkeletonInstance->getNumBones();
+        for (unsigned short i = 0; i < numBones; ++i)
+            mSkeletonInstance->getBone(i)->_copyLocalTransform(sourceSkeleton->getBone(i));
+        memcpy(mBoneMatrices, source->mBoneMatrices, sizeof(Affine3) * mNumBoneMatrices);
+        *mFrameBonesLastUpdated = currentFrameNumber;
+    }
+    //-----------------------------------------------------------------------
+    bool Entity::_isAnimationLodHeld(void) const
+    {
+        if (!mAnimationLodIndex || !hasSkeleton() || hasVertexAnimation() ||
+            *mFrameBonesLastUpdated == std::numeric_limits<unsigned long>::max() ||
+            mSkeletonInstance->getManualBonesDirty())
+            return false;
+
+        // Only trust the LOD of recent frames, and never hold a pose for longer than
+        // the interval (e.g. when the entity comes back into view)
+        unsigned long currentFrameNumber = Root::getSingleton().getNextFrameNumber();
+        ushort interval = mAnimationLodIntervals[mAnimationLodIndex - 1];
+        if (currentFrameNumber - mAnimationLodFrame > 1 ||
+            currentFrameNumber - *mFrameBonesLastUpdated >= interval)
+            return false;
+
+        return (currentFrameNumber + mAnimationLodPhase) % interval != 0;
+    }
+    //-----------------------------------------------------------------------
     bool Entity::cacheBoneMatrices(void)
     {
         Root& root = Root::getSingleton();
         unsigned long currentFrameNumber = root.getNextFrameNumber();
-        if ((*mFrameBonesLastUpdated != currentFrameNumber) ||
-            (hasSkeleton() && getSkeleton()->getManualBonesDirty()))
+        if (((*mFrameBonesLastUpdated != currentFrameNumber) ||
+             (hasSkeleton() && getSkeleton()->getManualBonesDirty())) &&
+            !_isAnimationLodHeld())
         {
             if ((!mSkipAnimStateUpdates) && (*mFrameBonesLastUpdated != currentFrameNumber))
                 mSkeletonInstance->setAnimationState(*mAnimationState);
             mSkeletonInstance->_getBoneMatrices(mBoneMatrices);
             *mFrameBonesLastUpdated  = currentFrameNumber;
+            if (mManager)
+                mManager->_notifySkeletonEvaluated(mSkeletonInstance->getNumBones());
 
             return true;
         }
@@ -1470,6 +1551,34 @@ namespace Ogre {
         mMinMaterialLodIndex = minDetailIndex;
     }
 #endif
+    //-----------------------------------------------------------------------
+    void Entity::setAnimationLodLevels(const std::vector<Real>& lodValues,
+                                       const std::vector<ushort>& updateIntervals)
+    {
+        if (lodValues.size() != updateIntervals.size() ||
+            std::find(updateIntervals.begin(), updateIntervals.end(), 0) != updateIntervals.end())
+        {
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS,
+                        "An update interval of at least 1 is required for every LOD value",
+                        "Entity::setAnimationLodLevels");
+        }
+
+        // Consecutive entities evaluate their skeleton in consecutive frames
+        static AtomicScalar<uint32> nextPhase(0);
+
+        mAnimationLodValues.clear();
+        mAnimationLodIntervals = updateIntervals;
+        mAnimationLodIndex = 0;
+        if (lodValues.empty())
+            return;
+
+        const LodStrategy* strategy = mMesh->getLodStrategy();
+        mAnimationLodValues.push_back(strategy->getBaseValue());
+        for (std::vector<Real>::const_iterator i = lodValues.begin(); i != lodValues.end(); ++i)
+            mAnimationLodValues.push_back(strategy->transformUserValue(*i));
+        strategy->assertSorted(mAnimationLodValues);
+        mAnimationLodPhase = nextPhase++;
+    }
     //-----------------------------------------------------------------------
     void Entity::buildSubEntityList(MeshPtr& mesh, SubEntityList* sublist)
     {
@@ -72,9 +72,12 @@ namespace {
         void findFiles(const String& pattern, bool recursive, bool dirs,
             StringVector* simpleList, FileInfoList* detailList) const;
 
+        /// Whether files opened read only are memory mapped
+        bool mMapFiles;
+
         OGRE_AUTO_MUTEX;
     public:
-        FileSystemArchive(const String& name, const String& archType, bool readOnly );
+        FileSystemArchive(const String& name, const String& archType, bool readOnly, bool mapFiles = false);
         ~FileSystemArchive();
 
         /// @copydoc Archive::isCaseSensitive
@@ -113,14 +116,18 @@ namespace {
 
         /// @copydoc Archive::getModifiedTime
         time_t getModifiedTime(const String& filename) const;
+
+        /// @copydoc Archive::getModifiedTimeAndSize
+        time_t getModifiedTimeAndSize(const String& filename, size_t& size) const;
     };
 
     bool gIgnoreHidden = true;
 }
 
     //-----------------------------------------------------------------------
-    FileSystemArchive::FileSystemArchive(const String& name, const String& archType, bool readOnly )
-        : Archive(name, archType)
+    FileSystemArchive::FileSystemArchive(const String& name, const String& archType, bool readOnly,
+                                         bool mapFiles)
+        : Archive(name, archType), mMapFiles(mapFiles)
     {
         // Even failed attempt to write to read only location violates Apple AppStore validation process.
         // And successful writing to some probe file does not prove that whole location with subfolders 
@@ -330,6 +337,9 @@ namespace {
     {
         String full_path = concatenate_path(mName, filename);
 
+        if (mMapFiles && readOnly)
+            return DataStreamPtr(OGRE_NEW MappedFileDataStream(filename, full_path));
+
         // Use filesystem to determine size 
         // (quicker than streaming to the end and back)
 #ifdef _OGRE_FILESYSTEM_ARCHIVE_UNICODE
@@ -556,6 +566,22 @@ namespace {
         }
 
     }
+    //---------------------------------------------------------------------
+    time_t FileSystemArchive::getModifiedTimeAndSize(const String& filename, size_t& size) const
+    {
+        String full_path = concatenate_path(mName, filename);
+
+#ifdef _OGRE_FILESYSTEM_ARCHIVE_UNICODE
+        struct _stat64i32 tagStat;
+        bool ret = (_wstat(to_wpath(full_path).c_str(), &tagStat) == 0);
+#else
+        struct stat tagStat;
+        bool ret = (stat(full_path.c_str(), &tagStat) == 0);
+#endif
+
+        size = ret ? static_cast<size_t>(tagStat.st_size) : 0;
+        return ret ? tagStat.st_mtime : 0;
+    }
     //-----------------------------------------------------------------------
     const String& FileSystemArchiveFactory::getType(void) const
     {
@@ -577,4 +603,15 @@ namespace {
     {
         return gIgnoreHidden;
     }
+    //-----------------------------------------------------------------------
+    const String& MappedFileSystemArchiveFactory::getType(void) const
+    {
+        static String name = "MappedFileSystem";
+        return name;
+    }
+
+    Archive *MappedFileSystemArchiveFactory::createInstance( const String& name, bool readOnly )
+    {
+        return OGRE_NEW FileSystemArchive(name, getType(), readOnly, true);
+    }
 }
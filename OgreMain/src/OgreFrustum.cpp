@@ -28,6 +28,7 @@ THE SOFTWARE.
 #include "OgreStableHeaders.h"
 #include "OgreHardwareVertexBuffer.h"
 #include "OgreMovablePlane.h"
+#include "OgreOptimisedUtil.h"
 
 namespace Ogre {
 
@@ -248,6 +249,28 @@ namespace Ogre {
         return true;
     }
 
+    //-----------------------------------------------------------------------
+    void Frustum::calculateVisibility(const float* centres, const float* halfSizes,
+                                      uint32* visibility, size_t numBoxes) const
+    {
+        // Make any pending updates to the calculated frustum planes
+        updateFrustumPlanes();
+
+        if (mFarDist == 0)
+        {
+            // Skip far plane if infinite view frustum
+            Plane planes[5] = {mFrustumPlanes[FRUSTUM_PLANE_NEAR], mFrustumPlanes[FRUSTUM_PLANE_LEFT],
+                               mFrustumPlanes[FRUSTUM_PLANE_RIGHT], mFrustumPlanes[FRUSTUM_PLANE_TOP],
+                               mFrustumPlanes[FRUSTUM_PLANE_BOTTOM]};
+            OptimisedUtil::getImplementation()->calculateBoxVisibility(
+                planes, 5, centres, halfSizes, visibility, numBoxes);
+        }
+        else
+        {
+            OptimisedUtil::getImplementation()->calculateBoxVisibility(
+                mFrustumPlanes, 6, centres, halfSizes, visibility, numBoxes);
+        }
+    }
     //-----------------------------------------------------------------------
     bool Frustum::isVisible(const Vector3& vert, FrustumPlane* culledBy) const
     {
@@ -30,6 +30,7 @@ Copyright (c) 2000-2014 Torus Knot Software Ltd
 #include "OgreGpuProgramManager.h"
 #include "OgreDualQuaternion.h"
 #include "OgreRenderTarget.h"
+#include "OgreAutoParamDataSource.h"
 
 namespace Ogre
 {
@@ -187,6 +188,135 @@ namespace Ogre
         AutoConstantDefinition(ACT_POINT_PARAMS,                    "point_params",                   4, ET_REAL, ACDT_NONE),
     };
 
+    //---------------------------------------------------------------------
+    uint32 GpuConstantDefinitionMap::hashName(const String& name)
+    {
+        return FastHash(name.c_str(), name.size());
+    }
+    //---------------------------------------------------------------------
+    GpuConstantDefinitionMap::iterator GpuConstantDefinitionMap::find(const String& name, uint32 hash)
+    {
+        if (mIndex.empty())
+            return end();
+
+        size_t mask = mIndex.size() - 1;
+        for (size_t slot = hash & mask;; slot = (slot + 1) & mask)
+        {
+            const IndexSlot& s = mIndex[slot];
+            if (!s.used)
+                return end();
+            if (s.hash == hash && s.pos->first == name)
+                return s.pos;
+        }
+    }
+    //---------------------------------------------------------------------
+    std::pair<GpuConstantDefinitionMap::iterator, bool>
+    GpuConstantDefinitionMap::insert(const value_type& val)
+    {
+        uint32 hash = hashName(val.first);
+        iterator i = find(val.first, hash);
+        if (i != end())
+            return std::make_pair(i, false);
+
+        i = BaseMap::insert(val).first;
+        addToIndex(i, hash);
+        return std::make_pair(i, true);
+    }
+    //---------------------------------------------------------------------
+    GpuConstantDefinitionMap::mapped_type& GpuConstantDefinitionMap::operator[](const String& name)
+    {
+        return insert(value_type(name, mapped_type())).first->second;
+    }
+    //---------------------------------------------------------------------
+    void GpuConstantDefinitionMap::erase(iterator pos)
+    {
+        BaseMap::erase(pos);
+        ++mSerial;
+        rebuildIndex();
+    }
+    //---------------------------------------------------------------------
+    GpuConstantDefinitionMap::size_type GpuConstantDefinitionMap::erase(const String& name)
+    {
+        iterator i = find(name);
+        if (i == end())
+            return 0;
+        erase(i);
+        return 1;
+    }
+    //---------------------------------------------------------------------
+    void GpuConstantDefinitionMap::erase(iterator first, iterator last)
+    {
+        BaseMap::erase(first, last);
+        ++mSerial;
+        rebuildIndex();
+    }
+    //---------------------------------------------------------------------
+    void GpuConstantDefinitionMap::clear()
+    {
+        BaseMap::clear();
+        ++mSerial;
+        mIndex.clear();
+    }
+    //---------------------------------------------------------------------
+    void GpuConstantDefinitionMap::swap(GpuConstantDefinitionMap& rhs)
+    {
+        BaseMap::swap(rhs);
+        ++mSerial;
+        ++rhs.mSerial;
+        // nodes change owner but iterators stay valid, so the indices can follow them
+        mIndex.swap(rhs.mIndex);
+    }
+    //---------------------------------------------------------------------
+    void GpuConstantDefinitionMap::addToIndex(iterator pos, uint32 hash)
+    {
+        // keep the table at most half full so probe sequences stay short
+        if (size() * 2 > mIndex.size())
+        {
+            rebuildIndex();
+            return;
+        }
+
+        size_t mask = mIndex.size() - 1;
+        size_t slot = hash & mask;
+        while (mIndex[slot].used)
+            slot = (slot + 1) & mask;
+
+        IndexSlot& s = mIndex[slot];
+        s.hash = hash;
+        s.used = true;
+        s.pos = pos;
+    }
+    //---------------------------------------------------------------------
+    void GpuConstantDefinitionMap::rebuildIndex()
+    {
+        mIndex.clear();
+        if (empty())
+            return;
+
+        size_t capacity = 16;
+        while (capacity < size() * 2)
+            capacity <<= 1;
+
+        IndexSlot unused;
+        unused.hash = 0;
+        unused.used = false;
+        mIndex.resize(capacity, unused);
+
+        size_t mask = capacity - 1;
+        for (iterator i = begin(); i != end(); ++i)
+        {
+            uint32 hash = hashName(i->first);
+            size_t slot = hash & mask;
+            while (mIndex[slot].used)
+                slot = (slot + 1) & mask;
+
+            IndexSlot& s = mIndex[slot];
+            s.hash = hash;
+            s.used = true;
+            s.pos = i;
+        }
+    }
+
     bool GpuNamedConstants::msGenerateAllConstantDefinitionArrayEntries = false;
 
     //---------------------------------------------------------------------
@@ -260,6 +390,14 @@ namespace Ogre
     //---------------------------------------------------------------------
     //  GpuNamedConstantsSerializer methods
     //---------------------------------------------------------------------
+    GpuConstantHandle::GpuConstantHandle(const String& name)
+        : mName(name)
+        , mHash(GpuConstantDefinitionMap::hashName(name))
+        , mDefinition(0)
+        , mSerial(0)
+    {
+    }
+    //---------------------------------------------------------------------
     GpuNamedConstantsSerializer::GpuNamedConstantsSerializer()
     {
         mVersion = "[v1.0]";
@@ -847,6 +985,7 @@ namespace Ogre
         , mTransposeMatrices(false)
         , mIgnoreMissingParams(false)
         , mActivePassIterationIndex(std::numeric_limits<size_t>::max())
+        , mLastAutoParamSource(0)
     {
     }
     //-----------------------------------------------------------------------------
@@ -875,6 +1014,9 @@ namespace Ogre
         mTransposeMatrices = oth.mTransposeMatrices;
         mIgnoreMissingParams  = oth.mIgnoreMissingParams;
         mActivePassIterationIndex = oth.mActivePassIterationIndex;
+        // rewrite all autos on the next update and upload everything
+        mLastAutoParamSource = 0;
+        markAllDirty();
 
         return *this;
     }
@@ -940,6 +1082,7 @@ namespace Ogre
             mIntConstants.insert(mIntConstants.end(),
                                  namedConstants->intBufferSize - mIntConstants.size(), 0);
         }
+        markAllDirty();
     }
     //---------------------------------------------------------------------
     void GpuProgramParameters::_setLogicalIndexes(const GpuLogicalBufferStructPtr& floatIndexMap,
@@ -970,6 +1113,14 @@ namespace Ogre
             mIntConstants.insert(mIntConstants.end(),
                                  intIndexMap->bufferSize - mIntConstants.size(), 0);
         }
+        markAllDirty();
+    }
+    //---------------------------------------------------------------------
+    void GpuProgramParameters::markAllDirty(void)
+    {
+        mFloatDirtyRange.add(0, mFloatConstants.size());
+        mDoubleDirtyRange.add(0, mDoubleConstants.size());
+        mIntDirtyRange.add(0, mIntConstants.size());
     }
     //---------------------------------------------------------------------()
     void GpuProgramParameters::setConstant(size_t index, const Vector4& vec)
@@ -1053,14 +1204,8 @@ namespace Ogre
         assert(mFloatLogicalToPhysical && "GpuProgram hasn't set up the logical -> physical map!");
 
         size_t physicalIndex = _getFloatConstantPhysicalIndex(index, rawCount, GPV_GLOBAL);
-        assert(physicalIndex + rawCount <= mFloatConstants.size());
-        // Copy manually since cast required
-        for (size_t i = 0; i < rawCount; ++i)
-        {
-            mFloatConstants[physicalIndex + i] =
-                static_cast<float>(val[i]);
-        }
-
+        // Copy, casting to float
+        _writeRawConstants(physicalIndex, val, rawCount);
     }
     //-----------------------------------------------------------------------------
     void GpuProgramParameters::setConstant(size_t index, const int *val, size_t count)
@@ -1175,24 +1320,28 @@ namespace Ogre
         {
             mFloatConstants[physicalIndex+i] = static_cast<float>(val[i]);
         }
+        mFloatDirtyRange.add(physicalIndex, count);
     }
     //-----------------------------------------------------------------------------
     void GpuProgramParameters::_writeRawConstants(size_t physicalIndex, const float* val, size_t count)
     {
         assert(physicalIndex + count <= mFloatConstants.size());
         memcpy(&mFloatConstants[physicalIndex], val, sizeof(float) * count);
+        mFloatDirtyRange.add(physicalIndex, count);
     }
     //-----------------------------------------------------------------------------
     void GpuProgramParameters::_writeRawConstants(size_t physicalIndex, const int* val, size_t count)
     {
         assert(physicalIndex + count <= mIntConstants.size());
         memcpy(&mIntConstants[physicalIndex], val, sizeof(int) * count);
+        mIntDirtyRange.add(physicalIndex, count);
     }
     //-----------------------------------------------------------------------------
     void GpuProgramParameters::_writeRawConstants(size_t physicalIndex, const uint* val, size_t count)
     {
         assert(physicalIndex + count <= mIntConstants.size());
         memcpy(&mIntConstants[physicalIndex], val, sizeof(uint) * count);
+        mIntDirtyRange.add(physicalIndex, count);
     }
     //-----------------------------------------------------------------------------
     void GpuProgramParameters::_readRawConstants(size_t physicalIndex, size_t count, float* dest)
@@ -1369,6 +1518,184 @@ namespace Ogre
 
     }
     //---------------------------------------------------------------------
+    uint16 GpuProgramParameters::deriveChangeSources(GpuProgramParameters::AutoConstantType act)
+    {
+        const uint16 world = AutoParamDataSource::CS_WORLD;
+        const uint16 camera = AutoParamDataSource::CS_CAMERA;
+        const uint16 lights = AutoParamDataSource::CS_LIGHTS;
+        const uint16 projectors = AutoParamDataSource::CS_TEXTURE_PROJECTORS;
+        const uint16 target = AutoParamDataSource::CS_TARGET;
+        const uint16 pass = AutoParamDataSource::CS_PASS;
+        const uint16 scene = AutoParamDataSource::CS_SCENE;
+
+        switch(act)
+        {
+        case ACT_WORLD_MATRIX:
+        case ACT_INVERSE_WORLD_MATRIX:
+        case ACT_TRANSPOSE_WORLD_MATRIX:
+        case ACT_INVERSE_TRANSPOSE_WORLD_MATRIX:
+        case ACT_WORLD_MATRIX_ARRAY_3x4:
+        case ACT_WORLD_MATRIX_ARRAY:
+        case ACT_WORLD_DUALQUATERNION_ARRAY_2x4:
+        case ACT_WORLD_SCALE_SHEAR_MATRIX_ARRAY_3x4:
+            return world;
+
+        case ACT_WORLDVIEW_MATRIX:
+        case ACT_INVERSE_WORLDVIEW_MATRIX:
+        case ACT_TRANSPOSE_WORLDVIEW_MATRIX:
+        case ACT_INVERSE_TRANSPOSE_WORLDVIEW_MATRIX:
+        case ACT_WORLDVIEWPROJ_MATRIX:
+        case ACT_INVERSE_WORLDVIEWPROJ_MATRIX:
+        case ACT_TRANSPOSE_WORLDVIEWPROJ_MATRIX:
+        case ACT_INVERSE_TRANSPOSE_WORLDVIEWPROJ_MATRIX:
+        case ACT_CAMERA_POSITION_OBJECT_SPACE:
+        case ACT_LOD_CAMERA_POSITION_OBJECT_SPACE:
+            return world | camera;
+
+        case ACT_VIEW_MATRIX:
+        case ACT_INVERSE_VIEW_MATRIX:
+        case ACT_TRANSPOSE_VIEW_MATRIX:
+        case ACT_INVERSE_TRANSPOSE_VIEW_MATRIX:
+        case ACT_PROJECTION_MATRIX:
+        case ACT_INVERSE_PROJECTION_MATRIX:
+        case ACT_TRANSPOSE_PROJECTION_MATRIX:
+        case ACT_INVERSE_TRANSPOSE_PROJECTION_MATRIX:
+        case ACT_VIEWPROJ_MATRIX:
+        case ACT_INVERSE_VIEWPROJ_MATRIX:
+        case ACT_TRANSPOSE_VIEWPROJ_MATRIX:
+        case ACT_INVERSE_TRANSPOSE_VIEWPROJ_MATRIX:
+        case ACT_CAMERA_POSITION:
+        case ACT_LOD_CAMERA_POSITION:
+        case ACT_VIEW_DIRECTION:
+        case ACT_VIEW_SIDE_VECTOR:
+        case ACT_VIEW_UP_VECTOR:
+        case ACT_FOV:
+        case ACT_NEAR_CLIP_DISTANCE:
+        case ACT_FAR_CLIP_DISTANCE:
+            return camera;
+
+        case ACT_RENDER_TARGET_FLIPPING:
+        case ACT_VIEWPORT_WIDTH:
+        case ACT_VIEWPORT_HEIGHT:
+        case ACT_INVERSE_VIEWPORT_WIDTH:
+        case ACT_INVERSE_VIEWPORT_HEIGHT:
+        case ACT_VIEWPORT_SIZE:
+        case ACT_TEXEL_OFFSETS:
+            return target;
+
+        case ACT_AMBIENT_LIGHT_COLOUR:
+        case ACT_FOG_COLOUR:
+        case ACT_FOG_PARAMS:
+        case ACT_POINT_PARAMS:
+        case ACT_SCENE_DEPTH_RANGE:
+        case ACT_SHADOW_COLOUR:
+        case ACT_TIME:
+        case ACT_TIME_0_X:
+        case ACT_COSTIME_0_X:
+        case ACT_SINTIME_0_X:
+        case ACT_TANTIME_0_X:
+        case ACT_TIME_0_X_PACKED:
+        case ACT_TIME_0_1:
+        case ACT_COSTIME_0_1:
+        case ACT_SINTIME_0_1:
+        case ACT_TANTIME_0_1:
+        case ACT_TIME_0_1_PACKED:
+        case ACT_TIME_0_2PI:
+        case ACT_COSTIME_0_2PI:
+        case ACT_SINTIME_0_2PI:
+        case ACT_TANTIME_0_2PI:
+        case ACT_TIME_0_2PI_PACKED:
+        case ACT_FRAME_TIME:
+        case ACT_FPS:
+            return scene;
+
+        case ACT_SURFACE_AMBIENT_COLOUR:
+        case ACT_SURFACE_DIFFUSE_COLOUR:
+        case ACT_SURFACE_SPECULAR_COLOUR:
+        case ACT_SURFACE_EMISSIVE_COLOUR:
+        case ACT_SURFACE_SHININESS:
+        case ACT_SURFACE_ALPHA_REJECTION_VALUE:
+        case ACT_PASS_NUMBER:
+        case ACT_TEXTURE_SIZE:
+        case ACT_INVERSE_TEXTURE_SIZE:
+        case ACT_PACKED_TEXTURE_SIZE:
+        case ACT_TEXTURE_MATRIX:
+            return pass;
+
+        case ACT_DERIVED_AMBIENT_LIGHT_COLOUR:
+        case ACT_DERIVED_SCENE_COLOUR:
+            return scene | pass;
+
+        case ACT_LIGHT_COUNT:
+        case ACT_LIGHT_NUMBER:
+        case ACT_LIGHT_DIFFUSE_COLOUR:
+        case ACT_LIGHT_SPECULAR_COLOUR:
+        case ACT_LIGHT_ATTENUATION:
+        case ACT_SPOTLIGHT_PARAMS:
+        case ACT_LIGHT_POSITION:
+        case ACT_LIGHT_DIRECTION:
+        case ACT_LIGHT_POWER_SCALE:
+        case ACT_LIGHT_DIFFUSE_COLOUR_POWER_SCALED:
+        case ACT_LIGHT_SPECULAR_COLOUR_POWER_SCALED:
+        case ACT_LIGHT_CASTS_SHADOWS:
+        case ACT_LIGHT_CASTS_SHADOWS_ARRAY:
+        case ACT_LIGHT_DIFFUSE_COLOUR_ARRAY:
+        case ACT_LIGHT_SPECULAR_COLOUR_ARRAY:
+        case ACT_LIGHT_DIFFUSE_COLOUR_POWER_SCALED_ARRAY:
+        case ACT_LIGHT_SPECULAR_COLOUR_POWER_SCALED_ARRAY:
+        case ACT_LIGHT_ATTENUATION_ARRAY:
+        case ACT_LIGHT_POSITION_ARRAY:
+        case ACT_LIGHT_DIRECTION_ARRAY:
+        case ACT_LIGHT_POWER_SCALE_ARRAY:
+        case ACT_SPOTLIGHT_PARAMS_ARRAY:
+            return lights;
+
+        case ACT_DERIVED_LIGHT_DIFFUSE_COLOUR:
+        case ACT_DERIVED_LIGHT_SPECULAR_COLOUR:
+        case ACT_DERIVED_LIGHT_DIFFUSE_COLOUR_ARRAY:
+        case ACT_DERIVED_LIGHT_SPECULAR_COLOUR_ARRAY:
+            return lights | pass;
+
+        case ACT_LIGHT_POSITION_VIEW_SPACE:
+        case ACT_LIGHT_DIRECTION_VIEW_SPACE:
+        case ACT_LIGHT_POSITION_VIEW_SPACE_ARRAY:
+        case ACT_LIGHT_DIRECTION_VIEW_SPACE_ARRAY:
+        case ACT_SPOTLIGHT_VIEWPROJ_MATRIX:
+        case ACT_SPOTLIGHT_VIEWPROJ_MATRIX_ARRAY:
+            return lights | camera;
+
+        case ACT_LIGHT_POSITION_OBJECT_SPACE:
+        case ACT_LIGHT_DIRECTION_OBJECT_SPACE:
+        case ACT_LIGHT_DISTANCE_OBJECT_SPACE:
+        case ACT_LIGHT_POSITION_OBJECT_SPACE_ARRAY:
+        case ACT_LIGHT_DIRECTION_OBJECT_SPACE_ARRAY:
+        case ACT_LIGHT_DISTANCE_OBJECT_SPACE_ARRAY:
+        case ACT_SHADOW_EXTRUSION_DISTANCE:
+            return lights | world;
+
+        case ACT_SPOTLIGHT_WORLDVIEWPROJ_MATRIX:
+        case ACT_SPOTLIGHT_WORLDVIEWPROJ_MATRIX_ARRAY:
+            return lights | world | camera;
+
+        case ACT_TEXTURE_VIEWPROJ_MATRIX:
+        case ACT_TEXTURE_VIEWPROJ_MATRIX_ARRAY:
+            return projectors | camera;
+
+        case ACT_TEXTURE_WORLDVIEWPROJ_MATRIX:
+        case ACT_TEXTURE_WORLDVIEWPROJ_MATRIX_ARRAY:
+            return projectors | world | camera;
+
+        case ACT_SHADOW_SCENE_DEPTH_RANGE:
+        case ACT_SHADOW_SCENE_DEPTH_RANGE_ARRAY:
+            return projectors | scene;
+
+        default:
+            // written by the renderable, the lights or the render system
+            // (custom parameters, pass iteration, vertex winding): always update
+            return 0;
+        };
+    }
+    //---------------------------------------------------------------------
     template <typename T> bool isElementType(GpuProgramParameters::ElementType)
     {
         return false;
@@ -1523,8 +1850,13 @@ namespace Ogre
     {
         if (!mFloatLogicalToPhysical)
             return NULL;
-        return getConstantLogicalIndexUse(mFloatLogicalToPhysical, mFloatConstants, logicalIndex,
-                                          requestedSize, variability);
+        size_t oldSize = mFloatConstants.size();
+        GpuLogicalIndexUse* indexUse = getConstantLogicalIndexUse(
+            mFloatLogicalToPhysical, mFloatConstants, logicalIndex, requestedSize, variability);
+        // entries may have moved
+        if (mFloatConstants.size() != oldSize)
+            mFloatDirtyRange.add(0, mFloatConstants.size());
+        return indexUse;
     }
     //---------------------------------------------------------------------
     GpuLogicalIndexUse* GpuProgramParameters::_getDoubleConstantLogicalIndexUse(
@@ -1532,8 +1864,12 @@ namespace Ogre
     {
         if (!mDoubleLogicalToPhysical)
             return NULL;
-        return getConstantLogicalIndexUse(mDoubleLogicalToPhysical, mDoubleConstants, logicalIndex,
-                                          requestedSize, variability);
+        size_t oldSize = mDoubleConstants.size();
+        GpuLogicalIndexUse* indexUse = getConstantLogicalIndexUse(
+            mDoubleLogicalToPhysical, mDoubleConstants, logicalIndex, requestedSize, variability);
+        if (mDoubleConstants.size() != oldSize)
+            mDoubleDirtyRange.add(0, mDoubleConstants.size());
+        return indexUse;
     }
     //---------------------------------------------------------------------()
     GpuLogicalIndexUse* GpuProgramParameters::_getIntConstantLogicalIndexUse(size_t logicalIndex, size_t requestedSize, uint16 variability)
@@ -1543,8 +1879,12 @@ namespace Ogre
                         "This is not a low-level parameter parameter object",
                         "GpuProgramParameters::_getIntConstantPhysicalIndex");
 
-        return getConstantLogicalIndexUse(mIntLogicalToPhysical, mIntConstants, logicalIndex,
-                                          requestedSize, variability);
+        size_t oldSize = mIntConstants.size();
+        GpuLogicalIndexUse* indexUse = getConstantLogicalIndexUse(
+            mIntLogicalToPhysical, mIntConstants, logicalIndex, requestedSize, variability);
+        if (mIntConstants.size() != oldSize)
+            mIntDirtyRange.add(0, mIntConstants.size());
+        return indexUse;
     }
     //---------------------------------------------------------------------()
     GpuLogicalIndexUse* GpuProgramParameters::_getUnsignedIntConstantLogicalIndexUse(size_t logicalIndex, size_t requestedSize, uint16 variability)
@@ -1652,6 +1992,27 @@ namespace Ogre
     const GpuConstantDefinition*
     GpuProgramParameters::_findNamedConstantDefinition(const String& name,
                                                        bool throwExceptionIfNotFound) const
+    {
+        return findNamedConstantDefinition(name, GpuConstantDefinitionMap::hashName(name),
+                                           throwExceptionIfNotFound);
+    }
+    //---------------------------------------------------------------------
+    const GpuConstantDefinition*
+    GpuProgramParameters::_findNamedConstantDefinition(const GpuConstantHandle& handle,
+                                                       bool throwExceptionIfNotFound) const
+    {
+        // the cached definition is only good for the definitions it was found in,
+        // as long as nothing has been removed from them since
+        if (handle.mDefinition && handle.mConstants == mNamedConstants &&
+            handle.mSerial == mNamedConstants->map.getSerial())
+            return handle.mDefinition;
+
+        return findNamedConstantDefinition(handle.mName, handle.mHash, throwExceptionIfNotFound);
+    }
+    //---------------------------------------------------------------------
+    const GpuConstantDefinition*
+    GpuProgramParameters::findNamedConstantDefinition(const String& name, uint32 hash,
+                                                      bool throwExceptionIfNotFound) const
     {
         if (!mNamedConstants)
         {
@@ -1662,7 +2023,7 @@ namespace Ogre
             return 0;
         }
 
-        GpuConstantDefinitionMap::const_iterator i = mNamedConstants->map.find(name);
+        GpuConstantDefinitionMap::const_iterator i = mNamedConstants->map.find(name, hash);
         if (i == mNamedConstants->map.end())
         {
             if (throwExceptionIfNotFound)
@@ -1723,6 +2084,8 @@ namespace Ogre
                 i->data = extraInfo;
                 i->elementCount = elementSize;
                 i->variability = variability;
+                i->changeSources = deriveChangeSources(acType);
+                i->lastUpdateTick = 0;
                 found = true;
                 break;
             }
@@ -1773,6 +2136,8 @@ namespace Ogre
                 i->fData = rData;
                 i->elementCount = elementSize;
                 i->variability = variability;
+                i->changeSources = deriveChangeSources(acType);
+                i->lastUpdateTick = 0;
                 found = true;
                 break;
             }
@@ -1881,12 +2246,24 @@ namespace Ogre
 
         mActivePassIterationIndex = std::numeric_limits<size_t>::max();
 
+        // change ticks are only comparable within the same source
+        bool trackChanges = source->isChangeTrackingEnabled() && source == mLastAutoParamSource;
+        mLastAutoParamSource = source;
+
         // Autoconstant index is not a physical index
-        for (AutoConstantList::const_iterator i = mAutoConstants.begin(); i != mAutoConstants.end(); ++i)
+        for (AutoConstantList::iterator i = mAutoConstants.begin(); i != mAutoConstants.end(); ++i)
         {
             // Only update needed slots
             if (i->variability & mask)
             {
+                // and skip those whose inputs did not change since they were written
+                if (i->changeSources)
+                {
+                    uint64 tick = source->getChangeTick(i->changeSources);
+                    if (trackChanges && tick <= i->lastUpdateTick)
+                        continue;
+                    i->lastUpdateTick = tick;
+                }
 
                 switch(i->paramType)
                 {
@@ -2512,6 +2889,53 @@ namespace Ogre
 
     }
     //---------------------------------------------------------------------------
+    bool GpuProgramParameters::_canPackPerObjectConstants(void) const
+    {
+        for (const AutoConstantEntry& e : mAutoConstants)
+        {
+            if (!(e.variability & GPV_PER_OBJECT))
+                continue;
+
+            if (e.variability != GPV_PER_OBJECT)
+                return false;
+
+            switch (e.paramType)
+            {
+            case ACT_WORLD_MATRIX_ARRAY_3x4:
+            case ACT_WORLD_MATRIX_ARRAY:
+            case ACT_WORLD_DUALQUATERNION_ARRAY_2x4:
+            case ACT_WORLD_SCALE_SHEAR_MATRIX_ARRAY_3x4:
+                return false;
+            default:
+                break;
+            }
+        }
+        return true;
+    }
+    //---------------------------------------------------------------------------
+    size_t GpuProgramParameters::_getPerObjectConstantCount(void) const
+    {
+        size_t count = 0;
+        for (const AutoConstantEntry& e : mAutoConstants)
+        {
+            if (e.variability & GPV_PER_OBJECT)
+                count += e.elementCount;
+        }
+        return count;
+    }
+    //---------------------------------------------------------------------------
+    void GpuProgramParameters::_packPerObjectConstants(float* dest) const
+    {
+        for (const AutoConstantEntry& e : mAutoConstants)
+        {
+            if (!(e.variability & GPV_PER_OBJECT))
+                continue;
+
+            memcpy(dest, &mFloatConstants[e.physicalIndex], e.elementCount * sizeof(float));
+            dest += e.elementCount;
+        }
+    }
+    //---------------------------------------------------------------------------
     void GpuProgramParameters::setNamedConstant(const String& name, Real val)
     {
         // look up, and throw an exception if we're not ignoring missing
@@ -2660,16 +3084,7 @@ namespace Ogre
         const GpuConstantDefinition* def =
             _findNamedConstantDefinition(name, !mIgnoreMissingParams);
         if (def)
-        {
-            def->variability = deriveVariability(acType);
-            // make sure we also set variability on the logical index map
-            GpuLogicalIndexUse* indexUse = _getFloatConstantLogicalIndexUse(def->logicalIndex, def->elementSize * def->arraySize, def->variability);
-            if (indexUse)
-                indexUse->variability = def->variability;
-
-            _setRawAutoConstant(def->physicalIndex, acType, extraInfo, def->variability, def->elementSize);
-        }
-
+            setDefinitionAutoConstant(*def, acType, extraInfo);
     }
     //---------------------------------------------------------------------------
     void GpuProgramParameters::setNamedAutoConstantReal(const String& name,
@@ -2679,14 +3094,7 @@ namespace Ogre
         const GpuConstantDefinition* def =
             _findNamedConstantDefinition(name, !mIgnoreMissingParams);
         if (def)
-        {
-            def->variability = deriveVariability(acType);
-            // make sure we also set variability on the logical index map
-            GpuLogicalIndexUse* indexUse = _getFloatConstantLogicalIndexUse(def->logicalIndex, def->elementSize * def->arraySize, def->variability);
-            if (indexUse)
-                indexUse->variability = def->variability;
-            _setRawAutoConstantReal(def->physicalIndex, acType, rData, def->variability, def->elementSize);
-        }
+            setDefinitionAutoConstantReal(*def, acType, rData);
     }
     //---------------------------------------------------------------------------
     void GpuProgramParameters::setNamedAutoConstant(const String& name,
@@ -2698,15 +3106,187 @@ namespace Ogre
         const GpuConstantDefinition* def =
             _findNamedConstantDefinition(name, !mIgnoreMissingParams);
         if (def)
-        {
-            def->variability = deriveVariability(acType);
-            // make sure we also set variability on the logical index map
-            GpuLogicalIndexUse* indexUse = _getFloatConstantLogicalIndexUse(def->logicalIndex, def->elementSize * def->arraySize, def->variability);
-            if (indexUse)
-                indexUse->variability = def->variability;
+            setDefinitionAutoConstant(*def, acType, extraInfo);
+    }
+    //---------------------------------------------------------------------------
+    void GpuProgramParameters::setDefinitionAutoConstant(const GpuConstantDefinition& def,
+                                                         AutoConstantType acType, size_t extraInfo)
+    {
+        def.variability = deriveVariability(acType);
+        // make sure we also set variability on the logical index map
+        GpuLogicalIndexUse* indexUse = _getFloatConstantLogicalIndexUse(def.logicalIndex, def.elementSize * def.arraySize, def.variability);
+        if (indexUse)
+            indexUse->variability = def.variability;
+
+        _setRawAutoConstant(def.physicalIndex, acType, extraInfo, def.variability, def.elementSize);
+    }
+    //---------------------------------------------------------------------------
+    void GpuProgramParameters::setDefinitionAutoConstantReal(const GpuConstantDefinition& def,
+                                                             AutoConstantType acType, Real rData)
+    {
+        def.variability = deriveVariability(acType);
+        // make sure we also set variability on the logical index map
+        GpuLogicalIndexUse* indexUse = _getFloatConstantLogicalIndexUse(def.logicalIndex, def.elementSize * def.arraySize, def.variability);
+        if (indexUse)
+            indexUse->variability = def.variability;
 
-            _setRawAutoConstant(def->physicalIndex, acType, extraInfo, def->variability, def->elementSize);
+        _setRawAutoConstantReal(def.physicalIndex, acType, rData, def.variability, def.elementSize);
+    }
+    //---------------------------------------------------------------------------
+    GpuConstantHandle GpuProgramParameters::getConstantHandle(const String& name) const
+    {
+        GpuConstantHandle handle(name);
+        handle.mDefinition = _findNamedConstantDefinition(handle, !mIgnoreMissingParams);
+        if (handle.mDefinition)
+        {
+            handle.mConstants = mNamedConstants;
+            handle.mSerial = mNamedConstants->map.getSerial();
         }
+        return handle;
+    }
+    //---------------------------------------------------------------------------
+    void GpuProgramParameters::setNamedConstant(const GpuConstantHandle& handle, Real val)
+    {
+        // look up, and throw an exception if we're not ignoring missing
+        const GpuConstantDefinition* def =
+            _findNamedConstantDefinition(handle, !mIgnoreMissingParams);
+        if (def)
+            _writeRawConstant(def->physicalIndex, val);
+    }
+    //---------------------------------------------------------------------------
+    void GpuProgramParameters::setNamedConstant(const GpuConstantHandle& handle, int val)
+    {
+        // look up, and throw an exception if we're not ignoring missing
+        const GpuConstantDefinition* def =
+            _findNamedConstantDefinition(handle, !mIgnoreMissingParams);
+        if (def)
+            _writeRawConstant(def->physicalIndex, val);
+    }
+    //---------------------------------------------------------------------------
+    void GpuProgramParameters::setNamedConstant(const GpuConstantHandle& handle, uint val)
+    {
+        // look up, and throw an exception if we're not ignoring missing
+        const GpuConstantDefinition* def =
+            _findNamedConstantDefinition(handle, !mIgnoreMissingParams);
+        if (def)
+            _writeRawConstant(def->physicalIndex, val);
+    }
+    //---------------------------------------------------------------------------
+    void GpuProgramParameters::setNamedConstant(const GpuConstantHandle& handle, const Vector4& vec)
+    {
+        // look up, and throw an exception if we're not ignoring missing
+        const GpuConstantDefinition* def =
+            _findNamedConstantDefinition(handle, !mIgnoreMissingParams);
+        if (def)
+            _writeRawConstant(def->physicalIndex, vec, def->elementSize);
+    }
+    //---------------------------------------------------------------------------
+    void GpuProgramParameters::setNamedConstant(const GpuConstantHandle& handle, const Vector3& vec)
+    {
+        // look up, and throw an exception if we're not ignoring missing
+        const GpuConstantDefinition* def =
+            _findNamedConstantDefinition(handle, !mIgnoreMissingParams);
+        if (def)
+            _writeRawConstant(def->physicalIndex, vec);
+    }
+    //---------------------------------------------------------------------------
+    void GpuProgramParameters::setNamedConstant(const GpuConstantHandle& handle, const Vector2& vec)
+    {
+        // look up, and throw an exception if we're not ignoring missing
+        const GpuConstantDefinition* def =
+            _findNamedConstantDefinition(handle, !mIgnoreMissingParams);
+        if (def)
+            _writeRawConstant(def->physicalIndex, vec);
+    }
+    //---------------------------------------------------------------------------
+    void GpuProgramParameters::setNamedConstant(const GpuConstantHandle& handle, const Matrix4& m)
+    {
+        // look up, and throw an exception if we're not ignoring missing
+        const GpuConstantDefinition* def =
+            _findNamedConstantDefinition(handle, !mIgnoreMissingParams);
+        if (def)
+            _writeRawConstant(def->physicalIndex, m, def->elementSize);
+    }
+    //---------------------------------------------------------------------------
+    void GpuProgramParameters::setNamedConstant(const GpuConstantHandle& handle, const Matrix4* m,
+                                                size_t numEntries)
+    {
+        // look up, and throw an exception if we're not ignoring missing
+        const GpuConstantDefinition* def =
+            _findNamedConstantDefinition(handle, !mIgnoreMissingParams);
+        if (def)
+            _writeRawConstant(def->physicalIndex, m, numEntries);
+    }
+    //---------------------------------------------------------------------------
+    void GpuProgramParameters::setNamedConstant(const GpuConstantHandle& handle, const ColourValue& colour)
+    {
+        // look up, and throw an exception if we're not ignoring missing
+        const GpuConstantDefinition* def =
+            _findNamedConstantDefinition(handle, !mIgnoreMissingParams);
+        if (def)
+            _writeRawConstant(def->physicalIndex, colour, def->elementSize);
+    }
+    //---------------------------------------------------------------------------
+    void GpuProgramParameters::setNamedConstant(const GpuConstantHandle& handle,
+                                                const float *val, size_t count, size_t multiple)
+    {
+        size_t rawCount = count * multiple;
+        // look up, and throw an exception if we're not ignoring missing
+        const GpuConstantDefinition* def =
+            _findNamedConstantDefinition(handle, !mIgnoreMissingParams);
+        if (def)
+            _writeRawConstants(def->physicalIndex, val, rawCount);
+    }
+    //---------------------------------------------------------------------------
+    void GpuProgramParameters::setNamedConstant(const GpuConstantHandle& handle,
+                                                const double *val, size_t count, size_t multiple)
+    {
+        size_t rawCount = count * multiple;
+        // look up, and throw an exception if we're not ignoring missing
+        const GpuConstantDefinition* def =
+            _findNamedConstantDefinition(handle, !mIgnoreMissingParams);
+        if (def)
+            _writeRawConstants(def->physicalIndex, val, rawCount);
+    }
+    //---------------------------------------------------------------------------
+    void GpuProgramParameters::setNamedConstant(const GpuConstantHandle& handle,
+                                                const int *val, size_t count, size_t multiple)
+    {
+        size_t rawCount = count * multiple;
+        // look up, and throw an exception if we're not ignoring missing
+        const GpuConstantDefinition* def =
+            _findNamedConstantDefinition(handle, !mIgnoreMissingParams);
+        if (def)
+            _writeRawConstants(def->physicalIndex, val, rawCount);
+    }
+    //---------------------------------------------------------------------------
+    void GpuProgramParameters::setNamedConstant(const GpuConstantHandle& handle,
+                                                const uint *val, size_t count, size_t multiple)
+    {
+        size_t rawCount = count * multiple;
+        // look up, and throw an exception if we're not ignoring missing
+        const GpuConstantDefinition* def =
+            _findNamedConstantDefinition(handle, !mIgnoreMissingParams);
+        if (def)
+            _writeRawConstants(def->physicalIndex, val, rawCount);
+    }
+    //---------------------------------------------------------------------------
+    void GpuProgramParameters::setNamedAutoConstant(const GpuConstantHandle& handle,
+                                                    AutoConstantType acType, size_t extraInfo)
+    {
+        const GpuConstantDefinition* def =
+            _findNamedConstantDefinition(handle, !mIgnoreMissingParams);
+        if (def)
+            setDefinitionAutoConstant(*def, acType, extraInfo);
+    }
+    //---------------------------------------------------------------------------
+    void GpuProgramParameters::setNamedAutoConstantReal(const GpuConstantHandle& handle,
+                                                        AutoConstantType acType, Real rData)
+    {
+        const GpuConstantDefinition* def =
+            _findNamedConstantDefinition(handle, !mIgnoreMissingParams);
+        if (def)
+            setDefinitionAutoConstantReal(*def, acType, rData);
     }
     //---------------------------------------------------------------------------
     void GpuProgramParameters::setConstantFromTime(size_t index, Real factor)
@@ -2865,6 +3445,8 @@ namespace Ogre
         mAutoConstants = source.getAutoConstantList();
         mCombinedVariability = source.mCombinedVariability;
         copySharedParamSetUsage(source.mSharedParamSets);
+        mLastAutoParamSource = 0;
+        markAllDirty();
     }
     //---------------------------------------------------------------------
     void GpuProgramParameters::copyMatchingNamedConstantsFrom(const GpuProgramParameters& source)
@@ -3006,6 +3588,7 @@ namespace Ogre
         {
             // This is a physical index
             ++mFloatConstants[mActivePassIterationIndex];
+            mFloatDirtyRange.add(mActivePassIterationIndex, 1);
         }
     }
     //---------------------------------------------------------------------
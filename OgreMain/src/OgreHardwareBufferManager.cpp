@@ -27,6 +27,7 @@ THE SOFTWARE.
 */
 #include "OgreStableHeaders.h"
 #include "OgreVertexIndexData.h"
+#include "OgreStreamingBufferAllocator.h"
 
 namespace Ogre {
 
@@ -61,6 +62,9 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     HardwareBufferManagerBase::~HardwareBufferManagerBase()
     {
+        // The rings must go while the buffer lists still exist
+        mStreamingBuffers.reset();
+
         // Clear vertex/index buffer list first, avoid destroyed notify do
         // unnecessary work, and we'll destroy everything here.
         mVertexBuffers.clear();
@@ -274,6 +278,19 @@ namespace Ogre {
         LogManager::getSingleton().logMessage(str.str(), LML_TRIVIAL);
     }
     //-----------------------------------------------------------------------
+    StreamingBufferAllocator& HardwareBufferManagerBase::getStreamingBuffers(void)
+    {
+        if (!mStreamingBuffers)
+            mStreamingBuffers.reset(new StreamingBufferAllocator(this));
+        return *mStreamingBuffers;
+    }
+    //-----------------------------------------------------------------------
+    void HardwareBufferManagerBase::_releaseStreamingBuffers(void)
+    {
+        if (mStreamingBuffers)
+            mStreamingBuffers->_releaseBuffers();
+    }
+    //-----------------------------------------------------------------------
     void HardwareBufferManagerBase::_releaseBufferCopies(bool forceFreeUnused)
     {
         OGRE_LOCK_MUTEX(mTempBuffersMutex);
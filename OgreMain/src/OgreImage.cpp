@@ -71,6 +71,11 @@ namespace Ogre {
             OGRE_FREE(mBuffer, MEMCATEGORY_GENERAL);
             mBuffer = NULL;
         }
+        else if( mBufferStream )
+        {
+            mBufferStream.reset();
+            mBuffer = NULL;
+        }
 
     }
 
@@ -87,6 +92,7 @@ namespace Ogre {
         mPixelSize = img.mPixelSize;
         mNumMipmaps = img.mNumMipmaps;
         mAutoDelete = img.mAutoDelete;
+        mBufferStream = img.mBufferStream;
         //Only create/copy when previous data was not dynamic data
         if( img.mBuffer && mAutoDelete )
         {
@@ -367,6 +373,13 @@ namespace Ogre {
         mPixelSize = static_cast<uchar>(PixelUtil::getNumElemBytes( mFormat ));
         // Just use internal buffer of returned memory stream
         mBuffer = res.first->getPtr();
+        if (!res.first->isFreeOnClose())
+        {
+            // the stream refers to memory it does not own, keep it alive instead
+            mBufferStream = res.first;
+            mAutoDelete = false;
+            return *this;
+        }
         // Make sure stream does not delete
         res.first->setFreeOnClose(false);
         // make sure we delete
@@ -494,13 +507,16 @@ namespace Ogre {
     //-----------------------------------------------------------------------------
     void Image::resize(ushort width, ushort height, Filter filter)
     {
-        OgreAssert(mAutoDelete, "resizing dynamic images is not supported");
+        OgreAssert(mAutoDelete || mBufferStream, "resizing dynamic images is not supported");
         assert(mDepth == 1);
 
         // reassign buffer to temp image, make sure auto-delete is true
         Image temp;
-        temp.loadDynamicImage(mBuffer, mWidth, mHeight, 1, mFormat, true);
-        // do not delete[] mBuffer!  temp will destroy it
+        temp.loadDynamicImage(mBuffer, mWidth, mHeight, 1, mFormat, mAutoDelete);
+        // do not delete[] mBuffer!  temp will destroy it, or the stream once scaled
+        DataStreamPtr source;
+        source.swap(mBufferStream);
+        mAutoDelete = true;
 
         // set new dimensions, allocate new buffer
         mWidth = width;
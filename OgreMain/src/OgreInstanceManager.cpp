@@ -485,6 +485,8 @@ namespace Ogre
     //-----------------------------------------------------------------------
     void InstanceManager::_addDirtyBatch( InstanceBatch *dirtyBatch )
     {
+        // may be called from several threads when updating the scene graph
+        OGRE_WQ_LOCK_MUTEX(mDirtyBatchesMutex);
         if( mDirtyBatches.empty() )
             mSceneManager->_addDirtyInstanceManager( this );
 
@@ -0,0 +1,171 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgreLightGrid.h"
+#include "OgreLight.h"
+
+namespace Ogre
+{
+    namespace
+    {
+        /// Lights covering more cells than this are tested for every query
+        const int MAX_CELLS_PER_LIGHT = 64;
+        /// Queries covering more cells than this test all lights
+        const int MAX_CELLS_PER_QUERY = 64;
+        /// Bits per cell coordinate in a cell key
+        const int CELL_BITS = 21;
+        const int32 CELL_MIN = -(1 << (CELL_BITS - 1));
+        const int32 CELL_MAX = (1 << (CELL_BITS - 1)) - 1;
+
+        uint64 getCellKey(int32 x, int32 y, int32 z)
+        {
+            const uint64 mask = (uint64(1) << CELL_BITS) - 1;
+            return (uint64(x - CELL_MIN) & mask) << (2 * CELL_BITS) |
+                   (uint64(y - CELL_MIN) & mask) << CELL_BITS |
+                   (uint64(z - CELL_MIN) & mask);
+        }
+
+        int getNumCells(const int32* minCell, const int32* maxCell)
+        {
+            int64 num = 1;
+            for (int i = 0; i < 3; ++i)
+                num *= int64(maxCell[i]) - minCell[i] + 1;
+            return int(std::min<int64>(num, std::numeric_limits<int>::max()));
+        }
+
+        struct CellEntryLess
+        {
+            bool operator()(const std::pair<uint64, uint32>& a, uint64 key) const { return a.first < key; }
+            bool operator()(uint64 key, const std::pair<uint64, uint32>& b) const { return key < b.first; }
+        };
+    }
+    //-----------------------------------------------------------------------
+    LightGrid::LightGrid() : mNumLights(0), mCellSize(1), mInvCellSize(1)
+    {
+    }
+    //-----------------------------------------------------------------------
+    void LightGrid::getCell(const Vector3& pos, int32* cell) const
+    {
+        // floor is monotonic, so boxes touching in world space share a cell
+        for (int i = 0; i < 3; ++i)
+        {
+            Real c = Math::Floor(pos[i] * mInvCellSize);
+            cell[i] = int32(Math::Clamp<Real>(c, Real(CELL_MIN), Real(CELL_MAX)));
+        }
+    }
+    //-----------------------------------------------------------------------
+    void LightGrid::build(const LightList& lights)
+    {
+        mCells.clear();
+        mUnboundedLights.clear();
+        mNumLights = lights.size();
+
+        // size the cells after the typical light
+        Real rangeSum = 0;
+        size_t numLocalLights = 0;
+        for (LightList::const_iterator i = lights.begin(); i != lights.end(); ++i)
+        {
+            if ((*i)->getType() != Light::LT_DIRECTIONAL)
+            {
+                rangeSum += (*i)->getAttenuationRange();
+                ++numLocalLights;
+            }
+        }
+        mCellSize = numLocalLights ? 2 * rangeSum / numLocalLights : 1;
+        // also catches infinite or NaN ranges
+        if (!(mCellSize > 0 && mCellSize < std::numeric_limits<Real>::max()))
+            mCellSize = 1;
+        mInvCellSize = 1 / mCellSize;
+
+        for (uint32 idx = 0; idx < lights.size(); ++idx)
+        {
+            const Light* l = lights[idx];
+            if (l->getType() == Light::LT_DIRECTIONAL)
+            {
+                mUnboundedLights.push_back(idx);
+                continue;
+            }
+
+            Vector3 pos = l->getDerivedPosition();
+            Vector3 range(l->getAttenuationRange());
+            int32 minCell[3], maxCell[3];
+            getCell(pos - range, minCell);
+            getCell(pos + range, maxCell);
+
+            if (getNumCells(minCell, maxCell) > MAX_CELLS_PER_LIGHT)
+            {
+                mUnboundedLights.push_back(idx);
+                continue;
+            }
+
+            for (int32 x = minCell[0]; x <= maxCell[0]; ++x)
+                for (int32 y = minCell[1]; y <= maxCell[1]; ++y)
+                    for (int32 z = minCell[2]; z <= maxCell[2]; ++z)
+                        mCells.push_back(CellEntry(getCellKey(x, y, z), idx));
+        }
+
+        std::sort(mCells.begin(), mCells.end());
+    }
+    //-----------------------------------------------------------------------
+    void LightGrid::findLights(const Sphere& bounds, std::vector<uint32>& indices) const
+    {
+        indices.clear();
+
+        Vector3 radius(bounds.getRadius());
+        int32 minCell[3], maxCell[3];
+        getCell(bounds.getCenter() - radius, minCell);
+        getCell(bounds.getCenter() + radius, maxCell);
+
+        if (getNumCells(minCell, maxCell) > MAX_CELLS_PER_QUERY)
+        {
+            indices.resize(mNumLights);
+            for (uint32 i = 0; i < mNumLights; ++i)
+                indices[i] = i;
+            return;
+        }
+
+        indices = mUnboundedLights;
+        for (int32 x = minCell[0]; x <= maxCell[0]; ++x)
+        {
+            for (int32 y = minCell[1]; y <= maxCell[1]; ++y)
+            {
+                for (int32 z = minCell[2]; z <= maxCell[2]; ++z)
+                {
+                    std::pair<std::vector<CellEntry>::const_iterator, std::vector<CellEntry>::const_iterator>
+                        range = std::equal_range(mCells.begin(), mCells.end(), getCellKey(x, y, z), CellEntryLess());
+                    for (std::vector<CellEntry>::const_iterator i = range.first; i != range.second; ++i)
+                        indices.push_back(i->second);
+                }
+            }
+        }
+
+        // lights overlapping several cells of the query are found repeatedly
+        std::sort(indices.begin(), indices.end());
+        indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+    }
+}
@@ -88,6 +88,9 @@ namespace Ogre
     void Log::logMessage( const String& message, LogMessageLevel lml, bool maskDebug )
     {
         OGRE_LOCK_AUTO_MUTEX;
+#if OGRE_THREAD_SUPPORT == 3
+        OGRE_WQ_LOCK_MUTEX(mMessageMutex);
+#endif
         if ((mLogLevel + lml) >= OGRE_LOG_THRESHOLD)
         {
             bool skipThisMessage = false;
@@ -354,6 +354,14 @@ namespace Ogre {
 
     }
     //-----------------------------------------------------------------------------
+    bool Material::_isReadyForConcurrentUse(void) const
+    {
+        return isLoaded() && !mCompilationRequired &&
+            mBestTechniquesBySchemeList.find(
+                MaterialManager::getSingleton()._getActiveSchemeIndex()) !=
+            mBestTechniquesBySchemeList.end();
+    }
+    //-----------------------------------------------------------------------------
     Technique* Material::getBestTechnique(unsigned short lodIndex, const Renderable* rend)
     {
         if (mSupportedTechniques.empty())
@@ -37,6 +37,7 @@ THE SOFTWARE.
 #include "OgreTangentSpaceCalc.h"
 #include "OgreLodStrategyManager.h"
 #include "OgrePixelCountLodStrategy.h"
+#include "OgreWorkerThreadPool.h"
 
 namespace Ogre {
     //-----------------------------------------------------------------------
@@ -209,8 +210,9 @@ namespace Ogre {
             ResourceGroupManager::getSingleton().openResource(
                 mName, mGroup, this);
  
-        // fully prebuffer into host RAM
-        mFreshFromDisk = DataStreamPtr(OGRE_NEW MemoryDataStream(mName,mFreshFromDisk));
+        // fully prebuffer into host RAM, unless it already is (e.g. memory mapped)
+        if (!dynamic_cast<MemoryDataStream*>(mFreshFromDisk.get()))
+            mFreshFromDisk = DataStreamPtr(OGRE_NEW MemoryDataStream(mName,mFreshFromDisk));
     }
     //-----------------------------------------------------------------------
     void Mesh::unprepareImpl()
@@ -1919,10 +1921,47 @@ namespace Ogre {
         }
     }
     //---------------------------------------------------------------------
+    namespace
+    {
+        /// Skins an even share of the vertices on each thread of a WorkerThreadPool
+        class SoftwareVertexSkinningTask : public UniformScalableTask
+        {
+        public:
+            const float *srcPos, *srcNorm, *blendWeight;
+            float *destPos, *destNorm;
+            const unsigned char* blendIdx;
+            const Affine3* const* blendMatrices;
+            size_t srcPosStride, destPosStride, srcNormStride, destNormStride;
+            size_t blendWeightStride, blendIdxStride;
+            size_t numWeightsPerVertex, numVertices;
+
+            void execute(size_t threadIdx, size_t numThreads)
+            {
+                size_t begin = numVertices * threadIdx / numThreads;
+                size_t end = numVertices * (threadIdx + 1) / numThreads;
+                if (begin == end)
+                    return;
+
+                OptimisedUtil::getImplementation()->softwareVertexSkinning(
+                    rawOffsetPointer(srcPos, begin * srcPosStride),
+                    rawOffsetPointer(destPos, begin * destPosStride),
+                    srcNorm ? rawOffsetPointer(srcNorm, begin * srcNormStride) : NULL,
+                    destNorm ? rawOffsetPointer(destNorm, begin * destNormStride) : NULL,
+                    rawOffsetPointer(blendWeight, begin * blendWeightStride),
+                    rawOffsetPointer(blendIdx, begin * blendIdxStride),
+                    blendMatrices,
+                    srcPosStride, destPosStride,
+                    srcNormStride, destNormStride,
+                    blendWeightStride, blendIdxStride,
+                    numWeightsPerVertex,
+                    end - begin);
+            }
+        };
+    }
     void Mesh::softwareVertexBlend(const VertexData* sourceVertexData,
         const VertexData* targetVertexData,
         const Affine3* const* blendMatrices, size_t numMatrices,
-        bool blendNormals)
+        bool blendNormals, WorkerThreadPool* pool)
     {
         float *pSrcPos = 0;
         float *pSrcNorm = 0;
@@ -2032,16 +2071,39 @@ namespace Ogre {
             destElemNorm->baseVertexPointerToElement(pBuffer, &pDestNorm);
         }
 
-        OptimisedUtil::getImplementation()->softwareVertexSkinning(
-            pSrcPos, pDestPos,
-            pSrcNorm, pDestNorm,
-            pBlendWeight, pBlendIdx,
-            blendMatrices,
-            srcPosStride, destPosStride,
-            srcNormStride, destNormStride,
-            blendWeightStride, blendIdxStride,
-            numWeightsPerVertex,
-            targetVertexData->vertexCount);
+        if (pool && pool->getNumThreads() > 1)
+        {
+            SoftwareVertexSkinningTask task;
+            task.srcPos = pSrcPos;
+            task.srcNorm = pSrcNorm;
+            task.blendWeight = pBlendWeight;
+            task.destPos = pDestPos;
+            task.destNorm = pDestNorm;
+            task.blendIdx = pBlendIdx;
+            task.blendMatrices = blendMatrices;
+            task.srcPosStride = srcPosStride;
+            task.destPosStride = destPosStride;
+            task.srcNormStride = srcNormStride;
+            task.destNormStride = destNormStride;
+            task.blendWeightStride = blendWeightStride;
+            task.blendIdxStride = blendIdxStride;
+            task.numWeightsPerVertex = numWeightsPerVertex;
+            task.numVertices = targetVertexData->vertexCount;
+            pool->execute(&task);
+        }
+        else
+        {
+            OptimisedUtil::getImplementation()->softwareVertexSkinning(
+                pSrcPos, pDestPos,
+                pSrcNorm, pDestNorm,
+                pBlendWeight, pBlendIdx,
+                blendMatrices,
+                srcPosStride, destPosStride,
+                srcNormStride, destNormStride,
+                blendWeightStride, blendIdxStride,
+                numWeightsPerVertex,
+                targetVertexData->vertexCount);
+        }
 
         // Unlock source buffers
         srcPosBuf->unlock();
@@ -51,6 +51,7 @@ namespace Ogre
 
         mLoadOrder = 350.0f;
         mResourceType = "Mesh";
+        mConcurrentPrepare = true;
 
         ResourceGroupManager::getSingleton()._registerResourceManager(mResourceType, this);
 
@@ -54,11 +54,15 @@ namespace Ogre {
         
         // Note MUST be added in reverse order so latest is first in the list
 
+        mVersionData.push_back(OGRE_NEW MeshVersionData(
+            MESH_VERSION_2_0, "[MeshSerializer_v2.0]",
+            OGRE_NEW MeshSerializerImpl()));
+
         // This one is a little ugly, 1.10 is used for version 1.1 legacy meshes.
         // So bump up to 1.100
         mVersionData.push_back(OGRE_NEW MeshVersionData(
             MESH_VERSION_1_10, "[MeshSerializer_v1.100]", 
-            OGRE_NEW MeshSerializerImpl()));
+            OGRE_NEW MeshSerializerImpl_v1_10()));
 
         mVersionData.push_back(OGRE_NEW MeshVersionData(
             MESH_VERSION_1_8, "[MeshSerializer_v1.8]", 
@@ -48,7 +48,7 @@ namespace Ogre {
     MeshSerializerImpl::MeshSerializerImpl()
     {
         // Version number
-        mVersion = "[MeshSerializer_v1.100]";
+        mVersion = "[MeshSerializer_v2.0]";
     }
     //---------------------------------------------------------------------
     MeshSerializerImpl::~MeshSerializerImpl()
@@ -84,8 +84,11 @@ namespace Ogre {
 
         LogManager::getSingleton().logMessage("Writing mesh data...");
         pushInnerChunk(mStream);
+        writeBufferDataTable(pMesh);
         writeMesh(pMesh);
         popInnerChunk(mStream);
+        mBufferData.clear();
+        mBufferDataIndices.clear();
         LogManager::getSingleton().logMessage("Mesh data exported.");
 
         LogManager::getSingleton().logMessage("MeshSerializer export successful.");
@@ -108,6 +111,9 @@ namespace Ogre {
         {
             switch (streamID)
             {
+            case M_BUFFER_DATA:
+                readBufferDataTable(stream);
+                break;
             case M_MESH:
                 readMesh(stream, pMesh, listener);
                 break;
@@ -116,6 +122,9 @@ namespace Ogre {
             streamID = readChunk(stream);
         }
         popInnerChunk(stream);
+
+        mBufferData.clear();
+        mBufferDataStorage.reset();
     }
     //---------------------------------------------------------------------
     void MeshSerializerImpl::writeMesh(const Mesh* pMesh)
@@ -256,19 +265,7 @@ namespace Ogre {
         if (indexCount > 0)
         {
             // unsigned short* faceVertexIndices ((indexCount)
-            HardwareIndexBufferSharedPtr ibuf = s->indexData->indexBuffer;
-            void* pIdx = ibuf->lock(HardwareBuffer::HBL_READ_ONLY);
-            if (idx32bit)
-            {
-                unsigned int* pIdx32 = static_cast<unsigned int*>(pIdx);
-                writeInts(pIdx32, s->indexData->indexCount);
-            }
-            else
-            {
-                unsigned short* pIdx16 = static_cast<unsigned short*>(pIdx);
-                writeShorts(pIdx16, s->indexData->indexCount);
-            }
-            ibuf->unlock();
+            writeIndexBufferData(s->indexData->indexBuffer, indexCount);
         }
 
         pushInnerChunk(mStream);
@@ -452,7 +449,7 @@ namespace Ogre {
         {
             const HardwareVertexBufferSharedPtr& vbuf = vbi->second;
             size_t vbufSizeInBytes = vbuf->getVertexSize() * vertexData->vertexCount; // vbuf->getSizeInBytes() is too large for meshes prepared for shadow volumes
-            size = (MSTREAM_OVERHEAD_SIZE * 2) + (sizeof(unsigned short) * 2) + vbufSizeInBytes;
+            size = (MSTREAM_OVERHEAD_SIZE * 2) + (sizeof(unsigned short) * 2) + calcBufferDataSize(vbufSizeInBytes);
             writeChunkHeader(M_GEOMETRY_VERTEX_BUFFER,  size);
             // unsigned short bindIndex;    // Index to bind this buffer to
                 unsigned short tmp = vbi->first;
@@ -463,34 +460,174 @@ namespace Ogre {
                 pushInnerChunk(mStream);
                 {
             // Data
-            size = MSTREAM_OVERHEAD_SIZE + vbufSizeInBytes;
+            size = MSTREAM_OVERHEAD_SIZE + calcBufferDataSize(vbufSizeInBytes);
             writeChunkHeader(M_GEOMETRY_VERTEX_BUFFER_DATA, size);
-            void* pBuf = vbuf->lock(HardwareBuffer::HBL_READ_ONLY);
+            writeVertexBufferData(vertexData, vbi->first);
+        }
+                popInnerChunk(mStream);
+            }
+        }
+        popInnerChunk(mStream);
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl::addBufferData(HardwareBuffer* buf, size_t size,
+        const VertexData* vertexData, unsigned short bindIndex)
+    {
+        BufferDataIndexMap::iterator i = mBufferDataIndices.find(buf);
+        if (i != mBufferDataIndices.end())
+        {
+            // shared by several geometries or LOD levels, store the largest range once
+            BufferData& data = mBufferData[i->second];
+            data.size = std::max(data.size, size);
+            return;
+        }
+
+        BufferData data = {buf, vertexData, bindIndex, 0, 0, size};
+        mBufferDataIndices[buf] = static_cast<uint32>(mBufferData.size());
+        mBufferData.push_back(data);
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl::addVertexBufferData(const VertexData* vertexData)
+    {
+        const VertexBufferBinding::VertexBufferBindingMap& bindings =
+            vertexData->vertexBufferBinding->getBindings();
+        VertexBufferBinding::VertexBufferBindingMap::const_iterator vbi, vbiend;
+        vbiend = bindings.end();
+        for (vbi = bindings.begin(); vbi != vbiend; ++vbi)
+        {
+            const HardwareVertexBufferSharedPtr& vbuf = vbi->second;
+            addBufferData(vbuf.get(), vbuf->getVertexSize() * vertexData->vertexCount,
+                          vertexData, vbi->first);
+        }
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl::writeBufferDataTable(const Mesh* pMesh)
+    {
+        // Gather all buffers first, so their offsets are known up front
+        mBufferData.clear();
+        mBufferDataIndices.clear();
+        if (pMesh->sharedVertexData)
+            addVertexBufferData(pMesh->sharedVertexData);
+
+        for (unsigned short i = 0; i < pMesh->getNumSubMeshes(); ++i)
+        {
+            const SubMesh* s = pMesh->getSubMesh(i);
+            if (s->indexData->indexCount > 0)
+            {
+                const HardwareIndexBufferSharedPtr& ibuf = s->indexData->indexBuffer;
+                addBufferData(ibuf.get(), ibuf->getIndexSize() * s->indexData->indexCount);
+            }
+
+            if (!s->useSharedVertices)
+                addVertexBufferData(s->vertexData);
+
+#if !OGRE_NO_MESHLOD
+            for (ushort lod = 1; lod < pMesh->getNumLodLevels(); ++lod)
+            {
+                if (pMesh->_isManualLodLevel(lod))
+                    continue;
+
+                const HardwareIndexBufferSharedPtr& ibuf = s->mLodFaceList[lod - 1]->indexBuffer;
+                if (ibuf && ibuf->getNumIndexes() > 0)
+                    addBufferData(ibuf.get(), ibuf->getSizeInBytes());
+            }
+#endif
+        }
+
+        // Table, then the buffers. Offsets are relative to the chunk, but aligned
+        // within the stream so that a mapped file can be used in place
+        size_t start = mStream->tell();
+        size_t dataStart = MSTREAM_OVERHEAD_SIZE + sizeof(uint32) * (2 + 2 * mBufferData.size());
+        size_t offset = dataStart;
+        BufferDataList::iterator i, iend;
+        iend = mBufferData.end();
+        for (i = mBufferData.begin(); i != iend; ++i)
+        {
+            size_t alignedPos = (start + offset + BUFFER_DATA_ALIGNMENT - 1) /
+                BUFFER_DATA_ALIGNMENT * BUFFER_DATA_ALIGNMENT;
+            i->offset = alignedPos - start;
+            offset = i->offset + i->size;
+        }
+
+        writeChunkHeader(M_BUFFER_DATA, offset);
+
+        // unsigned int numBuffers, alignment
+        uint32 tmp[2] = {static_cast<uint32>(mBufferData.size()), BUFFER_DATA_ALIGNMENT};
+        writeInts(tmp, 2);
+        for (i = mBufferData.begin(); i != iend; ++i)
+        {
+            // unsigned int offset, size
+            tmp[0] = static_cast<uint32>(i->offset);
+            tmp[1] = static_cast<uint32>(i->size);
+            writeInts(tmp, 2);
+        }
+
+        const uchar padding[BUFFER_DATA_ALIGNMENT] = {0};
+        offset = dataStart;
+        for (i = mBufferData.begin(); i != iend; ++i)
+        {
+            writeData(padding, 1, i->offset - offset);
 
+            void* pBuf = i->buffer->lock(0, i->size, HardwareBuffer::HBL_READ_ONLY);
             if (mFlipEndian)
             {
                 // endian conversion
                 // Copy data
-                unsigned char* tempData = OGRE_ALLOC_T(unsigned char, vbufSizeInBytes, MEMCATEGORY_GEOMETRY);
-                memcpy(tempData, pBuf, vbufSizeInBytes);
-                flipToLittleEndian(
-                    tempData,
-                    vertexData->vertexCount,
-                    vbuf->getVertexSize(),
-                    vertexData->vertexDeclaration->findElementsBySource(vbi->first));
-                writeData(tempData, vbuf->getVertexSize(), vertexData->vertexCount);
+                unsigned char* tempData = OGRE_ALLOC_T(unsigned char, i->size, MEMCATEGORY_GEOMETRY);
+                memcpy(tempData, pBuf, i->size);
+                if (i->vertexData)
+                {
+                    size_t vertexSize = i->vertexData->vertexDeclaration->getVertexSize(i->bindIndex);
+                    flipToLittleEndian(
+                        tempData,
+                        i->size / vertexSize,
+                        vertexSize,
+                        i->vertexData->vertexDeclaration->findElementsBySource(i->bindIndex));
+                }
+                else
+                {
+                    size_t indexSize = static_cast<HardwareIndexBuffer*>(i->buffer)->getIndexSize();
+                    Serializer::flipToLittleEndian(tempData, indexSize, i->size / indexSize);
+                }
+                writeData(tempData, 1, i->size);
                 OGRE_FREE(tempData, MEMCATEGORY_GEOMETRY);
             }
             else
             {
-                writeData(pBuf, vbuf->getVertexSize(), vertexData->vertexCount);
+                writeData(pBuf, 1, i->size);
             }
-            vbuf->unlock();
+            i->buffer->unlock();
+
+            offset = i->offset + i->size;
         }
-                popInnerChunk(mStream);
-            }
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl::writeBufferDataRef(const HardwareBuffer* buf)
+    {
+        BufferDataIndexMap::const_iterator i = mBufferDataIndices.find(buf);
+        if (i == mBufferDataIndices.end())
+        {
+            OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, "Buffer is not in the buffer data table",
+                "MeshSerializerImpl::writeBufferDataRef");
         }
-        popInnerChunk(mStream);
+        // unsigned int bufferIndex
+        writeInts(&i->second, 1);
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl::writeVertexBufferData(const VertexData* vertexData, unsigned short bindIndex)
+    {
+        writeBufferDataRef(vertexData->vertexBufferBinding->getBuffer(bindIndex).get());
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl::writeIndexBufferData(const HardwareIndexBufferSharedPtr& ibuf, size_t indexCount)
+    {
+        writeBufferDataRef(ibuf.get());
+    }
+    //---------------------------------------------------------------------
+    size_t MeshSerializerImpl::calcBufferDataSize(size_t sizeInBytes)
+    {
+        // unsigned int bufferIndex
+        return sizeof(uint32);
     }
     //---------------------------------------------------------------------
     size_t MeshSerializerImpl::calcSubMeshNameTableSize(const Mesh* pMesh)
@@ -590,10 +727,11 @@ namespace Ogre {
         bool idx32bit = (pSub->indexData->indexBuffer &&
             pSub->indexData->indexBuffer->getType() == HardwareIndexBuffer::IT_32BIT);
         // unsigned int* / unsigned short* faceVertexIndices
-        if (idx32bit)
-            size += sizeof(unsigned int) * pSub->indexData->indexCount;
-        else
-            size += sizeof(unsigned short) * pSub->indexData->indexCount;
+        if (pSub->indexData->indexCount > 0)
+        {
+            size_t indexSize = idx32bit ? sizeof(unsigned int) : sizeof(unsigned short);
+            size += calcBufferDataSize(indexSize * pSub->indexData->indexCount);
+        }
 
         // Geometry
         if (!pSub->useSharedVertices)
@@ -661,7 +799,7 @@ namespace Ogre {
         for (vbi = bindings.begin(); vbi != vbiend; ++vbi)
         {
             const HardwareVertexBufferSharedPtr& vbuf = vbi->second;
-            size += vbuf->getVertexSize() * vertexData->vertexCount; // vbuf->getSizeInBytes() is too large for meshes prepared for shadow volumes
+            size += calcBufferDataSize(vbuf->getVertexSize() * vertexData->vertexCount); // vbuf->getSizeInBytes() is too large for meshes prepared for shadow volumes
         }
         return size;
     }
@@ -814,22 +952,139 @@ namespace Ogre {
             dest->vertexCount,
             pMesh->mVertexBufferUsage,
             pMesh->mVertexBufferShadowBuffer);
-        void* pBuf = vbuf->lock(HardwareBuffer::HBL_DISCARD);
-        stream->read(pBuf, dest->vertexCount * vertexSize);
+        readVertexBufferData(stream, dest, bindIndex, vbuf.get());
+
+        // Set binding
+        dest->vertexBufferBinding->setBinding(bindIndex, vbuf);
+        }
+        popInnerChunk(stream);
+
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl::readBufferDataTable(DataStreamPtr& stream)
+    {
+        size_t start = stream->tell() - MSTREAM_OVERHEAD_SIZE;
+        size_t end = start + mCurrentstreamLen;
+
+        // unsigned int numBuffers, alignment
+        uint32 tmp[2];
+        readInts(stream, tmp, 2);
+        size_t headerSize = MSTREAM_OVERHEAD_SIZE + sizeof(tmp);
+        if (mCurrentstreamLen < headerSize ||
+            tmp[0] > (mCurrentstreamLen - headerSize) / (2 * sizeof(uint32)))
+        {
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Invalid buffer data table in " + stream->getName(),
+                "MeshSerializerImpl::readBufferDataTable");
+        }
+        std::vector<uint32> table(tmp[0] * 2);
+        if (!table.empty())
+            readInts(stream, &table[0], table.size());
+        size_t dataStart = stream->tell();
+
+        // Use the buffers straight from memory if the stream is, otherwise read them in one go
+        const uchar* base;
+        size_t baseOffset;
+        MemoryDataStream* memStream = dynamic_cast<MemoryDataStream*>(stream.get());
+        if (memStream && end <= memStream->size())
+        {
+            base = memStream->getPtr();
+            baseOffset = 0;
+            stream->seek(end);
+        }
+        else
+        {
+            mBufferDataStorage.reset(OGRE_NEW MemoryDataStream(end - dataStart));
+            if (stream->read(mBufferDataStorage->getPtr(), end - dataStart) != end - dataStart)
+            {
+                OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Truncated buffer data in " + stream->getName(),
+                    "MeshSerializerImpl::readBufferDataTable");
+            }
+            base = mBufferDataStorage->getPtr();
+            baseOffset = dataStart;
+        }
 
+        mBufferData.resize(tmp[0]);
+        for (size_t i = 0; i < mBufferData.size(); ++i)
+        {
+            BufferData& data = mBufferData[i];
+            data.buffer = 0;
+            data.vertexData = 0;
+            data.bindIndex = 0;
+            // offsets are relative to the chunk
+            data.offset = start + table[i * 2];
+            data.size = table[i * 2 + 1];
+            if (data.offset < dataStart || data.offset > end || data.size > end - data.offset)
+            {
+                OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Buffer data out of range in " + stream->getName(),
+                    "MeshSerializerImpl::readBufferDataTable");
+            }
+            // pointer fixup
+            data.data = base + (data.offset - baseOffset);
+        }
+    }
+    //---------------------------------------------------------------------
+    const uchar* MeshSerializerImpl::readBufferDataRef(DataStreamPtr& stream, size_t size)
+    {
+        // unsigned int bufferIndex
+        uint32 index;
+        readInts(stream, &index, 1);
+        if (index >= mBufferData.size() || mBufferData[index].size < size)
+        {
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Invalid buffer data reference in " + stream->getName(),
+                "MeshSerializerImpl::readBufferDataRef");
+        }
+        return mBufferData[index].data;
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl::readVertexBufferData(DataStreamPtr& stream, VertexData* dest,
+        unsigned short bindIndex, HardwareVertexBuffer* vbuf)
+    {
+        size_t size = dest->vertexCount * vbuf->getVertexSize();
+        const uchar* data = readBufferDataRef(stream, size);
+        if (!mFlipEndian)
+        {
+            // laid out exactly like the buffer, no staging copy
+            vbuf->writeData(0, size, data, true);
+            return;
+        }
+
+        void* pBuf = vbuf->lock(HardwareBuffer::HBL_DISCARD);
+        memcpy(pBuf, data, size);
         // endian conversion for OSX
         flipFromLittleEndian(
             pBuf,
             dest->vertexCount,
-            vertexSize,
+            vbuf->getVertexSize(),
             dest->vertexDeclaration->findElementsBySource(bindIndex));
         vbuf->unlock();
-
-        // Set binding
-        dest->vertexBufferBinding->setBinding(bindIndex, vbuf);
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl::readIndexBufferData(DataStreamPtr& stream, HardwareIndexBuffer* ibuf, size_t indexCount)
+    {
+        size_t size = indexCount * ibuf->getIndexSize();
+        const uchar* data = readBufferDataRef(stream, size);
+        if (!mFlipEndian)
+        {
+            ibuf->writeData(0, size, data, true);
+            return;
         }
-        popInnerChunk(stream);
 
+        void* pIdx = ibuf->lock(HardwareBuffer::HBL_DISCARD);
+        memcpy(pIdx, data, size);
+        Serializer::flipFromLittleEndian(pIdx, ibuf->getIndexSize(), indexCount);
+        ibuf->unlock();
+    }
+    //---------------------------------------------------------------------
+    bool MeshSerializerImpl::readBufferDataInPlace(DataStreamPtr& stream, HardwareBuffer* buf, size_t size)
+    {
+        MemoryDataStream* memStream = dynamic_cast<MemoryDataStream*>(stream.get());
+        if (!memStream || mFlipEndian || memStream->tell() + size > memStream->size())
+            return false;
+
+        // no staging copy, the bytes go from the file mapping to the buffer
+        buf->writeData(0, size, memStream->getCurrentPtr(), true);
+        stream->skip(static_cast<long>(size));
+        return true;
     }
     //---------------------------------------------------------------------
     void MeshSerializerImpl::readSubMeshNameTable(DataStreamPtr& stream, Mesh* pMesh)
@@ -1010,13 +1265,6 @@ namespace Ogre {
                         sm->indexData->indexCount,
                         pMesh->mIndexBufferUsage,
                         pMesh->mIndexBufferShadowBuffer);
-                // unsigned int* faceVertexIndices
-                unsigned int* pIdx = static_cast<unsigned int*>(
-                    ibuf->lock(HardwareBuffer::HBL_DISCARD)
-                    );
-                readInts(stream, pIdx, sm->indexData->indexCount);
-                ibuf->unlock();
-
             }
             else // 16-bit
             {
@@ -1025,13 +1273,9 @@ namespace Ogre {
                         sm->indexData->indexCount,
                         pMesh->mIndexBufferUsage,
                         pMesh->mIndexBufferShadowBuffer);
-                // unsigned short* faceVertexIndices
-                unsigned short* pIdx = static_cast<unsigned short*>(
-                    ibuf->lock(HardwareBuffer::HBL_DISCARD)
-                    );
-                readShorts(stream, pIdx, sm->indexData->indexCount);
-                ibuf->unlock();
             }
+            // unsigned int* / unsigned short* faceVertexIndices
+            readIndexBufferData(stream, ibuf.get(), sm->indexData->indexCount);
         }
         sm->indexData->indexBuffer = ibuf;
 
@@ -1274,20 +1518,7 @@ namespace Ogre {
 
             if (bufIndexCount > 0)
             {
-                if (is32BitIndices)
-                {
-                    unsigned int* pIdx = static_cast<unsigned int*>(
-                        ibuf->lock(HardwareBuffer::HBL_READ_ONLY));
-                    writeInts(pIdx, bufIndexCount);
-                    ibuf->unlock();
-                }
-                else
-                {
-                    unsigned short* pIdx = static_cast<unsigned short*>(
-                        ibuf->lock(HardwareBuffer::HBL_READ_ONLY));
-                    writeShorts(pIdx, bufIndexCount);
-                    ibuf->unlock();
-                }
+                writeIndexBufferData(ibuf, bufIndexCount);
             }
         }
     }
@@ -1369,7 +1600,8 @@ namespace Ogre {
         if(bufferIndex == (unsigned int)-1) {
             size += sizeof(bool); // bool indexes32Bit
             size += sizeof(unsigned int); // unsigned int ibuf->getNumIndexes()
-            size += !ibuf ? 0 : static_cast<unsigned long>(ibuf->getIndexSize() * ibuf->getNumIndexes()); // faces
+            if (ibuf && ibuf->getNumIndexes() > 0)
+                size += calcBufferDataSize(ibuf->getIndexSize() * ibuf->getNumIndexes()); // faces
         }
         return size;
     }
@@ -1589,19 +1821,10 @@ namespace Ogre {
                 indexData->indexBuffer = pMesh->getHardwareBufferManager()->createIndexBuffer(
                     idx32Bit ? HardwareIndexBuffer::IT_32BIT : HardwareIndexBuffer::IT_16BIT,
                     buffIndexCount, pMesh->mIndexBufferUsage, pMesh->mIndexBufferShadowBuffer);
-                void* pIdx = static_cast<unsigned int*>(indexData->indexBuffer->lock(
-                    0, indexData->indexBuffer->getSizeInBytes(), HardwareBuffer::HBL_DISCARD));
 
                 // unsigned short*/int* faceIndexes;  ((v1, v2, v3) * numFaces)
-                if (idx32Bit)
-                {
-                    readInts(stream, (uint32*)pIdx, buffIndexCount);
-                }
-                else
-                {
-                    readShorts(stream, (uint16*)pIdx, buffIndexCount);
-                }
-                indexData->indexBuffer->unlock();
+                if (buffIndexCount > 0)
+                    readIndexBufferData(stream, indexData->indexBuffer.get(), buffIndexCount);
             }
         }
     }
@@ -2746,6 +2969,103 @@ namespace Ogre {
     }
 
 
+    //---------------------------------------------------------------------
+    //---------------------------------------------------------------------
+    //---------------------------------------------------------------------
+    MeshSerializerImpl_v1_10::MeshSerializerImpl_v1_10()
+    {
+        // Version number
+        mVersion = "[MeshSerializer_v1.100]";
+    }
+    //---------------------------------------------------------------------
+    MeshSerializerImpl_v1_10::~MeshSerializerImpl_v1_10()
+    {
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl_v1_10::writeBufferDataTable(const Mesh* pMesh)
+    {
+        // vertex and index data is stored inline
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl_v1_10::writeVertexBufferData(const VertexData* vertexData, unsigned short bindIndex)
+    {
+        const HardwareVertexBufferSharedPtr& vbuf = vertexData->vertexBufferBinding->getBuffer(bindIndex);
+        size_t vbufSizeInBytes = vbuf->getVertexSize() * vertexData->vertexCount;
+        void* pBuf = vbuf->lock(HardwareBuffer::HBL_READ_ONLY);
+
+        if (mFlipEndian)
+        {
+            // endian conversion
+            // Copy data
+            unsigned char* tempData = OGRE_ALLOC_T(unsigned char, vbufSizeInBytes, MEMCATEGORY_GEOMETRY);
+            memcpy(tempData, pBuf, vbufSizeInBytes);
+            flipToLittleEndian(
+                tempData,
+                vertexData->vertexCount,
+                vbuf->getVertexSize(),
+                vertexData->vertexDeclaration->findElementsBySource(bindIndex));
+            writeData(tempData, vbuf->getVertexSize(), vertexData->vertexCount);
+            OGRE_FREE(tempData, MEMCATEGORY_GEOMETRY);
+        }
+        else
+        {
+            writeData(pBuf, vbuf->getVertexSize(), vertexData->vertexCount);
+        }
+        vbuf->unlock();
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl_v1_10::writeIndexBufferData(const HardwareIndexBufferSharedPtr& ibuf, size_t indexCount)
+    {
+        void* pIdx = ibuf->lock(HardwareBuffer::HBL_READ_ONLY);
+        if (ibuf->getType() == HardwareIndexBuffer::IT_32BIT)
+        {
+            unsigned int* pIdx32 = static_cast<unsigned int*>(pIdx);
+            writeInts(pIdx32, indexCount);
+        }
+        else
+        {
+            unsigned short* pIdx16 = static_cast<unsigned short*>(pIdx);
+            writeShorts(pIdx16, indexCount);
+        }
+        ibuf->unlock();
+    }
+    //---------------------------------------------------------------------
+    size_t MeshSerializerImpl_v1_10::calcBufferDataSize(size_t sizeInBytes)
+    {
+        return sizeInBytes;
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl_v1_10::readVertexBufferData(DataStreamPtr& stream, VertexData* dest,
+        unsigned short bindIndex, HardwareVertexBuffer* vbuf)
+    {
+        size_t size = dest->vertexCount * vbuf->getVertexSize();
+        if (readBufferDataInPlace(stream, vbuf, size))
+            return;
+
+        void* pBuf = vbuf->lock(HardwareBuffer::HBL_DISCARD);
+        stream->read(pBuf, size);
+
+        // endian conversion for OSX
+        flipFromLittleEndian(
+            pBuf,
+            dest->vertexCount,
+            vbuf->getVertexSize(),
+            dest->vertexDeclaration->findElementsBySource(bindIndex));
+        vbuf->unlock();
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl_v1_10::readIndexBufferData(DataStreamPtr& stream, HardwareIndexBuffer* ibuf, size_t indexCount)
+    {
+        if (readBufferDataInPlace(stream, ibuf, indexCount * ibuf->getIndexSize()))
+            return;
+
+        void* pIdx = ibuf->lock(HardwareBuffer::HBL_DISCARD);
+        if (ibuf->getType() == HardwareIndexBuffer::IT_32BIT)
+            readInts(stream, static_cast<unsigned int*>(pIdx), indexCount);
+        else
+            readShorts(stream, static_cast<unsigned short*>(pIdx), indexCount);
+        ibuf->unlock();
+    }
     //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     //---------------------------------------------------------------------
@@ -53,8 +53,15 @@ namespace Ogre {
     will be alternative subclasses of this class to load older versions, whilst this class
     will remain to load the latest version.
 
+    @par
+    Vertex and index data is not stored inline with the geometry chunks, but in a
+    table of buffers at the start of the file (M_BUFFER_DATA), each one aligned and
+    laid out exactly as it is uploaded to the HardwareBuffer. When the file is in
+    memory (e.g. mapped), the buffers are uploaded straight from there, otherwise
+    they are read in one go.
+
      @note
-        This mesh format was used from Ogre v1.10.
+        This mesh format was used from Ogre v1.11.
 
     */
     class _OgrePrivate MeshSerializerImpl : public Serializer
@@ -83,8 +90,41 @@ namespace Ogre {
         void importMesh(DataStreamPtr& stream, Mesh* pDest, MeshSerializerListener *listener);
 
     protected:
+        /// Alignment of the buffers in M_BUFFER_DATA, relative to the start of the file
+        static const size_t BUFFER_DATA_ALIGNMENT = 16;
+
+        /// A buffer stored in the M_BUFFER_DATA chunk
+        struct BufferData
+        {
+            /// Exported buffer
+            HardwareBuffer* buffer;
+            /// Owner of an exported vertex buffer, for endian conversion
+            const VertexData* vertexData;
+            unsigned short bindIndex;
+            /// Start of an imported buffer in memory
+            const uchar* data;
+            size_t offset;
+            size_t size;
+        };
+        typedef std::vector<BufferData> BufferDataList;
+        typedef std::map<const HardwareBuffer*, uint32> BufferDataIndexMap;
+
+        BufferDataList mBufferData;
+        BufferDataIndexMap mBufferDataIndices;
+        /// Copy of the buffer data, if the imported stream is not in memory
+        MemoryDataStreamPtr mBufferDataStorage;
 
         // Internal methods
+        virtual void writeBufferDataTable(const Mesh* pMesh);
+        virtual void writeVertexBufferData(const VertexData* vertexData, unsigned short bindIndex);
+        virtual void writeIndexBufferData(const HardwareIndexBufferSharedPtr& ibuf, size_t indexCount);
+        /// Size of the data of a vertex or index buffer of the given size in the geometry chunks
+        virtual size_t calcBufferDataSize(size_t sizeInBytes);
+        void addBufferData(HardwareBuffer* buf, size_t size, const VertexData* vertexData = 0,
+                           unsigned short bindIndex = 0);
+        void addVertexBufferData(const VertexData* vertexData);
+        /// Writes the index of the buffer in M_BUFFER_DATA
+        void writeBufferDataRef(const HardwareBuffer* buf);
         virtual void writeSubMeshNameTable(const Mesh* pMesh);
         virtual void writeMesh(const Mesh* pMesh);
         virtual void writeSubMesh(const SubMesh* s);
@@ -151,6 +191,12 @@ namespace Ogre {
         virtual void readGeometryVertexDeclaration(DataStreamPtr& stream, Mesh* pMesh, VertexData* dest);
         virtual void readGeometryVertexElement(DataStreamPtr& stream, Mesh* pMesh, VertexData* dest);
         virtual void readGeometryVertexBuffer(DataStreamPtr& stream, Mesh* pMesh, VertexData* dest);
+        virtual void readBufferDataTable(DataStreamPtr& stream);
+        virtual void readVertexBufferData(DataStreamPtr& stream, VertexData* dest,
+            unsigned short bindIndex, HardwareVertexBuffer* vbuf);
+        virtual void readIndexBufferData(DataStreamPtr& stream, HardwareIndexBuffer* ibuf, size_t indexCount);
+        /// Reads a buffer index and returns the data of that buffer in M_BUFFER_DATA
+        const uchar* readBufferDataRef(DataStreamPtr& stream, size_t size);
 
         virtual void readSkeletonLink(DataStreamPtr& stream, Mesh* pMesh, MeshSerializerListener *listener);
         virtual void readMeshBoneAssignment(DataStreamPtr& stream, Mesh* pMesh);
@@ -174,6 +220,13 @@ namespace Ogre {
         virtual void readPoseKeyFrame(DataStreamPtr& stream, VertexAnimationTrack* track);
         virtual void readExtremes(DataStreamPtr& stream, Mesh *pMesh);
 
+        /** Uploads the next bytes of the stream to the whole buffer straight from
+            the stream's memory, if it is in memory (e.g. mapped) and needs no
+            endian conversion.
+        @return false if the data has to be read into the locked buffer instead
+        */
+        bool readBufferDataInPlace(DataStreamPtr& stream, HardwareBuffer* buf, size_t size);
+
 
         /// Flip an entire vertex buffer from little endian
         virtual void flipFromLittleEndian(void* pData, size_t vertexCount, size_t vertexSize, const VertexDeclaration::VertexElementList& elems);
@@ -190,10 +243,29 @@ namespace Ogre {
     };
 
 
+    /** Class for providing backwards-compatibility for loading version 1.100 of the .mesh format,
+     which stores vertex and index data inline.
+     This mesh format was used from Ogre v1.10.
+     */
+    class _OgrePrivate MeshSerializerImpl_v1_10 : public MeshSerializerImpl
+    {
+    public:
+        MeshSerializerImpl_v1_10();
+        ~MeshSerializerImpl_v1_10();
+    protected:
+        virtual void writeBufferDataTable(const Mesh* pMesh);
+        virtual void writeVertexBufferData(const VertexData* vertexData, unsigned short bindIndex);
+        virtual void writeIndexBufferData(const HardwareIndexBufferSharedPtr& ibuf, size_t indexCount);
+        virtual size_t calcBufferDataSize(size_t sizeInBytes);
+        virtual void readVertexBufferData(DataStreamPtr& stream, VertexData* dest,
+            unsigned short bindIndex, HardwareVertexBuffer* vbuf);
+        virtual void readIndexBufferData(DataStreamPtr& stream, HardwareIndexBuffer* ibuf, size_t indexCount);
+    };
+
     /** Class for providing backwards-compatibility for loading version 1.8 of the .mesh format. 
      This mesh format was used from Ogre v1.8.
      */
-    class _OgrePrivate MeshSerializerImpl_v1_8 : public MeshSerializerImpl
+    class _OgrePrivate MeshSerializerImpl_v1_8 : public MeshSerializerImpl_v1_10
     {
     public:
         MeshSerializerImpl_v1_8();
@@ -26,10 +26,12 @@ THE SOFTWARE.
 -----------------------------------------------------------------------------
 */
 #include "OgreStableHeaders.h"
+#include "OgreNodeTransformStore.h"
 
 namespace Ogre {
 
     Node::QueuedUpdates Node::msQueuedUpdates;
+    Node::QueuedUpdatesMutex Node::msQueuedUpdatesMutex;
     //-----------------------------------------------------------------------
     Node::Node() : Node(BLANKSTRING) {}
     //-----------------------------------------------------------------------
@@ -52,7 +54,10 @@ namespace Ogre {
         mInitialPosition(Vector3::ZERO),
         mInitialOrientation(Quaternion::IDENTITY),
         mInitialScale(Vector3::UNIT_SCALE),
-        mListener(0)
+        mListener(0),
+        mTransformStore(0),
+        mTransformLevel(~uint32(0)),
+        mTransformIndex(0)
     {
         needUpdate();
     }
@@ -66,10 +71,14 @@ namespace Ogre {
             mListener->nodeDestroyed(this);
         }
 
+        if (mTransformStore)
+            mTransformStore->_notifyNodeRemoved(this);
+
         removeAllChildren();
         if(mParent)
             mParent->removeChild(this);
 
+        OGRE_WQ_LOCK_MUTEX(msQueuedUpdatesMutex.mutex);
         if (mQueuedForUpdate)
         {
             // Erase from queued updates
@@ -92,6 +101,8 @@ namespace Ogre {
         bool different = (parent != mParent);
 
         mParent = parent;
+        if (mTransformStore && different)
+            mTransformStore->_notifyHierarchyChanged();
         // Request update from parent
         mParentNotified = false ;
         needUpdate();
@@ -194,6 +205,43 @@ namespace Ogre {
         }
     }
     //-----------------------------------------------------------------------
+    bool Node::_updateSelf(bool parentHasChanged, ChildNodeMap& children)
+    {
+        // same as _update, minus the recursion
+        mParentNotified = false;
+
+        if (mNeedParentUpdate || parentHasChanged)
+        {
+            _updateFromParent();
+        }
+
+        if (mNeedChildUpdate || parentHasChanged)
+        {
+            children.insert(children.end(), mChildren.begin(), mChildren.end());
+            return true;
+        }
+
+        children.insert(children.end(), mChildrenToUpdate.begin(), mChildrenToUpdate.end());
+        return false;
+    }
+    //-----------------------------------------------------------------------
+    void Node::_updateChildrenDone(void)
+    {
+        mChildrenToUpdate.clear();
+        mNeedChildUpdate = false;
+    }
+    //-----------------------------------------------------------------------
+    void Node::_setTransformStore(NodeTransformStore* store)
+    {
+        if (mTransformStore)
+            mTransformStore->_notifyNodeRemoved(this);
+
+        mTransformStore = store;
+
+        if (mTransformStore)
+            mTransformStore->_notifyHierarchyChanged();
+    }
+    //-----------------------------------------------------------------------
     void Node::_updateFromParent(void) const
     {
         updateFromParentImpl();
@@ -209,6 +257,18 @@ namespace Ogre {
     {
         mCachedTransformOutOfDate = true;
 
+#if !OGRE_NODE_INHERIT_TRANSFORM
+        // Already computed in packed form during the scene graph update
+        if (mTransformStore &&
+            mTransformStore->_getDerivedTransform(this, mDerivedOrientation, mDerivedPosition,
+                                                  mDerivedScale, mCachedTransform))
+        {
+            mCachedTransformOutOfDate = false;
+            mNeedParentUpdate = false;
+            return;
+        }
+#endif
+
         if (mParent)
         {
 #if OGRE_NODE_INHERIT_TRANSFORM
@@ -748,6 +808,9 @@ namespace Ogre {
         mNeedChildUpdate = true;
         mCachedTransformOutOfDate = true;
 
+        if (mTransformStore)
+            mTransformStore->_notifyNodeChanged(this);
+
         // Make sure we're not root and parent hasn't been notified before
         if (mParent && (!mParentNotified || forceParentUpdate))
         {
@@ -791,6 +854,8 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void Node::queueNeedUpdate(Node* n)
     {
+        // Node listeners run on several threads during a parallel scene graph update
+        OGRE_WQ_LOCK_MUTEX(msQueuedUpdatesMutex.mutex);
         // Don't queue the node more than once
         if (!n->mQueuedForUpdate)
         {
@@ -801,6 +866,7 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void Node::processQueuedUpdates(void)
     {
+        OGRE_WQ_LOCK_MUTEX(msQueuedUpdatesMutex.mutex);
         for (QueuedUpdates::iterator i = msQueuedUpdates.begin();
             i != msQueuedUpdates.end(); ++i)
         {
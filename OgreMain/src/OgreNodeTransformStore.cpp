@@ -0,0 +1,521 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgreNodeTransformStore.h"
+#include "OgreNode.h"
+#include "OgreWorkerThreadPool.h"
+#include "OgrePlatformInformation.h"
+
+#if __OGRE_HAVE_SSE
+// Keep this include last to avoid potential "xmmintrin.h" included by other
+// headers before __OGRE_SIMD_ALIGN_ATTRIBUTE is defined.
+#include "OgreSIMDHelper.h"
+#endif
+
+namespace Ogre
+{
+    namespace
+    {
+        const uint32 NOT_STORED = ~uint32(0);
+
+        /// Levels smaller than this are not worth splitting across threads
+        const size_t MIN_NODES_PER_THREAD = 1024;
+
+        class UpdateLevelTask : public UniformScalableTask
+        {
+            NodeTransformStore* mStore;
+            size_t mLevel;
+            size_t mSize;
+        public:
+            UpdateLevelTask(NodeTransformStore* store, size_t level, size_t size)
+                : mStore(store), mLevel(level), mSize(size) {}
+
+            void execute(size_t threadIdx, size_t numThreads)
+            {
+                // split on multiples of 4, so no SIMD group is shared
+                size_t groups = (mSize + 3) / 4;
+                size_t begin = groups * threadIdx / numThreads * 4;
+                size_t end = std::min(groups * (threadIdx + 1) / numThreads * 4, mSize);
+                if (begin < end)
+                    mStore->_updateRange(mLevel, begin, end);
+            }
+        };
+    }
+    //-----------------------------------------------------------------------
+    void NodeTransformStore::Level::clear(void)
+    {
+        for (int c = 0; c < NUM_COMPONENTS; ++c)
+        {
+            local[c].clear();
+            derived[c].clear();
+        }
+        for (int c = 0; c < 12; ++c)
+            transform[c].clear();
+        parent.clear();
+        flags.clear();
+        nodes.clear();
+    }
+    //-----------------------------------------------------------------------
+    void NodeTransformStore::Level::push_back(Node* node, uint32 parentIdx)
+    {
+        for (int c = 0; c < NUM_COMPONENTS; ++c)
+        {
+            local[c].push_back(0);
+            derived[c].push_back(0);
+        }
+        for (int c = 0; c < 12; ++c)
+            transform[c].push_back(0);
+        parent.push_back(parentIdx);
+        flags.push_back(0);
+        nodes.push_back(node);
+    }
+    //-----------------------------------------------------------------------
+    void NodeTransformStore::Level::pad(void)
+    {
+        size_t paddedSize = (nodes.size() + 3) & ~size_t(3);
+        for (int c = 0; c < NUM_COMPONENTS; ++c)
+        {
+            // identity transform, so padding lanes compute sane values
+            Real value = (c == ORIENTATION_W || c >= SCALE_X) ? 1 : 0;
+            local[c].resize(paddedSize, value);
+            derived[c].resize(paddedSize, value);
+        }
+        for (int c = 0; c < 12; ++c)
+            transform[c].resize(paddedSize, 0);
+        parent.resize(paddedSize, 0);
+        flags.resize(paddedSize, 0);
+    }
+    //-----------------------------------------------------------------------
+    NodeTransformStore::NodeTransformStore()
+        : mLayoutOutOfDate(true), mUpdating(false), mUseSSE(false)
+    {
+#if __OGRE_HAVE_SSE
+        mUseSSE = (PlatformInformation::getCpuFeatures() & PlatformInformation::CPU_FEATURE_SSE) != 0;
+#endif
+    }
+    //-----------------------------------------------------------------------
+    NodeTransformStore::~NodeTransformStore()
+    {
+        for (size_t l = 0; l < mLevels.size(); ++l)
+        {
+            Level& level = mLevels[l];
+            for (size_t i = 0; i < level.size(); ++i)
+            {
+                if (level.nodes[i])
+                    level.nodes[i]->mTransformLevel = NOT_STORED;
+            }
+        }
+    }
+    //-----------------------------------------------------------------------
+    size_t NodeTransformStore::getNumNodes(void) const
+    {
+        size_t numNodes = 0;
+        for (size_t l = 0; l < mLevels.size(); ++l)
+            numNodes += mLevels[l].size();
+        return numNodes;
+    }
+    //-----------------------------------------------------------------------
+    void NodeTransformStore::storeLocalTransform(size_t l, size_t idx, const Node* node)
+    {
+        Level& level = mLevels[l];
+        const Quaternion& orientation = node->getOrientation();
+        const Vector3& position = node->getPosition();
+        const Vector3& scale = node->getScale();
+
+        level.local[ORIENTATION_W][idx] = orientation.w;
+        level.local[ORIENTATION_X][idx] = orientation.x;
+        level.local[ORIENTATION_Y][idx] = orientation.y;
+        level.local[ORIENTATION_Z][idx] = orientation.z;
+        level.local[POSITION_X][idx] = position.x;
+        level.local[POSITION_Y][idx] = position.y;
+        level.local[POSITION_Z][idx] = position.z;
+        level.local[SCALE_X][idx] = scale.x;
+        level.local[SCALE_Y][idx] = scale.y;
+        level.local[SCALE_Z][idx] = scale.z;
+
+        // FLAG_UPDATED is cleared, so a node changing mid update recomputes its transform
+        level.flags[idx] = FLAG_DIRTY |
+                           (node->getInheritOrientation() ? FLAG_INHERIT_ORIENTATION : 0) |
+                           (node->getInheritScale() ? FLAG_INHERIT_SCALE : 0);
+    }
+    //-----------------------------------------------------------------------
+    void NodeTransformStore::storeFullTransform(Level& level, size_t idx)
+    {
+        Affine3 transform;
+        transform.makeTransform(
+            Vector3(level.derived[POSITION_X][idx], level.derived[POSITION_Y][idx], level.derived[POSITION_Z][idx]),
+            Vector3(level.derived[SCALE_X][idx], level.derived[SCALE_Y][idx], level.derived[SCALE_Z][idx]),
+            Quaternion(level.derived[ORIENTATION_W][idx], level.derived[ORIENTATION_X][idx],
+                       level.derived[ORIENTATION_Y][idx], level.derived[ORIENTATION_Z][idx]));
+
+        for (int r = 0; r < 3; ++r)
+        {
+            for (int c = 0; c < 4; ++c)
+                level.transform[r * 4 + c][idx] = transform[r][c];
+        }
+    }
+    //-----------------------------------------------------------------------
+    void NodeTransformStore::_notifyNodeChanged(const Node* node)
+    {
+        if (!mLayoutOutOfDate && node->mTransformLevel != NOT_STORED)
+            storeLocalTransform(node->mTransformLevel, node->mTransformIndex, node);
+    }
+    //-----------------------------------------------------------------------
+    void NodeTransformStore::_notifyNodeRemoved(Node* node)
+    {
+        if (node->mTransformLevel != NOT_STORED)
+        {
+            mLevels[node->mTransformLevel].nodes[node->mTransformIndex] = NULL;
+            node->mTransformLevel = NOT_STORED;
+        }
+        mLayoutOutOfDate = true;
+    }
+    //-----------------------------------------------------------------------
+    void NodeTransformStore::rebuildLayout(Node* root)
+    {
+        // forget about the previous layout, some nodes might not be below root anymore
+        for (size_t l = 0; l < mLevels.size(); ++l)
+        {
+            Level& level = mLevels[l];
+            for (size_t i = 0; i < level.size(); ++i)
+            {
+                if (level.nodes[i])
+                    level.nodes[i]->mTransformLevel = NOT_STORED;
+            }
+            level.clear();
+        }
+
+        size_t numLevels = 0;
+        if (mLevels.empty())
+            mLevels.resize(1);
+        mLevels[0].push_back(root, 0);
+        numLevels = 1;
+
+        // breadth first, so every level only references the one before
+        for (size_t l = 0; l < numLevels; ++l)
+        {
+            for (size_t i = 0; i < mLevels[l].size(); ++i)
+            {
+                Node* node = mLevels[l].nodes[i];
+                node->mTransformLevel = uint32(l);
+                node->mTransformIndex = uint32(i);
+                storeLocalTransform(l, i, node);
+
+                const Node::ChildNodeMap& children = node->getChildren();
+                for (size_t c = 0; c < children.size(); ++c)
+                {
+                    // nodes of another kind (e.g. TagPoint) keep computing their own transform
+                    if (children[c]->mTransformStore != this)
+                        continue;
+
+                    if (numLevels == l + 1)
+                    {
+                        if (mLevels.size() == numLevels)
+                            mLevels.push_back(Level());
+                        ++numLevels;
+                    }
+                    mLevels[l + 1].push_back(children[c], uint32(i));
+                }
+            }
+            mLevels[l].pad();
+        }
+        mLevels.resize(numLevels);
+        mLayoutOutOfDate = false;
+    }
+    //-----------------------------------------------------------------------
+    void NodeTransformStore::beginUpdate(Node* root, WorkerThreadPool* pool)
+    {
+        if (mLayoutOutOfDate || mLevels.empty() || mLevels[0].nodes[0] != root)
+            rebuildLayout(root);
+
+        for (size_t l = 0; l < mLevels.size(); ++l)
+        {
+            size_t size = mLevels[l].size();
+            if (pool && pool->getNumThreads() > 1 && size >= MIN_NODES_PER_THREAD * 2)
+            {
+                UpdateLevelTask task(this, l, size);
+                pool->execute(&task);
+            }
+            else
+            {
+                _updateRange(l, 0, size);
+            }
+        }
+
+        mUpdating = true;
+    }
+    //-----------------------------------------------------------------------
+    bool NodeTransformStore::_getDerivedTransform(const Node* node, Quaternion& orientation,
+                                                  Vector3& position, Vector3& scale,
+                                                  Affine3& fullTransform) const
+    {
+        if (!mUpdating || node->mTransformLevel == NOT_STORED)
+            return false;
+
+        const Level& level = mLevels[node->mTransformLevel];
+        size_t idx = node->mTransformIndex;
+        if (!(level.flags[idx] & FLAG_UPDATED))
+            return false;
+
+        orientation.w = level.derived[ORIENTATION_W][idx];
+        orientation.x = level.derived[ORIENTATION_X][idx];
+        orientation.y = level.derived[ORIENTATION_Y][idx];
+        orientation.z = level.derived[ORIENTATION_Z][idx];
+        position.x = level.derived[POSITION_X][idx];
+        position.y = level.derived[POSITION_Y][idx];
+        position.z = level.derived[POSITION_Z][idx];
+        scale.x = level.derived[SCALE_X][idx];
+        scale.y = level.derived[SCALE_Y][idx];
+        scale.z = level.derived[SCALE_Z][idx];
+        for (int r = 0; r < 3; ++r)
+        {
+            for (int c = 0; c < 4; ++c)
+                fullTransform[r][c] = level.transform[r * 4 + c][idx];
+        }
+        // no projection term
+        fullTransform[3][0] = 0; fullTransform[3][1] = 0; fullTransform[3][2] = 0; fullTransform[3][3] = 1;
+        return true;
+    }
+    //-----------------------------------------------------------------------
+    void NodeTransformStore::_updateRange(size_t l, size_t begin, size_t end)
+    {
+        Level& level = mLevels[l];
+
+        if (l == 0)
+        {
+            // root of the hierarchy, no parent
+            for (size_t i = begin; i < end; ++i)
+            {
+                bool updated = (level.flags[i] & FLAG_DIRTY) != 0;
+                level.flags[i] = (level.flags[i] & ~(FLAG_DIRTY | FLAG_UPDATED)) | (updated ? FLAG_UPDATED : 0);
+                if (updated)
+                {
+                    for (int c = 0; c < NUM_COMPONENTS; ++c)
+                        level.derived[c][i] = level.local[c][i];
+                    storeFullTransform(level, i);
+                }
+            }
+            return;
+        }
+
+        const Level& parents = mLevels[l - 1];
+
+        // The operations below are those of Node::updateFromParentImpl, in the same
+        // order, so the results are bit identical to the ones of the scalar path.
+        for (size_t i = begin; i < end; i += 4)
+        {
+            size_t count = std::min<size_t>(4, end - i);
+
+            // a node is updated if it changed itself or its parent was updated
+            int updatedMask = 0;
+            for (size_t j = 0; j < count; ++j)
+            {
+                uint8& flags = level.flags[i + j];
+                bool updated = (flags & FLAG_DIRTY) || (parents.flags[level.parent[i + j]] & FLAG_UPDATED);
+                flags = (flags & ~(FLAG_DIRTY | FLAG_UPDATED)) | (updated ? FLAG_UPDATED : 0);
+                updatedMask |= updated << j;
+            }
+
+            if (!updatedMask)
+                continue;
+
+            // derived transform with inheritance, one column per node
+            OGRE_SIMD_ALIGNED_DECL(Real, inherited[NUM_COMPONENTS][4]);
+
+#if __OGRE_HAVE_SSE
+            if (mUseSSE)
+            {
+                __m128 parent[NUM_COMPONENTS];
+                const uint32* p = &level.parent[i];
+                for (int c = 0; c < NUM_COMPONENTS; ++c)
+                {
+                    const Real* src = &parents.derived[c][0];
+                    parent[c] = _mm_set_ps(src[p[3]], src[p[2]], src[p[1]], src[p[0]]);
+                }
+
+                __m128 local[NUM_COMPONENTS];
+                for (int c = 0; c < NUM_COMPONENTS; ++c)
+                    local[c] = _mm_loadu_ps(&level.local[c][i]);
+
+                const __m128& pw = parent[ORIENTATION_W];
+                const __m128& px = parent[ORIENTATION_X];
+                const __m128& py = parent[ORIENTATION_Y];
+                const __m128& pz = parent[ORIENTATION_Z];
+                const __m128& lw = local[ORIENTATION_W];
+                const __m128& lx = local[ORIENTATION_X];
+                const __m128& ly = local[ORIENTATION_Y];
+                const __m128& lz = local[ORIENTATION_Z];
+
+                // orientation, Quaternion::operator*
+                _mm_store_ps(inherited[ORIENTATION_W], _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(
+                    _mm_mul_ps(pw, lw), _mm_mul_ps(px, lx)), _mm_mul_ps(py, ly)), _mm_mul_ps(pz, lz)));
+                _mm_store_ps(inherited[ORIENTATION_X], _mm_sub_ps(_mm_add_ps(_mm_add_ps(
+                    _mm_mul_ps(pw, lx), _mm_mul_ps(px, lw)), _mm_mul_ps(py, lz)), _mm_mul_ps(pz, ly)));
+                _mm_store_ps(inherited[ORIENTATION_Y], _mm_sub_ps(_mm_add_ps(_mm_add_ps(
+                    _mm_mul_ps(pw, ly), _mm_mul_ps(py, lw)), _mm_mul_ps(pz, lx)), _mm_mul_ps(px, lz)));
+                _mm_store_ps(inherited[ORIENTATION_Z], _mm_sub_ps(_mm_add_ps(_mm_add_ps(
+                    _mm_mul_ps(pw, lz), _mm_mul_ps(pz, lw)), _mm_mul_ps(px, ly)), _mm_mul_ps(py, lx)));
+
+                // scale
+                for (int c = SCALE_X; c <= SCALE_Z; ++c)
+                    _mm_store_ps(inherited[c], _mm_mul_ps(parent[c], local[c]));
+
+                // position, parent orientation * (parent scale * position), Quaternion::operator*(Vector3)
+                __m128 vx = _mm_mul_ps(parent[SCALE_X], local[POSITION_X]);
+                __m128 vy = _mm_mul_ps(parent[SCALE_Y], local[POSITION_Y]);
+                __m128 vz = _mm_mul_ps(parent[SCALE_Z], local[POSITION_Z]);
+
+                __m128 uvx = _mm_sub_ps(_mm_mul_ps(py, vz), _mm_mul_ps(pz, vy));
+                __m128 uvy = _mm_sub_ps(_mm_mul_ps(pz, vx), _mm_mul_ps(px, vz));
+                __m128 uvz = _mm_sub_ps(_mm_mul_ps(px, vy), _mm_mul_ps(py, vx));
+
+                __m128 uuvx = _mm_sub_ps(_mm_mul_ps(py, uvz), _mm_mul_ps(pz, uvy));
+                __m128 uuvy = _mm_sub_ps(_mm_mul_ps(pz, uvx), _mm_mul_ps(px, uvz));
+                __m128 uuvz = _mm_sub_ps(_mm_mul_ps(px, uvy), _mm_mul_ps(py, uvx));
+
+                __m128 two = _mm_set1_ps(2.0f);
+                __m128 w2 = _mm_mul_ps(two, pw);
+                uvx = _mm_mul_ps(uvx, w2);
+                uvy = _mm_mul_ps(uvy, w2);
+                uvz = _mm_mul_ps(uvz, w2);
+                uuvx = _mm_mul_ps(uuvx, two);
+                uuvy = _mm_mul_ps(uuvy, two);
+                uuvz = _mm_mul_ps(uuvz, two);
+
+                _mm_store_ps(inherited[POSITION_X],
+                             _mm_add_ps(_mm_add_ps(_mm_add_ps(vx, uvx), uuvx), parent[POSITION_X]));
+                _mm_store_ps(inherited[POSITION_Y],
+                             _mm_add_ps(_mm_add_ps(_mm_add_ps(vy, uvy), uuvy), parent[POSITION_Y]));
+                _mm_store_ps(inherited[POSITION_Z],
+                             _mm_add_ps(_mm_add_ps(_mm_add_ps(vz, uvz), uuvz), parent[POSITION_Z]));
+            }
+            else
+#endif
+            {
+                for (size_t j = 0; j < count; ++j)
+                {
+                    size_t p = level.parent[i + j];
+                    Quaternion parentOrientation(
+                        parents.derived[ORIENTATION_W][p], parents.derived[ORIENTATION_X][p],
+                        parents.derived[ORIENTATION_Y][p], parents.derived[ORIENTATION_Z][p]);
+                    Vector3 parentScale(parents.derived[SCALE_X][p], parents.derived[SCALE_Y][p],
+                                        parents.derived[SCALE_Z][p]);
+                    Vector3 parentPosition(parents.derived[POSITION_X][p], parents.derived[POSITION_Y][p],
+                                           parents.derived[POSITION_Z][p]);
+
+                    Quaternion orientation = parentOrientation * Quaternion(
+                        level.local[ORIENTATION_W][i + j], level.local[ORIENTATION_X][i + j],
+                        level.local[ORIENTATION_Y][i + j], level.local[ORIENTATION_Z][i + j]);
+                    Vector3 scale = parentScale * Vector3(level.local[SCALE_X][i + j],
+                                                          level.local[SCALE_Y][i + j],
+                                                          level.local[SCALE_Z][i + j]);
+                    Vector3 position = parentOrientation * (parentScale * Vector3(
+                        level.local[POSITION_X][i + j], level.local[POSITION_Y][i + j],
+                        level.local[POSITION_Z][i + j]));
+                    position += parentPosition;
+
+                    inherited[ORIENTATION_W][j] = orientation.w;
+                    inherited[ORIENTATION_X][j] = orientation.x;
+                    inherited[ORIENTATION_Y][j] = orientation.y;
+                    inherited[ORIENTATION_Z][j] = orientation.z;
+                    inherited[POSITION_X][j] = position.x;
+                    inherited[POSITION_Y][j] = position.y;
+                    inherited[POSITION_Z][j] = position.z;
+                    inherited[SCALE_X][j] = scale.x;
+                    inherited[SCALE_Y][j] = scale.y;
+                    inherited[SCALE_Z][j] = scale.z;
+                }
+            }
+
+            // write back the updated nodes, honouring disabled inheritance
+            for (size_t j = 0; j < count; ++j)
+            {
+                if (!(updatedMask & (1 << j)))
+                    continue;
+
+                size_t idx = i + j;
+                uint8 flags = level.flags[idx];
+                for (int c = POSITION_X; c <= POSITION_Z; ++c)
+                    level.derived[c][idx] = inherited[c][j];
+                for (int c = ORIENTATION_W; c <= ORIENTATION_Z; ++c)
+                    level.derived[c][idx] = (flags & FLAG_INHERIT_ORIENTATION) ? inherited[c][j] : level.local[c][idx];
+                for (int c = SCALE_X; c <= SCALE_Z; ++c)
+                    level.derived[c][idx] = (flags & FLAG_INHERIT_SCALE) ? inherited[c][j] : level.local[c][idx];
+            }
+
+            // full transform, as Affine3::makeTransform. Recomputing the lanes which were not
+            // updated is harmless, they get the exact same result again.
+#if __OGRE_HAVE_SSE
+            if (mUseSSE)
+            {
+                __m128 w = _mm_loadu_ps(&level.derived[ORIENTATION_W][i]);
+                __m128 x = _mm_loadu_ps(&level.derived[ORIENTATION_X][i]);
+                __m128 y = _mm_loadu_ps(&level.derived[ORIENTATION_Y][i]);
+                __m128 z = _mm_loadu_ps(&level.derived[ORIENTATION_Z][i]);
+                __m128 sx = _mm_loadu_ps(&level.derived[SCALE_X][i]);
+                __m128 sy = _mm_loadu_ps(&level.derived[SCALE_Y][i]);
+                __m128 sz = _mm_loadu_ps(&level.derived[SCALE_Z][i]);
+                __m128 one = _mm_set1_ps(1.0f);
+
+                // Quaternion::ToRotationMatrix
+                __m128 tx = _mm_add_ps(x, x);
+                __m128 ty = _mm_add_ps(y, y);
+                __m128 tz = _mm_add_ps(z, z);
+                __m128 twx = _mm_mul_ps(tx, w);
+                __m128 twy = _mm_mul_ps(ty, w);
+                __m128 twz = _mm_mul_ps(tz, w);
+                __m128 txx = _mm_mul_ps(tx, x);
+                __m128 txy = _mm_mul_ps(ty, x);
+                __m128 txz = _mm_mul_ps(tz, x);
+                __m128 tyy = _mm_mul_ps(ty, y);
+                __m128 tyz = _mm_mul_ps(tz, y);
+                __m128 tzz = _mm_mul_ps(tz, z);
+
+                std::vector<Real>* m = level.transform;
+                _mm_storeu_ps(&m[0][i], _mm_mul_ps(sx, _mm_sub_ps(one, _mm_add_ps(tyy, tzz))));
+                _mm_storeu_ps(&m[1][i], _mm_mul_ps(sy, _mm_sub_ps(txy, twz)));
+                _mm_storeu_ps(&m[2][i], _mm_mul_ps(sz, _mm_add_ps(txz, twy)));
+                _mm_storeu_ps(&m[3][i], _mm_loadu_ps(&level.derived[POSITION_X][i]));
+                _mm_storeu_ps(&m[4][i], _mm_mul_ps(sx, _mm_add_ps(txy, twz)));
+                _mm_storeu_ps(&m[5][i], _mm_mul_ps(sy, _mm_sub_ps(one, _mm_add_ps(txx, tzz))));
+                _mm_storeu_ps(&m[6][i], _mm_mul_ps(sz, _mm_sub_ps(tyz, twx)));
+                _mm_storeu_ps(&m[7][i], _mm_loadu_ps(&level.derived[POSITION_Y][i]));
+                _mm_storeu_ps(&m[8][i], _mm_mul_ps(sx, _mm_sub_ps(txz, twy)));
+                _mm_storeu_ps(&m[9][i], _mm_mul_ps(sy, _mm_add_ps(tyz, twx)));
+                _mm_storeu_ps(&m[10][i], _mm_mul_ps(sz, _mm_sub_ps(one, _mm_add_ps(txx, tyy))));
+                _mm_storeu_ps(&m[11][i], _mm_loadu_ps(&level.derived[POSITION_Z][i]));
+            }
+            else
+#endif
+            {
+                for (size_t j = 0; j < count; ++j)
+                    storeFullTransform(level, i + j);
+            }
+        }
+    }
+}
@@ -37,6 +37,9 @@ namespace Ogre {
     extern OptimisedUtil* _getOptimisedUtilGeneral(void);
 #if __OGRE_HAVE_SSE
     extern OptimisedUtil* _getOptimisedUtilSSE(void);
+#if __OGRE_HAVE_AVX2
+    extern OptimisedUtil* _getOptimisedUtilAVX2(void);
+#endif
 //#elif __OGRE_HAVE_NEON
 //    extern OptimisedUtil* _getOptimisedUtilNEON(void);
 //#elif __OGRE_HAVE_VFP
@@ -80,6 +83,9 @@ namespace Ogre {
             IMPL_DEFAULT,
 #if __OGRE_HAVE_SSE
             IMPL_SSE,
+#if __OGRE_HAVE_AVX2
+            IMPL_AVX2,
+#endif
 //#elif __OGRE_HAVE_NEON
 //            IMPL_NEON,
 //#elif __OGRE_HAVE_VFP
@@ -131,6 +137,13 @@ namespace Ogre {
             {
                 mOptimisedUtils.push_back(_getOptimisedUtilSSE());
             }
+#if __OGRE_HAVE_AVX2
+            const uint avx2_fma = PlatformInformation::CPU_FEATURE_AVX2 | PlatformInformation::CPU_FEATURE_FMA;
+            if ((PlatformInformation::getCpuFeatures() & avx2_fma) == avx2_fma)
+            {
+                mOptimisedUtils.push_back(_getOptimisedUtilAVX2());
+            }
+#endif
 //#elif __OGRE_HAVE_VFP
 //            if (PlatformInformation::getCpuFeatures() & PlatformInformation::CPU_FEATURE_VFP)
 //            {
@@ -342,6 +355,36 @@ namespace Ogre {
             ++index;    // So we can put break point here even if in release build
         }
 
+        /// @copydoc OptimisedUtil::calculateBoxVisibility
+        virtual void calculateBoxVisibility(
+            const Plane* planes,
+            size_t numPlanes,
+            const float* centres,
+            const float* halfSizes,
+            uint32* visibility,
+            size_t numBoxes)
+        {
+            static ProfileItems results;
+            static size_t index;
+            index = Root::getSingleton().getNextFrameNumber() % mOptimisedUtils.size();
+            OptimisedUtil* impl = mOptimisedUtils[index];
+            ProfileItem& profile = results[index];
+
+            profile.begin();
+            impl->calculateBoxVisibility(
+                planes,
+                numPlanes,
+                centres,
+                halfSizes,
+                visibility,
+                numBoxes);
+            profile.end();
+
+            // You can put break point here while running test application, to
+            // watch profile results.
+            ++index;    // So we can put break point here even if in release build
+        }
+
     };
 #endif // __DO_PROFILE__
 
@@ -396,6 +439,14 @@ namespace Ogre {
 #else   // !__DO_PROFILE__
 
 #if __OGRE_HAVE_SSE
+#if __OGRE_HAVE_AVX2
+        const uint avx2_fma = PlatformInformation::CPU_FEATURE_AVX2 | PlatformInformation::CPU_FEATURE_FMA;
+        if ((PlatformInformation::getCpuFeatures() & avx2_fma) == avx2_fma)
+        {
+            return _getOptimisedUtilAVX2();
+        }
+        else
+#endif
         if (PlatformInformation::getCpuFeatures() & PlatformInformation::CPU_FEATURE_SSE)
         {
             return _getOptimisedUtilSSE();
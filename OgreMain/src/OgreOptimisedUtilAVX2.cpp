@@ -0,0 +1,413 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgreOptimisedUtil.h"
+
+
+#if __OGRE_HAVE_AVX2
+
+// Should keep this includes at latest, see OgreOptimisedUtilSSE.cpp
+#include "OgreSIMDHelper.h"
+#include <immintrin.h>
+
+//-------------------------------------------------------------------------
+//
+// Unlike the SSE implementation, this file is compiled with the default
+// instruction set. Only the functions marked with __OGRE_AVX2_TARGET may
+// use AVX2 and FMA instructions, and they must only be reached after
+// PlatformInformation reported both features.
+//
+// The 3x4 blend matrix is collapsed with one 256 bits FMA for rows 0 and 1
+// plus one 128 bits FMA for row 2 per weight, where the SSE version needs
+// three multiplies and three adds. The collapsed matrices of two vertices
+// are then applied at once, one vertex in each 128 bits lane.
+//
+//-------------------------------------------------------------------------
+
+#if OGRE_COMPILER == OGRE_COMPILER_GNUC || OGRE_COMPILER == OGRE_COMPILER_CLANG
+#define __OGRE_AVX2_TARGET __attribute__((target("avx2,fma")))
+#else
+#define __OGRE_AVX2_TARGET
+#endif
+
+namespace Ogre {
+
+    // Defined in OgreOptimisedUtilSSE.cpp
+    extern OptimisedUtil* _getOptimisedUtilSSE(void);
+
+//-------------------------------------------------------------------------
+// Local classes
+//-------------------------------------------------------------------------
+
+    /** AVX2 / FMA implementation of OptimisedUtil.
+    @remarks
+        Only softwareVertexSkinning benefits from the wider registers, the
+        other functions are forwarded to the SSE implementation.
+    @note
+        Don't use this class directly, use OptimisedUtil instead.
+    */
+    class _OgrePrivate OptimisedUtilAVX2 : public OptimisedUtil
+    {
+    protected:
+        /// The SSE implementation, used for everything but skinning
+        OptimisedUtil* mSSE;
+
+    public:
+        /// Constructor
+        OptimisedUtilAVX2(void) : mSSE(_getOptimisedUtilSSE()) {}
+
+        /// @copydoc OptimisedUtil::softwareVertexSkinning
+        virtual void __OGRE_SIMD_ALIGN_ATTRIBUTE softwareVertexSkinning(
+            const float *srcPosPtr, float *destPosPtr,
+            const float *srcNormPtr, float *destNormPtr,
+            const float *blendWeightPtr, const unsigned char* blendIndexPtr,
+            const Affine3* const* blendMatrices,
+            size_t srcPosStride, size_t destPosStride,
+            size_t srcNormStride, size_t destNormStride,
+            size_t blendWeightStride, size_t blendIndexStride,
+            size_t numWeightsPerVertex,
+            size_t numVertices);
+
+        /// @copydoc OptimisedUtil::softwareVertexMorph
+        virtual void softwareVertexMorph(
+            Real t,
+            const float *srcPos1, const float *srcPos2,
+            float *dstPos,
+            size_t pos1VSize, size_t pos2VSize, size_t dstVSize,
+            size_t numVertices,
+            bool morphNormals)
+        {
+            mSSE->softwareVertexMorph(
+                t,
+                srcPos1, srcPos2,
+                dstPos,
+                pos1VSize, pos2VSize, dstVSize,
+                numVertices,
+                morphNormals);
+        }
+
+        /// @copydoc OptimisedUtil::concatenateAffineMatrices
+        virtual void concatenateAffineMatrices(
+            const Affine3& baseMatrix,
+            const Affine3* srcMatrices,
+            Affine3* dstMatrices,
+            size_t numMatrices)
+        {
+            mSSE->concatenateAffineMatrices(
+                baseMatrix,
+                srcMatrices,
+                dstMatrices,
+                numMatrices);
+        }
+
+        /// @copydoc OptimisedUtil::calculateFaceNormals
+        virtual void calculateFaceNormals(
+            const float *positions,
+            const EdgeData::Triangle *triangles,
+            Vector4 *faceNormals,
+            size_t numTriangles)
+        {
+            mSSE->calculateFaceNormals(
+                positions,
+                triangles,
+                faceNormals,
+                numTriangles);
+        }
+
+        /// @copydoc OptimisedUtil::calculateLightFacing
+        virtual void calculateLightFacing(
+            const Vector4& lightPos,
+            const Vector4* faceNormals,
+            char* lightFacings,
+            size_t numFaces)
+        {
+            mSSE->calculateLightFacing(
+                lightPos,
+                faceNormals,
+                lightFacings,
+                numFaces);
+        }
+
+        /// @copydoc OptimisedUtil::extrudeVertices
+        virtual void extrudeVertices(
+            const Vector4& lightPos,
+            Real extrudeDist,
+            const float* srcPositions,
+            float* destPositions,
+            size_t numVertices)
+        {
+            mSSE->extrudeVertices(
+                lightPos,
+                extrudeDist,
+                srcPositions,
+                destPositions,
+                numVertices);
+        }
+
+        /// @copydoc OptimisedUtil::calculateBoxVisibility
+        virtual void calculateBoxVisibility(
+            const Plane* planes,
+            size_t numPlanes,
+            const float* centres,
+            const float* halfSizes,
+            uint32* visibility,
+            size_t numBoxes)
+        {
+            mSSE->calculateBoxVisibility(
+                planes,
+                numPlanes,
+                centres,
+                halfSizes,
+                visibility,
+                numBoxes);
+        }
+    };
+    //---------------------------------------------------------------------
+    // Loads three floats as (x, y, z, 0), without reading past them.
+    static OGRE_FORCE_INLINE __OGRE_AVX2_TARGET __m128 _loadVector3(const float* p)
+    {
+        __m128 xy = _mm_castpd_ps(_mm_load_sd((const double*)p));
+        return _mm_movelh_ps(xy, _mm_load_ss(p + 2));
+    }
+    //---------------------------------------------------------------------
+    // Stores the x, y and z components, without writing past them.
+    static OGRE_FORCE_INLINE __OGRE_AVX2_TARGET void _storeVector3(float* p, __m128 v)
+    {
+        _mm_storel_pi((__m64*)p, v);
+        _mm_store_ss(p + 2, _mm_movehl_ps(v, v));
+    }
+    //---------------------------------------------------------------------
+    // Collapses the weighted matrices of a vertex, rows 0 and 1 in m01, row 2 in m2.
+    template <size_t NumWeights>
+    static OGRE_FORCE_INLINE __OGRE_AVX2_TARGET void _collapseMatrices(
+        __m256& m01, __m128& m2,
+        const float* pBlendWeight, const unsigned char* pBlendIndex,
+        const Affine3* const* blendMatrices,
+        size_t numWeights)
+    {
+        const Affine3& mat = *blendMatrices[pBlendIndex[0]];
+        __m256 weight = _mm256_broadcast_ss(pBlendWeight);
+        m01 = _mm256_mul_ps(weight, _mm256_loadu_ps(mat[0]));
+        m2 = _mm_mul_ps(_mm256_castps256_ps128(weight), _mm_loadu_ps(mat[2]));
+        for (size_t w = 1; w < (NumWeights ? NumWeights : numWeights); ++w)
+        {
+            const Affine3& matw = *blendMatrices[pBlendIndex[w]];
+            weight = _mm256_broadcast_ss(pBlendWeight + w);
+            m01 = _mm256_fmadd_ps(weight, _mm256_loadu_ps(matw[0]), m01);
+            m2 = _mm_fmadd_ps(_mm256_castps256_ps128(weight), _mm_loadu_ps(matw[2]), m2);
+        }
+    }
+    //---------------------------------------------------------------------
+    // Loads the vectors of two vertices, the first one in the low lane.
+    static OGRE_FORCE_INLINE __OGRE_AVX2_TARGET __m256 _loadTwoVector3(const float* p, size_t stride)
+    {
+        return _mm256_insertf128_ps(
+            _mm256_castps128_ps256(_loadVector3(p)), _loadVector3(rawOffsetPointer(p, stride)), 1);
+    }
+    //---------------------------------------------------------------------
+    // Skinning of the given vertices, NumWeights is 0 if only known at run-time.
+    //
+    // Works on two vertices at a time, one in each 128 bits lane. Dot products
+    // of the rows with position and normal are summed horizontally, where the
+    // pairs are chosen so the position comes out as x y z nx, saving shuffles.
+    template <size_t NumWeights, bool BlendNormals>
+    static __OGRE_AVX2_TARGET void softwareVertexSkinning_AVX2(
+        const float *pSrcPos, float *pDestPos,
+        const float *pSrcNorm, float *pDestNorm,
+        const float *pBlendWeight, const unsigned char* pBlendIndex,
+        const Affine3* const* blendMatrices,
+        size_t srcPosStride, size_t destPosStride,
+        size_t srcNormStride, size_t destNormStride,
+        size_t blendWeightStride, size_t blendIndexStride,
+        size_t numWeightsPerVertex,
+        size_t numVertices)
+    {
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 half = _mm256_set1_ps(0.5f);
+        const __m256 threeHalves = _mm256_set1_ps(1.5f);
+
+        for (size_t i = 0; i < numVertices; i += 2)
+        {
+            // The last vertex of an odd count is blended twice, but stored once
+            const bool hasSecond = i + 1 < numVertices;
+            const size_t second = hasSecond ? 1 : 0;
+
+            __m256 mA01, mB01;
+            __m128 mA2, mB2;
+            _collapseMatrices<NumWeights>(mA01, mA2,
+                pBlendWeight, pBlendIndex, blendMatrices, numWeightsPerVertex);
+            _collapseMatrices<NumWeights>(mB01, mB2,
+                rawOffsetPointer(pBlendWeight, second * blendWeightStride),
+                rawOffsetPointer(pBlendIndex, second * blendIndexStride),
+                blendMatrices, numWeightsPerVertex);
+
+            // Rows of both vertices
+            __m256 r0 = _mm256_permute2f128_ps(mA01, mB01, 0x20);
+            __m256 r1 = _mm256_permute2f128_ps(mA01, mB01, 0x31);
+            __m256 r2 = _mm256_insertf128_ps(_mm256_castps128_ps256(mA2), mB2, 1);
+
+            // Positions with w = 1
+            __m256 pos = _mm256_blend_ps(_loadTwoVector3(pSrcPos, second * srcPosStride), one, 0x88);
+            __m256 xy = _mm256_hadd_ps(_mm256_mul_ps(r0, pos), _mm256_mul_ps(r1, pos));
+            __m256 z = _mm256_mul_ps(r2, pos);
+            __m256 result;
+
+            if (BlendNormals)
+            {
+                // Normals have w = 0
+                __m256 norm = _loadTwoVector3(pSrcNorm, second * srcNormStride);
+                __m256 nyz = _mm256_hadd_ps(_mm256_mul_ps(r1, norm), _mm256_mul_ps(r2, norm));
+                result = _mm256_hadd_ps(xy, _mm256_hadd_ps(z, _mm256_mul_ps(r0, norm)));   // x y z nx
+                nyz = _mm256_hadd_ps(nyz, nyz);                                             // ny nz ny nz
+                norm = _mm256_shuffle_ps(result, nyz, _MM_SHUFFLE(1, 0, 3, 3));             // nx nx ny nz
+
+                // Normalise with one Newton-Raphson step on the reciprocal square root,
+                // leaving zero length normals untouched like Vector3::normalise
+                __m256 lengthSquared = _mm256_dp_ps(norm, norm, 0xEE);
+                __m256 rsqrt = _mm256_rsqrt_ps(lengthSquared);
+                __m256 halfLengthSquared = _mm256_mul_ps(lengthSquared, half);
+                rsqrt = _mm256_mul_ps(rsqrt,
+                    _mm256_fnmadd_ps(_mm256_mul_ps(halfLengthSquared, rsqrt), rsqrt, threeHalves));
+                norm = _mm256_blendv_ps(norm, _mm256_mul_ps(norm, rsqrt), _mm256_cmp_ps(lengthSquared, zero, _CMP_GT_OQ));
+                norm = _mm256_permute_ps(norm, _MM_SHUFFLE(3, 3, 2, 1));                   // nx ny nz nz
+
+                _storeVector3(pDestNorm, _mm256_castps256_ps128(norm));
+                if (hasSecond)
+                    _storeVector3(rawOffsetPointer(pDestNorm, destNormStride), _mm256_extractf128_ps(norm, 1));
+
+                advanceRawPointer(pSrcNorm, 2 * srcNormStride);
+                advanceRawPointer(pDestNorm, 2 * destNormStride);
+            }
+            else
+            {
+                result = _mm256_hadd_ps(xy, _mm256_hadd_ps(z, z));                        // x y z z
+            }
+
+            _storeVector3(pDestPos, _mm256_castps256_ps128(result));
+            if (hasSecond)
+                _storeVector3(rawOffsetPointer(pDestPos, destPosStride), _mm256_extractf128_ps(result, 1));
+
+            advanceRawPointer(pSrcPos, 2 * srcPosStride);
+            advanceRawPointer(pDestPos, 2 * destPosStride);
+            advanceRawPointer(pBlendWeight, 2 * blendWeightStride);
+            advanceRawPointer(pBlendIndex, 2 * blendIndexStride);
+        }
+    }
+    //---------------------------------------------------------------------
+    template <bool BlendNormals>
+    static __OGRE_AVX2_TARGET void softwareVertexSkinning_AVX2_Weights(
+        const float *pSrcPos, float *pDestPos,
+        const float *pSrcNorm, float *pDestNorm,
+        const float *pBlendWeight, const unsigned char* pBlendIndex,
+        const Affine3* const* blendMatrices,
+        size_t srcPosStride, size_t destPosStride,
+        size_t srcNormStride, size_t destNormStride,
+        size_t blendWeightStride, size_t blendIndexStride,
+        size_t numWeightsPerVertex,
+        size_t numVertices)
+    {
+#define __OGRE_SKINNING_AVX2_ARGS                               \
+        pSrcPos, pDestPos, pSrcNorm, pDestNorm,                 \
+        pBlendWeight, pBlendIndex, blendMatrices,               \
+        srcPosStride, destPosStride,                            \
+        srcNormStride, destNormStride,                          \
+        blendWeightStride, blendIndexStride,                    \
+        numWeightsPerVertex, numVertices
+
+        // Unroll the weight loop for the common cases
+        switch (numWeightsPerVertex)
+        {
+        case 1:
+            softwareVertexSkinning_AVX2<1, BlendNormals>(__OGRE_SKINNING_AVX2_ARGS);
+            break;
+        case 2:
+            softwareVertexSkinning_AVX2<2, BlendNormals>(__OGRE_SKINNING_AVX2_ARGS);
+            break;
+        case 3:
+            softwareVertexSkinning_AVX2<3, BlendNormals>(__OGRE_SKINNING_AVX2_ARGS);
+            break;
+        case 4:
+            softwareVertexSkinning_AVX2<4, BlendNormals>(__OGRE_SKINNING_AVX2_ARGS);
+            break;
+        default:
+            softwareVertexSkinning_AVX2<0, BlendNormals>(__OGRE_SKINNING_AVX2_ARGS);
+            break;
+        }
+
+#undef __OGRE_SKINNING_AVX2_ARGS
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilAVX2::softwareVertexSkinning(
+        const float *pSrcPos, float *pDestPos,
+        const float *pSrcNorm, float *pDestNorm,
+        const float *pBlendWeight, const unsigned char* pBlendIndex,
+        const Affine3* const* blendMatrices,
+        size_t srcPosStride, size_t destPosStride,
+        size_t srcNormStride, size_t destNormStride,
+        size_t blendWeightStride, size_t blendIndexStride,
+        size_t numWeightsPerVertex,
+        size_t numVertices)
+    {
+        if (!numVertices || !numWeightsPerVertex)
+            return;
+
+        if (pSrcNorm)
+        {
+            softwareVertexSkinning_AVX2_Weights<true>(
+                pSrcPos, pDestPos, pSrcNorm, pDestNorm,
+                pBlendWeight, pBlendIndex, blendMatrices,
+                srcPosStride, destPosStride,
+                srcNormStride, destNormStride,
+                blendWeightStride, blendIndexStride,
+                numWeightsPerVertex, numVertices);
+        }
+        else
+        {
+            softwareVertexSkinning_AVX2_Weights<false>(
+                pSrcPos, pDestPos, pSrcNorm, pDestNorm,
+                pBlendWeight, pBlendIndex, blendMatrices,
+                srcPosStride, destPosStride,
+                srcNormStride, destNormStride,
+                blendWeightStride, blendIndexStride,
+                numWeightsPerVertex, numVertices);
+        }
+    }
+    //---------------------------------------------------------------------
+    //---------------------------------------------------------------------
+    //---------------------------------------------------------------------
+    extern OptimisedUtil* _getOptimisedUtilAVX2(void);
+    extern OptimisedUtil* _getOptimisedUtilAVX2(void)
+    {
+        static OptimisedUtilAVX2 msOptimisedUtilAVX2;
+        return &msOptimisedUtilAVX2;
+    }
+
+}
+
+#endif // __OGRE_HAVE_AVX2
@@ -28,6 +28,7 @@ THE SOFTWARE.
 #include "OgreStableHeaders.h"
 
 #include "OgreOptimisedUtil.h"
+#include "OgrePlane.h"
 
 namespace Ogre {
 
@@ -91,6 +92,15 @@ namespace Ogre {
             const float* srcPositions,
             float* destPositions,
             size_t numVertices);
+
+        /// @copydoc OptimisedUtil::calculateBoxVisibility
+        virtual void calculateBoxVisibility(
+            const Plane* planes,
+            size_t numPlanes,
+            const float* centres,
+            const float* halfSizes,
+            uint32* visibility,
+            size_t numBoxes);
     };
     //---------------------------------------------------------------------
     //---------------------------------------------------------------------
@@ -364,6 +374,34 @@ namespace Ogre {
         }
     }
     //---------------------------------------------------------------------
+    void OptimisedUtilGeneral::calculateBoxVisibility(
+        const Plane* planes,
+        size_t numPlanes,
+        const float* centres,
+        const float* halfSizes,
+        uint32* visibility,
+        size_t numBoxes)
+    {
+        memset(visibility, 0, (numBoxes + 31) / 32 * sizeof(uint32));
+
+        for (size_t i = 0; i < numBoxes; ++i)
+        {
+            Vector3 centre(centres[0], centres[1], centres[2]);
+            Vector3 halfSize(halfSizes[0], halfSizes[1], halfSizes[2]);
+            centres += 3;
+            halfSizes += 3;
+
+            bool visible = true;
+            for (size_t plane = 0; plane < numPlanes && visible; ++plane)
+            {
+                visible = planes[plane].getSide(centre, halfSize) != Plane::NEGATIVE_SIDE;
+            }
+
+            if (visible)
+                visibility[i / 32] |= 1u << (i % 32);
+        }
+    }
+    //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     extern OptimisedUtil* _getOptimisedUtilGeneral(void);
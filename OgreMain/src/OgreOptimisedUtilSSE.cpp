@@ -27,6 +27,7 @@ THE SOFTWARE.
 */
 #include "OgreStableHeaders.h"
 #include "OgreOptimisedUtil.h"
+#include "OgrePlane.h"
 
 
 #if __OGRE_HAVE_SSE
@@ -129,6 +130,15 @@ namespace Ogre {
             const float* srcPositions,
             float* destPositions,
             size_t numVertices);
+
+        /// @copydoc OptimisedUtil::calculateBoxVisibility
+        virtual void __OGRE_SIMD_ALIGN_ATTRIBUTE calculateBoxVisibility(
+            const Plane* planes,
+            size_t numPlanes,
+            const float* centres,
+            const float* halfSizes,
+            uint32* visibility,
+            size_t numBoxes);
     };
 
 #if defined(__OGRE_SIMD_ALIGN_STACK)
@@ -268,6 +278,26 @@ namespace Ogre {
                 destPositions,
                 numVertices);
         }
+
+        /// @copydoc OptimisedUtil::calculateBoxVisibility
+        virtual void calculateBoxVisibility(
+            const Plane* planes,
+            size_t numPlanes,
+            const float* centres,
+            const float* halfSizes,
+            uint32* visibility,
+            size_t numBoxes)
+        {
+            __OGRE_SIMD_ALIGN_STACK();
+
+            mImpl->calculateBoxVisibility(
+                planes,
+                numPlanes,
+                centres,
+                halfSizes,
+                visibility,
+                numBoxes);
+        }
     };
 #endif  // !defined(__OGRE_SIMD_ALIGN_STACK)
 
@@ -2130,6 +2160,95 @@ namespace Ogre {
         }
     }
     //---------------------------------------------------------------------
+    /** Test four boxes against the planes, returns the 4-bits mask of the
+        boxes which are completely on the negative side of any plane.
+    */
+    static OGRE_FORCE_INLINE int __cullFourBoxes(
+        const Plane* planes, size_t numPlanes,
+        const float* centres, const float* halfSizes)
+    {
+        // Load centres and half-sizes, unaligned
+        __m128 cx = _mm_loadu_ps(centres + 0);
+        __m128 cy = _mm_loadu_ps(centres + 4);
+        __m128 cz = _mm_loadu_ps(centres + 8);
+        __m128 hx = _mm_loadu_ps(halfSizes + 0);
+        __m128 hy = _mm_loadu_ps(halfSizes + 4);
+        __m128 hz = _mm_loadu_ps(halfSizes + 8);
+
+        // Rearrange to x0 x1 x2 x3, y0 y1 y2 y3, z0 z1 z2 z3
+        __MM_TRANSPOSE4x3_PS(cx, cy, cz);
+        __MM_TRANSPOSE4x3_PS(hx, hy, hz);
+
+        __m128 zero = _mm_setzero_ps();
+        __m128 outside = zero;
+        for (size_t i = 0; i < numPlanes; ++i)
+        {
+            __m128 nx = _mm_load_ps1(&planes[i].normal.x);
+            __m128 ny = _mm_load_ps1(&planes[i].normal.y);
+            __m128 nz = _mm_load_ps1(&planes[i].normal.z);
+
+            // Same evaluation order as Plane::getSide, so results are identical
+            __m128 dist = _mm_add_ps(
+                __MM_ACCUM3_PS(_mm_mul_ps(nx, cx), _mm_mul_ps(ny, cy), _mm_mul_ps(nz, cz)),
+                _mm_load_ps1(&planes[i].d));
+
+            __m128 px = _mm_mul_ps(nx, hx);
+            __m128 py = _mm_mul_ps(ny, hy);
+            __m128 pz = _mm_mul_ps(nz, hz);
+            __m128 maxAbsDist = __MM_ACCUM3_PS(
+                _mm_max_ps(px, _mm_sub_ps(zero, px)),
+                _mm_max_ps(py, _mm_sub_ps(zero, py)),
+                _mm_max_ps(pz, _mm_sub_ps(zero, pz)));
+
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(dist, _mm_sub_ps(zero, maxAbsDist)));
+
+            // All four culled already?
+            if (_mm_movemask_ps(outside) == 0xf)
+                break;
+        }
+
+        return _mm_movemask_ps(outside);
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilSSE::calculateBoxVisibility(
+        const Plane* planes,
+        size_t numPlanes,
+        const float* centres,
+        const float* halfSizes,
+        uint32* visibility,
+        size_t numBoxes)
+    {
+        __OGRE_CHECK_STACK_ALIGNED_FOR_SSE();
+
+        memset(visibility, 0, (numBoxes + 31) / 32 * sizeof(uint32));
+
+        // Four boxes per-iteration, 8 iterations fill a bitmask element
+        size_t numIterations = numBoxes / 4;
+        for (size_t i = 0; i < numIterations; ++i)
+        {
+            uint32 visible = ~__cullFourBoxes(planes, numPlanes, centres, halfSizes) & 0xf;
+            visibility[i / 8] |= visible << (i % 8 * 4);
+            centres += 12;
+            halfSizes += 12;
+        }
+
+        // Dealing with remaining boxes, padded with copies of the last one
+        size_t numRemaining = numBoxes & 3;
+        if (numRemaining)
+        {
+            float c[12], h[12];
+            for (size_t i = 0; i < 4; ++i)
+            {
+                size_t src = std::min(i, numRemaining - 1) * 3;
+                memcpy(c + i * 3, centres + src, sizeof(float) * 3);
+                memcpy(h + i * 3, halfSizes + src, sizeof(float) * 3);
+            }
+
+            uint32 visible = ~__cullFourBoxes(planes, numPlanes, c, h) & ((1u << numRemaining) - 1);
+            visibility[numIterations / 8] |= visible << (numIterations % 8 * 4);
+        }
+    }
+    //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     extern OptimisedUtil* _getOptimisedUtilSSE(void);
@@ -50,8 +50,6 @@ namespace Ogre {
     ParticleSystem::CmdIterationInterval ParticleSystem::msIterationIntervalCmd;
     ParticleSystem::CmdNonvisibleTimeout ParticleSystem::msNonvisibleTimeoutCmd;
 
-    RadixSort<ParticleSystem::ActiveParticleList, Particle*, float> ParticleSystem::mRadixSorter;
-
     Real ParticleSystem::msDefaultIterationInterval = 0;
     Real ParticleSystem::msDefaultNonvisibleTimeout = 0;
 
@@ -1202,6 +1200,10 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void ParticleSystem::_sortParticles(Camera* cam)
     {
+        // One sorter per thread, so that systems can be sorted concurrently without
+        // each of them holding the counters and scratch buffers of its own
+        static thread_local RadixSort<ActiveParticleList, Particle*, float> radixSorter;
+
         if (mRenderer)
         {
             SortMode sortMode = mRenderer->_getSortMode();
@@ -1213,7 +1215,7 @@ namespace Ogre {
                     // transform the camera direction into local space
                     camDir = mParentNode->convertWorldToLocalDirection(camDir, false);
                 }
-                mRadixSorter.sort(mActiveParticles, SortByDirectionFunctor(- camDir));
+                radixSorter.sort(mActiveParticles, SortByDirectionFunctor(- camDir));
             }
             else if (sortMode == SM_DISTANCE)
             {
@@ -1223,7 +1225,7 @@ namespace Ogre {
                     // transform the camera position into local space
                     camPos = mParentNode->convertWorldToLocalPosition(camPos);
                 }
-                mRadixSorter.sort(mActiveParticles, SortByDistanceFunctor(camPos));
+                radixSorter.sort(mActiveParticles, SortByDistanceFunctor(camPos));
             }
         }
     }
@@ -147,11 +147,12 @@ namespace Ogre {
 
     //---------------------------------------------------------------------
     // Performs CPUID instruction with 'query', fill the results, and return value of eax.
+    // The sub-leaf (ecx) is always 0, as needed by the structured extended features query.
     static uint _performCpuid(int query, CpuidResult& result)
     {
 #if OGRE_COMPILER == OGRE_COMPILER_MSVC
         int CPUInfo[4];
-        __cpuid(CPUInfo, query);
+        __cpuidex(CPUInfo, query, 0);
         result._eax = CPUInfo[0];
         result._ebx = CPUInfo[1];
         result._ecx = CPUInfo[2];
@@ -161,7 +162,7 @@ namespace Ogre {
         #if OGRE_ARCH_TYPE == OGRE_ARCHITECTURE_64
         __asm__
         (
-            "cpuid": "=a" (result._eax), "=b" (result._ebx), "=c" (result._ecx), "=d" (result._edx) : "a" (query)
+            "cpuid": "=a" (result._eax), "=b" (result._ebx), "=c" (result._ecx), "=d" (result._edx) : "a" (query), "c" (0)
         );
         #else
         __asm__
@@ -171,7 +172,7 @@ namespace Ogre {
             "movl   %%ebx, %%edi    \n\t"
             "popl   %%ebx           \n\t"
             : "=a" (result._eax), "=D" (result._ebx), "=c" (result._ecx), "=d" (result._edx)
-            : "a" (query)
+            : "a" (query), "c" (0)
         );
        #endif // OGRE_ARCHITECTURE_64
         return result._eax;
@@ -186,6 +187,24 @@ namespace Ogre {
 #pragma warning(pop)
 #endif
 
+    //---------------------------------------------------------------------
+    // Reads the extended control register XCR0, which tells which register
+    // states the OS saves on context switches. Only valid if CPUID reports OSXSAVE.
+    static uint _getExtendedControlRegister(void)
+    {
+#if OGRE_COMPILER == OGRE_COMPILER_MSVC && _MSC_VER >= 1600
+        return (uint)_xgetbv(0);
+#elif (OGRE_COMPILER == OGRE_COMPILER_GNUC || OGRE_COMPILER == OGRE_COMPILER_CLANG) && OGRE_PLATFORM != OGRE_PLATFORM_EMSCRIPTEN
+        uint eax, edx;
+        // xgetbv, spelled out for assemblers which don't know it
+        __asm__ (".byte 0x0f, 0x01, 0xd0" : "=a" (eax), "=d" (edx) : "c" (0));
+        return eax;
+#else
+        // TODO: Supports other compiler, assumed the AVX state is not saved
+        return 0;
+#endif
+    }
+
     //---------------------------------------------------------------------
     // Detect whether or not os support Streaming SIMD Extension.
 #if OGRE_COMPILER == OGRE_COMPILER_GNUC || OGRE_COMPILER == OGRE_COMPILER_CLANG
@@ -267,6 +286,7 @@ namespace Ogre {
 
 #define CPUID_FUNC_VENDOR_ID                 0x0
 #define CPUID_FUNC_STANDARD_FEATURES         0x1
+#define CPUID_FUNC_STRUCTURED_EXTENDED_FEATURES 0x7
 #define CPUID_FUNC_EXTENSION_QUERY           0x80000000
 #define CPUID_FUNC_EXTENDED_FEATURES         0x80000001
 #define CPUID_FUNC_ADVANCED_POWER_MANAGEMENT 0x80000007
@@ -282,6 +302,13 @@ namespace Ogre {
 #define CPUID_STD_SSE3              (1<<0)      // ECX[0]  - Bit 0 of standard function 1 indicate SSE3 supported
 #define CPUID_STD_SSE41             (1<<19)     // ECX[19] - Bit 0 of standard function 1 indicate SSE41 supported
 #define CPUID_STD_SSE42             (1<<20)     // ECX[20] - Bit 0 of standard function 1 indicate SSE42 supported
+#define CPUID_STD_FMA               (1<<12)     // ECX[12] - Bit 12 of standard function 1 indicate FMA3 supported
+#define CPUID_STD_OSXSAVE           (1<<27)     // ECX[27] - Bit 27 of standard function 1 indicate the OS enabled XGETBV
+#define CPUID_STD_AVX               (1<<28)     // ECX[28] - Bit 28 of standard function 1 indicate AVX supported
+
+#define CPUID_SEF_AVX2              (1<<5)      // EBX[5]  - Bit 5 of structured extended function 7 indicate AVX2 supported
+
+#define XCR0_SSE_AVX_STATE          0x6         // XCR0[2:1] - The OS saves both the XMM and the YMM registers
 
 #define CPUID_FAMILY_ID_MASK        0x0F00      // EAX[11:8] - Bit 11 thru 8 contains family  processor id
 #define CPUID_EXT_FAMILY_ID_MASK    0x0F00000   // EAX[23:20] - Bit 23 thru 20 contains extended family processor id
@@ -302,7 +329,8 @@ namespace Ogre {
             CpuidResult result;
 
             // Has standard feature ?
-            if (_performCpuid(CPUID_FUNC_VENDOR_ID, result))
+            const uint maxStandardFunctionSupport = _performCpuid(CPUID_FUNC_VENDOR_ID, result);
+            if (maxStandardFunctionSupport)
             {
                 // Check vendor strings
                 if (memcmp(&result._ebx, "GenuineIntel", 12) == 0)
@@ -398,6 +426,25 @@ namespace Ogre {
                             features |= PlatformInformation::CPU_FEATURE_INVARIANT_TSC;
                     }
                 }
+
+                // AVX is reported the same way by all vendors, but is only usable
+                // if the OS saves the YMM registers as well
+                _performCpuid(CPUID_FUNC_STANDARD_FEATURES, result);
+                if ((result._ecx & CPUID_STD_OSXSAVE) && (result._ecx & CPUID_STD_AVX) &&
+                    (_getExtendedControlRegister() & XCR0_SSE_AVX_STATE) == XCR0_SSE_AVX_STATE)
+                {
+                    features |= PlatformInformation::CPU_FEATURE_AVX;
+                    if (result._ecx & CPUID_STD_FMA)
+                        features |= PlatformInformation::CPU_FEATURE_FMA;
+
+                    if (maxStandardFunctionSupport >= CPUID_FUNC_STRUCTURED_EXTENDED_FEATURES)
+                    {
+                        _performCpuid(CPUID_FUNC_STRUCTURED_EXTENDED_FEATURES, result);
+
+                        if (result._ebx & CPUID_SEF_AVX2)
+                            features |= PlatformInformation::CPU_FEATURE_AVX2;
+                    }
+                }
             }
         }
 
@@ -413,7 +460,10 @@ namespace Ogre {
             | PlatformInformation::CPU_FEATURE_SSE2
             | PlatformInformation::CPU_FEATURE_SSE3
             | PlatformInformation::CPU_FEATURE_SSE41
-            | PlatformInformation::CPU_FEATURE_SSE42;
+            | PlatformInformation::CPU_FEATURE_SSE42
+            | PlatformInformation::CPU_FEATURE_AVX
+            | PlatformInformation::CPU_FEATURE_AVX2
+            | PlatformInformation::CPU_FEATURE_FMA;
 
         if ((features & sse_features) && !_checkOperatingSystemSupportSSE())
         {
@@ -687,6 +737,12 @@ namespace Ogre {
                 " *        SSE41: " + StringConverter::toString(hasCpuFeature(CPU_FEATURE_SSE41), true));
             pLog->logMessage(
                 " *        SSE42: " + StringConverter::toString(hasCpuFeature(CPU_FEATURE_SSE42), true));
+            pLog->logMessage(
+                " *          AVX: " + StringConverter::toString(hasCpuFeature(CPU_FEATURE_AVX), true));
+            pLog->logMessage(
+                " *         AVX2: " + StringConverter::toString(hasCpuFeature(CPU_FEATURE_AVX2), true));
+            pLog->logMessage(
+                " *          FMA: " + StringConverter::toString(hasCpuFeature(CPU_FEATURE_FMA), true));
             pLog->logMessage(
                 " *          MMX: " + StringConverter::toString(hasCpuFeature(CPU_FEATURE_MMX), true));
             pLog->logMessage(
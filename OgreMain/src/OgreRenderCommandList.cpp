@@ -0,0 +1,201 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgreRenderCommandList.h"
+#include "OgreRenderSystem.h"
+
+namespace Ogre {
+    //-----------------------------------------------------------------------
+    RenderCommandList::RenderCommandList() : mNumParameters(0)
+    {
+    }
+    //-----------------------------------------------------------------------
+    RenderCommandList::~RenderCommandList()
+    {
+    }
+    //-----------------------------------------------------------------------
+    void RenderCommandList::bindGpuProgram(GpuProgram* prg)
+    {
+        Command cmd;
+        cmd.type = RCT_BIND_GPU_PROGRAM;
+        cmd.program = prg;
+        mCommands.push_back(cmd);
+    }
+    //-----------------------------------------------------------------------
+    void RenderCommandList::unbindGpuProgram(GpuProgramType gptype)
+    {
+        Command cmd;
+        cmd.type = RCT_UNBIND_GPU_PROGRAM;
+        cmd.programType = gptype;
+        mCommands.push_back(cmd);
+    }
+    //-----------------------------------------------------------------------
+    void RenderCommandList::bindGpuProgramParameters(GpuProgramType gptype,
+                                                     const GpuProgramParametersSharedPtr& params,
+                                                     uint16 variabilityMask)
+    {
+        // reuse the copies of earlier recordings, so only their contents are copied
+        if (mNumParameters == mParameters.size())
+            mParameters.push_back(GpuProgramParametersSharedPtr(OGRE_NEW GpuProgramParameters(*params)));
+        else
+            *mParameters[mNumParameters] = *params;
+
+        // the copy uploads what binding the original would have, which counts as bound now
+        mParameters[mNumParameters]->_copyDirtyRanges(*params);
+        params->_clearDirtyRanges();
+
+        Command cmd;
+        cmd.type = RCT_BIND_GPU_PROGRAM_PARAMETERS;
+        cmd.parameters.type = gptype;
+        cmd.parameters.variabilityMask = variabilityMask;
+        cmd.parameters.index = static_cast<uint32>(mNumParameters++);
+        mCommands.push_back(cmd);
+    }
+    //-----------------------------------------------------------------------
+    void RenderCommandList::setWorldMatrix(const Matrix4& m)
+    {
+        Command cmd;
+        cmd.type = RCT_SET_WORLD_MATRIX;
+        cmd.index = static_cast<uint32>(mMatrices.size());
+        mMatrices.push_back(m);
+        mCommands.push_back(cmd);
+    }
+    //-----------------------------------------------------------------------
+    void RenderCommandList::setCullingMode(CullingMode mode)
+    {
+        Command cmd;
+        cmd.type = RCT_SET_CULLING_MODE;
+        cmd.cullingMode = mode;
+        mCommands.push_back(cmd);
+    }
+    //-----------------------------------------------------------------------
+    void RenderCommandList::setDepthBufferParams(bool depthTest, bool depthWrite, CompareFunction depthFunction)
+    {
+        Command cmd;
+        cmd.type = RCT_SET_DEPTH_BUFFER_PARAMS;
+        cmd.depth.test = depthTest;
+        cmd.depth.write = depthWrite;
+        cmd.depth.function = depthFunction;
+        mCommands.push_back(cmd);
+    }
+    //-----------------------------------------------------------------------
+    void RenderCommandList::setSceneBlending(SceneBlendFactor sourceFactor, SceneBlendFactor destFactor,
+                                             SceneBlendFactor sourceFactorAlpha, SceneBlendFactor destFactorAlpha,
+                                             SceneBlendOperation op, SceneBlendOperation alphaOp)
+    {
+        Command cmd;
+        cmd.type = RCT_SET_SCENE_BLENDING;
+        cmd.blending.source = sourceFactor;
+        cmd.blending.dest = destFactor;
+        cmd.blending.sourceAlpha = sourceFactorAlpha;
+        cmd.blending.destAlpha = destFactorAlpha;
+        cmd.blending.op = op;
+        cmd.blending.alphaOp = alphaOp;
+        mCommands.push_back(cmd);
+    }
+    //-----------------------------------------------------------------------
+    void RenderCommandList::setPolygonMode(PolygonMode mode)
+    {
+        Command cmd;
+        cmd.type = RCT_SET_POLYGON_MODE;
+        cmd.polygonMode = mode;
+        mCommands.push_back(cmd);
+    }
+    //-----------------------------------------------------------------------
+    void RenderCommandList::setTexture(size_t unit, bool enabled, const TexturePtr& tex)
+    {
+        Command cmd;
+        cmd.type = RCT_SET_TEXTURE;
+        cmd.texture.unit = static_cast<uint32>(unit);
+        cmd.texture.enabled = enabled;
+        cmd.texture.index = static_cast<uint32>(mTextures.size());
+        mTextures.push_back(tex);
+        mCommands.push_back(cmd);
+    }
+    //-----------------------------------------------------------------------
+    void RenderCommandList::render(const RenderOperation& op)
+    {
+        Command cmd;
+        cmd.type = RCT_RENDER;
+        cmd.index = static_cast<uint32>(mOperations.size());
+        mOperations.push_back(op);
+        mCommands.push_back(cmd);
+    }
+    //-----------------------------------------------------------------------
+    void RenderCommandList::clear(void)
+    {
+        mCommands.clear();
+        mMatrices.clear();
+        mOperations.clear();
+        mTextures.clear();
+        mNumParameters = 0;
+    }
+    //-----------------------------------------------------------------------
+    void RenderCommandList::_replay(RenderSystem* rs) const
+    {
+        for (std::vector<Command>::const_iterator i = mCommands.begin(); i != mCommands.end(); ++i)
+        {
+            const Command& cmd = *i;
+            switch (cmd.type)
+            {
+            case RCT_BIND_GPU_PROGRAM:
+                rs->bindGpuProgram(cmd.program);
+                break;
+            case RCT_UNBIND_GPU_PROGRAM:
+                rs->unbindGpuProgram(cmd.programType);
+                break;
+            case RCT_BIND_GPU_PROGRAM_PARAMETERS:
+                rs->bindGpuProgramParameters(cmd.parameters.type, mParameters[cmd.parameters.index],
+                                             cmd.parameters.variabilityMask);
+                break;
+            case RCT_SET_WORLD_MATRIX:
+                rs->_setWorldMatrix(mMatrices[cmd.index]);
+                break;
+            case RCT_SET_CULLING_MODE:
+                rs->_setCullingMode(cmd.cullingMode);
+                break;
+            case RCT_SET_DEPTH_BUFFER_PARAMS:
+                rs->_setDepthBufferParams(cmd.depth.test, cmd.depth.write, cmd.depth.function);
+                break;
+            case RCT_SET_SCENE_BLENDING:
+                rs->_setSeparateSceneBlending(cmd.blending.source, cmd.blending.dest, cmd.blending.sourceAlpha,
+                                              cmd.blending.destAlpha, cmd.blending.op, cmd.blending.alphaOp);
+                break;
+            case RCT_SET_POLYGON_MODE:
+                rs->_setPolygonMode(cmd.polygonMode);
+                break;
+            case RCT_SET_TEXTURE:
+                rs->_setTexture(cmd.texture.unit, cmd.texture.enabled, mTextures[cmd.texture.index]);
+                break;
+            case RCT_RENDER:
+                rs->_render(mOperations[cmd.index]);
+                break;
+            }
+        }
+    }
+}
@@ -32,6 +32,8 @@ THE SOFTWARE.
 #include "OgreRenderQueueSortingGrouping.h"
 #include "OgreSceneManagerEnumerator.h"
 
+#include <chrono>
+
 namespace Ogre {
 
     //---------------------------------------------------------------------
@@ -40,6 +42,8 @@ namespace Ogre {
         , mSplitNoShadowPasses(false)
         , mShadowCastersCannotBeReceivers(false)
         , mRenderableListener(0)
+        , mQueueingTimed(false)
+        , mQueueingTime(0)
     {
         // Create the 'main' queue up-front since we'll always need that
         mGroups[RENDER_QUEUE_MAIN].reset(new RenderQueueGroup(this, mSplitPassesByLightingType,
@@ -236,6 +240,24 @@ namespace Ogre {
         }
     }
 
+    //-----------------------------------------------------------------------
+    void RenderQueue::_copySettings( const RenderQueue* rhs )
+    {
+        mDefaultQueueGroup = rhs->mDefaultQueueGroup;
+        mDefaultRenderablePriority = rhs->mDefaultRenderablePriority;
+        mSplitPassesByLightingType = rhs->mSplitPassesByLightingType;
+        mSplitNoShadowPasses = rhs->mSplitNoShadowPasses;
+        mShadowCastersCannotBeReceivers = rhs->mShadowCastersCannotBeReceivers;
+        mRenderableListener = rhs->mRenderableListener;
+
+        for (size_t i = 0; i < RENDER_QUEUE_MAX; ++i)
+        {
+            if (rhs->mGroups[i])
+                getQueueGroup(i)->_copySettings(rhs->mGroups[i].get());
+            else
+                mGroups[i].reset();
+        }
+    }
     //---------------------------------------------------------------------
     void RenderQueue::processVisibleObject(MovableObject* mo, 
         Camera* cam, 
@@ -250,7 +272,17 @@ namespace Ogre {
 
             if (!onlyShadowCasters || mo->getCastShadows())
             {
-                mo -> _updateRenderQueue( this );
+                if (mQueueingTimed)
+                {
+                    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+                    mo->_updateRenderQueue(this);
+                    mQueueingTime += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - start).count();
+                }
+                else
+                {
+                    mo->_updateRenderQueue(this);
+                }
                 if (visibleBounds)
                 {
                     visibleBounds->merge(mo->getWorldBoundingBox(true), 
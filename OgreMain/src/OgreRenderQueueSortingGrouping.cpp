@@ -29,13 +29,6 @@ THE SOFTWARE.
 #include "OgreRenderQueueSortingGrouping.h"
 
 namespace Ogre {
-    // Init statics
-    RadixSort<QueuedRenderableCollection::RenderablePassList,
-        RenderablePass, uint32> QueuedRenderableCollection::msRadixSorter1;
-    RadixSort<QueuedRenderableCollection::RenderablePassList,
-        RenderablePass, float> QueuedRenderableCollection::msRadixSorter2;
-
-
     //-----------------------------------------------------------------------
     RenderPriorityGroup::RenderPriorityGroup(RenderQueueGroup* parent, 
             bool splitPassesByLightingType,
@@ -205,43 +198,9 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void RenderPriorityGroup::clear(void)
     {
-        // Delete queue groups which are using passes which are to be
-        // deleted, we won't need these any more and they clutter up 
-        // the list and can cause problems with future clones
-        {
-            // Hmm, a bit hacky but least obtrusive for now
-                    OGRE_LOCK_MUTEX(Pass::msPassGraveyardMutex);
-            const Pass::PassSet& graveyardList = Pass::getPassGraveyard();
-            Pass::PassSet::const_iterator gi, giend;
-            giend = graveyardList.end();
-            for (gi = graveyardList.begin(); gi != giend; ++gi)
-            {
-                removePassEntry(*gi);
-            }
-        }
-
-        // Now remove any dirty passes, these will have their hashes recalculated
-        // by the parent queue after all groups have been processed
-        // If we don't do this, the std::map will become inconsistent for new insterts
-        {
-            // Hmm, a bit hacky but least obtrusive for now
-                    OGRE_LOCK_MUTEX(Pass::msDirtyHashListMutex);
-            const Pass::PassSet& dirtyList = Pass::getDirtyHashList();
-            Pass::PassSet::const_iterator di, diend;
-            diend = dirtyList.end();
-            for (di = dirtyList.begin(); di != diend; ++di)
-            {
-                removePassEntry(*di);
-            }
-        }
-        // NB we do NOT clear the graveyard or the dirty list here, because 
-        // it needs to be acted on for all groups, the parent queue takes 
-        // care of this afterwards
-
-        // Now empty the remaining collections
-        // Note that groups don't get deleted, just emptied hence the difference
-        // between the pass groups which are removed above, and clearing done
-        // here
+        // Collections do not keep any per pass state between frames, so
+        // passes in the graveyard or with dirty hashes need no special
+        // treatment here; the parent queue processes those lists afterwards
         mSolidsBasic.clear();
         mSolidsDecal.clear();
         mSolidsDiffuseSpecular.clear();
@@ -272,35 +231,30 @@ namespace Ogre {
     }
     //-----------------------------------------------------------------------
     QueuedRenderableCollection::QueuedRenderableCollection(void)
-        :mOrganisationMode(0)
+        :mOrganisationMode(0), mGroupedNeedsSorting(false)
     {
     }
 
     //-----------------------------------------------------------------------
     void QueuedRenderableCollection::clear(void)
     {
-        PassGroupRenderableMap::iterator i, iend;
-        iend = mGrouped.end();
-        for (i = mGrouped.begin(); i != iend; ++i)
-        {
-            // Clear the list associated with this pass, but leave the pass entry
-            i->second.clear();
-        }
-
-        // Clear sorted list
+        // Clear lists, their memory stays allocated
+        mGrouped.clear();
+        mGroupedNeedsSorting = false;
         mSortedDescending.clear();
     }
     //-----------------------------------------------------------------------
     void QueuedRenderableCollection::removePassGroup(Pass* p)
     {
-        PassGroupRenderableMap::iterator i;
-
-        i = mGrouped.find(p);
-        if (i != mGrouped.end())
+        // Compact the list, keeping the order of the remaining entries
+        PassGroupList::iterator i, dst, iend;
+        iend = mGrouped.end();
+        for (i = dst = mGrouped.begin(); i != iend; ++i)
         {
-            // erase from map
-            mGrouped.erase(i);
+            if (i->pass != p)
+                *dst++ = *i;
         }
+        mGrouped.erase(dst, iend);
     }
     //-----------------------------------------------------------------------
     void QueuedRenderableCollection::sort(const Camera* cam)
@@ -312,11 +266,12 @@ namespace Ogre {
         {
             
             // We can either use a stable_sort and the 'less' implementation,
-            // or a 2-pass radix sort (once by pass, then by distance, since
-            // radix sorting is inherently stable this will work)
-            // We use stable_sort if the number of items is 512 or less, since
-            // the complexity of the radix sort is approximately O(10N), since 
-            // each sort is O(5N) (1 pass histograms, 4 passes sort)
+            // or a radix sort on a 64 bit key combining distance and pass
+            // (equivalent to sorting by pass, then by distance, since radix
+            // sorting is inherently stable)
+            // We use stable_sort if the number of items is 2000 or less, since
+            // the complexity of the radix sort is approximately O(9N)
+            // (1 pass histograms, 8 passes sort)
             // Since stable_sort has a worst-case performance of O(N(logN)^2)
             // the performance tipping point is from about 1500 items, but in
             // stable_sorts best-case scenario O(NlogN) it would be much higher.
@@ -324,10 +279,11 @@ namespace Ogre {
             
             if (mSortedDescending.size() > 2000)
             {
-                // sort by pass
-                msRadixSorter1.sort(mSortedDescending, RadixSortFunctorPass());
-                // sort by depth
-                msRadixSorter2.sort(mSortedDescending, RadixSortFunctorDistance(cam));
+                // One sorter per thread rather than per collection, it holds
+                // 8 KB of counters besides its scratch buffers
+                static thread_local RadixSort<RenderablePassList, RenderablePass, uint64> radixSorter;
+                // sort by depth, then pass
+                radixSorter.sort(mSortedDescending, RadixSortFunctorDistancePass(cam));
             }
             else
             {
@@ -337,8 +293,41 @@ namespace Ogre {
             }
         }
 
-        // Nothing needs to be done for pass groups, they auto-organise
+        if ((mOrganisationMode & OM_PASS_GROUP) && mGroupedNeedsSorting)
+        {
+            sortGrouped();
+        }
+    }
+    //-----------------------------------------------------------------------
+    void QueuedRenderableCollection::sortGrouped(void)
+    {
+        // Always radix sort, std::stable_sort would allocate a temporary buffer
+        // each time. Since radix sorting is stable, the renderables of a pass
+        // stay in the order they were added in. The sorter is shared by the
+        // collections sorted on the same thread.
+        static thread_local RadixSort<PassGroupList, PassGroupEntry, uint64> passGroupSorter;
+        passGroupSorter.sort(mGrouped, RadixSortFunctorPassGroup());
+
+        // Passes with the same hash are ordered by the lower bits of their address,
+        // which differs from the order of the full addresses if the upper bits differ
+        // too, and interleaves their entries if the lower bits are the same. Finish
+        // ordering such runs with the full comparison
+        PassGroupList::iterator i, runEnd, iend;
+        iend = mGrouped.end();
+        for (i = mGrouped.begin(); i != iend; i = runEnd)
+        {
+            uint32 hash = uint32(i->sortKey >> 32);
+            bool unordered = false;
+            for (runEnd = i + 1; runEnd != iend && uint32(runEnd->sortKey >> 32) == hash; ++runEnd)
+            {
+                unordered |= runEnd->pass < (runEnd - 1)->pass;
+            }
+
+            if (unordered)
+                std::stable_sort(i, runEnd, PassGroupLess());
+        }
 
+        mGroupedNeedsSorting = false;
     }
     //-----------------------------------------------------------------------
     void QueuedRenderableCollection::addRenderable(Pass* pass, Renderable* rend)
@@ -351,23 +340,9 @@ namespace Ogre {
 
         if (mOrganisationMode & OM_PASS_GROUP)
         {
-            PassGroupRenderableMap::iterator i = mGrouped.find(pass);
-            if (i == mGrouped.end())
-            {
-                std::pair<PassGroupRenderableMap::iterator, bool> retPair;
-                // Create new pass entry, build a new list
-                // Note that this pass and list are never destroyed until the 
-                // engine shuts down, or a pass is destroyed or has it's hash
-                // recalculated, although the lists will be cleared
-                retPair = mGrouped.insert(
-                    PassGroupRenderableMap::value_type(pass, RenderableList()));
-                assert(retPair.second && 
-                    "Error inserting new pass entry into PassGroupRenderableMap");
-                i = retPair.first;
-            }
-            // Insert renderable
-            i->second.push_back(rend);
-            
+            // Grouped when sorting
+            mGrouped.push_back(PassGroupEntry(pass, rend));
+            mGroupedNeedsSorting = true;
         }
         
     }
@@ -409,14 +384,20 @@ namespace Ogre {
     void QueuedRenderableCollection::acceptVisitorGrouped(
         QueuedRenderableVisitor* visitor) const
     {
-        PassGroupRenderableMap::const_iterator ipass, ipassend;
-        ipassend = mGrouped.end();
-        for (ipass = mGrouped.begin(); ipass != ipassend; ++ipass)
+        PassGroupList::const_iterator i, iend;
+        iend = mGrouped.end();
+        i = mGrouped.begin();
+        while (i != iend)
         {
-            // Fast bypass if this group is now empty
-            if (ipass->second.empty()) continue;
+            // Gather the renderables of this pass, adjacent once sorted
+            Pass* pass = i->pass;
+            mVisitedGroup.clear();
+            for (; i != iend && i->pass == pass; ++i)
+            {
+                mVisitedGroup.push_back(i->renderable);
+            }
 
-            visitor->visit(ipass->first, const_cast<RenderableList&>(ipass->second));
+            visitor->visit(pass, mVisitedGroup);
         } 
 
     }
@@ -452,26 +433,10 @@ namespace Ogre {
     {
         mSortedDescending.insert( mSortedDescending.end(), rhs.mSortedDescending.begin(), rhs.mSortedDescending.end() );
 
-        PassGroupRenderableMap::const_iterator srcGroup;
-        for( srcGroup = rhs.mGrouped.begin(); srcGroup != rhs.mGrouped.end(); ++srcGroup )
+        if (!rhs.mGrouped.empty())
         {
-            PassGroupRenderableMap::iterator dstGroup = mGrouped.find( srcGroup->first );
-            if (dstGroup == mGrouped.end())
-            {
-                std::pair<PassGroupRenderableMap::iterator, bool> retPair;
-                // Create new pass entry, build a new list
-                // Note that this pass and list are never destroyed until the 
-                // engine shuts down, or a pass is destroyed or has it's hash
-                // recalculated, although the lists will be cleared
-                retPair = mGrouped.insert(
-                    PassGroupRenderableMap::value_type(srcGroup->first, RenderableList()));
-                assert(retPair.second && 
-                    "Error inserting new pass entry into PassGroupRenderableMap");
-                dstGroup = retPair.first;
-            }
-
-            // Insert renderable
-            dstGroup->second.insert( dstGroup->second.end(), srcGroup->second.begin(), srcGroup->second.end() );
+            mGrouped.insert( mGrouped.end(), rhs.mGrouped.begin(), rhs.mGrouped.end() );
+            mGroupedNeedsSorting = true;
         }
     }
 
@@ -36,6 +36,7 @@ THE SOFTWARE.
 #include "OgreDepthBuffer.h"
 #include "OgreIteratorWrappers.h"
 #include "OgreHardwareOcclusionQuery.h"
+#include "OgreRenderCommandList.h"
 
 #ifdef OGRE_BUILD_COMPONENT_RTSHADERSYSTEM
 #include "OgreRTShaderConfig.h"
@@ -515,6 +516,10 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void RenderSystem::shutdown(void)
     {
+        // The streaming rings hold buffers of the manager the render system is about to destroy
+        if (HardwareBufferManager::getSingletonPtr())
+            HardwareBufferManager::getSingleton()._releaseStreamingBuffers();
+
         // Remove occlusion queries
         for (HardwareOcclusionQueryList::iterator i = mHwOcclusionQueries.begin();
             i != mHwOcclusionQueries.end(); ++i)
@@ -625,6 +630,11 @@ namespace Ogre {
         }
     }
     //-----------------------------------------------------------------------
+    void RenderSystem::_executeCommandList(const RenderCommandList& list)
+    {
+        list._replay(this);
+    }
+    //-----------------------------------------------------------------------
     void RenderSystem::setInvertVertexWinding(bool invert)
     {
         mInvertVertexWinding = invert;
@@ -27,6 +27,7 @@ THE SOFTWARE.
 */
 #include "OgreStableHeaders.h"
 #include "OgreScriptLoader.h"
+#include "OgreStreamSerialiser.h"
 
 namespace Ogre {
 
@@ -54,7 +55,7 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     //-----------------------------------------------------------------------
     ResourceGroupManager::ResourceGroupManager()
-        : mLoadingListener(0), mCurrentGroup(0)
+        : mLoadingListener(0), mCurrentGroup(0), mGroupsVersion(0)
     {
         // Create the 'General' group
         createResourceGroup(DEFAULT_RESOURCE_GROUP_NAME, true); // the "General" group is synonymous to global pool
@@ -96,6 +97,7 @@ namespace Ogre {
         OGRE_LOCK_AUTO_MUTEX;
         mResourceGroupMap.insert(
             ResourceGroupMap::value_type(name, grp));
+        ++mGroupsVersion;
     }
     //-----------------------------------------------------------------------
     void ResourceGroupManager::initialiseResourceGroup(const String& name)
@@ -169,6 +171,10 @@ namespace Ogre {
                 "ResourceGroupManager::prepareResourceGroup");
         }
 
+        // The worker threads open resources too, so this must not hold the locks below
+        if (prepareMainResources && mWorkerThreadPool)
+            prepareResourcesConcurrently(grp);
+
         OGRE_LOCK_AUTO_MUTEX;
         OGRE_LOCK_MUTEX(grp->OGRE_AUTO_MUTEX_NAME); // lock group mutex 
         // Set current group
@@ -249,6 +255,92 @@ namespace Ogre {
         LogManager::getSingleton().logMessage("Finished preparing resource group " + name);
     }
     //-----------------------------------------------------------------------
+    namespace {
+        /// Hands out the resources one at a time, as their preparation cost varies a lot
+        class PrepareResourcesTask : public UniformScalableTask
+        {
+            const std::vector<ResourcePtr>& mResources;
+            AtomicScalar<size_t> mNext;
+        public:
+            PrepareResourcesTask(const std::vector<ResourcePtr>& resources) : mResources(resources), mNext(0) {}
+
+            void execute(size_t, size_t)
+            {
+                size_t i;
+                while ((i = mNext.fetch_add(1)) < mResources.size())
+                {
+                    try
+                    {
+                        mResources[i]->prepare(true);
+                    }
+                    catch (...)
+                    {
+                        // the resource is left unprepared, so loading it on the calling
+                        // thread retries and reports the error in the usual order
+                    }
+                }
+            }
+        };
+    }
+    //-----------------------------------------------------------------------
+    void ResourceGroupManager::prepareResourcesConcurrently(ResourceGroup* grp)
+    {
+        // keep the resources alive, in loading order
+        std::vector<ResourcePtr> toPrepare;
+        {
+            OGRE_LOCK_AUTO_MUTEX;
+            OGRE_LOCK_MUTEX(grp->OGRE_AUTO_MUTEX_NAME);
+            ResourceGroup::LoadResourceOrderMap::iterator oi;
+            for (oi = grp->loadResourceOrderMap.begin(); oi != grp->loadResourceOrderMap.end(); ++oi)
+            {
+                for (LoadUnloadResourceList::iterator l = oi->second.begin(); l != oi->second.end(); ++l)
+                {
+                    const ResourcePtr& res = *l;
+                    if (!res->isManuallyLoaded() && res->getLoadingState() == Resource::LOADSTATE_UNLOADED &&
+                        res->getCreator()->isConcurrentPrepareSafe())
+                        toPrepare.push_back(res);
+                }
+            }
+        }
+        if (toPrepare.size() < 2)
+            return;
+
+        PrepareResourcesTask task(toPrepare);
+        mWorkerThreadPool->execute(&task);
+
+        // Resource::Listener callbacks happen on this thread, as with serial loading
+        for (std::vector<ResourcePtr>::iterator i = toPrepare.begin(); i != toPrepare.end(); ++i)
+        {
+            if ((*i)->isPrepared())
+                (*i)->_firePreparingComplete(false);
+        }
+    }
+    //-----------------------------------------------------------------------
+    void ResourceGroupManager::setNumWorkerThreads(size_t numThreads)
+    {
+#if OGRE_THREAD_SUPPORT != 1 && OGRE_THREAD_SUPPORT != 2
+        // archives, resources and managers are not locked, so never prepare concurrently
+        if (numThreads != 1)
+        {
+            LogManager::getSingleton().logWarning(
+                "ResourceGroupManager::setNumWorkerThreads - resources can only be prepared "
+                "concurrently with OGRE_THREAD_SUPPORT 1 or 2, using the calling thread");
+            numThreads = 1;
+        }
+#endif
+        if (numThreads == getNumWorkerThreads())
+            return;
+
+        mWorkerThreadPool.reset();
+        if (numThreads != 1)
+        {
+            mWorkerThreadPool.reset(OGRE_NEW WorkerThreadPool(numThreads));
+            // without thread support there is no point keeping it around
+            if (mWorkerThreadPool->getNumThreads() == 1)
+                mWorkerThreadPool.reset();
+        }
+    }
+    //-----------------------------------------------------------------------
     void ResourceGroupManager::loadResourceGroup(const String& name, 
         bool loadMainResources, bool loadWorldGeom)
     {
@@ -264,6 +356,10 @@ namespace Ogre {
                 "ResourceGroupManager::loadResourceGroup");
         }
 
+        // The worker threads open resources too, so this must not hold the locks below
+        if (loadMainResources && mWorkerThreadPool)
+            prepareResourcesConcurrently(grp);
+
         OGRE_LOCK_AUTO_MUTEX;
         OGRE_LOCK_MUTEX(grp->OGRE_AUTO_MUTEX_NAME); // lock group mutex 
         // Set current group
@@ -471,6 +567,7 @@ namespace Ogre {
         dropGroupContents(grp);
         deleteGroup(grp);
         mResourceGroupMap.erase(mResourceGroupMap.find(name));
+        ++mGroupsVersion;
         // reset current group
         mCurrentGroup = 0;
     }
@@ -534,7 +631,11 @@ namespace Ogre {
         // Add to location list
 
         ResourceLocation loc = {pArch, recursive};
-        StringVectorPtr vec = pArch->find("*", recursive);
+        StringVectorPtr vec;
+        if (!mIndexCachePath.empty())
+            loc.files = listLocationFiles(pArch, recursive);
+        if (!loc.files)
+            vec = pArch->find("*", recursive);
 
         ResourceGroup* grp = getResourceGroup(resGroup);
         if (!grp)
@@ -547,8 +648,16 @@ namespace Ogre {
         grp->locationList.push_back(loc);
 
         // Index resources
-        for( StringVector::iterator it = vec->begin(); it != vec->end(); ++it )
-            grp->addToIndex(*it, pArch);
+        if (loc.files)
+        {
+            for (FileInfoList::iterator it = loc.files->begin(); it != loc.files->end(); ++it)
+                grp->addToIndex(it->filename, pArch);
+        }
+        else
+        {
+            for( StringVector::iterator it = vec->begin(); it != vec->end(); ++it )
+                grp->addToIndex(*it, pArch);
+        }
         
         StringStream msg;
         msg << "Added resource location '" << name << "' of type '" << locType
@@ -559,6 +668,157 @@ namespace Ogre {
 
     }
     //-----------------------------------------------------------------------
+    namespace {
+        const uint32 INDEX_CACHE_CHUNK_ID = StreamSerialiser::makeIdentifier("RIDX");
+        const uint16 INDEX_CACHE_CHUNK_VERSION = 2;
+
+        /// Modification times of the directories the listing of a location depends on
+        typedef std::vector<std::pair<String, uint64> > DirectoryTimes;
+
+        bool readIndexCache(const String& cacheFile, Archive* arch, bool recursive, FileInfoList& files)
+        {
+            std::ifstream* ifs = OGRE_NEW_T(std::ifstream, MEMCATEGORY_GENERAL);
+            ifs->open(cacheFile.c_str(), std::ios::in | std::ios::binary);
+            if (!*ifs)
+            {
+                OGRE_DELETE_T(ifs, basic_ifstream, MEMCATEGORY_GENERAL);
+                return false;
+            }
+            StreamSerialiser ser(DataStreamPtr(OGRE_NEW FileStreamDataStream(cacheFile, ifs)));
+            if (!ser.readChunkBegin(INDEX_CACHE_CHUNK_ID, INDEX_CACHE_CHUNK_VERSION))
+                return false;
+
+            String name, type;
+            bool wasRecursive;
+            ser.read(&name);
+            ser.read(&type);
+            ser.read(&wasRecursive);
+            if (name != arch->getName() || type != arch->getType() || wasRecursive != recursive)
+                return false;
+
+            uint32 numDirs;
+            ser.read(&numDirs);
+            for (uint32 i = 0; i < numDirs; ++i)
+            {
+                String dir;
+                uint64 modified;
+                ser.read(&dir);
+                ser.read(&modified);
+                if (uint64(arch->getModifiedTime(dir)) != modified)
+                    return false;
+            }
+
+            uint32 numFiles;
+            ser.read(&numFiles);
+            files.resize(numFiles);
+            for (FileInfoList::iterator i = files.begin(); i != files.end(); ++i)
+            {
+                uint64 compressedSize, uncompressedSize, modified;
+                i->archive = arch;
+                ser.read(&i->filename);
+                ser.read(&i->path);
+                ser.read(&i->basename);
+                ser.read(&compressedSize);
+                ser.read(&uncompressedSize);
+                ser.read(&modified);
+                i->compressedSize = static_cast<size_t>(compressedSize);
+                i->uncompressedSize = static_cast<size_t>(uncompressedSize);
+
+                // files rewritten in place leave the times of their directories alone
+                size_t size;
+                if (uint64(arch->getModifiedTimeAndSize(i->filename, size)) != modified ||
+                    (size != ~size_t(0) && size != i->uncompressedSize))
+                    return false;
+            }
+            ser.readChunkEnd(INDEX_CACHE_CHUNK_ID);
+            return true;
+        }
+
+        void writeIndexCache(const String& cacheFile, Archive* arch, bool recursive,
+                             const DirectoryTimes& times, const FileInfoList& files)
+        {
+            std::fstream* fs = OGRE_NEW_T(std::fstream, MEMCATEGORY_GENERAL);
+            fs->open(cacheFile.c_str(), std::ios::out | std::ios::binary);
+            if (!*fs)
+            {
+                OGRE_DELETE_T(fs, basic_fstream, MEMCATEGORY_GENERAL);
+                OGRE_EXCEPT(Exception::ERR_CANNOT_WRITE_TO_FILE, "Can't open " + cacheFile + " for writing");
+            }
+            StreamSerialiser ser(DataStreamPtr(OGRE_NEW FileStreamDataStream(cacheFile, fs)));
+            ser.writeChunkBegin(INDEX_CACHE_CHUNK_ID, INDEX_CACHE_CHUNK_VERSION);
+            ser.write(&arch->getName());
+            ser.write(&arch->getType());
+            ser.write(&recursive);
+
+            uint32 numDirs = static_cast<uint32>(times.size());
+            ser.write(&numDirs);
+            for (DirectoryTimes::const_iterator i = times.begin(); i != times.end(); ++i)
+            {
+                ser.write(&i->first);
+                ser.write(&i->second);
+            }
+
+            uint32 numFiles = static_cast<uint32>(files.size());
+            ser.write(&numFiles);
+            for (FileInfoList::const_iterator i = files.begin(); i != files.end(); ++i)
+            {
+                uint64 compressedSize = i->compressedSize, uncompressedSize = i->uncompressedSize;
+                uint64 modified = arch->getModifiedTime(i->filename);
+                ser.write(&i->filename);
+                ser.write(&i->path);
+                ser.write(&i->basename);
+                ser.write(&compressedSize);
+                ser.write(&uncompressedSize);
+                ser.write(&modified);
+            }
+            ser.writeChunkEnd(INDEX_CACHE_CHUNK_ID);
+        }
+    }
+    //-----------------------------------------------------------------------
+    FileInfoListPtr ResourceGroupManager::listLocationFiles(Archive* arch, bool recursive) const
+    {
+        // without modification times there is no telling whether the cache is stale
+        time_t archiveTime = arch->getModifiedTime(BLANKSTRING);
+        if (!archiveTime)
+            return FileInfoListPtr();
+
+        String key = arch->getType() + ":" + arch->getName() + (recursive ? ":recursive" : "");
+        String cacheFile = StringUtil::standardisePath(mIndexCachePath) +
+                           StringConverter::toString(FastHash(key.c_str(), key.size())) + ".index";
+
+        FileInfoListPtr files(OGRE_NEW_T(FileInfoList, MEMCATEGORY_GENERAL)(), SPFM_DELETE_T);
+        try
+        {
+            if (readIndexCache(cacheFile, arch, recursive, *files))
+                return files;
+        }
+        catch (Exception&)
+        {
+            // truncated or otherwise broken, rewrite it below
+        }
+
+        // take the times first, so changes made while scanning are picked up next time
+        DirectoryTimes times(1, std::make_pair(BLANKSTRING, uint64(archiveTime)));
+        if (recursive)
+        {
+            FileInfoListPtr dirs = arch->findFileInfo("*", true, true);
+            for (FileInfoList::iterator i = dirs->begin(); i != dirs->end(); ++i)
+                times.push_back(std::make_pair(i->filename, uint64(arch->getModifiedTime(i->filename))));
+        }
+
+        files = arch->findFileInfo("*", recursive);
+        try
+        {
+            writeIndexCache(cacheFile, arch, recursive, times, *files);
+        }
+        catch (Exception& e)
+        {
+            LogManager::getSingleton().logWarning("cannot cache the files of resource location '" +
+                                                  arch->getName() + "': " + e.getDescription());
+        }
+        return files;
+    }
+    //-----------------------------------------------------------------------
     void ResourceGroupManager::removeResourceLocation(const String& name, 
         const String& resGroup)
     {
@@ -1540,6 +1800,18 @@ namespace Ogre {
         iend = grp->locationList.end();
         for (i = grp->locationList.begin(); i != iend; ++i)
         {
+            if (i->files && !dirs)
+            {
+                // match the cached file list like archives do, no need to scan them
+                bool fullMatch = pattern.find_first_of("/\\") != String::npos;
+                bool caseSensitive = i->archive->isCaseSensitive();
+                for (FileInfoList::iterator f = i->files->begin(); f != i->files->end(); ++f)
+                {
+                    if (StringUtil::match(fullMatch ? f->filename : f->basename, pattern, caseSensitive))
+                        vec->push_back(*f);
+                }
+                continue;
+            }
             FileInfoListPtr lst = i->archive->findFileInfo(pattern, i->recursive, dirs);
             vec->insert(vec->end(), lst->begin(), lst->end());
         }
@@ -32,7 +32,8 @@ namespace Ogre {
 
     //-----------------------------------------------------------------------
     ResourceManager::ResourceManager()
-        : mNextHandle(1), mMemoryUsage(0), mVerbose(true), mLoadOrder(0)
+        : mNextHandle(1), mMemoryUsage(0), mVerbose(true), mConcurrentPrepare(false),
+          mGroupPoolsVersion(0), mLoadOrder(0)
     {
         // Init memory limit & usage
         mMemoryBudget = std::numeric_limits<unsigned long>::max();
@@ -109,7 +110,10 @@ namespace Ogre {
             OGRE_LOCK_AUTO_MUTEX;
 
             std::pair<ResourceMap::iterator, bool> result;
-        if(ResourceGroupManager::getSingleton().isResourceGroupInGlobalPool(res->getGroup()))
+        // taken first, so the pool is never cached for a newer version than it was looked up with
+        uint32 groupsVersion = ResourceGroupManager::getSingleton()._getResourceGroupsVersion();
+        bool inGlobalPool = ResourceGroupManager::getSingleton().isResourceGroupInGlobalPool(res->getGroup());
+        if(inGlobalPool)
         {
             result = mResources.insert( ResourceMap::value_type( res->getName(), res ) );
         }
@@ -140,7 +144,7 @@ namespace Ogre {
             }
 
             // Try to do the addition again, no seconds attempts to resolve collisions are allowed
-            if(ResourceGroupManager::getSingleton().isResourceGroupInGlobalPool(res->getGroup()))
+            if(inGlobalPool)
             {
                 result = mResources.insert( ResourceMap::value_type( res->getName(), res ) );
             }
@@ -156,6 +160,7 @@ namespace Ogre {
             OGRE_EXCEPT(Exception::ERR_DUPLICATE_ITEM, getResourceType()+" with the name " + res->getName() +
                 " already exists.", "ResourceManager::add");
         }
+        addToNameIndex(res, inGlobalPool, groupsVersion);
 
         // Insert the handle
         std::pair<ResourceHandleMap::iterator, bool> resultHandle =
@@ -174,7 +179,9 @@ namespace Ogre {
 
         OGRE_LOCK_AUTO_MUTEX;
 
-        if(ResourceGroupManager::getSingleton().isResourceGroupInGlobalPool(res->getGroup()))
+        bool inGlobalPool = ResourceGroupManager::getSingleton().isResourceGroupInGlobalPool(res->getGroup());
+        removeFromNameIndex(res, inGlobalPool);
+        if(inGlobalPool)
         {
             ResourceMap::iterator nameIt = mResources.find(res->getName());
             if (nameIt != mResources.end())
@@ -337,6 +344,11 @@ namespace Ogre {
         mResources.clear();
         mResourcesWithGroup.clear();
         mResourcesByHandle.clear();
+        for (size_t i = 0; i < NUM_NAME_INDEX_SHARDS; ++i)
+        {
+            OGRE_LOCK_RW_MUTEX_WRITE(mNameIndex[i].mutex);
+            mNameIndex[i].entries.clear();
+        }
         // Notify resource group manager
         ResourceGroupManager::getSingleton()._notifyAllResourcesRemoved(this);
     }
@@ -368,60 +380,111 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     ResourcePtr ResourceManager::getResourceByName(const String& name, const String& groupName /* = ResourceGroupManager::AUTODETECT_RESOURCE_GROUP_NAME */)
     {
-        OGRE_LOCK_AUTO_MUTEX;
-
-        // resource should be in global pool
-        bool isGlobal = ResourceGroupManager::getSingleton().isResourceGroupInGlobalPool(groupName);
-
-        if(isGlobal)
+        return getResourceByName(name, hashName(name), groupName);
+    }
+    //-----------------------------------------------------------------------
+    ResourcePtr ResourceManager::getResourceByName(const String& name, uint32 hash, const String& groupName)
+    {
+        ResourcePtr global, grouped;
+        const String* groupedPool = 0;
         {
-            ResourceMap::iterator it = mResources.find(name);
-            if( it != mResources.end())
+            NameIndexShard& shard = mNameIndex[hash % NUM_NAME_INDEX_SHARDS];
+            OGRE_LOCK_RW_MUTEX_READ(shard.mutex);
+
+            std::pair<NameIndexShardMap::iterator, NameIndexShardMap::iterator> range =
+                shard.entries.equal_range(hash);
+            for (NameIndexShardMap::iterator i = range.first; i != range.second; ++i)
             {
-                return it->second;
+                const NameIndexEntry& entry = i->second;
+                if (entry.name != name)
+                    continue;
+
+                // found in the pool of the group itself
+                if (entry.pool == groupName)
+                    return entry.resource;
+
+                if (entry.pool.empty())
+                    global = entry.resource;
+                else if (!groupedPool || entry.pool < *groupedPool)
+                {
+                    // the first group by name, as mResourcesWithGroup is ordered
+                    grouped = entry.resource;
+                    groupedPool = &entry.pool;
+                }
             }
         }
 
+        // like ResourceGroupManager::isResourceGroupInGlobalPool, raises for unknown groups
+        bool isGlobal = isGroupInGlobalPool(groupName);
+
         // look in all grouped pools
         if (groupName == ResourceGroupManager::AUTODETECT_RESOURCE_GROUP_NAME)
+            return global ? global : grouped;
+
+#if OGRE_RESOURCEMANAGER_STRICT
+        if (!isGlobal)
+            return ResourcePtr();
+#else
+        // fall back to global
+        (void)isGlobal;
+#endif
+        return global;
+    }
+    //-----------------------------------------------------------------------
+    void ResourceManager::addToNameIndex(const ResourcePtr& res, bool inGlobalPool, uint32 groupsVersion)
+    {
+        // internal, assumes the auto mutex is locked
+        uint32 hash = hashName(res->getName());
+        NameIndexEntry entry = {res->getName(), inGlobalPool ? BLANKSTRING : res->getGroup(), res};
         {
-            ResourceWithGroupMap::iterator iter = mResourcesWithGroup.begin();
-            ResourceWithGroupMap::iterator iterE = mResourcesWithGroup.end();
-            for ( ; iter != iterE ; ++iter )
-            {
-                ResourceMap::iterator resMapIt = iter->second.find(name);
+            NameIndexShard& shard = mNameIndex[hash % NUM_NAME_INDEX_SHARDS];
+            OGRE_LOCK_RW_MUTEX_WRITE(shard.mutex);
+            shard.entries.insert(NameIndexShardMap::value_type(hash, entry));
+        }
 
-                if( resMapIt != iter->second.end())
-                {
-                    return resMapIt->second;
-                }
-            }
+        OGRE_LOCK_RW_MUTEX_WRITE(mGroupPoolsMutex);
+        if (groupsVersion != mGroupPoolsVersion)
+        {
+            mGroupPools.clear();
+            mGroupPoolsVersion = groupsVersion;
         }
-        else if (!isGlobal)
+        mGroupPools[res->getGroup()] = inGlobalPool;
+    }
+    //-----------------------------------------------------------------------
+    void ResourceManager::removeFromNameIndex(const ResourcePtr& res, bool inGlobalPool)
+    {
+        // internal, assumes the auto mutex is locked
+        uint32 hash = hashName(res->getName());
+        const String& pool = inGlobalPool ? BLANKSTRING : res->getGroup();
+
+        NameIndexShard& shard = mNameIndex[hash % NUM_NAME_INDEX_SHARDS];
+        OGRE_LOCK_RW_MUTEX_WRITE(shard.mutex);
+        std::pair<NameIndexShardMap::iterator, NameIndexShardMap::iterator> range =
+            shard.entries.equal_range(hash);
+        for (NameIndexShardMap::iterator i = range.first; i != range.second; ++i)
         {
-            // look in the grouped pool
-            ResourceWithGroupMap::iterator itGroup = mResourcesWithGroup.find(groupName);
-            if( itGroup != mResourcesWithGroup.end())
+            if (i->second.name == res->getName() && i->second.pool == pool)
             {
-                ResourceMap::iterator it = itGroup->second.find(name);
-
-                if( it != itGroup->second.end())
-                {
-                    return it->second;
-                }
+                shard.entries.erase(i);
+                break;
             }
-
-#if !OGRE_RESOURCEMANAGER_STRICT
-            // fall back to global
-            ResourceMap::iterator it = mResources.find(name);
-            if( it != mResources.end())
+        }
+    }
+    //-----------------------------------------------------------------------
+    bool ResourceManager::isGroupInGlobalPool(const String& group)
+    {
+        ResourceGroupManager& rgm = ResourceGroupManager::getSingleton();
+        {
+            OGRE_LOCK_RW_MUTEX_READ(mGroupPoolsMutex);
+            if (mGroupPoolsVersion == rgm._getResourceGroupsVersion())
             {
-                return it->second;
+                std::unordered_map<String, bool>::iterator i = mGroupPools.find(group);
+                if (i != mGroupPools.end())
+                    return i->second;
             }
-#endif
         }
-    
-        return ResourcePtr();
+        // groups without resources of this type, or changed since
+        return rgm.isResourceGroupInGlobalPool(group);
     }
     //-----------------------------------------------------------------------
     ResourcePtr ResourceManager::getByHandle(ResourceHandle handle)
@@ -57,6 +57,7 @@ THE SOFTWARE.
 #endif
 
 #include "OgreHardwareBufferManager.h"
+#include "OgreStreamingBufferAllocator.h"
 #include "OgreHighLevelGpuProgramManager.h"
 #include "OgreExternalTextureSourceManager.h"
 #include "OgreCompositorManager.h"
@@ -177,6 +178,8 @@ namespace Ogre {
 
         mFileSystemArchiveFactory.reset(new FileSystemArchiveFactory());
         ArchiveManager::getSingleton().addArchiveFactory( mFileSystemArchiveFactory.get() );
+        mMappedFileSystemArchiveFactory.reset(new MappedFileSystemArchiveFactory());
+        ArchiveManager::getSingleton().addArchiveFactory( mMappedFileSystemArchiveFactory.get() );
 #   if OGRE_NO_ZIP_ARCHIVE == 0
         mZipArchiveFactory.reset(new ZipArchiveFactory());
         ArchiveManager::getSingleton().addArchiveFactory( mZipArchiveFactory.get() );
@@ -766,8 +769,13 @@ namespace Ogre {
         }
 
         // Tell buffer manager to free temp buffers used this frame
+        // and to recycle the streaming space of old frames
         if (HardwareBufferManager::getSingletonPtr())
+        {
             HardwareBufferManager::getSingleton()._releaseBufferCopies();
+            if (StreamingBufferAllocator* streaming = HardwareBufferManager::getSingleton()._getStreamingBuffersPtr())
+                streaming->_notifyFrameEnded();
+        }
 
         // Tell the queue to process responses
         mWorkQueue->processResponses();
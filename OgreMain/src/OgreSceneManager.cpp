@@ -31,11 +31,14 @@ THE SOFTWARE.
 #include "OgreLight.h"
 #include "OgreControllerManager.h"
 #include "OgreAnimation.h"
+#include "OgreSkeletonInstance.h"
 #include "OgreRenderObjectListener.h"
 #include "OgreBillboardSet.h"
 #include "OgreStaticGeometry.h"
 #include "OgreSubEntity.h"
 #include "OgreHardwarePixelBuffer.h"
+#include "OgreHardwareUniformBuffer.h"
+#include "OgreStreamingBufferAllocator.h"
 #include "OgreRenderQueueInvocation.h"
 #include "OgreBillboardChain.h"
 #include "OgreRibbonTrail.h"
@@ -46,13 +49,37 @@ THE SOFTWARE.
 #include "OgreRenderTexture.h"
 #include "OgreLodListener.h"
 #include "OgreUnifiedHighLevelGpuProgram.h"
+#include "OgreAtomicScalar.h"
 
 // This class implements the most basic scene manager
 
 #include <cstdio>
+#include <chrono>
 
 namespace Ogre {
 
+namespace
+{
+    /// Adds the time spent in its scope to a stage time, if enabled
+    class StageTimer
+    {
+        uint64* mTime;
+        std::chrono::steady_clock::time_point mStart;
+    public:
+        StageTimer(bool enabled, uint64& time) : mTime(enabled ? &time : NULL)
+        {
+            if (mTime)
+                mStart = std::chrono::steady_clock::now();
+        }
+        ~StageTimer()
+        {
+            if (mTime)
+                *mTime += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - mStart).count();
+        }
+    };
+}
+
 //-----------------------------------------------------------------------
 uint32 SceneManager::WORLD_GEOMETRY_TYPE_MASK   = 0x80000000;
 uint32 SceneManager::ENTITY_TYPE_MASK           = 0x40000000;
@@ -81,6 +108,7 @@ mResetIdentityProj(false),
 mNormaliseNormalsOnScale(true),
 mFlipCullingOnNegativeScale(true),
 mLightsDirtyCounter(0),
+mLightGridDirtyCounter(0),
 mMovableNameGenerator("Ogre/MO"),
 mShadowRenderer(this),
 mDisplayNodes(false),
@@ -94,14 +122,25 @@ mLightClippingInfoMapFrameNumber(999),
 mShadowTextureSelfShadow(false),
 mVisibilityMask(0xFFFFFFFF),
 mFindVisibleObjects(true),
+mParallelCulling(false),
+mSkeletalAnimationStage(false),
+mParallelSkinningThreshold(0),
+mNumSkeletonsEvaluated(0),
+mNumBonesEvaluated(0),
+mStageTimingEnabled(false),
 mSuppressRenderStateChanges(false),
 mSuppressShadows(false),
 mCameraRelativeRendering(false),
 mLastLightHash(0),
 mLastLightLimit(0),
-mGpuParamsDirty((uint16)GPV_ALL)
+mGpuParamsDirty((uint16)GPV_ALL),
+mPerObjectConstantBatching(false),
+mPerObjectBlockWritePos(0),
+mPerObjectBlockActive(false),
+mPerObjectBlockSlot(0)
 {
     mShadowCasterQueryListener.reset(new ShadowCasterSceneQueryListener(this));
+    resetStageTimes();
 
     Root *root = Root::getSingletonPtr();
     if (root)
@@ -124,6 +163,8 @@ SceneManager::~SceneManager()
     mShadowRenderer.destroyShadowTextures();
     clearScene();
     destroyAllCameras();
+    // the root node outlives the body of the destructor
+    setNodeTransformStoreEnabled(false);
 
     // clear down movable object collection map
     {
@@ -364,10 +405,22 @@ void SceneManager::_populateLightList(const Vector3& position, Real radius,
     destList.clear();
     destList.reserve(candidateLights.size());
 
-    LightList::const_iterator it;
-    for (it = candidateLights.begin(); it != candidateLights.end(); ++it)
+    size_t numCandidates = candidateLights.size();
+    if (mLightGrid)
+    {
+        if (mLightGridDirtyCounter != mLightsDirtyCounter)
+        {
+            mLightGrid->build(candidateLights);
+            mLightGridDirtyCounter = mLightsDirtyCounter;
+        }
+        // Candidates stay in the same order, so sorting gives the same result
+        mLightGrid->findLights(Sphere(position, radius), mLightGridResults);
+        numCandidates = mLightGridResults.size();
+    }
+
+    for (size_t i = 0; i < numCandidates; ++i)
     {
-        Light* lt = *it;
+        Light* lt = candidateLights[mLightGrid ? mLightGridResults[i] : i];
         // check whether or not this light is suppose to be taken into consideration for the current light mask set for this operation
         if(!(lt->getLightMask() & lightMask))
             continue; //skip this light
@@ -745,6 +798,8 @@ SceneNode* SceneManager::createSceneNode(void)
 {
     SceneNode* sn = createSceneNodeImpl();
     mSceneNodes.push_back(sn);
+    if (mNodeTransformStore)
+        sn->_setTransformStore(mNodeTransformStore.get());
     return sn;
 }
 //-----------------------------------------------------------------------
@@ -761,6 +816,8 @@ SceneNode* SceneManager::createSceneNode(const String& name)
 
     SceneNode* sn = createSceneNodeImpl(name);
     mSceneNodes.push_back(sn);
+    if (mNodeTransformStore)
+        sn->_setTransformStore(mNodeTransformStore.get());
     return sn;
 }
 //-----------------------------------------------------------------------
@@ -836,6 +893,8 @@ SceneNode* SceneManager::getRootSceneNode(void)
         // Create root scene node
         mSceneRoot.reset(createSceneNodeImpl("Ogre/SceneRoot"));
         mSceneRoot->_notifyRootNode();
+        if (mNodeTransformStore)
+            mSceneRoot->_setTransformStore(mNodeTransformStore.get());
     }
 
     return mSceneRoot.get();
@@ -1323,15 +1382,26 @@ void SceneManager::_renderScene(Camera* camera, Viewport* vp, bool includeOverla
 
 
     // Update controllers 
-    ControllerManager::getSingleton().updateAllControllers();
+    {
+        StageTimer timer(mStageTimingEnabled, mStageTimes[FS_ANIMATION]);
+        ControllerManager::getSingleton().updateAllControllers();
+    }
 
     // Update the scene, only do this once per frame
     unsigned long thisFrameNumber = Root::getSingleton().getNextFrameNumber();
     if (thisFrameNumber != mLastFrameNumber)
     {
         // Update animations
-        _applySceneAnimations();
+        {
+            StageTimer timer(mStageTimingEnabled, mStageTimes[FS_ANIMATION]);
+            _applySceneAnimations();
+        }
         updateDirtyInstanceManagers();
+        if (mSkeletalAnimationStage)
+        {
+            StageTimer timer(mStageTimingEnabled, mStageTimes[FS_SKELETAL_ANIMATION]);
+            updateSkeletalAnimations();
+        }
         mLastFrameNumber = thisFrameNumber;
     }
 
@@ -1342,6 +1412,7 @@ void SceneManager::_renderScene(Camera* camera, Viewport* vp, bool includeOverla
         // Update scene graph for this camera (can happen multiple times per frame)
         {
             OgreProfileGroup("_updateSceneGraph", OGREPROF_GENERAL);
+            StageTimer timer(mStageTimingEnabled, mStageTimes[FS_UPDATE_SCENE_GRAPH]);
             _updateSceneGraph(camera);
 
             // Auto-track nodes
@@ -1436,8 +1507,19 @@ void SceneManager::_renderScene(Camera* camera, Viewport* vp, bool includeOverla
 
             // Parse the scene and tag visibles
             firePreFindVisibleObjects(vp);
-            _findVisibleObjects(camera, &(camVisObjIt->second),
-                mIlluminationStage == IRS_RENDER_TO_TEXTURE? true : false);
+            uint64 queueingStart = getRenderQueue()->_getQueueingTime();
+            {
+                StageTimer timer(mStageTimingEnabled, mStageTimes[FS_CULLING]);
+                _findVisibleObjects(camera, &(camVisObjIt->second),
+                    mIlluminationStage == IRS_RENDER_TO_TEXTURE? true : false);
+            }
+            if (mStageTimingEnabled)
+            {
+                // the objects queued themselves while the scene was searched
+                uint64 queueing = getRenderQueue()->_getQueueingTime() - queueingStart;
+                mStageTimes[FS_QUEUEING] += queueing;
+                mStageTimes[FS_CULLING] -= queueing;
+            }
             firePostFindVisibleObjects(vp);
 
             mAutoParamDataSource->setMainCamBoundsInfo(&(camVisObjIt->second));
@@ -1449,6 +1531,12 @@ void SceneManager::_renderScene(Camera* camera, Viewport* vp, bool includeOverla
         }
     } // end lock on scene graph mutex
 
+    // The queued objects wrote their per frame geometry, make it visible to the GPU
+    StreamingBufferAllocator* streaming = HardwareBufferManager::getSingletonPtr() ?
+        HardwareBufferManager::getSingleton()._getStreamingBuffersPtr() : 0;
+    if (streaming)
+        streaming->flush();
+
     mDestRenderSystem->_beginGeometryCount();
     // Clear the viewport if required
     if (mCurrentViewport->getClearEveryFrame())
@@ -1692,20 +1780,452 @@ void SceneManager::_updateSceneGraph(Camera* cam)
     // In this implementation, just update from the root
     // Smarter SceneManager subclasses may choose to update only
     //   certain scene graph branches
-    getRootSceneNode()->_update(true, false);
+    // Compute the derived transforms in packed form first, the traversal then picks them up
+    if (mNodeTransformStore)
+        mNodeTransformStore->beginUpdate(getRootSceneNode(), mWorkerThreadPool.get());
+
+    if (mWorkerThreadPool && isSceneGraphUpdateThreadSafe())
+        updateSceneGraphParallel();
+    else
+        getRootSceneNode()->_update(true, false);
+
+    if (mNodeTransformStore)
+        mNodeTransformStore->endUpdate();
 
     firePostUpdateSceneGraph(cam);
 }
 //-----------------------------------------------------------------------
+namespace
+{
+    /// Updates the branches of a NodeUpdateList, handing them out to threads in small batches
+    class UpdateSubtreesTask : public UniformScalableTask
+    {
+        const std::vector<std::pair<Node*, bool> >& mSubtrees;
+        size_t mBatchSize;
+        AtomicScalar<size_t> mNext;
+    public:
+        UpdateSubtreesTask(const std::vector<std::pair<Node*, bool> >& subtrees, size_t batchSize)
+            : mSubtrees(subtrees), mBatchSize(batchSize), mNext(0) {}
+
+        void execute(size_t, size_t)
+        {
+            size_t numSubtrees = mSubtrees.size();
+            size_t begin;
+            while ((begin = mNext.fetch_add(mBatchSize)) < numSubtrees)
+            {
+                size_t end = std::min(begin + mBatchSize, numSubtrees);
+                for (size_t i = begin; i < end; ++i)
+                    mSubtrees[i].first->_update(true, mSubtrees[i].second);
+            }
+        }
+    };
+}
+void SceneManager::updateSceneGraphParallel(void)
+{
+    // Branches are of unknown size, so aim for plenty of them per thread to balance the
+    // load. Descend level by level from the root until there are enough, updating the
+    // nodes above the split here.
+    const size_t numThreads = mWorkerThreadPool->getNumThreads();
+    const size_t minSubtrees = numThreads * 16;
+    const size_t maxSplitDepth = 8;
+
+    mSubtreesToUpdate.clear();
+    mSplitNodes.clear();
+    mSubtreesToUpdate.push_back(std::make_pair(getRootSceneNode(), false));
+
+    for (size_t depth = 0; depth < maxSplitDepth && mSubtreesToUpdate.size() < minSubtrees; ++depth)
+    {
+        mSubtreesToUpdateTmp.clear();
+        for (NodeUpdateList::iterator i = mSubtreesToUpdate.begin(); i != mSubtreesToUpdate.end(); ++i)
+        {
+            mSplitChildrenTmp.clear();
+            bool parentHasChanged = i->first->_updateSelf(i->second, mSplitChildrenTmp);
+            mSplitNodes.push_back(i->first);
+
+            for (std::vector<Node*>::iterator c = mSplitChildrenTmp.begin(); c != mSplitChildrenTmp.end(); ++c)
+                mSubtreesToUpdateTmp.push_back(std::make_pair(*c, parentHasChanged));
+        }
+        mSubtreesToUpdate.swap(mSubtreesToUpdateTmp);
+
+        if (mSubtreesToUpdate.empty())
+            break;
+    }
+
+    if (!mSubtreesToUpdate.empty())
+    {
+        size_t batchSize = std::max<size_t>(mSubtreesToUpdate.size() / minSubtrees, 1);
+        UpdateSubtreesTask task(mSubtreesToUpdate, batchSize);
+        mWorkerThreadPool->execute(&task);
+    }
+
+    // Children were split after their parents, so finishing in reverse order
+    // merges the bounds bottom up
+    for (std::vector<Node*>::reverse_iterator i = mSplitNodes.rbegin(); i != mSplitNodes.rend(); ++i)
+        (*i)->_updateChildrenDone();
+}
+//-----------------------------------------------------------------------
+namespace
+{
+    /// Hash of what the pose of the skeleton of an entity depends on
+    uint32 hashSkeletalAnimationState(const Entity* entity)
+    {
+        const Skeleton* skeleton = entity->getMesh()->getSkeleton().get();
+        uint32 hash = HashCombine(0, skeleton);
+        hash = HashCombine(hash, entity->getSkeleton()->getBlendMode());
+
+        const EnabledAnimationStateList& states = entity->getAllAnimationStates()->getEnabledAnimationStates();
+        for (EnabledAnimationStateList::const_iterator i = states.begin(); i != states.end(); ++i)
+        {
+            const String& name = (*i)->getAnimationName();
+            hash = FastHash(name.c_str(), name.size(), hash);
+            hash = HashCombine(hash, (*i)->getTimePosition());
+            hash = HashCombine(hash, (*i)->getWeight());
+            hash = HashCombine(hash, (*i)->hasBlendMask());
+        }
+        return hash;
+    }
+
+    /// Whether evaluating the skeletons of both entities results in the same pose
+    bool haveSameSkeletalAnimationState(const Entity* a, const Entity* b)
+    {
+        if (a->getMesh()->getSkeleton() != b->getMesh()->getSkeleton() ||
+            a->getSkeleton()->getBlendMode() != b->getSkeleton()->getBlendMode())
+            return false;
+
+        const EnabledAnimationStateList& statesA = a->getAllAnimationStates()->getEnabledAnimationStates();
+        const EnabledAnimationStateList& statesB = b->getAllAnimationStates()->getEnabledAnimationStates();
+        if (statesA.size() != statesB.size())
+            return false;
+
+        EnabledAnimationStateList::const_iterator i, j;
+        for (i = statesA.begin(), j = statesB.begin(); i != statesA.end(); ++i, ++j)
+        {
+            const AnimationState* stateA = *i;
+            const AnimationState* stateB = *j;
+            if (stateA->getAnimationName() != stateB->getAnimationName() ||
+                stateA->getTimePosition() != stateB->getTimePosition() ||
+                stateA->getWeight() != stateB->getWeight() ||
+                stateA->hasBlendMask() != stateB->hasBlendMask() ||
+                (stateA->hasBlendMask() && *stateA->getBlendMask() != *stateB->getBlendMask()))
+                return false;
+        }
+        return true;
+    }
+
+    struct SkeletonLess
+    {
+        bool operator()(const Entity* a, const Entity* b) const { return a->getSkeleton() < b->getSkeleton(); }
+    };
+    struct SkeletonEqual
+    {
+        bool operator()(const Entity* a, const Entity* b) const { return a->getSkeleton() == b->getSkeleton(); }
+    };
+    struct HashLess
+    {
+        bool operator()(const std::pair<uint32, Entity*>& a, const std::pair<uint32, Entity*>& b) const
+        {
+            return a.first < b.first;
+        }
+    };
+
+    /// Evaluates or copies the skeletons of entities, handing them out to threads in small batches
+    class UpdateSkeletonsTask : public UniformScalableTask
+    {
+        const std::vector<std::pair<Entity*, const Entity*> >& mEntities;
+        size_t mBatchSize;
+        AtomicScalar<size_t> mNext;
+    public:
+        UpdateSkeletonsTask(const std::vector<std::pair<Entity*, const Entity*> >& entities, size_t batchSize)
+            : mEntities(entities), mBatchSize(batchSize), mNext(0) {}
+
+        void execute(size_t, size_t)
+        {
+            size_t numEntities = mEntities.size();
+            size_t begin;
+            while ((begin = mNext.fetch_add(mBatchSize)) < numEntities)
+            {
+                size_t end = std::min(begin + mBatchSize, numEntities);
+                for (size_t i = begin; i < end; ++i)
+                {
+                    if (mEntities[i].second)
+                        mEntities[i].first->_copyBoneMatrices(mEntities[i].second);
+                    else
+                        mEntities[i].first->_updateBoneMatrices();
+                }
+            }
+        }
+    };
+}
+void SceneManager::updateSkeletalAnimations(void)
+{
+    mAnimatedEntitiesTmp.clear();
+    mSharedSkeletonEntitiesTmp.clear();
+    mSkeletonUpdates.clear();
+    mSkeletonCopies.clear();
+
+    {
+        MovableObjectCollection* entities = getMovableObjectCollection(EntityFactory::FACTORY_TYPE_NAME);
+        OGRE_LOCK_MUTEX(entities->mutex);
+        for (MovableObjectMap::iterator i = entities->map.begin(); i != entities->map.end(); ++i)
+        {
+            Entity* entity = static_cast<Entity*>(i->second);
+            if (!entity->isInScene() || !entity->isVisible() || !entity->_isSkeletonAnimated() ||
+                !entity->_canUpdateBonesConcurrently() || entity->_isAnimationLodHeld())
+                continue;
+
+            if (entity->sharesSkeletonInstance())
+                mSharedSkeletonEntitiesTmp.push_back(entity);
+            else if (entity->getSkipAnimationStateUpdate() || entity->getSkeleton()->hasManualBones())
+                mSkeletonUpdates.push_back(std::make_pair(entity, (const Entity*)NULL));
+            else
+                mAnimatedEntitiesTmp.push_back(std::make_pair(hashSkeletalAnimationState(entity), entity));
+        }
+    }
+
+    // A skeleton instance shared by several entities must be evaluated only once
+    std::stable_sort(mSharedSkeletonEntitiesTmp.begin(), mSharedSkeletonEntitiesTmp.end(), SkeletonLess());
+    mSharedSkeletonEntitiesTmp.erase(std::unique(mSharedSkeletonEntitiesTmp.begin(),
+        mSharedSkeletonEntitiesTmp.end(), SkeletonEqual()), mSharedSkeletonEntitiesTmp.end());
+    for (std::vector<Entity*>::iterator i = mSharedSkeletonEntitiesTmp.begin(); i != mSharedSkeletonEntitiesTmp.end(); ++i)
+    {
+        if ((*i)->getSkipAnimationStateUpdate() || (*i)->getSkeleton()->hasManualBones())
+            mSkeletonUpdates.push_back(std::make_pair(*i, (const Entity*)NULL));
+        else
+            mAnimatedEntitiesTmp.push_back(std::make_pair(hashSkeletalAnimationState(*i), *i));
+    }
+
+    // Within each run of equal hashes, evaluate the first entity of every distinct
+    // animation state and let the others copy it
+    std::stable_sort(mAnimatedEntitiesTmp.begin(), mAnimatedEntitiesTmp.end(), HashLess());
+    size_t numAnimated = mAnimatedEntitiesTmp.size();
+    for (size_t begin = 0, end; begin < numAnimated; begin = end)
+    {
+        size_t firstLeader = mSkeletonUpdates.size();
+        for (end = begin; end < numAnimated && mAnimatedEntitiesTmp[end].first == mAnimatedEntitiesTmp[begin].first; ++end)
+        {
+            Entity* entity = mAnimatedEntitiesTmp[end].second;
+            const Entity* leader = NULL;
+            for (size_t i = firstLeader; i < mSkeletonUpdates.size() && !leader; ++i)
+            {
+                if (haveSameSkeletalAnimationState(mSkeletonUpdates[i].first, entity))
+                    leader = mSkeletonUpdates[i].first;
+            }
+
+            if (leader)
+                mSkeletonCopies.push_back(std::make_pair(entity, leader));
+            else
+                mSkeletonUpdates.push_back(std::make_pair(entity, (const Entity*)NULL));
+        }
+    }
+
+    if (mSkeletonUpdates.empty())
+        return;
+
+    // Do the lazy initialisation of the animations up front, so they can be applied concurrently
+    mAnimatedSkeletonsTmp.clear();
+    for (SkeletonUpdateList::iterator i = mSkeletonUpdates.begin(); i != mSkeletonUpdates.end(); ++i)
+        mAnimatedSkeletonsTmp.push_back(i->first->getMesh()->getSkeleton().get());
+    std::sort(mAnimatedSkeletonsTmp.begin(), mAnimatedSkeletonsTmp.end());
+    mAnimatedSkeletonsTmp.erase(std::unique(mAnimatedSkeletonsTmp.begin(), mAnimatedSkeletonsTmp.end()),
+                                mAnimatedSkeletonsTmp.end());
+    for (std::vector<Skeleton*>::iterator i = mAnimatedSkeletonsTmp.begin(); i != mAnimatedSkeletonsTmp.end(); ++i)
+        (*i)->_prepareAnimationsForConcurrentApply();
+
+    const size_t numThreads = getNumWorkerThreads();
+    {
+        UpdateSkeletonsTask task(mSkeletonUpdates,
+                                 std::max<size_t>(mSkeletonUpdates.size() / (numThreads * 16), 1));
+        executeUserScalableTask(&task);
+    }
+    if (!mSkeletonCopies.empty())
+    {
+        UpdateSkeletonsTask task(mSkeletonCopies,
+                                 std::max<size_t>(mSkeletonCopies.size() / (numThreads * 16), 1));
+        executeUserScalableTask(&task);
+    }
+}
+//-----------------------------------------------------------------------
+void SceneManager::setNumWorkerThreads(size_t numThreads)
+{
+    if (numThreads == getNumWorkerThreads())
+        return;
+
+    mWorkerThreadPool.reset();
+    if (numThreads != 1)
+    {
+        mWorkerThreadPool.reset(OGRE_NEW WorkerThreadPool(numThreads));
+        // without thread support there is no point keeping it around
+        if (mWorkerThreadPool->getNumThreads() == 1)
+            mWorkerThreadPool.reset();
+    }
+}
+//-----------------------------------------------------------------------
+void SceneManager::executeUserScalableTask(UniformScalableTask* task)
+{
+    if (mWorkerThreadPool)
+        mWorkerThreadPool->execute(task);
+    else
+        task->execute(0, 1);
+}
+//-----------------------------------------------------------------------
+void SceneManager::setNodeTransformStoreEnabled(bool enabled)
+{
+#if OGRE_NODE_INHERIT_TRANSFORM
+    if (enabled)
+    {
+        OGRE_EXCEPT(Exception::ERR_NOT_IMPLEMENTED,
+                    "not supported with OGRE_NODE_INHERIT_TRANSFORM",
+                    "SceneManager::setNodeTransformStoreEnabled");
+    }
+#endif
+    if (enabled == isNodeTransformStoreEnabled())
+        return;
+
+    NodeTransformStore* store = enabled ? OGRE_NEW NodeTransformStore() : NULL;
+
+    if (mSceneRoot)
+        mSceneRoot->_setTransformStore(store);
+    for (SceneNodeList::iterator i = mSceneNodes.begin(); i != mSceneNodes.end(); ++i)
+        (*i)->_setTransformStore(store);
+
+    mNodeTransformStore.reset(store);
+}
+//-----------------------------------------------------------------------
+void SceneManager::setLightGridEnabled(bool enabled)
+{
+    if (enabled == isLightGridEnabled())
+        return;
+
+    mLightGrid.reset(enabled ? OGRE_NEW LightGrid() : NULL);
+    // build on first use
+    mLightGridDirtyCounter = mLightsDirtyCounter - 1;
+}
+//-----------------------------------------------------------------------
+void SceneManager::setStageTimingEnabled(bool enabled)
+{
+    mStageTimingEnabled = enabled;
+    getRenderQueue()->_setQueueingTimed(enabled);
+}
+//-----------------------------------------------------------------------
+void SceneManager::resetStageTimes(void)
+{
+    std::fill(mStageTimes, mStageTimes + FS_COUNT, uint64(0));
+}
+//-----------------------------------------------------------------------
 void SceneManager::_findVisibleObjects(
     Camera* cam, VisibleObjectsBoundsInfo* visibleBounds, bool onlyShadowCasters)
 {
+    if (mParallelCulling && mWorkerThreadPool)
+    {
+        findVisibleObjectsParallel(cam, visibleBounds, onlyShadowCasters);
+        return;
+    }
+
     // Tell nodes to find, cascade down all nodes
     getRootSceneNode()->_findVisibleObjects(cam, getRenderQueue(), visibleBounds, true, 
         mDisplayNodes, onlyShadowCasters);
 
 }
 //-----------------------------------------------------------------------
+namespace
+{
+    /// Culls the branches of a scene graph, each thread into its own render queue
+    class FindVisibleObjectsTask : public UniformScalableTask
+    {
+        const std::vector<SceneNode*>& mSubtrees;
+        std::unique_ptr<RenderQueue>* mQueues;
+        VisibleObjectsBoundsInfo* mBounds;
+        std::vector<MovableObject*>* mDeferredObjects;
+        Camera* mCamera;
+        bool mDisplayNodes;
+        bool mOnlyShadowCasters;
+    public:
+        FindVisibleObjectsTask(const std::vector<SceneNode*>& subtrees, std::unique_ptr<RenderQueue>* queues,
+                               VisibleObjectsBoundsInfo* bounds, std::vector<MovableObject*>* deferredObjects,
+                               Camera* cam, bool displayNodes, bool onlyShadowCasters)
+            : mSubtrees(subtrees), mQueues(queues), mBounds(bounds), mDeferredObjects(deferredObjects),
+              mCamera(cam), mDisplayNodes(displayNodes), mOnlyShadowCasters(onlyShadowCasters) {}
+
+        void execute(size_t threadIdx, size_t numThreads)
+        {
+            // Contiguous ranges, so merging the queues in thread order keeps the traversal order
+            size_t begin = mSubtrees.size() * threadIdx / numThreads;
+            size_t end = mSubtrees.size() * (threadIdx + 1) / numThreads;
+            for (size_t i = begin; i < end; ++i)
+            {
+                mSubtrees[i]->_findVisibleObjects(mCamera, mQueues[threadIdx].get(),
+                                                  mBounds ? &mBounds[threadIdx] : NULL, true, mDisplayNodes,
+                                                  mOnlyShadowCasters, &mDeferredObjects[threadIdx]);
+            }
+        }
+    };
+}
+void SceneManager::findVisibleObjectsParallel(Camera* cam, VisibleObjectsBoundsInfo* visibleBounds,
+                                              bool onlyShadowCasters)
+{
+    const size_t numThreads = mWorkerThreadPool->getNumThreads();
+    const size_t minSubtrees = numThreads * 16;
+    const size_t maxSplitDepth = 8;
+    RenderQueue* queue = getRenderQueue();
+
+    // Cull the nodes above the split here. This also brings the frustum planes
+    // up to date before the camera is shared by the threads.
+    mCullingSubtrees.clear();
+    mCullingSubtrees.push_back(getRootSceneNode());
+
+    for (size_t depth = 0; depth < maxSplitDepth && mCullingSubtrees.size() < minSubtrees; ++depth)
+    {
+        mCullingSubtreesTmp.clear();
+        for (std::vector<SceneNode*>::iterator i = mCullingSubtrees.begin(); i != mCullingSubtrees.end(); ++i)
+        {
+            SceneNode* node = *i;
+            if (!cam->isVisible(node->_getWorldAABB()))
+                continue;
+
+            node->_findVisibleObjects(cam, queue, visibleBounds, false, mDisplayNodes, onlyShadowCasters);
+
+            const Node::ChildNodeMap& children = node->getChildren();
+            for (Node::ChildNodeMap::const_iterator c = children.begin(); c != children.end(); ++c)
+                mCullingSubtreesTmp.push_back(static_cast<SceneNode*>(*c));
+        }
+        mCullingSubtrees.swap(mCullingSubtreesTmp);
+
+        if (mCullingSubtrees.empty())
+            return;
+    }
+
+    mCullingRenderQueues.resize(numThreads);
+    mCullingBounds.resize(numThreads);
+    mCullingDeferredObjects.resize(numThreads);
+    for (size_t t = 0; t < numThreads; ++t)
+    {
+        if (!mCullingRenderQueues[t])
+            mCullingRenderQueues[t].reset(new RenderQueue());
+        mCullingRenderQueues[t]->_copySettings(queue);
+        mCullingBounds[t].reset();
+        mCullingDeferredObjects[t].clear();
+    }
+
+    FindVisibleObjectsTask task(mCullingSubtrees, &mCullingRenderQueues[0], visibleBounds ? &mCullingBounds[0] : NULL,
+                                &mCullingDeferredObjects[0], cam, mDisplayNodes, onlyShadowCasters);
+    mWorkerThreadPool->execute(&task);
+
+    // Merge in thread order, so the result does not depend on the timing of the threads
+    for (size_t t = 0; t < numThreads; ++t)
+    {
+        queue->merge(mCullingRenderQueues[t].get());
+        if (visibleBounds)
+            visibleBounds->merge(mCullingBounds[t]);
+    }
+
+    for (size_t t = 0; t < numThreads; ++t)
+    {
+        std::vector<MovableObject*>& deferred = mCullingDeferredObjects[t];
+        for (std::vector<MovableObject*>::iterator i = deferred.begin(); i != deferred.end(); ++i)
+            queue->processVisibleObject(*i, cam, onlyShadowCasters, visibleBounds);
+    }
+}
+//-----------------------------------------------------------------------
 void SceneManager::_renderVisibleObjects(void)
 {
     RenderQueueInvocationSequence* invocationSequence = 
@@ -1834,6 +2354,33 @@ void SceneManager::SceneMgrQueuedRenderableVisitor::visit(const Pass* p, Rendera
     // Set pass, store the actual one used
     mUsedPass = targetSceneMgr->_setPass(p);
 
+    if (targetSceneMgr->mPerObjectConstantBatching)
+    {
+        // Give SM a chance to eliminate renderables before their constants are packed
+        RenderableList& validated = targetSceneMgr->mPerObjectBlockRenderables;
+        validated.clear();
+        for (Renderable* r : rs)
+        {
+            if (targetSceneMgr->validateRenderableForRendering(mUsedPass, r))
+                validated.push_back(r);
+        }
+
+        // Compute and upload the per-object constants of the whole group at once if possible
+        size_t blockStride = targetSceneMgr->preparePerObjectConstantBlock(mUsedPass, validated);
+        if (blockStride)
+        {
+            size_t blockSlot = targetSceneMgr->mPerObjectBlockSlot;
+            for (Renderable* r : validated)
+            {
+                targetSceneMgr->mPerObjectBlockSlot = blockSlot;
+                blockSlot += blockStride;
+                targetSceneMgr->renderSingleObject(r, mUsedPass, scissoring, autoLights, manualLightList);
+            }
+            targetSceneMgr->mPerObjectBlockActive = false;
+            return;
+        }
+    }
+
     for (Renderable* r : rs)
     {
         // Give SM a chance to eliminate
@@ -1979,7 +2526,10 @@ void SceneManager::renderBasicQueueGroupObjects(RenderQueueGroup* pGroup,
         RenderPriorityGroup* pPriorityGrp = groupIt.getNext();
 
         // Sort the queue first
-        pPriorityGrp->sort(mCameraInProgress);
+        {
+            StageTimer timer(mStageTimingEnabled, mStageTimes[FS_SORTING]);
+            pPriorityGrp->sort(mCameraInProgress);
+        }
 
         // Do solids
         renderObjects(pPriorityGrp->getSolidsBasic(), om, true, true);
@@ -2575,7 +3125,7 @@ void SceneManager::_applySceneAnimations(void)
         const AnimationState* state = *animIt;
         Animation* anim = getAnimation(state->getAnimationName());
         // Apply the animation
-        anim->apply(state->getTimePosition(), state->getWeight());
+        anim->apply(state->getTimePosition(), state->getWeight(), 1.0f, state->_getKeyFrameCursors());
     }
 }
 //---------------------------------------------------------------------
@@ -3974,6 +4524,7 @@ void SceneManager::destroyInstancedEntity( InstancedEntity *instancedEntity )
 //---------------------------------------------------------------------
 void SceneManager::_addDirtyInstanceManager( InstanceManager *dirtyManager )
 {
+    OGRE_WQ_LOCK_MUTEX(mDirtyInstanceManagersMutex);
     mDirtyInstanceManagers.push_back( dirtyManager );
 }
 //---------------------------------------------------------------------
@@ -4400,7 +4951,10 @@ void SceneManager::_notifyMovableObjectLodChanged(MovableObjectLodChangedEvent&
 
     // Push event onto queue if requested
     if (queueEvent)
+    {
+        OGRE_WQ_LOCK_MUTEX(mLodChangedEventsMutex);
         mMovableObjectLodChangedEvents.push_back(evt);
+    }
 }
 //---------------------------------------------------------------------
 void SceneManager::_notifyEntityMeshLodChanged(EntityMeshLodChangedEvent& evt)
@@ -4415,7 +4969,10 @@ void SceneManager::_notifyEntityMeshLodChanged(EntityMeshLodChangedEvent& evt)
 
     // Push event onto queue if requested
     if (queueEvent)
+    {
+        OGRE_WQ_LOCK_MUTEX(mLodChangedEventsMutex);
         mEntityMeshLodChangedEvents.push_back(evt);
+    }
 }
 //---------------------------------------------------------------------
 void SceneManager::_notifyEntityMaterialLodChanged(EntityMaterialLodChangedEvent& evt)
@@ -4430,7 +4987,10 @@ void SceneManager::_notifyEntityMaterialLodChanged(EntityMaterialLodChangedEvent
 
     // Push event onto queue if requested
     if (queueEvent)
+    {
+        OGRE_WQ_LOCK_MUTEX(mLodChangedEventsMutex);
         mEntityMaterialLodChangedEvents.push_back(evt);
+    }
 }
 //---------------------------------------------------------------------
 void SceneManager::_handleLodEvents()
@@ -4510,16 +5070,31 @@ void SceneManager::updateGpuProgramParameters(const Pass* pass)
         if (!mGpuParamsDirty)
             return;
 
-        if (mGpuParamsDirty)
-            pass->_updateAutoParams(mAutoParamDataSource.get(), mGpuParamsDirty);
+        StageTimer timer(mStageTimingEnabled, mStageTimes[FS_AUTO_PARAMS]);
+
+        // per-object constants were already packed into the block, only its offset changes
+        uint16 mask = mGpuParamsDirty;
+        if (mPerObjectBlockActive)
+            mask &= ~(uint16)GPV_PER_OBJECT;
+
+        if (mask)
+            pass->_updateAutoParams(mAutoParamDataSource.get(), mask);
 
         for (int i = 0; i < GPT_COUNT; i++)
         {
             GpuProgramType t = (GpuProgramType)i;
-            if (pass->hasGpuProgram(t))
+            if (!pass->hasGpuProgram(t))
+                continue;
+
+            if (mask)
+                mDestRenderSystem->bindGpuProgramParameters(t, pass->getGpuProgramParameters(t), mask);
+
+            if (mPerObjectBlockActive && (mGpuParamsDirty & GPV_PER_OBJECT) &&
+                mPerObjectBlockOffsets[i] != std::numeric_limits<size_t>::max())
             {
-                mDestRenderSystem->bindGpuProgramParameters(t, pass->getGpuProgramParameters(t),
-                                                            mGpuParamsDirty);
+                mDestRenderSystem->_bindPerObjectConstantBlock(
+                    t, pass->getGpuProgramParameters(t), mPerObjectConstantBlock,
+                    mPerObjectBlockSlot + mPerObjectBlockOffsets[i]);
             }
         }
 
@@ -4528,6 +5103,87 @@ void SceneManager::updateGpuProgramParameters(const Pass* pass)
 
 }
 //---------------------------------------------------------------------
+size_t SceneManager::preparePerObjectConstantBlock(const Pass* pass, const RenderableList& rs)
+{
+    mPerObjectBlockActive = false;
+
+    // passes iterating per light issue several draws per renderable
+    if (!mPerObjectConstantBatching || mSuppressRenderStateChanges || rs.size() < 2 ||
+        !pass->isProgrammable() || pass->getIteratePerLight() || pass->getPassIterationCount() > 1 ||
+        !mDestRenderSystem->_supportsPerObjectConstantBlocks())
+        return 0;
+
+    // common minimum of GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT and D3D11 constant buffer offsets
+    const size_t alignment = 256;
+
+    size_t stride = 0;
+    for (int i = 0; i < GPT_COUNT; i++)
+    {
+        mPerObjectBlockOffsets[i] = std::numeric_limits<size_t>::max();
+        if (!pass->hasGpuProgram((GpuProgramType)i))
+            continue;
+
+        const GpuProgramParametersSharedPtr& params = pass->getGpuProgramParameters((GpuProgramType)i);
+        if (!params->_canPackPerObjectConstants())
+            return 0;
+
+        size_t bytes = params->_getPerObjectConstantCount() * sizeof(float);
+        if (!bytes)
+            continue;
+
+        mPerObjectBlockOffsets[i] = stride;
+        stride += (bytes + alignment - 1) & ~(alignment - 1);
+    }
+
+    if (!stride)
+        return 0;
+
+    StageTimer timer(mStageTimingEnabled, mStageTimes[FS_AUTO_PARAMS]);
+
+    size_t groupSize = stride * rs.size();
+    mPerObjectBlockStaging.resize(groupSize / sizeof(float));
+    for (size_t r = 0; r < rs.size(); ++r)
+    {
+        mAutoParamDataSource->setCurrentRenderable(rs[r]);
+        pass->_updateAutoParams(mAutoParamDataSource.get(), GPV_PER_OBJECT);
+
+        for (int i = 0; i < GPT_COUNT; i++)
+        {
+            if (mPerObjectBlockOffsets[i] == std::numeric_limits<size_t>::max())
+                continue;
+
+            float* dest = &mPerObjectBlockStaging[(r * stride + mPerObjectBlockOffsets[i]) / sizeof(float)];
+            pass->getGpuProgramParameters((GpuProgramType)i)->_packPerObjectConstants(dest);
+        }
+    }
+
+    // append to the ring, orphaning the buffer whenever it wraps around
+    bool wrapped = false;
+    if (!mPerObjectConstantBlock || mPerObjectConstantBlock->getSizeInBytes() < groupSize)
+    {
+        size_t capacity = 64 * 1024;
+        while (capacity < groupSize)
+            capacity <<= 1;
+        mPerObjectConstantBlock = HardwareBufferManager::getSingleton().createUniformBuffer(
+            capacity, HardwareBuffer::HBU_DYNAMIC_WRITE_ONLY_DISCARDABLE, false,
+            mName + "/PerObjectConstants");
+        mPerObjectBlockWritePos = 0;
+    }
+    else if (mPerObjectBlockWritePos + groupSize > mPerObjectConstantBlock->getSizeInBytes())
+    {
+        mPerObjectBlockWritePos = 0;
+        wrapped = true;
+    }
+
+    mPerObjectConstantBlock->writeData(mPerObjectBlockWritePos, groupSize,
+                                       mPerObjectBlockStaging.data(), wrapped);
+    mPerObjectBlockSlot = mPerObjectBlockWritePos;
+    mPerObjectBlockWritePos += groupSize;
+    mPerObjectBlockActive = true;
+
+    return stride;
+}
+//---------------------------------------------------------------------
 void SceneManager::_issueRenderOp(Renderable* rend, const Pass* pass)
 {
     if(rend->preRender(this, mDestRenderSystem))
@@ -4586,6 +5242,16 @@ void VisibleObjectsBoundsInfo::mergeNonRenderedButInFrustum(const AxisAlignedBox
     maxDistanceInFrustum = std::max(maxDistanceInFrustum, camDistToCenter + sphereBounds.getRadius());
 
 }
+//---------------------------------------------------------------------
+void VisibleObjectsBoundsInfo::merge(const VisibleObjectsBoundsInfo& rhs)
+{
+    aabb.merge(rhs.aabb);
+    receiverAabb.merge(rhs.receiverAabb);
+    minDistance = std::min(minDistance, rhs.minDistance);
+    maxDistance = std::max(maxDistance, rhs.maxDistance);
+    minDistanceInFrustum = std::min(minDistanceInFrustum, rhs.minDistanceInFrustum);
+    maxDistanceInFrustum = std::max(maxDistanceInFrustum, rhs.maxDistanceInFrustum);
+}
 
 
 
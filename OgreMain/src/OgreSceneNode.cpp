@@ -63,6 +63,12 @@ namespace Ogre {
         _updateBounds();
     }
     //-----------------------------------------------------------------------
+    void SceneNode::_updateChildrenDone(void)
+    {
+        Node::_updateChildrenDone();
+        _updateBounds();
+    }
+    //-----------------------------------------------------------------------
     void SceneNode::setParent(Node* parent)
     {
         Node::setParent(parent);
@@ -257,7 +263,7 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void SceneNode::_findVisibleObjects(Camera* cam, RenderQueue* queue, 
         VisibleObjectsBoundsInfo* visibleBounds, bool includeChildren, 
-        bool displayNodes, bool onlyShadowCasters)
+        bool displayNodes, bool onlyShadowCasters, std::vector<MovableObject*>* deferredObjects)
     {
         // Check self visible
         if (!cam->isVisible(mWorldAABB))
@@ -270,7 +276,10 @@ namespace Ogre {
         {
             MovableObject* mo = *iobj;
 
-            queue->processVisibleObject(mo, cam, onlyShadowCasters, visibleBounds);
+            if (deferredObjects && !mo->_canQueueConcurrently())
+                deferredObjects->push_back(mo);
+            else
+                queue->processVisibleObject(mo, cam, onlyShadowCasters, visibleBounds);
         }
 
         if (includeChildren)
@@ -281,7 +290,7 @@ namespace Ogre {
             {
                 SceneNode* sceneChild = static_cast<SceneNode*>(*child);
                 sceneChild->_findVisibleObjects(cam, queue, visibleBounds, includeChildren, 
-                    displayNodes, onlyShadowCasters);
+                    displayNodes, onlyShadowCasters, deferredObjects);
             }
         }
 
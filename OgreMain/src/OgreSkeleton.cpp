@@ -243,17 +243,33 @@ namespace Ogre {
               if(animState->hasBlendMask())
               {
                 anim->apply(this, animState->getTimePosition(), animState->getWeight() * weightFactor,
-                  animState->getBlendMask(), linked ? linked->scale : 1.0f);
+                  animState->getBlendMask(), linked ? linked->scale : 1.0f, animState->_getKeyFrameCursors());
               }
               else
               {
                 anim->apply(this, animState->getTimePosition(), 
-                  animState->getWeight() * weightFactor, linked ? linked->scale : 1.0f);
+                  animState->getWeight() * weightFactor, linked ? linked->scale : 1.0f,
+                  animState->_getKeyFrameCursors());
               }
             }
         }
 
 
+    }
+    //---------------------------------------------------------------------
+    void Skeleton::_prepareAnimationsForConcurrentApply(void)
+    {
+        for (AnimationList::iterator i = mAnimationsList.begin(); i != mAnimationsList.end(); ++i)
+        {
+            i->second->_prepareForConcurrentApply();
+        }
+
+        LinkedSkeletonAnimSourceList::iterator it;
+        for (it = mLinkedSkeletonAnimSourceList.begin(); it != mLinkedSkeletonAnimSourceList.end(); ++it)
+        {
+            if (it->pSkeleton)
+                it->pSkeleton->_prepareAnimationsForConcurrentApply();
+        }
     }
     //---------------------------------------------------------------------
     void Skeleton::setBindingPose(void)
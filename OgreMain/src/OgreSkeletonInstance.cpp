@@ -107,6 +107,11 @@ namespace Ogre {
         mSkeleton->_refreshAnimationState(animSet);
     }
     //-------------------------------------------------------------------------
+    void SkeletonInstance::_prepareAnimationsForConcurrentApply(void)
+    {
+        mSkeleton->_prepareAnimationsForConcurrentApply();
+    }
+    //-------------------------------------------------------------------------
     void SkeletonInstance::cloneBoneAndChildren(Bone* source, Bone* parent)
     {
         Bone* newBone;
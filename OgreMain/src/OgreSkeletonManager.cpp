@@ -45,6 +45,7 @@ namespace Ogre
     {
         mLoadOrder = 300.0f;
         mResourceType = "Skeleton";
+        mConcurrentPrepare = true;
 
         ResourceGroupManager::getSingleton()._registerResourceManager(mResourceType, this);
     }
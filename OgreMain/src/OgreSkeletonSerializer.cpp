@@ -32,6 +32,7 @@ THE SOFTWARE.
 #include "OgreAnimation.h"
 #include "OgreAnimationTrack.h"
 #include "OgreKeyFrame.h"
+#include "OgreCompressedNodeAnimation.h"
 
 namespace Ogre {
     /// stream overhead = ID + size
@@ -124,7 +125,8 @@ namespace Ogre {
         // Read version
         String ver = readString(stream);
         if ((ver != "[Serializer_v1.10]") &&
-            (ver != "[Serializer_v1.80]"))
+            (ver != "[Serializer_v1.80]") &&
+            (ver != "[Serializer_v1.110]"))
         {
             OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR,
                 "Invalid file: version incompatible, file reports " + String(ver),
@@ -176,7 +178,9 @@ namespace Ogre {
     {
         if (ver == SKELETON_VERSION_1_0)
             mVersion = "[Serializer_v1.10]";
-        else mVersion = "[Serializer_v1.80]";
+        else if (ver == SKELETON_VERSION_1_8)
+            mVersion = "[Serializer_v1.80]";
+        else mVersion = "[Serializer_v1.110]";
     }
     //---------------------------------------------------------------------
     void SkeletonSerializer::writeSkeleton(const Skeleton* pSkel, SkeletonVersion ver)
@@ -250,6 +254,15 @@ namespace Ogre {
     void SkeletonSerializer::writeAnimation(const Skeleton* pSkel, 
         const Animation* anim, SkeletonVersion ver)
     {
+        const CompressedNodeAnimation* compressedTracks = anim->getCompressedNodeTracks();
+        if (compressedTracks && !anim->getNumNodeTracks() && (int)ver < (int)SKELETON_VERSION_1_11)
+        {
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS,
+                "Animation " + anim->getName() + " only has compressed node tracks, "
+                "which need SKELETON_VERSION_1_11 or later",
+                "SkeletonSerializer::writeAnimation");
+        }
+
         writeChunkHeader(SKELETON_ANIMATION, calcAnimationSize(pSkel, anim, ver));
 
         // char* name                       : Name of the animation
@@ -286,6 +299,11 @@ namespace Ogre {
         {
             writeAnimationTrack(pSkel, trackIt.getNext());
         }
+
+        if (compressedTracks && (int)ver >= (int)SKELETON_VERSION_1_11)
+        {
+            writeCompressedNodeAnimation(compressedTracks);
+        }
         }
         popInnerChunk(mStream);
 
@@ -329,6 +347,46 @@ namespace Ogre {
         }
     }
     //---------------------------------------------------------------------
+    void SkeletonSerializer::writeCompressedNodeAnimation(const CompressedNodeAnimation* tracks)
+    {
+        writeChunkHeader(SKELETON_ANIMATION_COMPRESSED, calcCompressedNodeAnimationSize(tracks));
+
+        // unsigned short numTracks
+        uint16 numTracks = static_cast<uint16>(tracks->mHandles.size());
+        writeShorts(&numTracks, 1);
+        // unsigned int numKeys             : including the first key wrapped around
+        uint32 numKeys = static_cast<uint32>(tracks->mTimes.size());
+        writeInts(&numKeys, 1);
+        // bool hasTranslations
+        bool hasTranslations = tracks->hasTranslationKeys();
+        writeBools(&hasTranslations, 1);
+        // bool hasScales
+        bool hasScales = tracks->hasScaleKeys();
+        writeBools(&hasScales, 1);
+        if (!numTracks || !numKeys)
+            return;
+
+        // unsigned short handles[numTracks]
+        writeShorts(&tracks->mHandles[0], numTracks);
+        // unsigned char useShortestRotationPath[numTracks]
+        writeData(&tracks->mUseShortestRotationPath[0], 1, numTracks);
+        // float times[numKeys]
+        writeFloats(&tracks->mTimes[0], numKeys);
+        // float translationBase, translationStep, scaleBase, scaleStep [numGroups * 12]
+        writeFloats(&tracks->mTranslationBase[0], tracks->mTranslationBase.size());
+        writeFloats(&tracks->mTranslationStep[0], tracks->mTranslationStep.size());
+        writeFloats(&tracks->mScaleBase[0], tracks->mScaleBase.size());
+        writeFloats(&tracks->mScaleStep[0], tracks->mScaleStep.size());
+        // short rotations[numKeys * numGroups * 16]
+        writeShorts(reinterpret_cast<const uint16*>(&tracks->mRotations[0]), tracks->mRotations.size());
+        // unsigned short translations[numKeys * numGroups * 12]
+        if (hasTranslations)
+            writeShorts(&tracks->mTranslations[0], tracks->mTranslations.size());
+        // unsigned short scales[numKeys * numGroups * 12]
+        if (hasScales)
+            writeShorts(&tracks->mScales[0], tracks->mScales.size());
+    }
+    //---------------------------------------------------------------------
     size_t SkeletonSerializer::calcBoneSize(const Skeleton* pSkel, 
         const Bone* pBone)
     {
@@ -405,6 +463,11 @@ namespace Ogre {
             size += calcAnimationTrackSize(pSkel, trackIt.getNext());
         }
 
+        if (pAnim->getCompressedNodeTracks() && (int)ver >= (int)SKELETON_VERSION_1_11)
+        {
+            size += calcCompressedNodeAnimationSize(pAnim->getCompressedNodeTracks());
+        }
+
         return size;
     }
     //---------------------------------------------------------------------
@@ -454,6 +517,28 @@ namespace Ogre {
         return size;
     }
     //---------------------------------------------------------------------
+    size_t SkeletonSerializer::calcCompressedNodeAnimationSize(const CompressedNodeAnimation* pTracks)
+    {
+        size_t size = SSTREAM_OVERHEAD_SIZE;
+
+        // unsigned short numTracks, unsigned int numKeys
+        size += sizeof(uint16) + sizeof(uint32);
+        // bool hasTranslations, bool hasScales
+        size += sizeof(bool) * 2;
+        // unsigned short handles, unsigned char useShortestRotationPath
+        size += pTracks->mHandles.size() * (sizeof(uint16) + sizeof(uint8));
+        // float times
+        size += pTracks->mTimes.size() * sizeof(float);
+        // float translationBase, translationStep, scaleBase, scaleStep
+        size += (pTracks->mTranslationBase.size() + pTracks->mTranslationStep.size() +
+                 pTracks->mScaleBase.size() + pTracks->mScaleStep.size()) * sizeof(float);
+        // short rotations, unsigned short translations, unsigned short scales
+        size += (pTracks->mRotations.size() + pTracks->mTranslations.size() +
+                 pTracks->mScales.size()) * sizeof(uint16);
+
+        return size;
+    }
+    //---------------------------------------------------------------------
     void SkeletonSerializer::readBone(DataStreamPtr& stream, Skeleton* pSkel)
     {
         // char* name
@@ -543,9 +628,13 @@ namespace Ogre {
                 }
             }
             
-            while(streamID == SKELETON_ANIMATION_TRACK && !stream->eof())
+            while((streamID == SKELETON_ANIMATION_TRACK ||
+                   streamID == SKELETON_ANIMATION_COMPRESSED) && !stream->eof())
             {
-                readAnimationTrack(stream, pAnim, pSkel);
+                if (streamID == SKELETON_ANIMATION_TRACK)
+                    readAnimationTrack(stream, pAnim, pSkel);
+                else
+                    readCompressedNodeAnimation(stream, pAnim);
 
                 if (!stream->eof())
                 {
@@ -627,6 +716,62 @@ namespace Ogre {
         }
     }
     //---------------------------------------------------------------------
+    void SkeletonSerializer::readCompressedNodeAnimation(DataStreamPtr& stream, Animation* anim)
+    {
+        CompressedNodeAnimation* tracks = OGRE_NEW CompressedNodeAnimation();
+        anim->_setCompressedNodeTracks(tracks);
+
+        // unsigned short numTracks
+        uint16 numTracks;
+        readShorts(stream, &numTracks, 1);
+        // unsigned int numKeys             : including the first key wrapped around
+        uint32 numKeys;
+        readInts(stream, &numKeys, 1);
+        // bool hasTranslations
+        bool hasTranslations;
+        readBools(stream, &hasTranslations, 1);
+        // bool hasScales
+        bool hasScales;
+        readBools(stream, &hasScales, 1);
+        if (!numTracks || !numKeys)
+            return;
+
+        const size_t numGroups = (numTracks + 3) / 4;
+        // unsigned short handles[numTracks]
+        tracks->mHandles.resize(numTracks);
+        readShorts(stream, &tracks->mHandles[0], numTracks);
+        // unsigned char useShortestRotationPath[numTracks]
+        tracks->mUseShortestRotationPath.resize(numTracks);
+        stream->read(&tracks->mUseShortestRotationPath[0], numTracks);
+        // float times[numKeys]
+        tracks->mTimes.resize(numKeys);
+        readFloats(stream, &tracks->mTimes[0], numKeys);
+        // float translationBase, translationStep, scaleBase, scaleStep [numGroups * 12]
+        tracks->mTranslationBase.resize(numGroups * 12);
+        readFloats(stream, &tracks->mTranslationBase[0], numGroups * 12);
+        tracks->mTranslationStep.resize(numGroups * 12);
+        readFloats(stream, &tracks->mTranslationStep[0], numGroups * 12);
+        tracks->mScaleBase.resize(numGroups * 12);
+        readFloats(stream, &tracks->mScaleBase[0], numGroups * 12);
+        tracks->mScaleStep.resize(numGroups * 12);
+        readFloats(stream, &tracks->mScaleStep[0], numGroups * 12);
+        // short rotations[numKeys * numGroups * 16]
+        tracks->mRotations.resize(numKeys * numGroups * 16);
+        readShorts(stream, reinterpret_cast<uint16*>(&tracks->mRotations[0]), tracks->mRotations.size());
+        // unsigned short translations[numKeys * numGroups * 12]
+        if (hasTranslations)
+        {
+            tracks->mTranslations.resize(numKeys * numGroups * 12);
+            readShorts(stream, &tracks->mTranslations[0], tracks->mTranslations.size());
+        }
+        // unsigned short scales[numKeys * numGroups * 12]
+        if (hasScales)
+        {
+            tracks->mScales.resize(numKeys * numGroups * 12);
+            readShorts(stream, &tracks->mScales[0], tracks->mScales.size());
+        }
+    }
+    //---------------------------------------------------------------------
     void SkeletonSerializer::writeSkeletonAnimationLink(const Skeleton* pSkel, 
         const LinkedSkeletonAnimationSource& link)
     {
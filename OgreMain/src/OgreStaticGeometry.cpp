@@ -868,6 +868,23 @@ namespace Ogre {
             mLodValue);
     }
     //---------------------------------------------------------------------
+    bool StaticGeometry::Region::_canQueueConcurrently(void) const
+    {
+        // Queueing touches the materials, which must not load or compile them
+        for (LODBucketList::const_iterator i = mLodBucketList.begin(); i != mLodBucketList.end(); ++i)
+        {
+            const LODBucket::MaterialBucketMap& buckets = (*i)->getMaterialBucketMap();
+            for (LODBucket::MaterialBucketMap::const_iterator m = buckets.begin();
+                 m != buckets.end(); ++m)
+            {
+                const MaterialPtr& mat = m->second->getMaterial();
+                if (mat && !mat->_isReadyForConcurrentUse())
+                    return false;
+            }
+        }
+        return true;
+    }
+    //---------------------------------------------------------------------
     void StaticGeometry::Region::visitRenderables(Renderable::Visitor* visitor, 
         bool debugRenderables)
     {
@@ -0,0 +1,221 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgreStreamingBufferAllocator.h"
+#include "OgreHardwareBufferManager.h"
+
+namespace Ogre {
+    //-----------------------------------------------------------------------
+    StreamingBufferAllocator::StreamingBufferAllocator(HardwareBufferManagerBase* mgr)
+        : mMgr(mgr), mFramesInFlight(3), mFrameNumber(0), mInitialSize(1024 * 1024), mEnabled(false)
+    {
+        mIndexRings[HardwareIndexBuffer::IT_16BIT].elementSize = sizeof(uint16);
+        mIndexRings[HardwareIndexBuffer::IT_32BIT].elementSize = sizeof(uint32);
+        mIndexRings[HardwareIndexBuffer::IT_16BIT].isIndexRing = true;
+        mIndexRings[HardwareIndexBuffer::IT_32BIT].isIndexRing = true;
+    }
+    //-----------------------------------------------------------------------
+    StreamingBufferAllocator::~StreamingBufferAllocator()
+    {
+    }
+    //-----------------------------------------------------------------------
+    void* StreamingBufferAllocator::allocateVertices(size_t vertexSize, size_t numVertices,
+                                                     HardwareVertexBufferSharedPtr& buffer, size_t& vertexStart)
+    {
+        Ring& ring = mVertexRings[vertexSize];
+        ring.elementSize = vertexSize;
+
+        vertexStart = allocate(ring, numVertices);
+        buffer = ring.vertexBuffer;
+        return ring.data + vertexStart * vertexSize;
+    }
+    //-----------------------------------------------------------------------
+    void* StreamingBufferAllocator::allocateIndexes(HardwareIndexBuffer::IndexType itype, size_t numIndexes,
+                                                    HardwareIndexBufferSharedPtr& buffer, size_t& indexStart)
+    {
+        Ring& ring = mIndexRings[itype];
+
+        indexStart = allocate(ring, numIndexes);
+        buffer = ring.indexBuffer;
+        return ring.data + indexStart * ring.elementSize;
+    }
+    //-----------------------------------------------------------------------
+    size_t StreamingBufferAllocator::allocate(Ring& ring, size_t count)
+    {
+        if (ring.buffer && count <= ring.capacity)
+        {
+            uint64 pos = ring.head;
+            size_t offset = static_cast<size_t>(pos % ring.capacity);
+            if (offset + count > ring.capacity)
+            {
+                // allocations never straddle the end, continue at the start
+                flush(ring);
+                pos += ring.capacity - offset;
+                offset = 0;
+                ring.flushed = pos;
+            }
+
+            if (pos + count - ring.tail <= ring.capacity)
+            {
+                ring.head = pos + count;
+                return offset;
+            }
+        }
+
+        grow(ring, count);
+        ring.head = count;
+        return 0;
+    }
+    //-----------------------------------------------------------------------
+    void StreamingBufferAllocator::grow(Ring& ring, size_t count)
+    {
+        // the data still in flight stays in the old buffer, which lives as long as it is bound
+        if (ring.buffer)
+            flush(ring);
+
+        size_t capacity = std::max(ring.capacity * 2, mInitialSize / ring.elementSize);
+        capacity = std::max(std::max(capacity, count), size_t(1));
+
+        if (ring.isIndexRing)
+        {
+            ring.indexBuffer = mMgr->createIndexBuffer(
+                ring.elementSize == sizeof(uint16) ? HardwareIndexBuffer::IT_16BIT : HardwareIndexBuffer::IT_32BIT,
+                capacity, HardwareBuffer::HBU_DYNAMIC_WRITE_ONLY);
+            ring.buffer = ring.indexBuffer.get();
+        }
+        else
+        {
+            ring.vertexBuffer = mMgr->createVertexBuffer(ring.elementSize, capacity,
+                                                         HardwareBuffer::HBU_DYNAMIC_WRITE_ONLY);
+            ring.buffer = ring.vertexBuffer.get();
+        }
+
+        ring.data = static_cast<uchar*>(ring.buffer->_getPersistentMapping());
+        if (ring.data)
+        {
+            std::vector<uchar>().swap(ring.staging);
+        }
+        else
+        {
+            ring.staging.resize(capacity * ring.elementSize);
+            ring.data = &ring.staging[0];
+        }
+
+        ring.capacity = capacity;
+        ring.head = ring.tail = ring.flushed = ring.frameStart = 0;
+        ring.frameStarts.clear();
+    }
+    //-----------------------------------------------------------------------
+    void StreamingBufferAllocator::flush(Ring& ring)
+    {
+        if (ring.head == ring.flushed)
+            return;
+
+        // the unflushed range never wraps, see allocate
+        size_t offset = static_cast<size_t>(ring.flushed % ring.capacity) * ring.elementSize;
+        size_t length = static_cast<size_t>(ring.head - ring.flushed) * ring.elementSize;
+
+        if (ring.staging.empty())
+            ring.buffer->_flushPersistentRange(offset, length);
+        else
+            ring.buffer->writeData(offset, length, ring.data + offset);
+
+        ring.flushed = ring.head;
+    }
+    //-----------------------------------------------------------------------
+    void StreamingBufferAllocator::flush(void)
+    {
+        for (VertexRingMap::iterator i = mVertexRings.begin(); i != mVertexRings.end(); ++i)
+        {
+            if (i->second.buffer)
+                flush(i->second);
+        }
+        for (size_t i = 0; i < 2; ++i)
+        {
+            if (mIndexRings[i].buffer)
+                flush(mIndexRings[i]);
+        }
+    }
+    //-----------------------------------------------------------------------
+    void StreamingBufferAllocator::endFrame(Ring& ring)
+    {
+        ring.frameStarts.push_back(ring.frameStart);
+        ring.frameStart = ring.head;
+        // keep the ended frames which are still in flight besides the next one
+        while (ring.frameStarts.size() >= mFramesInFlight)
+            ring.frameStarts.pop_front();
+        ring.tail = ring.frameStarts.empty() ? ring.frameStart : ring.frameStarts.front();
+    }
+    //-----------------------------------------------------------------------
+    void StreamingBufferAllocator::_notifyFrameEnded(void)
+    {
+        ++mFrameNumber;
+
+        for (VertexRingMap::iterator i = mVertexRings.begin(); i != mVertexRings.end(); ++i)
+        {
+            if (i->second.buffer)
+                endFrame(i->second);
+        }
+        for (size_t i = 0; i < 2; ++i)
+        {
+            if (mIndexRings[i].buffer)
+                endFrame(mIndexRings[i]);
+        }
+    }
+    //-----------------------------------------------------------------------
+    void StreamingBufferAllocator::setFramesInFlight(size_t frames)
+    {
+        OgreAssert(frames > 0, "at least the current frame is in flight");
+        mFramesInFlight = frames;
+    }
+    //-----------------------------------------------------------------------
+    size_t StreamingBufferAllocator::getBufferCount(void) const
+    {
+        size_t count = mIndexRings[0].buffer ? 1 : 0;
+        count += mIndexRings[1].buffer ? 1 : 0;
+        for (VertexRingMap::const_iterator i = mVertexRings.begin(); i != mVertexRings.end(); ++i)
+            count += i->second.buffer ? 1 : 0;
+        return count;
+    }
+    //-----------------------------------------------------------------------
+    void StreamingBufferAllocator::_releaseBuffers(void)
+    {
+        mVertexRings.clear();
+        for (size_t i = 0; i < 2; ++i)
+        {
+            Ring& ring = mIndexRings[i];
+            ring.indexBuffer.reset();
+            ring.buffer = 0;
+            ring.data = 0;
+            std::vector<uchar>().swap(ring.staging);
+            ring.capacity = 0;
+            ring.head = ring.tail = ring.flushed = ring.frameStart = 0;
+            ring.frameStarts.clear();
+        }
+    }
+}
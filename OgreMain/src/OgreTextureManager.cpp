@@ -47,6 +47,7 @@ namespace Ogre {
     {
         mResourceType = "Texture";
         mLoadOrder = 75.0f;
+        mConcurrentPrepare = true;
 
         // Subclasses should register (when this is fully constructed)
     }
@@ -0,0 +1,128 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgreWorkerThreadPool.h"
+
+namespace Ogre
+{
+    //---------------------------------------------------------------------
+    WorkerThreadPool::WorkerThreadPool(size_t numThreads)
+        : mNumThreads(1), mTask(0), mTaskCounter(0), mPendingThreads(0), mShuttingDown(false)
+    {
+#if OGRE_THREAD_SUPPORT
+        if (numThreads == 0)
+            numThreads = std::max<size_t>(OGRE_THREAD_HARDWARE_CONCURRENCY, 1);
+        mNumThreads = numThreads;
+
+        // the calling thread is the first one of the pool
+        for (size_t i = 1; i < mNumThreads; ++i)
+        {
+            WorkerFunc worker(this, i);
+            OGRE_THREAD_CREATE(t, worker);
+            mWorkers.push_back(t);
+        }
+#else
+        (void)numThreads;
+#endif
+    }
+    //---------------------------------------------------------------------
+    WorkerThreadPool::~WorkerThreadPool()
+    {
+#if OGRE_THREAD_SUPPORT
+        {
+            OGRE_WQ_LOCK_MUTEX(mMutex);
+            mShuttingDown = true;
+        }
+        OGRE_THREAD_NOTIFY_ALL(mTaskAvailableSync);
+
+        for (WorkerThreadList::iterator i = mWorkers.begin(); i != mWorkers.end(); ++i)
+        {
+            (*i)->join();
+            OGRE_THREAD_DESTROY(*i);
+        }
+        mWorkers.clear();
+#endif
+    }
+    //---------------------------------------------------------------------
+    void WorkerThreadPool::execute(UniformScalableTask* task)
+    {
+        if (mNumThreads == 1)
+        {
+            task->execute(0, 1);
+            return;
+        }
+
+#if OGRE_THREAD_SUPPORT
+        {
+            OGRE_WQ_LOCK_MUTEX(mMutex);
+            mTask = task;
+            mPendingThreads = mNumThreads - 1;
+            ++mTaskCounter;
+        }
+        OGRE_THREAD_NOTIFY_ALL(mTaskAvailableSync);
+
+        task->execute(0, mNumThreads);
+
+        OGRE_WQ_LOCK_MUTEX_NAMED(mMutex, lock);
+        while (mPendingThreads != 0)
+            OGRE_THREAD_WAIT(mTaskDoneSync, mMutex, lock);
+        mTask = 0;
+#endif
+    }
+    //---------------------------------------------------------------------
+    void WorkerThreadPool::_threadMain(size_t threadIdx)
+    {
+#if OGRE_THREAD_SUPPORT
+        uint32 lastTask = 0;
+
+        while (true)
+        {
+            UniformScalableTask* task;
+            {
+                OGRE_WQ_LOCK_MUTEX_NAMED(mMutex, lock);
+                while (!mShuttingDown && mTaskCounter == lastTask)
+                    OGRE_THREAD_WAIT(mTaskAvailableSync, mMutex, lock);
+
+                if (mShuttingDown)
+                    return;
+
+                lastTask = mTaskCounter;
+                task = mTask;
+            }
+
+            task->execute(threadIdx, mNumThreads);
+
+            OGRE_WQ_LOCK_MUTEX(mMutex);
+            if (--mPendingThreads == 0)
+                OGRE_THREAD_NOTIFY_ALL(mTaskDoneSync);
+        }
+#else
+        (void)threadIdx;
+#endif
+    }
+}
@@ -0,0 +1,688 @@
+/*-------------------------------------------------------------------------
+This source file is a part of OGRE
+(Object-oriented Graphics Rendering Engine)
+
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE
+-------------------------------------------------------------------------*/
+#include "OgreStableHeaders.h"
+#include "OgreWorkStealingWorkQueue.h"
+#include "OgreTimer.h"
+
+#include <thread>
+
+namespace Ogre
+{
+    //---------------------------------------------------------------------
+    bool WorkStealingWorkQueue::RequestFilter::matches(const Request* r) const
+    {
+        switch (type)
+        {
+        case ID:
+            return r->getID() == id;
+        case CHANNEL:
+            return r->getChannel() == channel;
+        default:
+            return true;
+        }
+    }
+    //---------------------------------------------------------------------
+    WorkStealingWorkQueue::WorkStealingWorkQueue(const String& name)
+        : DefaultWorkQueueBase(name)
+        , mNextDeque(0)
+        , mNextWorker(0)
+        , mNextRequestID(0)
+        , mPendingIdleRequests(0)
+        , mIdleRequestsRunning(false)
+        , mResponseStack(0)
+        , mRequestHandlerSnapshot(new RequestHandlerSnapshot())
+        , mSleepingWorkers(0)
+        , mNumThreadsRegisteredWithRS(0)
+    {
+        for (int p = 0; p < NUM_PRIORITIES; ++p)
+            mPendingRequests[p] = 0;
+
+        // requests may be queued before startup
+        resizeDeques(1);
+    }
+    //---------------------------------------------------------------------
+    WorkStealingWorkQueue::~WorkStealingWorkQueue()
+    {
+        shutdown();
+
+        for (RequestDequeList::iterator i = mDeques.begin(); i != mDeques.end(); ++i)
+        {
+            for (int p = 0; p < NUM_PRIORITIES; ++p)
+            {
+                for (RequestQueue::iterator j = (*i)->requests[p].begin(); j != (*i)->requests[p].end(); ++j)
+                    OGRE_DELETE *j;
+            }
+            OGRE_DELETE *i;
+        }
+        mDeques.clear();
+
+        for (RequestQueue::iterator i = mIdleRequestQueue.begin(); i != mIdleRequestQueue.end(); ++i)
+            OGRE_DELETE *i;
+        mIdleRequestQueue.clear();
+
+        // the base class deletes mResponseQueue
+        collectResponses();
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::setChannelPriority(uint16 channel, uint8 priority)
+    {
+        OGRE_WQ_LOCK_MUTEX(mChannelPriorityMutex);
+        mChannelPriorities[channel] = std::min<uint8>(priority, NUM_PRIORITIES - 1);
+    }
+    //---------------------------------------------------------------------
+    uint8 WorkStealingWorkQueue::getChannelPriority(uint16 channel) const
+    {
+        OGRE_WQ_LOCK_MUTEX(mChannelPriorityMutex);
+        ChannelPriorityMap::const_iterator i = mChannelPriorities.find(channel);
+        return i != mChannelPriorities.end() ? i->second : 0;
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::resizeDeques(size_t count)
+    {
+        RequestDequeList oldDeques;
+        oldDeques.swap(mDeques);
+
+        for (size_t i = 0; i < count; ++i)
+            mDeques.push_back(OGRE_NEW RequestDeque());
+
+        // requests queued while the queue was not running
+        for (RequestDequeList::iterator i = oldDeques.begin(); i != oldDeques.end(); ++i)
+        {
+            for (int p = 0; p < NUM_PRIORITIES; ++p)
+            {
+                RequestQueue& requests = mDeques[(i - oldDeques.begin()) % count]->requests[p];
+                requests.insert(requests.end(), (*i)->requests[p].begin(), (*i)->requests[p].end());
+            }
+            OGRE_DELETE *i;
+        }
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::startup(bool forceRestart)
+    {
+        if (mIsRunning)
+        {
+            if (forceRestart)
+                shutdown();
+            else
+                return;
+        }
+
+        mShuttingDown = false;
+
+        mWorkerFunc = OGRE_NEW_T(WorkerFunc(this), MEMCATEGORY_GENERAL);
+
+        LogManager::getSingleton().stream() <<
+            "WorkStealingWorkQueue('" << mName << "') initialising on thread " <<
+            OGRE_THREAD_CURRENT_ID
+            << ".";
+
+#if OGRE_THREAD_SUPPORT
+        resizeDeques(std::max<size_t>(mWorkerThreadCount, 1));
+        mNextWorker = 0;
+
+        if (mWorkerRenderSystemAccess)
+            Root::getSingleton().getRenderSystem()->preExtraThreadsStarted();
+
+        mNumThreadsRegisteredWithRS = 0;
+        for (size_t i = 0; i < mWorkerThreadCount; ++i)
+        {
+            OGRE_THREAD_CREATE(t, *mWorkerFunc);
+            mWorkers.push_back(t);
+        }
+
+        if (mWorkerRenderSystemAccess)
+        {
+            OGRE_WQ_LOCK_MUTEX_NAMED(mInitMutex, initLock);
+            // have to wait until all threads are registered with the render system
+            while (mNumThreadsRegisteredWithRS < mWorkerThreadCount)
+                OGRE_THREAD_WAIT(mInitSync, mInitMutex, initLock);
+
+            Root::getSingleton().getRenderSystem()->postExtraThreadsStarted();
+        }
+#endif
+
+        mIsRunning = true;
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::notifyThreadRegistered()
+    {
+        OGRE_WQ_LOCK_MUTEX(mInitMutex);
+
+        ++mNumThreadsRegisteredWithRS;
+
+        // wake up main thread
+        OGRE_THREAD_NOTIFY_ALL(mInitSync);
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::shutdown()
+    {
+        if (!mIsRunning)
+            return;
+
+        LogManager::getSingleton().stream() <<
+            "WorkStealingWorkQueue('" << mName << "') shutting down on thread " <<
+            OGRE_THREAD_CURRENT_ID
+            << ".";
+
+        mShuttingDown = true;
+        abortAllRequests();
+#if OGRE_THREAD_SUPPORT
+        {
+            // workers check for shutdown while holding the mutex before they wait
+            OGRE_WQ_LOCK_MUTEX(mWakeMutex);
+            OGRE_THREAD_NOTIFY_ALL(mWakeSync);
+        }
+
+        for (WorkerThreadList::iterator i = mWorkers.begin(); i != mWorkers.end(); ++i)
+        {
+            (*i)->join();
+            OGRE_THREAD_DESTROY(*i);
+        }
+        mWorkers.clear();
+#endif
+
+        OGRE_DELETE_T(mWorkerFunc, WorkerFunc, MEMCATEGORY_GENERAL);
+        mWorkerFunc = 0;
+
+        mIsRunning = false;
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::addRequestHandler(uint16 channel, RequestHandler* rh)
+    {
+        OGRE_WQ_LOCK_RW_MUTEX_WRITE(mRequestHandlerMutex);
+
+        DefaultWorkQueueBase::addRequestHandler(channel, rh);
+
+        RequestHandlerSnapshot* handlers = OGRE_NEW_T(RequestHandlerSnapshot, MEMCATEGORY_GENERAL)(
+            *std::atomic_load(&mRequestHandlerSnapshot));
+        std::vector<RequestHandler*>& channelHandlers = (*handlers)[channel];
+        if (std::find(channelHandlers.begin(), channelHandlers.end(), rh) == channelHandlers.end())
+            channelHandlers.push_back(rh);
+
+        std::atomic_store(&mRequestHandlerSnapshot, shared_ptr<const RequestHandlerSnapshot>(handlers));
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::removeRequestHandler(uint16 channel, RequestHandler* rh)
+    {
+        shared_ptr<const RequestHandlerSnapshot> oldHandlers;
+        {
+            OGRE_WQ_LOCK_RW_MUTEX_WRITE(mRequestHandlerMutex);
+
+            DefaultWorkQueueBase::removeRequestHandler(channel, rh);
+
+            oldHandlers = std::atomic_load(&mRequestHandlerSnapshot);
+            RequestHandlerSnapshot* handlers =
+                OGRE_NEW_T(RequestHandlerSnapshot, MEMCATEGORY_GENERAL)(*oldHandlers);
+            std::vector<RequestHandler*>& channelHandlers = (*handlers)[channel];
+            channelHandlers.erase(std::remove(channelHandlers.begin(), channelHandlers.end(), rh),
+                                  channelHandlers.end());
+
+            std::atomic_store(&mRequestHandlerSnapshot, shared_ptr<const RequestHandlerSnapshot>(handlers));
+        }
+
+#if OGRE_THREAD_SUPPORT
+        // workers hold a reference to the snapshot while calling its handlers,
+        // so once ours is the last one the handler can no longer be in use
+        while (oldHandlers.use_count() > 1)
+            std::this_thread::yield();
+#endif
+    }
+    //---------------------------------------------------------------------
+    WorkQueue::RequestID WorkStealingWorkQueue::addRequest(uint16 channel, uint16 requestType,
+        const Any& rData, uint8 retryCount, bool forceSynchronous, bool idleThread)
+    {
+        if (!mAcceptRequests || mShuttingDown)
+            return 0;
+
+        RequestID rid = ++mNextRequestID;
+        Request* req = OGRE_NEW Request(channel, requestType, rData, retryCount, rid);
+
+#if OGRE_THREAD_SUPPORT
+        if (idleThread)
+        {
+            OGRE_WQ_LOCK_MUTEX(mIdleMutex);
+            mIdleRequestQueue.push_back(req);
+            ++mPendingIdleRequests;
+            if (!mIdleRequestsRunning)
+                notifyWorkers();
+            return rid;
+        }
+        if (!forceSynchronous)
+        {
+            queueRequest(req, 0);
+            return rid;
+        }
+#endif
+        executeRequest(req, 0, true);
+        return rid;
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::queueRequest(Request* r, RequestDeque* deque)
+    {
+#if OGRE_THREAD_SUPPORT
+        uint8 priority = getChannelPriority(r->getChannel());
+        if (!deque)
+            deque = mDeques[mNextDeque++ % mDeques.size()];
+
+        {
+            OGRE_WQ_LOCK_MUTEX(deque->mutex);
+            deque->requests[priority].push_back(r);
+        }
+        ++mPendingRequests[priority];
+        notifyWorkers();
+#else
+        (void)deque;
+        executeRequest(r, 0, true);
+#endif
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::notifyWorkers()
+    {
+        // pairs with the increment of mSleepingWorkers in waitForWork: either the
+        // worker sees the new request, or we see the worker and wake it up
+        if (mSleepingWorkers != 0)
+        {
+            OGRE_WQ_LOCK_MUTEX(mWakeMutex);
+            OGRE_THREAD_NOTIFY_ONE(mWakeSync);
+        }
+    }
+    //---------------------------------------------------------------------
+    bool WorkStealingWorkQueue::hasPendingWork() const
+    {
+        for (int p = 0; p < NUM_PRIORITIES; ++p)
+        {
+            if (mPendingRequests[p] != 0)
+                return true;
+        }
+        return mPendingIdleRequests != 0 && !mIdleRequestsRunning;
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::waitForWork()
+    {
+#if OGRE_THREAD_SUPPORT
+        OGRE_WQ_LOCK_MUTEX_NAMED(mWakeMutex, wakeLock);
+        ++mSleepingWorkers;
+        while (!isShuttingDown() && !hasPendingWork())
+            OGRE_THREAD_WAIT(mWakeSync, mWakeMutex, wakeLock);
+        --mSleepingWorkers;
+#endif
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::_threadMain()
+    {
+#if OGRE_THREAD_SUPPORT
+        size_t workerIdx = mNextWorker++;
+
+        LogManager::getSingleton().stream() <<
+            "WorkStealingWorkQueue('" << getName() << "')::WorkerFunc - thread "
+            << OGRE_THREAD_CURRENT_ID << " starting.";
+
+        // Initialise the thread for RS if necessary
+        if (mWorkerRenderSystemAccess)
+        {
+            Root::getSingleton().getRenderSystem()->registerThread();
+            notifyThreadRegistered();
+        }
+
+        while (!isShuttingDown())
+        {
+            if (!processNextRequest(workerIdx))
+                waitForWork();
+        }
+
+        LogManager::getSingleton().stream() <<
+            "WorkStealingWorkQueue('" << getName() << "')::WorkerFunc - thread "
+            << OGRE_THREAD_CURRENT_ID << " stopped.";
+#endif
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::_processNextRequest()
+    {
+        processNextRequest(mNextWorker % mDeques.size());
+    }
+    //---------------------------------------------------------------------
+    bool WorkStealingWorkQueue::processNextRequest(size_t workerIdx)
+    {
+        if (processIdleQueue())
+            return true;
+
+        RequestDeque* owner = 0;
+        Request* request = takeRequest(workerIdx, owner);
+        if (!request)
+            return false;
+
+        executeRequest(request, owner, false);
+        return true;
+    }
+    //---------------------------------------------------------------------
+    WorkQueue::Request* WorkStealingWorkQueue::takeRequest(size_t workerIdx, RequestDeque*& owner)
+    {
+        size_t numDeques = mDeques.size();
+        for (int p = NUM_PRIORITIES - 1; p >= 0; --p)
+        {
+            if (mPendingRequests[p] == 0)
+                continue;
+
+            // own deque first, then steal from the others
+            for (size_t i = 0; i < numDeques; ++i)
+            {
+                RequestDeque* deque = mDeques[(workerIdx + i) % numDeques];
+
+                OGRE_WQ_LOCK_MUTEX(deque->mutex);
+                RequestQueue& requests = deque->requests[p];
+                if (!requests.empty())
+                {
+                    Request* request = requests.front();
+                    requests.pop_front();
+                    deque->processing.push_back(request);
+                    --mPendingRequests[p];
+
+                    owner = deque;
+                    return request;
+                }
+            }
+        }
+        return 0;
+    }
+    //---------------------------------------------------------------------
+    bool WorkStealingWorkQueue::processIdleQueue()
+    {
+        if (mPendingIdleRequests == 0)
+            return false;
+
+        {
+            OGRE_WQ_LOCK_MUTEX(mIdleMutex);
+            if (mIdleRequestQueue.empty() || mIdleRequestsRunning)
+                return false;
+            mIdleRequestsRunning = true;
+        }
+
+        while (true)
+        {
+            Request* request;
+            {
+                OGRE_WQ_LOCK_MUTEX(mIdleMutex);
+                if (mIdleRequestQueue.empty())
+                {
+                    mIdleRequestsRunning = false;
+                    return true;
+                }
+                request = mIdleProcessed = mIdleRequestQueue.front();
+                mIdleRequestQueue.pop_front();
+                --mPendingIdleRequests;
+            }
+            executeRequest(request, 0, false);
+        }
+    }
+    //---------------------------------------------------------------------
+    WorkQueue::Response* WorkStealingWorkQueue::handleRequest(const Request* r)
+    {
+        // keeps the handlers alive, see removeRequestHandler
+        shared_ptr<const RequestHandlerSnapshot> handlers = std::atomic_load(&mRequestHandlerSnapshot);
+
+        RequestHandlerSnapshot::const_iterator i = handlers->find(r->getChannel());
+        if (i == handlers->end())
+            return 0;
+
+        const std::vector<RequestHandler*>& channelHandlers = i->second;
+        for (std::vector<RequestHandler*>::const_reverse_iterator j = channelHandlers.rbegin();
+             j != channelHandlers.rend(); ++j)
+        {
+            if ((*j)->canHandleRequest(r, this))
+            {
+                Response* response = (*j)->handleRequest(r, this);
+                if (response)
+                    return response;
+            }
+        }
+        return 0;
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::executeRequest(Request* r, RequestDeque* owner, bool synchronous)
+    {
+        Response* response = handleRequest(r);
+
+        if (synchronous)
+        {
+            if (!response)
+            {
+                LogManager::getSingleton().stream(LML_WARNING) <<
+                    "WorkStealingWorkQueue('" << mName << "') warning: no handler processed request "
+                    << r->getID() << ", channel " << r->getChannel()
+                    << ", type " << r->getType();
+                OGRE_DELETE r;
+                return;
+            }
+            if (!response->succeeded() && r->getRetryCount())
+            {
+                queueRequest(OGRE_NEW Request(r->getChannel(), r->getType(), r->getData(),
+                                              r->getRetryCount() - 1, r->getID()), 0);
+                OGRE_DELETE response;
+                return;
+            }
+            processResponse(response);
+            OGRE_DELETE response;
+            return;
+        }
+
+        // Hold the lock guarding the request while it is in progress until the
+        // response is handed over, so aborts either find it here or in the responses
+        OGRE_WQ_LOCK_MUTEX_NAMED(owner ? owner->mutex : mIdleMutex, lock);
+
+        if (owner)
+            owner->processing.erase(std::find(owner->processing.begin(), owner->processing.end(), r));
+        else if (mIdleProcessed == r)
+            mIdleProcessed = 0;
+
+        if (!response)
+        {
+            if (!r->getAborted())
+            {
+                LogManager::getSingleton().stream(LML_WARNING) <<
+                    "WorkStealingWorkQueue('" << mName << "') warning: no handler processed request "
+                    << r->getID() << ", channel " << r->getChannel()
+                    << ", type " << r->getType();
+            }
+            OGRE_DELETE r;
+            return;
+        }
+
+        if (!response->succeeded() && r->getRetryCount())
+        {
+            if (!mShuttingDown)
+            {
+                queueRequest(OGRE_NEW Request(r->getChannel(), r->getType(), r->getData(),
+                                              r->getRetryCount() - 1, r->getID()), owner);
+            }
+            // discard response (this also deletes request)
+            OGRE_DELETE response;
+            return;
+        }
+
+        if (r->getAborted())
+        {
+            // destroy response user data
+            response->abortRequest();
+        }
+
+        ResponseNode* node = OGRE_NEW ResponseNode();
+        node->response = response;
+        node->next = mResponseStack.load(std::memory_order_relaxed);
+        while (!mResponseStack.compare_exchange_weak(node->next, node, std::memory_order_release,
+                                                     std::memory_order_relaxed))
+        {
+        }
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::collectResponses()
+    {
+        ResponseNode* node = mResponseStack.exchange(0, std::memory_order_acquire);
+
+        // the stack holds the most recent response first
+        ResponseNode* reversed = 0;
+        while (node)
+        {
+            ResponseNode* next = node->next;
+            node->next = reversed;
+            reversed = node;
+            node = next;
+        }
+
+        while (reversed)
+        {
+            mResponseQueue.push_back(reversed->response);
+            ResponseNode* next = reversed->next;
+            OGRE_DELETE reversed;
+            reversed = next;
+        }
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::processResponses()
+    {
+        unsigned long msStart = Root::getSingleton().getTimer()->getMilliseconds();
+        unsigned long msCurrent = 0;
+
+        // keep going until we run out of responses or out of time
+        while (true)
+        {
+            Response* response = 0;
+            {
+                OGRE_WQ_LOCK_MUTEX(mResponseMutex);
+
+                if (mResponseQueue.empty())
+                    collectResponses();
+                if (mResponseQueue.empty())
+                    break;
+
+                response = mResponseQueue.front();
+                mResponseQueue.pop_front();
+            }
+
+            processResponse(response);
+            OGRE_DELETE response;
+
+            // time limit
+            if (mResposeTimeLimitMS)
+            {
+                msCurrent = Root::getSingleton().getTimer()->getMilliseconds();
+                if (msCurrent - msStart > mResposeTimeLimitMS)
+                    break;
+            }
+        }
+    }
+    //---------------------------------------------------------------------
+    bool WorkStealingWorkQueue::abortRequests(const RequestFilter& filter, bool pendingOnly)
+    {
+        bool found = false;
+
+        for (RequestDequeList::iterator i = mDeques.begin(); i != mDeques.end(); ++i)
+        {
+            RequestDeque* deque = *i;
+            OGRE_WQ_LOCK_MUTEX(deque->mutex);
+
+            for (int p = 0; p < NUM_PRIORITIES; ++p)
+            {
+                for (RequestQueue::iterator j = deque->requests[p].begin(); j != deque->requests[p].end(); ++j)
+                {
+                    if (filter.matches(*j))
+                    {
+                        (*j)->abortRequest();
+                        found = true;
+                    }
+                }
+            }
+
+            if (!pendingOnly)
+            {
+                for (RequestQueue::iterator j = deque->processing.begin(); j != deque->processing.end(); ++j)
+                {
+                    if (filter.matches(*j))
+                        (*j)->abortRequest();
+                }
+            }
+        }
+
+        {
+            OGRE_WQ_LOCK_MUTEX(mIdleMutex);
+
+            for (RequestQueue::iterator i = mIdleRequestQueue.begin(); i != mIdleRequestQueue.end(); ++i)
+            {
+                if (filter.matches(*i))
+                {
+                    (*i)->abortRequest();
+                    found = true;
+                }
+            }
+
+            if (!pendingOnly && mIdleProcessed && filter.matches(mIdleProcessed))
+                mIdleProcessed->abortRequest();
+        }
+
+        if (!pendingOnly)
+        {
+            OGRE_WQ_LOCK_MUTEX(mResponseMutex);
+
+            collectResponses();
+            for (ResponseQueue::iterator i = mResponseQueue.begin(); i != mResponseQueue.end(); ++i)
+            {
+                if (filter.matches((*i)->getRequest()))
+                    (*i)->abortRequest();
+            }
+        }
+
+        return found;
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::abortRequest(RequestID id)
+    {
+        RequestFilter filter = {RequestFilter::ID, id, 0};
+        abortRequests(filter, false);
+    }
+    //---------------------------------------------------------------------
+    bool WorkStealingWorkQueue::abortPendingRequest(RequestID id)
+    {
+        RequestFilter filter = {RequestFilter::ID, id, 0};
+        return abortRequests(filter, true);
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::abortRequestsByChannel(uint16 channel)
+    {
+        RequestFilter filter = {RequestFilter::CHANNEL, 0, channel};
+        abortRequests(filter, false);
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::abortPendingRequestsByChannel(uint16 channel)
+    {
+        RequestFilter filter = {RequestFilter::CHANNEL, 0, channel};
+        abortRequests(filter, true);
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::abortAllRequests()
+    {
+        RequestFilter filter = {RequestFilter::ALL, 0, 0};
+        abortRequests(filter, false);
+    }
+}
@@ -159,6 +159,15 @@ namespace Ogre {
             const float* srcPositions,
             float* destPositions,
             size_t numVertices);
+
+        /// @copydoc OptimisedUtil::calculateBoxVisibility
+        virtual void calculateBoxVisibility(
+            const Plane* planes,
+            size_t numPlanes,
+            const float* centres,
+            const float* halfSizes,
+            uint32* visibility,
+            size_t numBoxes);
     };
 
 //---------------------------------------------------------------------
@@ -2032,6 +2041,20 @@ static OGRE_FORCE_INLINE bool _isAlignedForDirectXMath(const void *p)
         }
     }
     //---------------------------------------------------------------------
+    extern OptimisedUtil* _getOptimisedUtilGeneral(void);
+    void OptimisedUtilDirectXMath::calculateBoxVisibility(
+        const Plane* planes,
+        size_t numPlanes,
+        const float* centres,
+        const float* halfSizes,
+        uint32* visibility,
+        size_t numBoxes)
+    {
+        // Not worth a DirectXMath version yet
+        _getOptimisedUtilGeneral()->calculateBoxVisibility(
+            planes, numPlanes, centres, halfSizes, visibility, numBoxes);
+    }
+    //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     extern OptimisedUtil* _getOptimisedUtilDirectXMath(void)
@@ -119,6 +119,9 @@ namespace Ogre {
         typedef std::set<const MovableObject*> MovablesForRendering;
         MovablesForRendering mMovablesForRendering;
 
+        /// Moving nodes relocates their objects in the shared BSP leaves, so updates must stay serial
+        bool isSceneGraphUpdateThreadSafe(void) const { return false; }
+
     public:
         BspSceneManager(const String& name);
         ~BspSceneManager();
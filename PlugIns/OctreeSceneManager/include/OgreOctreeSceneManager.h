@@ -187,10 +187,23 @@ public:
     IntersectionSceneQuery* createIntersectionQuery(uint32 mask);
 
 protected:
-
+    /// Moving nodes relocates them in the shared octree, so updates must stay serial
+    bool isSceneGraphUpdateThreadSafe(void) const { return false; }
 
     Octree::NodeList mVisible;
 
+    /** Culls the nodes of a partially visible octant in one batch.
+    @remarks
+        Fills mNodeVisibility with one bit per node, see Frustum::calculateVisibility.
+    */
+    void cullNodes( OctreeCamera* camera, const Octree::NodeList& nodes );
+
+    /// Packed bounds of the nodes culled by cullNodes
+    std::vector<float> mNodeCentres;
+    std::vector<float> mNodeHalfSizes;
+    /// Visibility bitmask of the nodes culled by cullNodes
+    std::vector<uint32> mNodeVisibility;
+
     /// The root octree
     Octree *mOctree;
 
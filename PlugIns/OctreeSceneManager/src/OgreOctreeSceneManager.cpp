@@ -568,6 +568,50 @@ void OctreeSceneManager::_findVisibleObjects(Camera * cam,
     }
 }
 
+void OctreeSceneManager::cullNodes( OctreeCamera* camera, const Octree::NodeList& nodes )
+{
+    size_t numNodes = nodes.size();
+    mNodeCentres.resize( numNodes * 3 );
+    mNodeHalfSizes.resize( numNodes * 3 );
+    mNodeVisibility.resize( ( numNodes + 31 ) / 32 );
+
+    bool hasSpecialBoxes = false;
+    for ( size_t n = 0; n < numNodes; ++n )
+    {
+        const AxisAlignedBox& box = nodes[ n ] -> _getWorldAABB();
+        Vector3 centre = Vector3::ZERO, halfSize = Vector3::ZERO;
+        if ( box.isFinite() )
+        {
+            centre = box.getCenter();
+            halfSize = box.getHalfSize();
+        }
+        else
+            hasSpecialBoxes = true;
+
+        for ( int i = 0; i < 3; ++i )
+        {
+            mNodeCentres[ n * 3 + i ] = float( centre[ i ] );
+            mNodeHalfSizes[ n * 3 + i ] = float( halfSize[ i ] );
+        }
+    }
+
+    camera -> calculateVisibility( mNodeCentres.data(), mNodeHalfSizes.data(),
+        mNodeVisibility.data(), numNodes );
+
+    // null boxes are never visible, infinite ones always
+    if ( hasSpecialBoxes )
+    {
+        for ( size_t n = 0; n < numNodes; ++n )
+        {
+            const AxisAlignedBox& box = nodes[ n ] -> _getWorldAABB();
+            if ( box.isNull() )
+                mNodeVisibility[ n / 32 ] &= ~( 1u << ( n % 32 ) );
+            else if ( box.isInfinite() )
+                mNodeVisibility[ n / 32 ] |= 1u << ( n % 32 );
+        }
+    }
+}
+
 void OctreeSceneManager::walkOctree( OctreeCamera *camera, RenderQueue *queue, 
     Octree *octant, VisibleObjectsBoundsInfo* visibleBounds, 
     bool foundvisible, bool onlyShadowCasters )
@@ -611,15 +655,17 @@ void OctreeSceneManager::walkOctree( OctreeCamera *camera, RenderQueue *queue,
 
         bool vis = true;
 
-        while ( it != octant -> mNodes.end() )
+        // if this octree is partially visible, manually cull all
+        // scene nodes attached directly to this level.
+        if ( v == OctreeCamera::PARTIAL )
+            cullNodes( camera, octant -> mNodes );
+
+        for ( size_t n = 0; it != octant -> mNodes.end(); ++n )
         {
             OctreeNode * sn = *it;
 
-            // if this octree is partially visible, manually cull all
-            // scene nodes attached directly to this level.
-
             if ( v == OctreeCamera::PARTIAL )
-                vis = camera -> isVisible( sn -> _getWorldAABB() );
+                vis = ( mNodeVisibility[ n / 32 ] & ( 1u << ( n % 32 ) ) ) != 0;
 
             if ( vis )
             {
@@ -380,6 +380,8 @@ namespace Ogre
         virtual void destroyShadowTextures(void);
         /// Internal method for firing the pre caster texture shadows event
         virtual void fireShadowTexturesPreCaster(Light* light, Camera* camera, size_t iteration);
+        /// Moving nodes updates the shared zone membership, so updates must stay serial
+        bool isSceneGraphUpdateThreadSafe(void) const { return false; }
     };
 
     /// Factory for PCZSceneManager
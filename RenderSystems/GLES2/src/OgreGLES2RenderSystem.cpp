@@ -589,6 +589,8 @@ namespace Ogre {
         OGRE_DELETE mGpuProgramManager;
         mGpuProgramManager = 0;
 
+        if (mHardwareBufferManager)
+            mHardwareBufferManager->_releaseStreamingBuffers();
         OGRE_DELETE mHardwareBufferManager;
         mHardwareBufferManager = 0;
 
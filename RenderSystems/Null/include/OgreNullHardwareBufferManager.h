@@ -0,0 +1,144 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __NullHardwareBufferManager_H__
+#define __NullHardwareBufferManager_H__
+
+#include "OgreNullPrerequisites.h"
+#include "OgreDefaultHardwareBufferManager.h"
+
+namespace Ogre {
+
+    /// System memory vertex buffer which reports the bytes written to it
+    class _OgreNullExport NullHardwareVertexBuffer : public DefaultHardwareVertexBuffer
+    {
+        NullRenderSystem* mRenderSystem;
+        size_t mLockLength;
+    public:
+        NullHardwareVertexBuffer(HardwareBufferManagerBase* mgr, NullRenderSystem* rs, size_t vertexSize,
+                                 size_t numVertices, HardwareBuffer::Usage usage);
+
+        void writeData(size_t offset, size_t length, const void* pSource,
+                bool discardWholeBuffer = false);
+        void* lock(size_t offset, size_t length, LockOptions options);
+        void unlock(void);
+        void _flushPersistentRange(size_t offset, size_t length);
+    };
+
+    /// System memory index buffer which reports the bytes written to it
+    class _OgreNullExport NullHardwareIndexBuffer : public DefaultHardwareIndexBuffer
+    {
+        NullRenderSystem* mRenderSystem;
+        size_t mLockLength;
+    public:
+        NullHardwareIndexBuffer(NullRenderSystem* rs, IndexType idxType, size_t numIndexes,
+                                HardwareBuffer::Usage usage);
+
+        void writeData(size_t offset, size_t length, const void* pSource,
+                bool discardWholeBuffer = false);
+        void* lock(size_t offset, size_t length, LockOptions options);
+        void unlock(void);
+        void _flushPersistentRange(size_t offset, size_t length);
+    };
+
+    /// System memory uniform buffer which reports the bytes written to it
+    class _OgreNullExport NullHardwareUniformBuffer : public DefaultHardwareUniformBuffer
+    {
+        NullRenderSystem* mRenderSystem;
+        size_t mLockLength;
+    public:
+        NullHardwareUniformBuffer(HardwareBufferManagerBase* mgr, NullRenderSystem* rs, size_t sizeBytes,
+                                  HardwareBuffer::Usage usage, const String& name);
+
+        void writeData(size_t offset, size_t length, const void* pSource,
+                bool discardWholeBuffer = false);
+        void* lock(size_t offset, size_t length, LockOptions options);
+        void unlock(void);
+    };
+
+    /** Buffer manager handing out system memory buffers.
+    @remarks
+        Behaves like DefaultHardwareBufferManagerBase, except that vertex, index
+        and uniform buffers report every write (through writeData, a lock which
+        is not read only or a flush of their persistent mapping) to the
+        NullRenderSystem, which counts them as uploads.
+    */
+    class _OgreNullExport NullHardwareBufferManagerBase : public DefaultHardwareBufferManagerBase
+    {
+        NullRenderSystem* mRenderSystem;
+    public:
+        NullHardwareBufferManagerBase(NullRenderSystem* rs) : mRenderSystem(rs) {}
+
+        HardwareVertexBufferSharedPtr
+            createVertexBuffer(size_t vertexSize, size_t numVerts,
+                HardwareBuffer::Usage usage, bool useShadowBuffer = false);
+        HardwareIndexBufferSharedPtr
+            createIndexBuffer(HardwareIndexBuffer::IndexType itype, size_t numIndexes,
+                HardwareBuffer::Usage usage, bool useShadowBuffer = false);
+        HardwareUniformBufferSharedPtr
+            createUniformBuffer(size_t sizeBytes, HardwareBuffer::Usage usage,
+                bool useShadowBuffer, const String& name = "");
+    };
+
+    /// NullHardwareBufferManagerBase as a Singleton
+    class _OgreNullExport NullHardwareBufferManager : public HardwareBufferManager
+    {
+        std::unique_ptr<HardwareBufferManagerBase> mImpl;
+    public:
+        NullHardwareBufferManager(NullRenderSystem* rs) : mImpl(new NullHardwareBufferManagerBase(rs)) {}
+        // the streaming rings hold buffers of mImpl
+        ~NullHardwareBufferManager() { _releaseStreamingBuffers(); }
+        HardwareVertexBufferSharedPtr
+            createVertexBuffer(size_t vertexSize, size_t numVerts, HardwareBuffer::Usage usage,
+            bool useShadowBuffer = false)
+        {
+            return mImpl->createVertexBuffer(vertexSize, numVerts, usage, useShadowBuffer);
+        }
+        HardwareIndexBufferSharedPtr
+            createIndexBuffer(HardwareIndexBuffer::IndexType itype, size_t numIndexes,
+            HardwareBuffer::Usage usage, bool useShadowBuffer = false)
+        {
+            return mImpl->createIndexBuffer(itype, numIndexes, usage, useShadowBuffer);
+        }
+        RenderToVertexBufferSharedPtr createRenderToVertexBuffer()
+        {
+            return mImpl->createRenderToVertexBuffer();
+        }
+        HardwareUniformBufferSharedPtr
+                createUniformBuffer(size_t sizeBytes, HardwareBuffer::Usage usage, bool useShadowBuffer, const String& name = "")
+        {
+            return mImpl->createUniformBuffer(sizeBytes, usage, useShadowBuffer, name);
+        }
+        HardwareCounterBufferSharedPtr
+        createCounterBuffer(size_t sizeBytes, HardwareBuffer::Usage usage, bool useShadowBuffer, const String& name = "")
+        {
+            return mImpl->createCounterBuffer(sizeBytes, usage, useShadowBuffer, name);
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,243 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __NullRenderSystem_H__
+#define __NullRenderSystem_H__
+
+#include "OgreNullPrerequisites.h"
+#include "OgreRenderSystem.h"
+#include "OgreHardwareOcclusionQuery.h"
+#include "OgreHardwareBufferManager.h"
+
+namespace Ogre {
+    /** \addtogroup RenderSystems RenderSystems
+    *  @{
+    */
+    /** \defgroup Null Null
+    * Render system which does not draw anything
+    *  @{
+    */
+
+    /// Occlusion query which never sees any fragment
+    class _OgreNullExport NullHardwareOcclusionQuery : public HardwareOcclusionQuery
+    {
+    public:
+        void beginOcclusionQuery() {}
+        void endOcclusionQuery() {}
+        bool pullOcclusionQuery(unsigned int* NumOfFragments)
+        {
+            *NumOfFragments = mPixelCount = 0;
+            return true;
+        }
+        bool isStillOutstanding(void) { return false; }
+    };
+
+    /** Render system for machines without a GPU.
+    @remarks
+        Accepts the whole rendering pipeline driven by Root::renderOneFrame
+        without drawing anything: windows are never shown, vertex, index and
+        texture data live in system memory and GPU programs are never compiled.
+        This allows running (and profiling) the CPU side of the engine on
+        headless machines, for instance in benchmarks and automated tests.
+    @par
+        Instead of drawing, the render system counts what a real device would
+        have been asked to do during each frame, see getLastFrameStats. The
+        capabilities are those of a fixed function device which also accepts
+        vertex and fragment programs of the "null" syntax, whose parameters are
+        updated and bound like those of real programs.
+    */
+    class _OgreNullExport NullRenderSystem : public RenderSystem
+    {
+    public:
+        /// Work recorded over one frame
+        struct FrameStats
+        {
+            /// Number of _render calls
+            size_t drawCalls;
+            /** Number of calls setting render state (textures, samplers, blending,
+                depth, stencil, culling, programs and their parameters, viewports).
+                There is no state cache, so redundant calls are counted too. */
+            size_t stateChanges;
+            /// Bytes written to vertex, index and texture buffers
+            size_t bytesUploaded;
+            /** Bytes of GPU program constants written since they were last bound,
+                plus those written to uniform buffers */
+            size_t constantBytesUploaded;
+            /// Number of bindGpuProgramParameters calls
+            size_t constantBinds;
+            /// Number of _bindPerObjectConstantBlock calls, i.e. offset changes
+            size_t constantBlockBinds;
+            /// Number of vertex and index buffer locks which are not read only
+            size_t bufferLocks;
+            /// Number of _executeCommandList calls
+            size_t commandListsExecuted;
+            /// Number of commands replayed from command lists, also counted by the stats above
+            size_t commandsExecuted;
+
+            FrameStats()
+                : drawCalls(0), stateChanges(0), bytesUploaded(0), constantBytesUploaded(0),
+                  constantBinds(0), constantBlockBinds(0), bufferLocks(0), commandListsExecuted(0),
+                  commandsExecuted(0) {}
+        };
+
+        NullRenderSystem();
+        ~NullRenderSystem();
+
+        /** Statistics of the last completed frame.
+        @remarks
+            A frame ends when the render target buffers are swapped, i.e. at the
+            end of Root::renderOneFrame. Uploads done outside of a frame (e.g.
+            while loading resources) are accounted to the next one.
+        */
+        const FrameStats& getLastFrameStats() const { return mLastFrameStats; }
+
+        /// Statistics gathered since the last completed frame
+        const FrameStats& getFrameStats() const { return mFrameStats; }
+
+        /// Called by the buffers of this render system whenever data is written to them
+        void _notifyBytesUploaded(size_t bytes) { mFrameStats.bytesUploaded += bytes; }
+        /// Called by the vertex and index buffers of this render system when they are locked for writing
+        void _notifyBufferLocked(void) { ++mFrameStats.bufferLocks; }
+        /// Called by the uniform buffers of this render system whenever data is written to them
+        void _notifyConstantBytesUploaded(size_t bytes) { mFrameStats.constantBytesUploaded += bytes; }
+
+        const String& getName(void) const;
+        void setConfigOption(const String& name, const String& value);
+        String validateConfigOptions(void) { return BLANKSTRING; }
+        HardwareOcclusionQuery* createHardwareOcclusionQuery(void);
+
+        RenderWindow* _initialise(bool autoCreateWindow, const String& windowTitle = "OGRE Render Window");
+        RenderSystemCapabilities* createRenderSystemCapabilities() const;
+        void initialiseFromRenderSystemCapabilities(RenderSystemCapabilities* caps, RenderTarget* primary);
+        void reinitialise(void);
+        void shutdown(void);
+
+        RenderWindow* _createRenderWindow(const String& name, unsigned int width, unsigned int height,
+            bool fullScreen, const NameValuePairList* miscParams = 0);
+        MultiRenderTarget* createMultiRenderTarget(const String& name);
+        DepthBuffer* _createDepthBufferFor(RenderTarget* renderTarget);
+
+        void _swapAllRenderTargetBuffers();
+        void _beginFrame(void) {}
+        void _endFrame(void) {}
+        void _setViewport(Viewport* vp);
+        void _setRenderTarget(RenderTarget* target);
+        void clearFrameBuffer(unsigned int buffers, const ColourValue& colour = ColourValue::Black,
+            Real depth = 1.0f, unsigned short stencil = 0) {}
+        void _render(const RenderOperation& op);
+        void _executeCommandList(const RenderCommandList& list);
+
+        void _setSampler(size_t texUnit, Sampler& s) { ++mFrameStats.stateChanges; }
+        void _setTexture(size_t unit, bool enabled, const TexturePtr& texPtr) { ++mFrameStats.stateChanges; }
+        void _setTextureUnitFiltering(size_t unit, FilterType ftype, FilterOptions filter) { ++mFrameStats.stateChanges; }
+        void _setTextureUnitCompareEnabled(size_t unit, bool compare) { ++mFrameStats.stateChanges; }
+        void _setTextureUnitCompareFunction(size_t unit, CompareFunction function) { ++mFrameStats.stateChanges; }
+        void _setTextureLayerAnisotropy(size_t unit, unsigned int maxAnisotropy) { ++mFrameStats.stateChanges; }
+        void _setTextureAddressingMode(size_t unit, const Sampler::UVWAddressingMode& uvw) { ++mFrameStats.stateChanges; }
+        void _setTextureBorderColour(size_t unit, const ColourValue& colour) { ++mFrameStats.stateChanges; }
+        void _setTextureMipmapBias(size_t unit, float bias) { ++mFrameStats.stateChanges; }
+
+        void _setSeparateSceneBlending(SceneBlendFactor sourceFactor, SceneBlendFactor destFactor,
+            SceneBlendFactor sourceFactorAlpha, SceneBlendFactor destFactorAlpha,
+            SceneBlendOperation op = SBO_ADD, SceneBlendOperation alphaOp = SBO_ADD) { ++mFrameStats.stateChanges; }
+        void _setAlphaRejectSettings(CompareFunction func, unsigned char value, bool alphaToCoverage) { ++mFrameStats.stateChanges; }
+        void _setCullingMode(CullingMode mode) { mCullingMode = mode; ++mFrameStats.stateChanges; }
+        void _setDepthBufferParams(bool depthTest = true, bool depthWrite = true,
+            CompareFunction depthFunction = CMPF_LESS_EQUAL) { ++mFrameStats.stateChanges; }
+        void _setDepthBufferCheckEnabled(bool enabled = true) { ++mFrameStats.stateChanges; }
+        void _setDepthBufferWriteEnabled(bool enabled = true) { ++mFrameStats.stateChanges; }
+        void _setDepthBufferFunction(CompareFunction func = CMPF_LESS_EQUAL) { ++mFrameStats.stateChanges; }
+        void _setColourBufferWriteEnabled(bool red, bool green, bool blue, bool alpha) { ++mFrameStats.stateChanges; }
+        void _setDepthBias(float constantBias, float slopeScaleBias = 0.0f) { ++mFrameStats.stateChanges; }
+        void _setPolygonMode(PolygonMode level) { ++mFrameStats.stateChanges; }
+        void setStencilCheckEnabled(bool enabled) { ++mFrameStats.stateChanges; }
+        void setStencilBufferParams(CompareFunction func = CMPF_ALWAYS_PASS,
+            uint32 refValue = 0, uint32 compareMask = 0xFFFFFFFF, uint32 writeMask = 0xFFFFFFFF,
+            StencilOperation stencilFailOp = SOP_KEEP,
+            StencilOperation depthFailOp = SOP_KEEP,
+            StencilOperation passOp = SOP_KEEP,
+            bool twoSidedOperation = false,
+            bool readBackAsTexture = false) { ++mFrameStats.stateChanges; }
+        void setScissorTest(bool enabled, size_t left = 0, size_t top = 0,
+            size_t right = 800, size_t bottom = 600) { ++mFrameStats.stateChanges; }
+
+        void bindGpuProgram(GpuProgram* prg);
+        void unbindGpuProgram(GpuProgramType gptype);
+        void bindGpuProgramParameters(GpuProgramType gptype,
+            GpuProgramParametersSharedPtr params, uint16 variabilityMask);
+        void bindGpuProgramPassIterationParameters(GpuProgramType gptype) { ++mFrameStats.stateChanges; }
+        bool _supportsPerObjectConstantBlocks(void) const { return true; }
+        void _bindPerObjectConstantBlock(GpuProgramType gptype, const GpuProgramParametersSharedPtr& params,
+            const HardwareUniformBufferSharedPtr& block, size_t offset)
+        {
+            ++mFrameStats.constantBlockBinds;
+            ++mFrameStats.stateChanges;
+        }
+
+        VertexElementType getColourVertexElementType(void) const { return VET_COLOUR_ABGR; }
+        void _convertProjectionMatrix(const Matrix4& matrix, Matrix4& dest, bool forGpuProgram = false)
+        {
+            // same conventions as OpenGL
+            dest = matrix;
+        }
+        void _makeProjectionMatrix(const Radian& fovy, Real aspect, Real nearPlane, Real farPlane,
+            Matrix4& dest, bool forGpuProgram = false);
+        void _makeProjectionMatrix(Real left, Real right, Real bottom, Real top,
+            Real nearPlane, Real farPlane, Matrix4& dest, bool forGpuProgram = false);
+        void _makeOrthoMatrix(const Radian& fovy, Real aspect, Real nearPlane, Real farPlane,
+            Matrix4& dest, bool forGpuProgram = false);
+        void _applyObliqueDepthProjection(Matrix4& matrix, const Plane& plane, bool forGpuProgram);
+
+        Real getHorizontalTexelOffset(void) { return 0.0f; }
+        Real getVerticalTexelOffset(void) { return 0.0f; }
+        Real getMinimumDepthInputValue(void) { return -1.0f; }
+        Real getMaximumDepthInputValue(void) { return 1.0f; }
+
+        void preExtraThreadsStarted() {}
+        void postExtraThreadsStarted() {}
+        void registerThread() {}
+        void unregisterThread() {}
+        unsigned int getDisplayMonitorCount() const { return 1; }
+        void beginProfileEvent(const String& eventName) {}
+        void endProfileEvent(void) {}
+        void markProfileEvent(const String& event) {}
+        bool hasAnisotropicMipMapFilter() const { return true; }
+    protected:
+        void initConfigOptions();
+
+        HardwareBufferManager* mHardwareBufferManager;
+        GpuProgramManager* mGpuProgramManager;
+        bool mInitialised;
+
+        FrameStats mFrameStats;
+        FrameStats mLastFrameStats;
+    };
+    /** @} */
+    /** @} */
+}
+
+#endif
@@ -0,0 +1,118 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __NullTexture_H__
+#define __NullTexture_H__
+
+#include "OgreNullPrerequisites.h"
+#include "OgreTexture.h"
+#include "OgreTextureManager.h"
+#include "OgreHardwarePixelBuffer.h"
+#include "OgreRenderTexture.h"
+#include "OgreImage.h"
+
+namespace Ogre {
+
+    /// Render target on a slice of a NullHardwarePixelBuffer
+    class _OgreNullExport NullRenderTexture : public RenderTexture
+    {
+    public:
+        NullRenderTexture(const String& name, HardwarePixelBuffer* buffer, uint32 zoffset, uint fsaa);
+
+        bool requiresTextureFlipping() const { return false; }
+    };
+
+    /** Texture surface kept in system memory.
+    @remarks
+        Writes through blitFromMemory or a lock which is not read only are
+        reported to the NullRenderSystem as uploads.
+    */
+    class _OgreNullExport NullHardwarePixelBuffer : public HardwarePixelBuffer
+    {
+    public:
+        NullHardwarePixelBuffer(NullRenderSystem* rs, const String& parentName, uint32 width,
+                                uint32 height, uint32 depth, PixelFormat format, int usage,
+                                uint fsaa);
+        ~NullHardwarePixelBuffer();
+
+        void blitFromMemory(const PixelBox& src, const Box& dstBox);
+        void blitToMemory(const Box& srcBox, const PixelBox& dst);
+        RenderTexture* getRenderTarget(size_t slice = 0);
+    protected:
+        PixelBox lockImpl(const Box& lockBox, LockOptions options);
+        void unlockImpl(void);
+        void _clearSliceRTT(size_t zoffset);
+
+        NullRenderSystem* mRenderSystem;
+        PixelBox mBuffer;
+        LockOptions mCurrentLockOptions;
+        typedef std::vector<RenderTexture*> SliceTRT;
+        SliceTRT mSliceTRT;
+    };
+
+    /// Texture whose surfaces are NullHardwarePixelBuffer instances
+    class _OgreNullExport NullTexture : public Texture
+    {
+    public:
+        NullTexture(ResourceManager* creator, const String& name, ResourceHandle handle,
+                    const String& group, bool isManual, ManualResourceLoader* loader,
+                    NullRenderSystem* renderSystem);
+        ~NullTexture();
+
+    protected:
+        void prepareImpl(void);
+        void unprepareImpl(void);
+        void loadImpl(void);
+        void createInternalResourcesImpl(void);
+        void freeInternalResourcesImpl(void);
+
+        void readImage(const String& name, const String& ext);
+
+        NullRenderSystem* mRenderSystem;
+        /// Images read by prepareImpl, consumed by loadImpl
+        std::vector<Image> mLoadedImages;
+    };
+
+    /// Texture manager creating NullTexture instances
+    class _OgreNullExport NullTextureManager : public TextureManager
+    {
+    public:
+        NullTextureManager(NullRenderSystem* renderSystem);
+        ~NullTextureManager();
+
+        /// Every format is supported as is
+        PixelFormat getNativeFormat(TextureType ttype, PixelFormat format, int usage);
+    protected:
+        Resource* createImpl(const String& name, ResourceHandle handle,
+            const String& group, bool isManual, ManualResourceLoader* loader,
+            const NameValuePairList* createParams);
+
+        NullRenderSystem* mRenderSystem;
+    };
+}
+
+#endif
@@ -0,0 +1,153 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include "OgreNullHardwareBufferManager.h"
+#include "OgreNullRenderSystem.h"
+
+namespace Ogre {
+    //-----------------------------------------------------------------------
+    NullHardwareVertexBuffer::NullHardwareVertexBuffer(HardwareBufferManagerBase* mgr, NullRenderSystem* rs,
+                                                       size_t vertexSize, size_t numVertices,
+                                                       HardwareBuffer::Usage usage)
+        : DefaultHardwareVertexBuffer(mgr, vertexSize, numVertices, usage), mRenderSystem(rs), mLockLength(0)
+    {
+    }
+    //-----------------------------------------------------------------------
+    void NullHardwareVertexBuffer::writeData(size_t offset, size_t length, const void* pSource,
+            bool discardWholeBuffer)
+    {
+        DefaultHardwareVertexBuffer::writeData(offset, length, pSource, discardWholeBuffer);
+        mRenderSystem->_notifyBytesUploaded(length);
+    }
+    //-----------------------------------------------------------------------
+    void* NullHardwareVertexBuffer::lock(size_t offset, size_t length, LockOptions options)
+    {
+        mLockLength = options == HBL_READ_ONLY ? 0 : length;
+        if (mLockLength)
+            mRenderSystem->_notifyBufferLocked();
+        return DefaultHardwareVertexBuffer::lock(offset, length, options);
+    }
+    //-----------------------------------------------------------------------
+    void NullHardwareVertexBuffer::unlock(void)
+    {
+        DefaultHardwareVertexBuffer::unlock();
+        mRenderSystem->_notifyBytesUploaded(mLockLength);
+        mLockLength = 0;
+    }
+    //-----------------------------------------------------------------------
+    void NullHardwareVertexBuffer::_flushPersistentRange(size_t offset, size_t length)
+    {
+        mRenderSystem->_notifyBytesUploaded(length);
+    }
+    //-----------------------------------------------------------------------
+    NullHardwareIndexBuffer::NullHardwareIndexBuffer(NullRenderSystem* rs, IndexType idxType,
+                                                     size_t numIndexes, HardwareBuffer::Usage usage)
+        : DefaultHardwareIndexBuffer(idxType, numIndexes, usage), mRenderSystem(rs), mLockLength(0)
+    {
+    }
+    //-----------------------------------------------------------------------
+    void NullHardwareIndexBuffer::writeData(size_t offset, size_t length, const void* pSource,
+            bool discardWholeBuffer)
+    {
+        DefaultHardwareIndexBuffer::writeData(offset, length, pSource, discardWholeBuffer);
+        mRenderSystem->_notifyBytesUploaded(length);
+    }
+    //-----------------------------------------------------------------------
+    void* NullHardwareIndexBuffer::lock(size_t offset, size_t length, LockOptions options)
+    {
+        mLockLength = options == HBL_READ_ONLY ? 0 : length;
+        if (mLockLength)
+            mRenderSystem->_notifyBufferLocked();
+        return DefaultHardwareIndexBuffer::lock(offset, length, options);
+    }
+    //-----------------------------------------------------------------------
+    void NullHardwareIndexBuffer::unlock(void)
+    {
+        DefaultHardwareIndexBuffer::unlock();
+        mRenderSystem->_notifyBytesUploaded(mLockLength);
+        mLockLength = 0;
+    }
+    //-----------------------------------------------------------------------
+    void NullHardwareIndexBuffer::_flushPersistentRange(size_t offset, size_t length)
+    {
+        mRenderSystem->_notifyBytesUploaded(length);
+    }
+    //-----------------------------------------------------------------------
+    NullHardwareUniformBuffer::NullHardwareUniformBuffer(HardwareBufferManagerBase* mgr, NullRenderSystem* rs,
+                                                         size_t sizeBytes, HardwareBuffer::Usage usage,
+                                                         const String& name)
+        : DefaultHardwareUniformBuffer(mgr, sizeBytes, usage, false, name), mRenderSystem(rs), mLockLength(0)
+    {
+    }
+    //-----------------------------------------------------------------------
+    void NullHardwareUniformBuffer::writeData(size_t offset, size_t length, const void* pSource,
+            bool discardWholeBuffer)
+    {
+        DefaultHardwareUniformBuffer::writeData(offset, length, pSource, discardWholeBuffer);
+        mRenderSystem->_notifyConstantBytesUploaded(length);
+    }
+    //-----------------------------------------------------------------------
+    void* NullHardwareUniformBuffer::lock(size_t offset, size_t length, LockOptions options)
+    {
+        mLockLength = options == HBL_READ_ONLY ? 0 : length;
+        return DefaultHardwareUniformBuffer::lock(offset, length, options);
+    }
+    //-----------------------------------------------------------------------
+    void NullHardwareUniformBuffer::unlock(void)
+    {
+        DefaultHardwareUniformBuffer::unlock();
+        mRenderSystem->_notifyConstantBytesUploaded(mLockLength);
+        mLockLength = 0;
+    }
+    //-----------------------------------------------------------------------
+    HardwareVertexBufferSharedPtr
+        NullHardwareBufferManagerBase::createVertexBuffer(size_t vertexSize,
+        size_t numVerts, HardwareBuffer::Usage usage, bool useShadowBuffer)
+    {
+        NullHardwareVertexBuffer* vb =
+            OGRE_NEW NullHardwareVertexBuffer(this, mRenderSystem, vertexSize, numVerts, usage);
+        return HardwareVertexBufferSharedPtr(vb);
+    }
+    //-----------------------------------------------------------------------
+    HardwareIndexBufferSharedPtr
+        NullHardwareBufferManagerBase::createIndexBuffer(HardwareIndexBuffer::IndexType itype,
+        size_t numIndexes, HardwareBuffer::Usage usage, bool useShadowBuffer)
+    {
+        NullHardwareIndexBuffer* ib = OGRE_NEW NullHardwareIndexBuffer(mRenderSystem, itype, numIndexes, usage);
+        return HardwareIndexBufferSharedPtr(ib);
+    }
+    //-----------------------------------------------------------------------
+    HardwareUniformBufferSharedPtr
+        NullHardwareBufferManagerBase::createUniformBuffer(size_t sizeBytes,
+        HardwareBuffer::Usage usage, bool useShadowBuffer, const String& name)
+    {
+        NullHardwareUniformBuffer* ub =
+            OGRE_NEW NullHardwareUniformBuffer(this, mRenderSystem, sizeBytes, usage, name);
+        return HardwareUniformBufferSharedPtr(ub);
+    }
+}
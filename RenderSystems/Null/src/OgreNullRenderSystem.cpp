@@ -0,0 +1,372 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include "OgreNullRenderSystem.h"
+#include "OgreNullRenderWindow.h"
+#include "OgreNullTexture.h"
+#include "OgreNullHardwareBufferManager.h"
+#include "OgreNullGpuProgramManager.h"
+#include "OgreDepthBuffer.h"
+#include "OgreViewport.h"
+#include "OgreLogManager.h"
+#include "OgreStringConverter.h"
+#include "OgreRenderCommandList.h"
+
+namespace Ogre {
+    //---------------------------------------------------------------------
+    NullRenderSystem::NullRenderSystem()
+        : mHardwareBufferManager(0), mGpuProgramManager(0), mInitialised(false)
+    {
+        LogManager::getSingleton().logMessage(getName() + " created.");
+
+        initConfigOptions();
+    }
+    //---------------------------------------------------------------------
+    NullRenderSystem::~NullRenderSystem()
+    {
+        shutdown();
+    }
+    //---------------------------------------------------------------------
+    const String& NullRenderSystem::getName(void) const
+    {
+        static String strName("Null Rendering Subsystem");
+        return strName;
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::initConfigOptions()
+    {
+        RenderSystem::initConfigOptions();
+
+        ConfigOption optVideoMode;
+        optVideoMode.name = "Video Mode";
+        optVideoMode.possibleValues.push_back("640 x 480");
+        optVideoMode.possibleValues.push_back("800 x 600");
+        optVideoMode.possibleValues.push_back("1024 x 768");
+        optVideoMode.possibleValues.push_back("1280 x 720");
+        optVideoMode.possibleValues.push_back("1920 x 1080");
+        optVideoMode.currentValue = optVideoMode.possibleValues[1];
+        optVideoMode.immutable = false;
+        mOptions[optVideoMode.name] = optVideoMode;
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::setConfigOption(const String& name, const String& value)
+    {
+        ConfigOptionMap::iterator it = mOptions.find(name);
+        if (it == mOptions.end())
+        {
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Option named '" + name + "' does not exist.",
+                        "NullRenderSystem::setConfigOption");
+        }
+
+        it->second.currentValue = value;
+    }
+    //---------------------------------------------------------------------
+    HardwareOcclusionQuery* NullRenderSystem::createHardwareOcclusionQuery(void)
+    {
+        NullHardwareOcclusionQuery* ret = new NullHardwareOcclusionQuery();
+        mHwOcclusionQueries.push_back(ret);
+        return ret;
+    }
+    //---------------------------------------------------------------------
+    RenderWindow* NullRenderSystem::_initialise(bool autoCreateWindow, const String& windowTitle)
+    {
+        // Create the texture manager
+        mTextureManager = new NullTextureManager(this);
+
+        RenderWindow* autoWindow = NULL;
+        if (autoCreateWindow)
+        {
+            StringVector tokens = StringUtil::split(mOptions["Video Mode"].currentValue, " x");
+            uint w = tokens.size() > 0 ? StringConverter::parseUnsignedInt(tokens[0], 800) : 800;
+            uint h = tokens.size() > 1 ? StringConverter::parseUnsignedInt(tokens[1], 600) : 600;
+            bool fullscreen = mOptions["Full Screen"].currentValue == "Yes";
+
+            autoWindow = _createRenderWindow(windowTitle, w, h, fullscreen);
+        }
+
+        RenderSystem::_initialise(autoCreateWindow, windowTitle);
+
+        return autoWindow;
+    }
+    //---------------------------------------------------------------------
+    RenderSystemCapabilities* NullRenderSystem::createRenderSystemCapabilities() const
+    {
+        RenderSystemCapabilities* rsc = new RenderSystemCapabilities();
+
+        rsc->setRenderSystemName(getName());
+        rsc->setDeviceName("Null");
+        rsc->setVendor(GPU_UNKNOWN);
+        rsc->setDriverVersion(mDriverVersion);
+
+        rsc->setCapability(RSC_FIXED_FUNCTION);
+        rsc->setCapability(RSC_ANISOTROPY);
+        rsc->setCapability(RSC_DOT3);
+        rsc->setCapability(RSC_CUBEMAPPING);
+        rsc->setCapability(RSC_HWSTENCIL);
+        rsc->setCapability(RSC_32BIT_INDEX);
+        rsc->setCapability(RSC_SCISSOR_TEST);
+        rsc->setCapability(RSC_TWO_SIDED_STENCIL);
+        rsc->setCapability(RSC_STENCIL_WRAP);
+        rsc->setCapability(RSC_HWOCCLUSION);
+        rsc->setCapability(RSC_USER_CLIP_PLANES);
+        rsc->setCapability(RSC_VERTEX_FORMAT_UBYTE4);
+        rsc->setCapability(RSC_INFINITE_FAR_PLANE);
+        rsc->setCapability(RSC_HWRENDER_TO_TEXTURE);
+        rsc->setCapability(RSC_TEXTURE_FLOAT);
+        rsc->setCapability(RSC_NON_POWER_OF_2_TEXTURES);
+        rsc->setCapability(RSC_TEXTURE_1D);
+        rsc->setCapability(RSC_TEXTURE_3D);
+        rsc->setCapability(RSC_POINT_SPRITES);
+        rsc->setCapability(RSC_POINT_EXTENDED_PARAMETERS);
+        rsc->setCapability(RSC_MIPMAP_LOD_BIAS);
+        rsc->setCapability(RSC_TEXTURE_COMPRESSION);
+        rsc->setCapability(RSC_TEXTURE_COMPRESSION_DXT);
+        rsc->setCapability(RSC_AUTOMIPMAP_COMPRESSED);
+        rsc->setCapability(RSC_RTT_MAIN_DEPTHBUFFER_ATTACHABLE);
+
+        // programs of the "null" syntax are accepted and never compiled, this
+        // lets programmable materials exercise the GPU program parameter path
+        rsc->setCapability(RSC_VERTEX_PROGRAM);
+        rsc->setCapability(RSC_FRAGMENT_PROGRAM);
+        rsc->addShaderProfile("null");
+        rsc->setVertexProgramConstantFloatCount(256);
+        rsc->setVertexProgramConstantIntCount(16);
+        rsc->setVertexProgramConstantBoolCount(16);
+        rsc->setFragmentProgramConstantFloatCount(256);
+        rsc->setFragmentProgramConstantIntCount(16);
+        rsc->setFragmentProgramConstantBoolCount(16);
+
+        rsc->setStencilBufferBitDepth(8);
+        rsc->setNumTextureUnits(OGRE_MAX_TEXTURE_LAYERS);
+        rsc->setNumMultiRenderTargets(std::min<int>(OGRE_MAX_MULTIPLE_RENDER_TARGETS, 8));
+        rsc->setNumVertexAttributes(16);
+        rsc->setMaxPointSize(256);
+        rsc->setMaxSupportedAnisotropy(16);
+
+        return rsc;
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::initialiseFromRenderSystemCapabilities(RenderSystemCapabilities* caps,
+                                                                  RenderTarget* primary)
+    {
+        if (caps->getRenderSystemName() != getName())
+        {
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS,
+                        "Trying to initialize NullRenderSystem from RenderSystemCapabilities that do not support it",
+                        "NullRenderSystem::initialiseFromRenderSystemCapabilities");
+        }
+
+        mHardwareBufferManager = new NullHardwareBufferManager(this);
+        mGpuProgramManager = new NullGpuProgramManager();
+
+        Log* defaultLog = LogManager::getSingleton().getDefaultLog();
+        if (defaultLog)
+        {
+            caps->log(defaultLog);
+        }
+
+        mInitialised = true;
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::reinitialise(void)
+    {
+        shutdown();
+        _initialise(true);
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::shutdown(void)
+    {
+        RenderSystem::shutdown();
+
+        delete mGpuProgramManager;
+        mGpuProgramManager = 0;
+
+        delete mHardwareBufferManager;
+        mHardwareBufferManager = 0;
+
+        delete mTextureManager;
+        mTextureManager = 0;
+
+        mInitialised = false;
+    }
+    //---------------------------------------------------------------------
+    RenderWindow* NullRenderSystem::_createRenderWindow(const String& name, unsigned int width,
+                                                        unsigned int height, bool fullScreen,
+                                                        const NameValuePairList* miscParams)
+    {
+        if (mRenderTargets.find(name) != mRenderTargets.end())
+        {
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS,
+                        "Window with name '" + name + "' already exists",
+                        "NullRenderSystem::_createRenderWindow");
+        }
+
+        NullRenderWindow* win = new NullRenderWindow();
+        win->create(name, width, height, fullScreen, miscParams);
+
+        attachRenderTarget(*win);
+
+        if (!mInitialised)
+        {
+            // Initialise after the first window has been created, like the other render systems
+            OGRE_DELETE mRealCapabilities;
+            mRealCapabilities = createRenderSystemCapabilities();
+
+            // use real capabilities if custom capabilities are not available
+            if (!mUseCustomCapabilities)
+                mCurrentCapabilities = mRealCapabilities;
+
+            fireEvent("RenderSystemCapabilitiesCreated");
+
+            initialiseFromRenderSystemCapabilities(mCurrentCapabilities, win);
+        }
+
+        return win;
+    }
+    //---------------------------------------------------------------------
+    MultiRenderTarget* NullRenderSystem::createMultiRenderTarget(const String& name)
+    {
+        MultiRenderTarget* retval = new NullMultiRenderTarget(name);
+        attachRenderTarget(*retval);
+        return retval;
+    }
+    //---------------------------------------------------------------------
+    DepthBuffer* NullRenderSystem::_createDepthBufferFor(RenderTarget* renderTarget)
+    {
+        return new DepthBuffer(DepthBuffer::POOL_DEFAULT, 32, renderTarget->getWidth(),
+                               renderTarget->getHeight(), renderTarget->getFSAA(),
+                               renderTarget->getFSAAHint(), false);
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::_swapAllRenderTargetBuffers()
+    {
+        RenderSystem::_swapAllRenderTargetBuffers();
+
+        // end of the frame
+        mLastFrameStats = mFrameStats;
+        mFrameStats = FrameStats();
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::_setViewport(Viewport* vp)
+    {
+        if (!vp)
+        {
+            mActiveViewport = NULL;
+            _setRenderTarget(NULL);
+        }
+        else if (vp != mActiveViewport || vp->_isUpdated())
+        {
+            _setRenderTarget(vp->getTarget());
+            mActiveViewport = vp;
+            vp->_clearUpdatedFlag();
+            ++mFrameStats.stateChanges;
+        }
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::_setRenderTarget(RenderTarget* target)
+    {
+        mActiveRenderTarget = target;
+        if (target && target->getDepthBufferPool() != DepthBuffer::POOL_NO_DEPTH &&
+            !target->getDepthBuffer())
+        {
+            // Depth is automatically managed and there is no depth buffer attached to this RT
+            setDepthBufferFor(target);
+        }
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::_render(const RenderOperation& op)
+    {
+        // Update stats
+        RenderSystem::_render(op);
+
+        ++mFrameStats.drawCalls;
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::_executeCommandList(const RenderCommandList& list)
+    {
+        ++mFrameStats.commandListsExecuted;
+        mFrameStats.commandsExecuted += list.getNumCommands();
+
+        RenderSystem::_executeCommandList(list);
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::bindGpuProgram(GpuProgram* prg)
+    {
+        RenderSystem::bindGpuProgram(prg);
+        ++mFrameStats.stateChanges;
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::unbindGpuProgram(GpuProgramType gptype)
+    {
+        RenderSystem::unbindGpuProgram(gptype);
+        ++mFrameStats.stateChanges;
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::bindGpuProgramParameters(GpuProgramType gptype,
+        GpuProgramParametersSharedPtr params, uint16 variabilityMask)
+    {
+        // a real device would only upload what changed since the last bind
+        mFrameStats.constantBytesUploaded +=
+            params->_getFloatDirtyRange().size() * sizeof(float) +
+            params->_getDoubleDirtyRange().size() * sizeof(double) +
+            params->_getIntDirtyRange().size() * sizeof(int);
+        params->_clearDirtyRanges();
+
+        ++mFrameStats.constantBinds;
+        ++mFrameStats.stateChanges;
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::_makeProjectionMatrix(const Radian& fovy, Real aspect, Real nearPlane,
+                                                 Real farPlane, Matrix4& dest, bool forGpuProgram)
+    {
+        OGRE_EXCEPT(Exception::ERR_NOT_IMPLEMENTED, "use Frustum::getProjectionMatrixRS",
+                    "NullRenderSystem::_makeProjectionMatrix");
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::_makeProjectionMatrix(Real left, Real right, Real bottom, Real top,
+                                                 Real nearPlane, Real farPlane, Matrix4& dest,
+                                                 bool forGpuProgram)
+    {
+        OGRE_EXCEPT(Exception::ERR_NOT_IMPLEMENTED, "use Frustum::getProjectionMatrixRS",
+                    "NullRenderSystem::_makeProjectionMatrix");
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::_makeOrthoMatrix(const Radian& fovy, Real aspect, Real nearPlane,
+                                            Real farPlane, Matrix4& dest, bool forGpuProgram)
+    {
+        OGRE_EXCEPT(Exception::ERR_NOT_IMPLEMENTED, "use Frustum::getProjectionMatrixRS",
+                    "NullRenderSystem::_makeOrthoMatrix");
+    }
+    //---------------------------------------------------------------------
+    void NullRenderSystem::_applyObliqueDepthProjection(Matrix4& matrix, const Plane& plane,
+                                                        bool forGpuProgram)
+    {
+        OGRE_EXCEPT(Exception::ERR_NOT_IMPLEMENTED, "use Frustum::getProjectionMatrixRS",
+                    "NullRenderSystem::_applyObliqueDepthProjection");
+    }
+}
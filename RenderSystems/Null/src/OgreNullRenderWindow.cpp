@@ -0,0 +1,121 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include "OgreNullRenderWindow.h"
+#include "OgreViewport.h"
+#include "OgreStringConverter.h"
+
+namespace Ogre {
+    //---------------------------------------------------------------------
+    NullRenderWindow::NullRenderWindow() : mClosed(false), mHidden(false)
+    {
+    }
+    //---------------------------------------------------------------------
+    NullRenderWindow::~NullRenderWindow()
+    {
+        destroy();
+    }
+    //---------------------------------------------------------------------
+    void NullRenderWindow::create(const String& name, unsigned int widthPt, unsigned int heightPt,
+                                  bool fullScreen, const NameValuePairList* miscParams)
+    {
+        mName = name;
+        mWidth = widthPt;
+        mHeight = heightPt;
+        mIsFullScreen = fullScreen;
+        mColourDepth = 32;
+
+        if (miscParams)
+        {
+            NameValuePairList::const_iterator opt;
+            if ((opt = miscParams->find("left")) != miscParams->end())
+                mLeft = StringConverter::parseInt(opt->second);
+            if ((opt = miscParams->find("top")) != miscParams->end())
+                mTop = StringConverter::parseInt(opt->second);
+            if ((opt = miscParams->find("hidden")) != miscParams->end())
+                mHidden = StringConverter::parseBool(opt->second);
+            if ((opt = miscParams->find("FSAA")) != miscParams->end())
+                mFSAA = StringConverter::parseUnsignedInt(opt->second);
+        }
+
+        mActive = true;
+        mClosed = false;
+    }
+    //---------------------------------------------------------------------
+    void NullRenderWindow::destroy(void)
+    {
+        mActive = false;
+        mClosed = true;
+    }
+    //---------------------------------------------------------------------
+    void NullRenderWindow::resize(unsigned int widthPt, unsigned int heightPt)
+    {
+        if (mWidth == widthPt && mHeight == heightPt)
+            return;
+
+        mWidth = widthPt;
+        mHeight = heightPt;
+
+        for (ViewportList::iterator it = mViewportList.begin(); it != mViewportList.end(); ++it)
+            (*it).second->_updateDimensions();
+    }
+    //---------------------------------------------------------------------
+    void NullRenderWindow::reposition(int leftPt, int topPt)
+    {
+        mLeft = leftPt;
+        mTop = topPt;
+    }
+    //---------------------------------------------------------------------
+    void NullRenderWindow::copyContentsToMemory(const Box& src, const PixelBox& dst, FrameBuffer buffer)
+    {
+        if (!Box(0, 0, mWidth, mHeight).contains(src))
+        {
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Invalid box.",
+                        "NullRenderWindow::copyContentsToMemory");
+        }
+
+        const size_t elemSize = PixelUtil::getNumElemBytes(dst.format);
+        for (uint32 z = dst.front; z < dst.back; z++)
+        {
+            for (uint32 y = dst.top; y < dst.bottom; y++)
+            {
+                uchar* row = dst.data + (z * dst.slicePitch + y * dst.rowPitch + dst.left) * elemSize;
+                memset(row, 0, dst.getWidth() * elemSize);
+            }
+        }
+    }
+    //---------------------------------------------------------------------
+    void NullMultiRenderTarget::bindSurfaceImpl(size_t attachment, RenderTexture* target)
+    {
+        if (attachment == 0)
+        {
+            mWidth = target->getWidth();
+            mHeight = target->getHeight();
+        }
+    }
+}
@@ -0,0 +1,299 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include "OgreNullTexture.h"
+#include "OgreNullRenderSystem.h"
+#include "OgreResourceGroupManager.h"
+#include "OgreBitwise.h"
+#include "OgreRoot.h"
+
+namespace Ogre {
+    //-----------------------------------------------------------------------------
+    NullRenderTexture::NullRenderTexture(const String& name, HardwarePixelBuffer* buffer,
+                                         uint32 zoffset, uint fsaa)
+        : RenderTexture(buffer, zoffset)
+    {
+        mName = name;
+        mFSAA = fsaa;
+    }
+    //-----------------------------------------------------------------------------
+    NullHardwarePixelBuffer::NullHardwarePixelBuffer(NullRenderSystem* rs, const String& parentName,
+                                                     uint32 width, uint32 height, uint32 depth,
+                                                     PixelFormat format, int usage, uint fsaa)
+        : HardwarePixelBuffer(width, height, depth, format, (HardwareBuffer::Usage)usage, false, false),
+          mRenderSystem(rs), mCurrentLockOptions(HBL_NORMAL)
+    {
+        mSizeInBytes = PixelUtil::getMemorySize(width, height, depth, format);
+        mBuffer = PixelBox(width, height, depth, format, OGRE_MALLOC(mSizeInBytes, MEMCATEGORY_RENDERSYS));
+
+        if (usage & TU_RENDERTARGET)
+        {
+            // Create render target for each slice
+            mSliceTRT.reserve(mDepth);
+            for (uint32 zoffset = 0; zoffset < mDepth; ++zoffset)
+            {
+                String name = "rtt/" + StringConverter::toString((size_t)this) + "/" + parentName;
+                if (zoffset > 0)
+                    name += "/" + StringConverter::toString(zoffset);
+                mSliceTRT.push_back(OGRE_NEW NullRenderTexture(name, this, zoffset, fsaa));
+                mRenderSystem->attachRenderTarget(*mSliceTRT[zoffset]);
+            }
+        }
+    }
+    //-----------------------------------------------------------------------------
+    NullHardwarePixelBuffer::~NullHardwarePixelBuffer()
+    {
+        // Delete all render targets that were not deleted by the user already
+        for (SliceTRT::const_iterator it = mSliceTRT.begin(); it != mSliceTRT.end(); ++it)
+        {
+            if (*it)
+                mRenderSystem->destroyRenderTarget((*it)->getName());
+        }
+
+        OGRE_FREE(mBuffer.data, MEMCATEGORY_RENDERSYS);
+    }
+    //-----------------------------------------------------------------------------
+    PixelBox NullHardwarePixelBuffer::lockImpl(const Box& lockBox, LockOptions options)
+    {
+        mCurrentLockOptions = options;
+        mLockedBox = lockBox;
+        return mBuffer.getSubVolume(lockBox);
+    }
+    //-----------------------------------------------------------------------------
+    void NullHardwarePixelBuffer::unlockImpl(void)
+    {
+        if (mCurrentLockOptions != HBL_READ_ONLY)
+        {
+            mRenderSystem->_notifyBytesUploaded(PixelUtil::getMemorySize(
+                mLockedBox.getWidth(), mLockedBox.getHeight(), mLockedBox.getDepth(), mFormat));
+        }
+    }
+    //-----------------------------------------------------------------------------
+    void NullHardwarePixelBuffer::blitFromMemory(const PixelBox& src, const Box& dstBox)
+    {
+        if (!mBuffer.contains(dstBox))
+        {
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Destination box out of range",
+                        "NullHardwarePixelBuffer::blitFromMemory");
+        }
+
+        PixelBox dst = mBuffer.getSubVolume(dstBox);
+        if (src.getWidth() != dst.getWidth() || src.getHeight() != dst.getHeight() ||
+            src.getDepth() != dst.getDepth())
+        {
+            Image::scale(src, dst);
+        }
+        else
+        {
+            PixelUtil::bulkPixelConversion(src, dst);
+        }
+
+        mRenderSystem->_notifyBytesUploaded(PixelUtil::getMemorySize(
+            dstBox.getWidth(), dstBox.getHeight(), dstBox.getDepth(), mFormat));
+    }
+    //-----------------------------------------------------------------------------
+    void NullHardwarePixelBuffer::blitToMemory(const Box& srcBox, const PixelBox& dst)
+    {
+        if (!mBuffer.contains(srcBox))
+        {
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Source box out of range",
+                        "NullHardwarePixelBuffer::blitToMemory");
+        }
+
+        PixelBox src = mBuffer.getSubVolume(srcBox);
+        if (src.getWidth() != dst.getWidth() || src.getHeight() != dst.getHeight() ||
+            src.getDepth() != dst.getDepth())
+        {
+            Image::scale(src, dst);
+        }
+        else
+        {
+            PixelUtil::bulkPixelConversion(src, dst);
+        }
+    }
+    //-----------------------------------------------------------------------------
+    RenderTexture* NullHardwarePixelBuffer::getRenderTarget(size_t zoffset)
+    {
+        assert(mUsage & TU_RENDERTARGET);
+        assert(zoffset < mDepth);
+        return mSliceTRT[zoffset];
+    }
+    //-----------------------------------------------------------------------------
+    void NullHardwarePixelBuffer::_clearSliceRTT(size_t zoffset)
+    {
+        mSliceTRT[zoffset] = NULL;
+    }
+    //-----------------------------------------------------------------------------
+    NullTexture::NullTexture(ResourceManager* creator, const String& name, ResourceHandle handle,
+                             const String& group, bool isManual, ManualResourceLoader* loader,
+                             NullRenderSystem* renderSystem)
+        : Texture(creator, name, handle, group, isManual, loader), mRenderSystem(renderSystem)
+    {
+    }
+    //-----------------------------------------------------------------------------
+    NullTexture::~NullTexture()
+    {
+        // have to call this here rather than in Resource destructor
+        // since calling virtual methods in base destructors causes crash
+        if (isLoaded())
+        {
+            unload();
+        }
+        else
+        {
+            freeInternalResources();
+        }
+    }
+    //-----------------------------------------------------------------------------
+    void NullTexture::readImage(const String& name, const String& ext)
+    {
+        mLoadedImages.push_back(Image());
+        DataStreamPtr dstream = ResourceGroupManager::getSingleton().openResource(name, mGroup, this);
+        mLoadedImages.back().load(dstream, ext);
+    }
+    //-----------------------------------------------------------------------------
+    void NullTexture::prepareImpl(void)
+    {
+        if (mUsage & TU_RENDERTARGET)
+            return;
+
+        String baseName, ext;
+        StringUtil::splitBaseFilename(mName, baseName, ext);
+
+        if (mTextureType == TEX_TYPE_CUBE_MAP && getSourceFileType() != "dds")
+        {
+            for (size_t i = 0; i < 6; i++)
+            {
+                String fullName = baseName + CUBEMAP_SUFFIXES[i];
+                if (!ext.empty())
+                    fullName = fullName + "." + ext;
+                readImage(fullName, ext);
+            }
+            return;
+        }
+
+        readImage(mName, ext);
+
+        // If this is a cube map, set the texture type flag accordingly.
+        if (mLoadedImages[0].hasFlag(IF_CUBEMAP))
+            mTextureType = TEX_TYPE_CUBE_MAP;
+        // If this is a volumetric texture set the texture type flag accordingly.
+        if (mLoadedImages[0].getDepth() > 1 && mTextureType != TEX_TYPE_2D_ARRAY)
+            mTextureType = TEX_TYPE_3D;
+    }
+    //-----------------------------------------------------------------------------
+    void NullTexture::unprepareImpl(void)
+    {
+        mLoadedImages.clear();
+    }
+    //-----------------------------------------------------------------------------
+    void NullTexture::loadImpl(void)
+    {
+        if (mUsage & TU_RENDERTARGET)
+        {
+            createInternalResources();
+            return;
+        }
+
+        // Now the only copy is on the stack and will be cleaned in case of
+        // exceptions being thrown from _loadImages
+        std::vector<Image> loadedImages;
+        std::swap(loadedImages, mLoadedImages);
+
+        ConstImagePtrList imagePtrs;
+        for (size_t i = 0; i < loadedImages.size(); ++i)
+        {
+            imagePtrs.push_back(&loadedImages[i]);
+        }
+
+        _loadImages(imagePtrs);
+    }
+    //-----------------------------------------------------------------------------
+    void NullTexture::createInternalResourcesImpl(void)
+    {
+        mFormat = TextureManager::getSingleton().getNativeFormat(mTextureType, mFormat, mUsage);
+
+        // Check requested number of mipmaps
+        uint32 maxMips = Bitwise::mostSignificantBitSet(std::max(mWidth, std::max(mHeight, mDepth)));
+        mNumMipmaps = std::min(mNumRequestedMipmaps, maxMips);
+
+        // There is nothing to generate the mipmaps, pretend the device did it
+        mMipmapsHardwareGenerated = true;
+
+        mSurfaceList.clear();
+        for (size_t face = 0; face < getNumFaces(); face++)
+        {
+            uint32 width = mWidth;
+            uint32 height = mHeight;
+            uint32 depth = mDepth;
+
+            for (uint32 mip = 0; mip <= mNumMipmaps; mip++)
+            {
+                mSurfaceList.push_back(HardwarePixelBufferSharedPtr(OGRE_NEW NullHardwarePixelBuffer(
+                    mRenderSystem, mName, width, height, depth, mFormat, mUsage, mFSAA)));
+
+                if (width > 1)
+                    width = width / 2;
+                if (height > 1)
+                    height = height / 2;
+                if (depth > 1 && mTextureType != TEX_TYPE_2D_ARRAY)
+                    depth = depth / 2;
+            }
+        }
+    }
+    //-----------------------------------------------------------------------------
+    void NullTexture::freeInternalResourcesImpl(void)
+    {
+        // surfaces are released by Texture::freeInternalResources
+    }
+    //-----------------------------------------------------------------------------
+    NullTextureManager::NullTextureManager(NullRenderSystem* renderSystem)
+        : TextureManager(), mRenderSystem(renderSystem)
+    {
+        // register with group manager
+        ResourceGroupManager::getSingleton()._registerResourceManager(mResourceType, this);
+    }
+    //-----------------------------------------------------------------------------
+    NullTextureManager::~NullTextureManager()
+    {
+        // unregister with group manager
+        ResourceGroupManager::getSingleton()._unregisterResourceManager(mResourceType);
+    }
+    //-----------------------------------------------------------------------------
+    Resource* NullTextureManager::createImpl(const String& name, ResourceHandle handle,
+        const String& group, bool isManual, ManualResourceLoader* loader,
+        const NameValuePairList* createParams)
+    {
+        return OGRE_NEW NullTexture(this, name, handle, group, isManual, loader, mRenderSystem);
+    }
+    //-----------------------------------------------------------------------------
+    PixelFormat NullTextureManager::getNativeFormat(TextureType ttype, PixelFormat format, int usage)
+    {
+        return format == PF_UNKNOWN ? PF_BYTE_RGBA : format;
+    }
+}
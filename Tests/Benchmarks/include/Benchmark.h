@@ -0,0 +1,107 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#ifndef __Benchmark_H__
+#define __Benchmark_H__
+
+#include "OgrePrerequisites.h"
+
+namespace Ogre
+{
+    class HardwareBufferManager;
+}
+
+/** Minimal framework for CPU side performance measurements.
+    Benchmarks register themselves with OGRE_BENCHMARK and run headless, without
+    a render system or with the Null render system, so the results only depend on
+    the CPU they run on.
+*/
+namespace Benchmarks
+{
+    typedef void (*BenchmarkFunc)();
+
+    /// Registers a benchmark at static initialisation time, see OGRE_BENCHMARK
+    struct Registration
+    {
+        Registration(const char* name, BenchmarkFunc func);
+    };
+
+    typedef std::map<Ogre::String, BenchmarkFunc> BenchmarkMap;
+    BenchmarkMap& getBenchmarks();
+
+    /** Sets up a Root without render system, which is enough to create scene
+        managers and entities using the DefaultHardwareBufferManager.
+    */
+    class HeadlessRoot
+    {
+        Ogre::Root* mRoot;
+        Ogre::HardwareBufferManager* mHBM;
+    public:
+        HeadlessRoot();
+        ~HeadlessRoot();
+    };
+
+    /// Runs func repeatedly and returns the average time per iteration in milliseconds
+    template<typename Func> double timeIterations(size_t iterations, Func func);
+
+    /// Records a measurement of the benchmark in the given configuration
+    void report(const Ogre::String& benchmark, const Ogre::String& config, double msPerIteration);
+
+    /// Thread counts to scale parallel benchmarks over: powers of two up to the hardware threads
+    std::vector<size_t> getThreadCounts();
+
+    /// Options given on the command line as --name=value
+    typedef std::map<Ogre::String, Ogre::String> OptionMap;
+    OptionMap& getOptions();
+
+    /// Value of the command line option --name=value, or defaultValue if not given
+    Ogre::String getOption(const Ogre::String& name, const Ogre::String& defaultValue);
+
+    /// Numeric value of the command line option --name=value, or defaultValue if not given
+    size_t getOption(const Ogre::String& name, size_t defaultValue);
+}
+
+#define OGRE_BENCHMARK(name) \
+    static void name(); \
+    static Benchmarks::Registration name##Registration(#name, &name); \
+    static void name()
+
+#include "OgreTimer.h"
+
+namespace Benchmarks
+{
+    template<typename Func> double timeIterations(size_t iterations, Func func)
+    {
+        Ogre::Timer timer;
+        for (size_t i = 0; i < iterations; ++i)
+            func();
+        return timer.getMicroseconds() / 1000.0 / iterations;
+    }
+}
+
+#endif
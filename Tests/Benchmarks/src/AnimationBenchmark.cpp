@@ -0,0 +1,177 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include "Benchmark.h"
+
+#include "OgreAnimation.h"
+#include "OgreBone.h"
+#include "OgreCompressedNodeAnimation.h"
+#include "OgreKeyFrame.h"
+#include "OgreSkeleton.h"
+#include "OgreSkeletonManager.h"
+#include "OgreStringConverter.h"
+
+#include <random>
+#include <set>
+
+using namespace Ogre;
+
+/** Applying a skeletal animation with node tracks and with compressed node tracks. */
+OGRE_BENCHMARK(NodeAnimationSampling)
+{
+    Benchmarks::HeadlessRoot root;
+
+    const size_t numBones = Benchmarks::getOption("bones", size_t(64));
+    const size_t numKeys = Benchmarks::getOption("keys", size_t(60));
+    const Real length = 2;
+
+    SkeletonPtr skel = SkeletonManager::getSingleton().create(
+        "NodeAnimationSampling", ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+    skel->createBone();
+    for (size_t i = 1; i < numBones; ++i)
+        skel->getBone(static_cast<unsigned short>((i - 1) / 2))->createChild(static_cast<unsigned short>(i));
+    skel->setBindingPose();
+
+    std::minstd_rand rng;
+    std::uniform_real_distribution<Real> dist(-1, 1);
+    Animation* anim = skel->createAnimation("Random", length);
+    for (unsigned short i = 0; i < numBones; ++i)
+    {
+        NodeAnimationTrack* track = anim->createNodeTrack(i, skel->getBone(i));
+        for (size_t k = 0; k < numKeys; ++k)
+        {
+            TransformKeyFrame* kf = track->createNodeKeyFrame(length * k / numKeys);
+            kf->setRotation(Quaternion(Radian(dist(rng)), Vector3(dist(rng), dist(rng), dist(rng)).normalisedCopy()));
+            kf->setTranslate(Vector3(dist(rng), dist(rng), dist(rng)) * 10);
+        }
+    }
+
+    size_t trackSize = 0;
+    for (unsigned short i = 0; i < numBones; ++i)
+        trackSize += sizeof(NodeAnimationTrack) + numKeys * (sizeof(TransformKeyFrame) + sizeof(KeyFrame*));
+
+    const size_t numSamples = 1000;
+    Real timePos = 0;
+    double tracksTime = Benchmarks::timeIterations(20, [&]() {
+        for (size_t i = 0; i < numSamples; ++i, timePos += 0.0137f)
+        {
+            skel->reset();
+            anim->apply(skel.get(), timePos);
+        }
+    });
+
+    anim->compressNodeTracks(true);
+    size_t compressedSize = anim->getCompressedNodeTracks()->calculateSize();
+    timePos = 0;
+    double compressedTime = Benchmarks::timeIterations(20, [&]() {
+        for (size_t i = 0; i < numSamples; ++i, timePos += 0.0137f)
+        {
+            skel->reset();
+            anim->apply(skel.get(), timePos);
+        }
+    });
+
+    String config = StringConverter::toString(numBones) + " bones, " + StringConverter::toString(numKeys) +
+                    " keys, " + StringConverter::toString(numSamples) + " samples, ";
+    Benchmarks::report("NodeAnimationSampling",
+                       config + "tracks (" + StringConverter::toString(trackSize / 1024) + " KiB)", tracksTime);
+    Benchmarks::report("NodeAnimationSampling",
+                       config + "compressed (" + StringConverter::toString(compressedSize / 1024) + " KiB, x" +
+                           StringConverter::toString(Real(tracksTime / compressedTime), 3) + ")",
+                       compressedTime);
+}
+
+/** Playing a long clip with unaligned keys, searching the keyframes of each track
+    from scratch and resuming from the keyframe cursors of the animation state. */
+OGRE_BENCHMARK(KeyFrameCursors)
+{
+    Benchmarks::HeadlessRoot root;
+
+    const size_t numBones = Benchmarks::getOption("bones", size_t(64));
+    const Real length = 30;
+    const Real keyInterval = Real(1) / 120;
+
+    SkeletonPtr skel = SkeletonManager::getSingleton().create(
+        "KeyFrameCursors", ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+    skel->createBone();
+    for (size_t i = 1; i < numBones; ++i)
+        skel->getBone(static_cast<unsigned short>((i - 1) / 2))->createChild(static_cast<unsigned short>(i));
+    skel->setBindingPose();
+
+    // motion capture like clip, every track sampled at its own times
+    std::minstd_rand rng;
+    std::uniform_real_distribution<Real> dist(-1, 1);
+    Animation* anim = skel->createAnimation("Unaligned", length);
+    std::set<Real> keyTimes;
+    for (unsigned short i = 0; i < numBones; ++i)
+    {
+        NodeAnimationTrack* track = anim->createNodeTrack(i, skel->getBone(i));
+        for (Real time = keyInterval * (dist(rng) + 1) / 2; time < length;
+             time += keyInterval * (1 + dist(rng) / 4))
+        {
+            TransformKeyFrame* kf = track->createNodeKeyFrame(time);
+            kf->setRotation(Quaternion(Radian(dist(rng)), Vector3::UNIT_Y));
+            kf->setTranslate(Vector3(dist(rng), dist(rng), dist(rng)));
+            keyTimes.insert(time);
+        }
+    }
+    // what the global index maps took: one entry per track and key time
+    size_t indexMapSize = numBones * (keyTimes.size() + 1) * sizeof(ushort) + keyTimes.size() * sizeof(Real);
+
+    AnimationStateSet states;
+    AnimationState* state = states.createAnimationState("Unaligned", 0, length, 1, true);
+
+    // a minute of playback at 60 fps
+    const size_t numFrames = 3600;
+    double searchTime = Benchmarks::timeIterations(5, [&]() {
+        for (size_t i = 0; i < numFrames; ++i)
+        {
+            skel->reset();
+            anim->apply(skel.get(), Real(i) / 60);
+        }
+    });
+    double cursorTime = Benchmarks::timeIterations(5, [&]() {
+        for (size_t i = 0; i < numFrames; ++i)
+        {
+            skel->reset();
+            anim->apply(skel.get(), Real(i) / 60, 1, 1, state->_getKeyFrameCursors());
+        }
+    });
+
+    String config = StringConverter::toString(numBones) + " tracks, " +
+                    StringConverter::toString(keyTimes.size()) + " key times, " +
+                    StringConverter::toString(numFrames) + " frames, ";
+    Benchmarks::report("KeyFrameCursors",
+                       config + "search (index maps took " +
+                           StringConverter::toString(indexMapSize / 1024) + " KiB)",
+                       searchTime);
+    Benchmarks::report("KeyFrameCursors",
+                       config + "cursors (" + StringConverter::toString(numBones * sizeof(ushort)) +
+                           " bytes, x" + StringConverter::toString(Real(searchTime / cursorTime), 3) + ")",
+                       cursorTime);
+}
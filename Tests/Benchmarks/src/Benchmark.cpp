@@ -0,0 +1,104 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include "Benchmark.h"
+
+#include "OgreRoot.h"
+#include "OgreMaterialManager.h"
+#include "OgreMeshManager.h"
+#include "OgreDefaultHardwareBufferManager.h"
+#include "OgreLogManager.h"
+#include "OgreStringConverter.h"
+
+#include <cstdio>
+#include <thread>
+
+using namespace Ogre;
+
+namespace Benchmarks
+{
+    BenchmarkMap& getBenchmarks()
+    {
+        static BenchmarkMap benchmarks;
+        return benchmarks;
+    }
+
+    Registration::Registration(const char* name, BenchmarkFunc func)
+    {
+        getBenchmarks()[name] = func;
+    }
+
+    HeadlessRoot::HeadlessRoot()
+    {
+        mRoot = new Root("");
+        mHBM = new DefaultHardwareBufferManager;
+        MaterialManager::getSingleton().initialise();
+        MeshManager::getSingleton()._initialise();
+    }
+
+    HeadlessRoot::~HeadlessRoot()
+    {
+        delete mRoot;
+        delete mHBM;
+    }
+
+    void report(const String& benchmark, const String& config, double msPerIteration)
+    {
+        printf("%-32s %-32s %10.3f ms\n", benchmark.c_str(), config.c_str(), msPerIteration);
+        fflush(stdout);
+    }
+
+    std::vector<size_t> getThreadCounts()
+    {
+        size_t maxThreads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+
+        std::vector<size_t> counts;
+        for (size_t threads = 1; threads < maxThreads; threads *= 2)
+            counts.push_back(threads);
+        counts.push_back(maxThreads);
+        return counts;
+    }
+
+    OptionMap& getOptions()
+    {
+        static OptionMap options;
+        return options;
+    }
+
+    String getOption(const String& name, const String& defaultValue)
+    {
+        OptionMap::const_iterator i = getOptions().find(name);
+        return i != getOptions().end() ? i->second : defaultValue;
+    }
+
+    size_t getOption(const String& name, size_t defaultValue)
+    {
+        OptionMap::const_iterator i = getOptions().find(name);
+        return i != getOptions().end() ? StringConverter::parseSizeT(i->second, defaultValue) : defaultValue;
+    }
+}
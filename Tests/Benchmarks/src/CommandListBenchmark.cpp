@@ -0,0 +1,158 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include "Benchmark.h"
+
+#include "OgreRoot.h"
+#include "OgreRenderSystem.h"
+#include "OgreRenderCommandList.h"
+#include "OgreGpuProgramManager.h"
+#include "OgreMeshManager.h"
+#include "OgreMesh.h"
+#include "OgreSubMesh.h"
+#include "OgreFileSystemLayer.h"
+#include "OgreStringConverter.h"
+#include "OgreWorkerThreadPool.h"
+
+#include <cstdio>
+
+using namespace Ogre;
+
+namespace
+{
+    /// Records the draws of a part of the objects into the list of each thread
+    struct RecordTask : public UniformScalableTask
+    {
+        GpuProgram* program;
+        RenderOperation op;
+        std::vector<Matrix4> worldMatrices;
+        std::vector<RenderCommandList> lists;
+        std::vector<GpuProgramParametersSharedPtr> params;
+
+        void execute(size_t threadIdx, size_t numThreads)
+        {
+            RenderCommandList& list = lists[threadIdx];
+            const GpuProgramParametersSharedPtr& p = params[threadIdx];
+            list.clear();
+            list.bindGpuProgram(program);
+
+            const size_t numObjects = worldMatrices.size();
+            for (size_t i = threadIdx * numObjects / numThreads; i < (threadIdx + 1) * numObjects / numThreads;
+                 ++i)
+            {
+                p->setConstant(0, worldMatrices[i]);
+                list.setWorldMatrix(worldMatrices[i]);
+                list.bindGpuProgramParameters(GPT_VERTEX_PROGRAM, p, GPV_ALL);
+                list.render(op);
+            }
+        }
+    };
+}
+
+/** Issues the draws of many objects, each with its own world matrix constants, either
+    directly to the render system or recorded into one command list per thread which the
+    render thread then executes.
+@remarks
+    Uses the render system named by the rendersystem option, the Null render system by
+    default. draws sets the number of objects. The recording time is what the render
+    thread saves when the lists are recorded by other threads while it is busy with
+    the previous frame.
+*/
+OGRE_BENCHMARK(CommandList)
+{
+    const size_t numDraws = Benchmarks::getOption("draws", size_t(20000));
+    const String renderSystemName = Benchmarks::getOption("rendersystem", String("Null Rendering Subsystem"));
+
+    FileSystemLayer fsLayer(OGRE_VERSION_NAME);
+    Root* root = new Root(fsLayer.getConfigFilePath("plugins.cfg"), "", "");
+
+    RenderSystem* rs = root->getRenderSystemByName(renderSystemName);
+    if (!rs)
+    {
+        fprintf(stderr, "CommandList: render system \"%s\" not available, skipped\n", renderSystemName.c_str());
+        delete root;
+        return;
+    }
+    root->setRenderSystem(rs);
+    root->initialise(false);
+    root->createRenderWindow("CommandListBenchmark", 320, 240, false);
+
+    const String& group = ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME;
+    GpuProgramPtr vp = GpuProgramManager::getSingleton().createProgramFromString(
+        "CommandListBenchmarkVP", group, "null", GPT_VERTEX_PROGRAM, "null");
+    vp->load();
+    MeshPtr plane = MeshManager::getSingleton().createPlane("CommandListBenchmarkPlane", group,
+                                                            Plane(Vector3::UNIT_Z, 0), 50, 50);
+
+    RecordTask task;
+    task.program = vp.get();
+    plane->getSubMesh(0)->_getRenderOperation(task.op);
+    for (size_t i = 0; i < numDraws; ++i)
+        task.worldMatrices.push_back(Affine3::getTrans(Real(i), 0, 0));
+
+    String config = StringConverter::toString(numDraws) + " draws, ";
+
+    GpuProgramParametersSharedPtr params = vp->createParameters();
+    double immediate = Benchmarks::timeIterations(20, [&]() {
+        rs->bindGpuProgram(vp.get());
+        for (size_t i = 0; i < numDraws; ++i)
+        {
+            params->setConstant(0, task.worldMatrices[i]);
+            rs->_setWorldMatrix(task.worldMatrices[i]);
+            rs->bindGpuProgramParameters(GPT_VERTEX_PROGRAM, params, GPV_ALL);
+            rs->_render(task.op);
+        }
+    });
+    Benchmarks::report("CommandList", config + "immediate", immediate);
+
+    std::vector<size_t> threadCounts = Benchmarks::getThreadCounts();
+    for (size_t t = 0; t < threadCounts.size(); ++t)
+    {
+        WorkerThreadPool pool(threadCounts[t]);
+        task.lists.clear();
+        task.lists.resize(threadCounts[t]);
+        task.params.clear();
+        for (size_t p = 0; p < threadCounts[t]; ++p)
+            task.params.push_back(vp->createParameters());
+
+        // the first recording allocates the lists
+        pool.execute(&task);
+
+        double record = Benchmarks::timeIterations(20, [&]() { pool.execute(&task); });
+        double replay = Benchmarks::timeIterations(20, [&]() {
+            for (size_t l = 0; l < task.lists.size(); ++l)
+                rs->_executeCommandList(task.lists[l]);
+        });
+
+        String threads = StringConverter::toString(threadCounts[t]) + " threads, ";
+        Benchmarks::report("CommandList", config + threads + "recording", record);
+        Benchmarks::report("CommandList", config + threads + "replay", replay);
+    }
+
+    delete root;
+}
@@ -0,0 +1,82 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include "Benchmark.h"
+
+#include "OgreFrustum.h"
+#include "OgreStringConverter.h"
+
+#include <random>
+
+using namespace Ogre;
+
+/** Visibility of many boxes against a frustum, one at a time and batched. */
+OGRE_BENCHMARK(FrustumCulling)
+{
+    Benchmarks::HeadlessRoot root;
+
+    Frustum frustum;
+    frustum.setFOVy(Degree(60));
+    frustum.setNearClipDistance(1);
+    frustum.setFarClipDistance(1000);
+
+    const size_t numBoxes = 100000;
+    std::minstd_rand rng;
+    std::vector<AxisAlignedBox> boxes;
+    std::vector<float> centres, halfSizes;
+    for (size_t i = 0; i < numBoxes; ++i)
+    {
+        Vector3 centre(Real(rng() % 2000) - 1000, Real(rng() % 2000) - 1000, Real(rng() % 2000) - 1500);
+        Vector3 halfSize(Real(1 + rng() % 20));
+        boxes.push_back(AxisAlignedBox(centre - halfSize, centre + halfSize));
+        for (int j = 0; j < 3; ++j)
+        {
+            centres.push_back(float(centre[j]));
+            halfSizes.push_back(float(halfSize[j]));
+        }
+    }
+
+    size_t numVisible = 0;
+    double singleTime = Benchmarks::timeIterations(20, [&]() {
+        numVisible = 0;
+        for (size_t i = 0; i < numBoxes; ++i)
+            numVisible += frustum.isVisible(boxes[i]);
+    });
+
+    std::vector<uint32> visibility((numBoxes + 31) / 32);
+    double batchedTime = Benchmarks::timeIterations(20, [&]() {
+        frustum.calculateVisibility(centres.data(), halfSizes.data(), visibility.data(), numBoxes);
+    });
+
+    String boxCount = StringConverter::toString(numBoxes) + " boxes (" +
+                      StringConverter::toString(numVisible) + " visible), ";
+    Benchmarks::report("FrustumCulling", boxCount + "single", singleTime);
+    Benchmarks::report("FrustumCulling",
+                       boxCount + "batched (x" + StringConverter::toString(Real(singleTime / batchedTime), 3) + ")",
+                       batchedTime);
+}
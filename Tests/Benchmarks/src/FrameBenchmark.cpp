@@ -0,0 +1,593 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include "Benchmark.h"
+
+#include "OgreRoot.h"
+#include "OgreRenderWindow.h"
+#include "OgreViewport.h"
+#include "OgreSceneManager.h"
+#include "OgreSceneNode.h"
+#include "OgreCamera.h"
+#include "OgreEntity.h"
+#include "OgreLight.h"
+#include "OgreMeshManager.h"
+#include "OgreSubMesh.h"
+#include "OgreSkeletonManager.h"
+#include "OgreSkeleton.h"
+#include "OgreBone.h"
+#include "OgreAnimation.h"
+#include "OgreKeyFrame.h"
+#include "OgreMaterialManager.h"
+#include "OgreTechnique.h"
+#include "OgrePass.h"
+#include "OgreGpuProgramManager.h"
+#include "OgreParticleSystemManager.h"
+#include "OgreParticleSystem.h"
+#include "OgreParticleEmitter.h"
+#include "OgreStaticGeometry.h"
+#include "OgreStreamingBufferAllocator.h"
+#include "OgreFileSystemLayer.h"
+#include "OgreStringConverter.h"
+
+#include <cstdio>
+#include <fstream>
+#include <random>
+
+using namespace Ogre;
+
+namespace
+{
+    const String GROUP = ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME;
+
+    /// Size of the synthetic scene, taken from the command line options
+    struct SceneConfig
+    {
+        size_t entities;
+        size_t lights;
+        size_t characters;
+        size_t particleSystems;
+        size_t staticGeometry;
+        size_t materials;
+
+        SceneConfig()
+            : entities(Benchmarks::getOption("entities", size_t(5000))),
+              lights(Benchmarks::getOption("lights", size_t(50))),
+              characters(Benchmarks::getOption("characters", size_t(200))),
+              particleSystems(Benchmarks::getOption("particles", size_t(50))),
+              staticGeometry(Benchmarks::getOption("staticgeometry", size_t(5000))),
+              materials(Benchmarks::getOption("materials", size_t(16)))
+        {
+        }
+
+        String describe() const
+        {
+            return StringConverter::toString(entities) + " entities, " + StringConverter::toString(lights) +
+                   " lights, " + StringConverter::toString(characters) + " characters, " +
+                   StringConverter::toString(particleSystems) + " particle systems, " +
+                   StringConverter::toString(staticGeometry) + " static";
+        }
+    };
+
+    /** Materials with a programmable technique using a typical set of auto constants,
+        falling back to fixed function where the "null" program syntax is not supported.
+    */
+    void createMaterials(size_t count)
+    {
+        GpuProgramManager& progMgr = GpuProgramManager::getSingleton();
+        GpuProgramPtr vp = progMgr.createProgramFromString("FrameBenchmark/VP", GROUP, "null", GPT_VERTEX_PROGRAM,
+                                                           "null");
+        GpuProgramPtr fp = progMgr.createProgramFromString("FrameBenchmark/FP", GROUP, "null", GPT_FRAGMENT_PROGRAM,
+                                                           "null");
+
+        const size_t maxLights = 4;
+        GpuProgramParametersSharedPtr vpParams = vp->getDefaultParameters();
+        vpParams->setAutoConstant(0, GpuProgramParameters::ACT_WORLDVIEWPROJ_MATRIX);
+        vpParams->setAutoConstant(4, GpuProgramParameters::ACT_WORLD_MATRIX);
+        vpParams->setAutoConstant(8, GpuProgramParameters::ACT_CAMERA_POSITION_OBJECT_SPACE);
+
+        GpuProgramParametersSharedPtr fpParams = fp->getDefaultParameters();
+        fpParams->setAutoConstant(0, GpuProgramParameters::ACT_SURFACE_DIFFUSE_COLOUR);
+        fpParams->setAutoConstant(1, GpuProgramParameters::ACT_DERIVED_AMBIENT_LIGHT_COLOUR);
+        fpParams->setAutoConstant(2, GpuProgramParameters::ACT_FOG_PARAMS);
+
+        // one constant per light, indexed constants do not reserve room for arrays
+        for (size_t l = 0; l < maxLights; ++l)
+        {
+            vpParams->setAutoConstant(9 + l, GpuProgramParameters::ACT_LIGHT_POSITION_OBJECT_SPACE, l);
+            vpParams->setAutoConstant(9 + maxLights + l, GpuProgramParameters::ACT_LIGHT_ATTENUATION, l);
+            fpParams->setAutoConstant(3 + l, GpuProgramParameters::ACT_LIGHT_DIFFUSE_COLOUR, l);
+        }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            ColourValue colour(Real(i % 4) / 3, Real(i / 4 % 4) / 3, Real(i / 16 % 4) / 3);
+            MaterialPtr mat = MaterialManager::getSingleton().create(
+                "FrameBenchmark/Material" + StringConverter::toString(i), GROUP);
+
+            Pass* pass = mat->getTechnique(0)->getPass(0);
+            pass->setDiffuse(colour);
+            pass->setMaxSimultaneousLights(maxLights);
+            pass->setVertexProgram(vp->getName());
+            pass->setFragmentProgram(fp->getName());
+
+            pass = mat->createTechnique()->createPass();
+            pass->setDiffuse(colour);
+            pass->setMaxSimultaneousLights(maxLights);
+        }
+
+        MaterialPtr particleMat = MaterialManager::getSingleton().create("FrameBenchmark/Particle", GROUP);
+        particleMat->setSceneBlending(SBT_ADD);
+        particleMat->setDepthWriteEnabled(false);
+        particleMat->setLightingEnabled(false);
+    }
+
+    /** Tube wrapped around a chain of bones which wave back and forth, skinned on the CPU
+        like characters without hardware skinning.
+    */
+    MeshPtr createCharacterMesh(const String& materialName)
+    {
+        const ushort numBones = 16;
+        const size_t numRings = 65;
+        const size_t numSegments = 24;
+        const Real height = 100;
+        const Real radius = 10;
+        const Real boneLength = height / numBones;
+
+        SkeletonPtr skel = SkeletonManager::getSingleton().create("FrameBenchmark/Character.skeleton", GROUP, true);
+        Bone* parent = NULL;
+        for (ushort b = 0; b < numBones; ++b)
+        {
+            Bone* bone = skel->createBone(b);
+            if (parent)
+            {
+                parent->addChild(bone);
+                bone->setPosition(0, boneLength, 0);
+            }
+            parent = bone;
+        }
+        skel->setBindingPose();
+
+        const size_t numKeys = 8;
+        const Real length = 2;
+        Animation* anim = skel->createAnimation("Wave", length);
+        for (ushort b = 0; b < numBones; ++b)
+        {
+            NodeAnimationTrack* track = anim->createNodeTrack(b, skel->getBone(b));
+            for (size_t k = 0; k <= numKeys; ++k)
+            {
+                Real phase = Math::TWO_PI * k / numKeys + b * Real(0.4);
+                TransformKeyFrame* key = track->createNodeKeyFrame(length * k / numKeys);
+                key->setRotation(Quaternion(Degree(10 * Math::Sin(phase)), Vector3::UNIT_Z));
+            }
+        }
+
+        MeshPtr mesh = MeshManager::getSingleton().createManual("FrameBenchmark/Character.mesh", GROUP);
+        VertexData* vertexData = OGRE_NEW VertexData();
+        mesh->sharedVertexData = vertexData;
+        vertexData->vertexCount = numRings * numSegments;
+
+        // positions and normals are blended, keep them apart from the texture coordinates
+        VertexDeclaration* decl = vertexData->vertexDeclaration;
+        size_t offset = decl->addElement(0, 0, VET_FLOAT3, VES_POSITION).getSize();
+        decl->addElement(0, offset, VET_FLOAT3, VES_NORMAL);
+        decl->addElement(1, 0, VET_FLOAT2, VES_TEXTURE_COORDINATES);
+
+        std::vector<float> positions, texCoords;
+        for (size_t r = 0; r < numRings; ++r)
+        {
+            Real y = height * r / (numRings - 1);
+            for (size_t s = 0; s < numSegments; ++s)
+            {
+                Radian angle(Math::TWO_PI * s / numSegments);
+                Vector3 normal(Math::Cos(angle), 0, Math::Sin(angle));
+                Vector3 pos(normal * radius + Vector3(0, y, 0));
+                positions.insert(positions.end(), {float(pos.x), float(pos.y), float(pos.z),
+                                                   float(normal.x), float(normal.y), float(normal.z)});
+                texCoords.insert(texCoords.end(), {float(s) / numSegments, float(r) / (numRings - 1)});
+
+                // blend between the bone the vertex is on and the next one
+                Real b = std::min(y / boneLength, Real(numBones - 1));
+                ushort bone = ushort(b);
+                Real weight = b - bone;
+                VertexBoneAssignment vba;
+                vba.vertexIndex = uint(r * numSegments + s);
+                vba.boneIndex = bone;
+                vba.weight = 1 - weight;
+                mesh->addBoneAssignment(vba);
+                if (weight > 0 && bone + 1 < numBones)
+                {
+                    vba.boneIndex = bone + 1;
+                    vba.weight = weight;
+                    mesh->addBoneAssignment(vba);
+                }
+            }
+        }
+
+        HardwareBufferManager& hbm = HardwareBufferManager::getSingleton();
+        for (unsigned short source = 0; source < 2; ++source)
+        {
+            const std::vector<float>& data = source == 0 ? positions : texCoords;
+            HardwareVertexBufferSharedPtr vbuf = hbm.createVertexBuffer(
+                decl->getVertexSize(source), vertexData->vertexCount, HardwareBuffer::HBU_STATIC_WRITE_ONLY, true);
+            vbuf->writeData(0, vbuf->getSizeInBytes(), data.data(), true);
+            vertexData->vertexBufferBinding->setBinding(source, vbuf);
+        }
+
+        std::vector<uint16> indices;
+        for (size_t r = 0; r + 1 < numRings; ++r)
+        {
+            for (size_t s = 0; s < numSegments; ++s)
+            {
+                uint16 i0 = uint16(r * numSegments + s);
+                uint16 i1 = uint16(r * numSegments + (s + 1) % numSegments);
+                uint16 i2 = uint16(i0 + numSegments);
+                uint16 i3 = uint16(i1 + numSegments);
+                indices.insert(indices.end(), {i0, i2, i1, i1, i2, i3});
+            }
+        }
+
+        SubMesh* sub = mesh->createSubMesh();
+        sub->useSharedVertices = true;
+        sub->indexData->indexCount = indices.size();
+        sub->indexData->indexBuffer = hbm.createIndexBuffer(HardwareIndexBuffer::IT_16BIT, indices.size(),
+                                                            HardwareBuffer::HBU_STATIC_WRITE_ONLY);
+        sub->indexData->indexBuffer->writeData(0, sub->indexData->indexBuffer->getSizeInBytes(), indices.data(),
+                                               true);
+        sub->setMaterialName(materialName, GROUP);
+
+        mesh->setSkeletonName(skel->getName());
+        mesh->_compileBoneAssignments();
+        // room for the waving
+        mesh->_setBounds(AxisAlignedBox(-height / 2, 0, -height / 2, height / 2, height, height / 2));
+        mesh->_setBoundingSphereRadius(height);
+        mesh->load();
+        return mesh;
+    }
+
+    bool hasEmitterFactory(const String& type)
+    {
+        ParticleSystemManager::ParticleEmitterFactoryIterator i =
+            ParticleSystemManager::getSingleton().getEmitterFactoryIterator();
+        while (i.hasMoreElements())
+        {
+            if (i.peekNextKey() == type)
+                return true;
+            i.moveNext();
+        }
+        return false;
+    }
+
+    /// The synthetic scene and the per frame work the application does on it
+    class FrameScene
+    {
+        SceneManager* mSceneMgr;
+        SceneNode* mCameraNode;
+        std::vector<AnimationState*> mAnimationStates;
+        std::vector<Entity*> mCharacters;
+        std::vector<SceneNode*> mCharacterNodes;
+        Vector3 mCentre;
+        Real mExtent;
+        Real mTime;
+    public:
+        /// Time spent by the application on animation, in nanoseconds
+        uint64 animationTime;
+        size_t particleSystems;
+
+        FrameScene(SceneManager* sceneMgr, Camera* cam, const SceneConfig& config)
+            : mSceneMgr(sceneMgr), mTime(0), animationTime(0), particleSystems(0)
+        {
+            // fixed seed, so every run measures the same scene
+            std::minstd_rand rng;
+            const Real spacing = 300;
+            size_t numObjects = config.entities + config.characters + config.particleSystems + config.staticGeometry;
+            mExtent = spacing * Math::Sqrt(Real(std::max<size_t>(numObjects, 1)));
+            mCentre = Vector3(mExtent / 2, 0, mExtent / 2);
+
+            std::uniform_real_distribution<Real> coord(0, mExtent);
+            std::uniform_real_distribution<Real> unit(0, 1);
+            SceneNode* root = sceneMgr->getRootSceneNode();
+            size_t numMaterials = std::max<size_t>(config.materials, 1);
+            createMaterials(numMaterials);
+
+            for (size_t i = 0; i < config.entities; ++i)
+            {
+                Entity* ent = sceneMgr->createEntity(SceneManager::PT_CUBE);
+                ent->setMaterialName("FrameBenchmark/Material" + StringConverter::toString(i % numMaterials));
+                root->createChildSceneNode(Vector3(coord(rng), 50, coord(rng)),
+                                           Quaternion(Degree(360 * unit(rng)), Vector3::UNIT_Y))
+                    ->attachObject(ent);
+            }
+
+            if (config.staticGeometry)
+            {
+                StaticGeometry* geom = sceneMgr->createStaticGeometry("FrameBenchmark");
+                geom->setRegionDimensions(Vector3(spacing * 10));
+                Entity* ent = sceneMgr->createEntity(SceneManager::PT_CUBE);
+                for (size_t i = 0; i < config.staticGeometry; ++i)
+                {
+                    ent->setMaterialName("FrameBenchmark/Material" + StringConverter::toString(i % numMaterials));
+                    geom->addEntity(ent, Vector3(coord(rng), -50, coord(rng)),
+                                    Quaternion(Degree(360 * unit(rng)), Vector3::UNIT_Y));
+                }
+                geom->build();
+                sceneMgr->destroyEntity(ent);
+            }
+
+            if (config.characters)
+            {
+                MeshPtr mesh = createCharacterMesh("FrameBenchmark/Material0");
+                for (size_t i = 0; i < config.characters; ++i)
+                {
+                    Entity* ent = sceneMgr->createEntity(mesh);
+                    AnimationState* state = ent->getAnimationState("Wave");
+                    state->setEnabled(true);
+                    state->setLoop(true);
+                    state->setTimePosition(state->getLength() * unit(rng));
+                    mAnimationStates.push_back(state);
+                    mCharacters.push_back(ent);
+
+                    SceneNode* node = root->createChildSceneNode(Vector3(coord(rng), 0, coord(rng)));
+                    node->attachObject(ent);
+                    mCharacterNodes.push_back(node);
+                }
+            }
+
+            if (config.particleSystems && hasEmitterFactory("Point"))
+            {
+                for (size_t i = 0; i < config.particleSystems; ++i)
+                {
+                    ParticleSystem* ps = sceneMgr->createParticleSystem(200);
+                    ps->setMaterialName("FrameBenchmark/Particle", GROUP);
+                    ps->setDefaultDimensions(10, 10);
+                    ParticleEmitter* emitter = ps->addEmitter("Point");
+                    emitter->setDirection(Vector3::UNIT_Y);
+                    emitter->setAngle(Degree(30));
+                    emitter->setEmissionRate(50);
+                    emitter->setTimeToLive(2);
+                    emitter->setParticleVelocity(50, 100);
+                    root->createChildSceneNode(Vector3(coord(rng), 0, coord(rng)))->attachObject(ps);
+                    // start in the steady state
+                    ps->fastForward(2);
+                }
+                particleSystems = config.particleSystems;
+            }
+            else if (config.particleSystems)
+            {
+                fprintf(stderr, "Frame: no \"Point\" particle emitter (ParticleFX plugin), particle systems skipped\n");
+            }
+
+            sceneMgr->setAmbientLight(ColourValue(0.2f, 0.2f, 0.2f));
+            for (size_t i = 0; i < config.lights; ++i)
+            {
+                Light* light = sceneMgr->createLight();
+                light->setDiffuseColour(unit(rng), unit(rng), unit(rng));
+                light->setAttenuation(spacing * 2, 1, 0, 0);
+                root->createChildSceneNode(Vector3(coord(rng), 200, coord(rng)))->attachObject(light);
+            }
+
+            cam->setNearClipDistance(10);
+            cam->setFarClipDistance(mExtent * Real(1.5));
+            mCameraNode = root->createChildSceneNode();
+            mCameraNode->attachObject(cam);
+        }
+
+        /// Evaluates the skeletons of characters across the scene every 2 frames, far ones every 4
+        void enableAnimationLod()
+        {
+            std::vector<Real> lodValues;
+            lodValues.push_back(mExtent * Real(0.3));
+            lodValues.push_back(mExtent * Real(0.6));
+            std::vector<ushort> intervals;
+            intervals.push_back(2);
+            intervals.push_back(4);
+            for (size_t i = 0; i < mCharacters.size(); ++i)
+                mCharacters[i]->setAnimationLodLevels(lodValues, intervals);
+        }
+
+        /// Advances the scene by timeSinceLastFrame, like an application would before rendering it
+        void update(Real timeSinceLastFrame)
+        {
+            mTime += timeSinceLastFrame;
+
+            // orbit around the scene, looking across it
+            Radian angle(mTime * Real(0.1));
+            mCameraNode->setPosition(mCentre + Vector3(Math::Cos(angle), Real(0.2), Math::Sin(angle)) * mExtent *
+                                                   Real(0.6));
+            mCameraNode->lookAt(mCentre, Node::TS_WORLD);
+
+            for (size_t i = 0; i < mCharacterNodes.size(); ++i)
+                mCharacterNodes[i]->yaw(Radian(timeSinceLastFrame));
+
+            // evaluate the skeletons and skin the characters here, rather than lazily when they
+            // are queued, so this is measured separately from the queueing
+            Timer timer;
+            for (size_t i = 0; i < mAnimationStates.size(); ++i)
+                mAnimationStates[i]->addTime(timeSinceLastFrame);
+            for (size_t i = 0; i < mCharacters.size(); ++i)
+                mCharacters[i]->_updateAnimation();
+            animationTime += timer.getMicroseconds() * 1000;
+        }
+    };
+
+    struct Phase
+    {
+        const char* name;
+        double msPerFrame;
+    };
+}
+
+/** Renders a synthetic scene through Root::renderOneFrame and measures the time per frame
+    spent in each stage of the frame.
+@remarks
+    Uses the render system listed in plugins.cfg which is named by the rendersystem option,
+    the Null render system by default, so it runs on machines without a GPU. The scene is
+    sized by the entities, lights, characters, particles, staticgeometry and materials options,
+    frames sets the number of frames measured and threads the worker threads of the scene
+    manager. skeletonstage=1 evaluates the characters' skeletons in the skeletal animation
+    stage of the scene manager, animationlod=1 evaluates distant ones less often.
+    autoparamtracking=0 rewrites all automatic GPU program constants on every update instead
+    of only those whose inputs changed, constantbatching=1 batches the per-object constants
+    into a uniform buffer instead of binding those of each object separately and
+    streamingbuffers=1 has the particle systems write to the streaming buffers instead of
+    locking their own vertex buffers. The results are also written as JSON to the file given
+    by the json option.
+*/
+OGRE_BENCHMARK(Frame)
+{
+    SceneConfig config;
+    const size_t warmupFrames = 10;
+    const size_t frames = std::max<size_t>(Benchmarks::getOption("frames", size_t(200)), 1);
+    const size_t threads = Benchmarks::getOption("threads", size_t(1));
+    const bool skeletonStage = Benchmarks::getOption("skeletonstage", size_t(0)) != 0;
+    const bool animationLod = Benchmarks::getOption("animationlod", size_t(0)) != 0;
+    const bool autoParamTracking = Benchmarks::getOption("autoparamtracking", size_t(1)) != 0;
+    const bool constantBatching = Benchmarks::getOption("constantbatching", size_t(0)) != 0;
+    const bool streamingBuffers = Benchmarks::getOption("streamingbuffers", size_t(0)) != 0;
+    const String renderSystemName = Benchmarks::getOption("rendersystem", String("Null Rendering Subsystem"));
+    const String jsonFile = Benchmarks::getOption("json", String("FrameBenchmark.json"));
+    const Real timeSinceLastFrame = Real(1) / 60;
+
+    FileSystemLayer fsLayer(OGRE_VERSION_NAME);
+    Root* root = new Root(fsLayer.getConfigFilePath("plugins.cfg"), "", "");
+
+    RenderSystem* rs = root->getRenderSystemByName(renderSystemName);
+    if (!rs)
+    {
+        fprintf(stderr, "Frame: render system \"%s\" not available, skipped\n", renderSystemName.c_str());
+        delete root;
+        return;
+    }
+    root->setRenderSystem(rs);
+    root->initialise(false);
+    RenderWindow* window = root->createRenderWindow("FrameBenchmark", 1280, 720, false);
+    HardwareBufferManager::getSingleton().getStreamingBuffers().setEnabled(streamingBuffers);
+
+    SceneManager* sceneMgr = root->createSceneManager();
+    sceneMgr->setNumWorkerThreads(threads);
+    sceneMgr->setParallelCullingEnabled(threads != 1);
+    sceneMgr->setSkeletalAnimationStageEnabled(skeletonStage);
+    sceneMgr->setAutoParamChangeTrackingEnabled(autoParamTracking);
+    sceneMgr->setPerObjectConstantBatchingEnabled(constantBatching);
+    Camera* cam = sceneMgr->createCamera("FrameBenchmark");
+    window->addViewport(cam);
+    cam->setAspectRatio(Real(window->getWidth()) / window->getHeight());
+
+    FrameScene scene(sceneMgr, cam, config);
+    if (animationLod)
+        scene.enableAnimationLod();
+
+    for (size_t f = 0; f < warmupFrames; ++f)
+    {
+        scene.update(timeSinceLastFrame);
+        root->renderOneFrame(timeSinceLastFrame);
+    }
+
+    scene.animationTime = 0;
+    sceneMgr->setStageTimingEnabled(true);
+    sceneMgr->resetStageTimes();
+    sceneMgr->resetAnimationStats();
+    size_t batches = 0, triangles = 0;
+
+    Timer timer;
+    for (size_t f = 0; f < frames; ++f)
+    {
+        scene.update(timeSinceLastFrame);
+        root->renderOneFrame(timeSinceLastFrame);
+        batches += window->getStatistics().batchCount;
+        triangles += window->getStatistics().triangleCount;
+    }
+    double msPerFrame = timer.getMicroseconds() / 1000.0 / frames;
+
+    double nsToMsPerFrame = 1e-6 / frames;
+    Phase phases[] = {
+        {"animation", (scene.animationTime + sceneMgr->getStageTime(SceneManager::FS_ANIMATION)) * nsToMsPerFrame},
+        {"skeletalAnimation", sceneMgr->getStageTime(SceneManager::FS_SKELETAL_ANIMATION) * nsToMsPerFrame},
+        {"updateSceneGraph", sceneMgr->getStageTime(SceneManager::FS_UPDATE_SCENE_GRAPH) * nsToMsPerFrame},
+        {"culling", sceneMgr->getStageTime(SceneManager::FS_CULLING) * nsToMsPerFrame},
+        {"queueing", sceneMgr->getStageTime(SceneManager::FS_QUEUEING) * nsToMsPerFrame},
+        {"sorting", sceneMgr->getStageTime(SceneManager::FS_SORTING) * nsToMsPerFrame},
+        {"autoParams", sceneMgr->getStageTime(SceneManager::FS_AUTO_PARAMS) * nsToMsPerFrame}};
+    const size_t numPhases = sizeof(phases) / sizeof(phases[0]);
+
+    String configName = config.describe() + ", " + StringConverter::toString(threads) + " threads";
+    if (skeletonStage)
+        configName += ", skeleton stage";
+    if (animationLod)
+        configName += ", animation LOD";
+    if (!autoParamTracking)
+        configName += ", untracked auto params";
+    if (constantBatching)
+        configName += ", batched constants";
+    if (streamingBuffers)
+        configName += ", streaming buffers";
+    Benchmarks::report("Frame", configName, msPerFrame);
+    for (size_t p = 0; p < numPhases; ++p)
+        Benchmarks::report("Frame", String("  ") + phases[p].name, phases[p].msPerFrame);
+    size_t bonesPerFrame = sceneMgr->getNumBonesEvaluated() / frames;
+    printf("%-32s %-32s %10zu\n", "Frame", "  bonesEvaluated", bonesPerFrame);
+
+    std::ofstream json(jsonFile.c_str());
+    if (json)
+    {
+        json << "{\n"
+             << "  \"benchmark\": \"Frame\",\n"
+             << "  \"renderSystem\": \"" << rs->getName() << "\",\n"
+             << "  \"scene\": {\n"
+             << "    \"entities\": " << config.entities << ",\n"
+             << "    \"lights\": " << config.lights << ",\n"
+             << "    \"characters\": " << config.characters << ",\n"
+             << "    \"particleSystems\": " << scene.particleSystems << ",\n"
+             << "    \"staticGeometry\": " << config.staticGeometry << ",\n"
+             << "    \"materials\": " << config.materials << "\n"
+             << "  },\n"
+             << "  \"threads\": " << threads << ",\n"
+             << "  \"skeletonStage\": " << (skeletonStage ? "true" : "false") << ",\n"
+             << "  \"animationLod\": " << (animationLod ? "true" : "false") << ",\n"
+             << "  \"autoParamTracking\": " << (autoParamTracking ? "true" : "false") << ",\n"
+             << "  \"constantBatching\": " << (constantBatching ? "true" : "false") << ",\n"
+             << "  \"streamingBuffers\": " << (streamingBuffers ? "true" : "false") << ",\n"
+             << "  \"frames\": " << frames << ",\n"
+             << "  \"msPerFrame\": " << msPerFrame << ",\n"
+             << "  \"batchesPerFrame\": " << batches / frames << ",\n"
+             << "  \"trianglesPerFrame\": " << triangles / frames << ",\n"
+             << "  \"bonesEvaluatedPerFrame\": " << bonesPerFrame << ",\n"
+             << "  \"phasesMsPerFrame\": {\n";
+        for (size_t p = 0; p < numPhases; ++p)
+            json << "    \"" << phases[p].name << "\": " << phases[p].msPerFrame << (p + 1 < numPhases ? ",\n" : "\n");
+        json << "  }\n"
+             << "}\n";
+        json.close();
+    }
+    if (!json)
+    {
+        fprintf(stderr, "Frame: cannot write %s\n", jsonFile.c_str());
+    }
+
+    delete root;
+}
@@ -0,0 +1,96 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include "Benchmark.h"
+
+#include "OgreGpuProgramParams.h"
+#include "OgreStringConverter.h"
+#include "OgreVector4.h"
+
+using namespace Ogre;
+
+/** Setting named constants by name and through GpuConstantHandle, as a material system
+    does for every renderable, with a plain std::map find as the reference for the old
+    tree lookup.
+    Options: constants (declared by the program), sets (per iteration).
+*/
+OGRE_BENCHMARK(NamedConstants)
+{
+    Benchmarks::HeadlessRoot root;
+
+    const size_t numConstants = Benchmarks::getOption("constants", size_t(64));
+    const size_t numSets = Benchmarks::getOption("sets", size_t(100000));
+
+    // names sharing long prefixes, like the uniforms of generated shaders
+    GpuNamedConstantsPtr constants(new GpuNamedConstants());
+    std::map<String, GpuConstantDefinition> reference;
+    StringVector names;
+    for (size_t i = 0; i < numConstants; ++i)
+    {
+        GpuConstantDefinition def;
+        def.constType = GCT_FLOAT4;
+        def.elementSize = 4;
+        def.physicalIndex = i * 4;
+        names.push_back("u_material_param_" + StringConverter::toString(i));
+        constants->map.insert(GpuConstantDefinitionMap::value_type(names.back(), def));
+        reference.insert(std::make_pair(names.back(), def));
+    }
+    constants->floatBufferSize = numConstants * 4;
+
+    GpuProgramParametersSharedPtr params(new GpuProgramParameters());
+    params->_setNamedConstants(constants);
+
+    std::vector<GpuConstantHandle> handles;
+    for (size_t i = 0; i < numConstants; ++i)
+        handles.push_back(params->getConstantHandle(names[i]));
+
+    String config = StringConverter::toString(numConstants) + " constants, " +
+                    StringConverter::toString(numSets) + " sets, ";
+    Vector4 value(1, 2, 3, 4);
+
+    double time = Benchmarks::timeIterations(10, [&]() {
+        for (size_t i = 0; i < numSets; ++i)
+        {
+            const GpuConstantDefinition& def = reference.find(names[i % numConstants])->second;
+            memcpy(params->getFloatPointer(def.physicalIndex), value.ptr(), sizeof(value));
+        }
+    });
+    Benchmarks::report("NamedConstants", config + "std::map reference", time);
+
+    time = Benchmarks::timeIterations(10, [&]() {
+        for (size_t i = 0; i < numSets; ++i)
+            params->setNamedConstant(names[i % numConstants], value);
+    });
+    Benchmarks::report("NamedConstants", config + "by name", time);
+
+    time = Benchmarks::timeIterations(10, [&]() {
+        for (size_t i = 0; i < numSets; ++i)
+            params->setNamedConstant(handles[i % numConstants], value);
+    });
+    Benchmarks::report("NamedConstants", config + "by handle", time);
+}
@@ -0,0 +1,105 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include "Benchmark.h"
+
+#include "OgreRoot.h"
+#include "OgreSceneManagerEnumerator.h"
+#include "OgreSceneNode.h"
+#include "OgreCamera.h"
+#include "OgreLight.h"
+#include "OgreStringConverter.h"
+
+#include <random>
+
+using namespace Ogre;
+
+namespace
+{
+    /// exposes the light list update, which normally happens while rendering
+    struct LightingSceneManager : public DefaultSceneManager
+    {
+        LightingSceneManager() : DefaultSceneManager("Lighting") {}
+        using DefaultSceneManager::findLightsAffectingFrustum;
+    };
+}
+
+/** Light lists of many objects among many point lights, with and without the LightGrid. */
+OGRE_BENCHMARK(LightAssignment)
+{
+    Benchmarks::HeadlessRoot root;
+
+    const size_t numObjects = 10000;
+    const size_t lightCounts[] = {100, 2000};
+    for (size_t c = 0; c < sizeof(lightCounts) / sizeof(lightCounts[0]); ++c)
+    {
+        LightingSceneManager sceneMgr;
+        std::minstd_rand rng;
+
+        for (size_t i = 0; i < lightCounts[c]; ++i)
+        {
+            Light* l = sceneMgr.createLight();
+            l->setAttenuation(Real(20 + rng() % 30), 1, 0, 0);
+            sceneMgr.getRootSceneNode()
+                ->createChildSceneNode(Vector3(Real(rng() % 1000), Real(rng() % 100), -Real(rng() % 1000)))
+                ->attachObject(l);
+        }
+
+        Camera* cam = sceneMgr.createCamera("cam");
+        cam->setFOVy(Degree(120));
+        cam->setFarClipDistance(0);
+        sceneMgr.getRootSceneNode()->createChildSceneNode(Vector3(500, 50, 100))->attachObject(cam);
+        sceneMgr._updateSceneGraph(cam);
+        sceneMgr.findLightsAffectingFrustum(cam);
+
+        std::vector<Vector3> positions;
+        for (size_t i = 0; i < numObjects; ++i)
+            positions.push_back(Vector3(Real(rng() % 1000), Real(rng() % 100), -Real(rng() % 1000)));
+
+        double linearTime = 0;
+        for (int grid = 0; grid < 2; ++grid)
+        {
+            sceneMgr.setLightGridEnabled(grid != 0);
+
+            LightList lights;
+            double time = Benchmarks::timeIterations(5, [&]() {
+                for (size_t i = 0; i < numObjects; ++i)
+                    sceneMgr._populateLightList(positions[i], 5, lights);
+            });
+
+            if (!grid)
+                linearTime = time;
+
+            Benchmarks::report("LightAssignment",
+                               StringConverter::toString(lightCounts[c]) + " lights, " +
+                                   (grid ? "grid (x" + StringConverter::toString(Real(linearTime / time), 3) + ")"
+                                         : String("linear")),
+                               time);
+        }
+    }
+}
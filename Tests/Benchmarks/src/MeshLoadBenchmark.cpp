@@ -0,0 +1,85 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include "Benchmark.h"
+
+#include "OgreMeshManager.h"
+#include "OgreMesh.h"
+#include "OgreSubMesh.h"
+#include "OgreMeshSerializer.h"
+#include "OgreHardwareBufferManager.h"
+#include "OgreStringConverter.h"
+
+using namespace Ogre;
+
+/** Loading a mesh from memory, as from a mapped or prebuffered file, in the chunked
+    v1.100 format against the v2.0 format with its buffers laid out for upload.
+    Options: segments (of the plane per side), loads (per iteration).
+*/
+OGRE_BENCHMARK(MeshLoad)
+{
+    Benchmarks::HeadlessRoot root;
+
+    const size_t numSegments = Benchmarks::getOption("segments", size_t(128));
+    const size_t numLoads = Benchmarks::getOption("loads", size_t(10));
+
+    MeshManager& mm = MeshManager::getSingleton();
+    const String& group = ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME;
+    MeshPtr plane = mm.createPlane("MeshLoad/plane", group, Plane(Vector3::UNIT_Z, 0), 100, 100,
+                                   int(numSegments), int(numSegments), true, 2);
+
+    // generous upper bound of the file size
+    size_t capacity = 1 << 16;
+    capacity += plane->sharedVertexData->vertexBufferBinding->getBuffer(0)->getSizeInBytes();
+    capacity += plane->getSubMesh(0)->indexData->indexBuffer->getSizeInBytes();
+
+    String config = StringConverter::toString(plane->sharedVertexData->vertexCount) + " vertices, " +
+                    StringConverter::toString(numLoads) + " loads, ";
+
+    const MeshVersion versions[] = {MESH_VERSION_1_10, MESH_VERSION_2_0};
+    const char* names[] = {"v1.100", "v2.0"};
+    for (size_t v = 0; v < 2; ++v)
+    {
+        MemoryDataStreamPtr file(OGRE_NEW MemoryDataStream(capacity, true, false));
+        MeshSerializer serializer;
+        serializer.exportMesh(plane.get(), file, versions[v]);
+        size_t fileSize = file->tell();
+
+        size_t loaded = 0;
+        double time = Benchmarks::timeIterations(10, [&]() {
+            for (size_t i = 0; i < numLoads; ++i)
+            {
+                DataStreamPtr stream(OGRE_NEW MemoryDataStream(file->getPtr(), fileSize));
+                MeshPtr mesh = mm.createManual("MeshLoad/" + StringConverter::toString(loaded++), group);
+                serializer.importMesh(stream, mesh.get());
+                mm.remove(mesh);
+            }
+        });
+        Benchmarks::report("MeshLoad", config + names[v], time);
+    }
+}
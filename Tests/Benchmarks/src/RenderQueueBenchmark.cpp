@@ -0,0 +1,122 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include "Benchmark.h"
+
+#include "OgreRoot.h"
+#include "OgreMaterialManager.h"
+#include "OgreTechnique.h"
+#include "OgrePass.h"
+#include "OgreRenderable.h"
+#include "OgreRenderQueueSortingGrouping.h"
+#include "OgreStringConverter.h"
+
+#include <random>
+
+using namespace Ogre;
+
+namespace
+{
+    struct BenchmarkRenderable : public Renderable
+    {
+        Real depth;
+        MaterialPtr material;
+        LightList lights;
+
+        explicit BenchmarkRenderable(Real d) : depth(d) {}
+        const MaterialPtr& getMaterial(void) const { return material; }
+        void getRenderOperation(RenderOperation& op) {}
+        void getWorldTransforms(Matrix4* xform) const {}
+        Real getSquaredViewDepth(const Camera* cam) const { return depth; }
+        const LightList& getLights(void) const { return lights; }
+    };
+
+    /// touches every visited renderable, standing in for the scene manager's render visitor
+    struct CountingVisitor : public QueuedRenderableVisitor
+    {
+        size_t groups;
+        size_t renderables;
+
+        CountingVisitor() : groups(0), renderables(0) {}
+        void visit(RenderablePass* rp) { ++renderables; }
+        void visit(const Pass* p, RenderableList& rs)
+        {
+            ++groups;
+            renderables += rs.size();
+        }
+    };
+}
+
+/** Queueing, sorting and visiting 100k renderables spread over 500 passes, as done once per frame. */
+OGRE_BENCHMARK(RenderQueueSorting)
+{
+    Benchmarks::HeadlessRoot root;
+
+    const size_t numRenderables = 100000;
+    const size_t numPasses = 500;
+
+    MaterialPtr mat = MaterialManager::getSingleton().create("RenderQueueSorting", ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+    Technique* tech = mat->getTechnique(0);
+    while (tech->getNumPasses() < numPasses)
+        tech->createPass();
+
+    std::minstd_rand rng;
+    std::vector<BenchmarkRenderable> renderables;
+    std::vector<Pass*> passes;
+    for (size_t i = 0; i < numRenderables; ++i)
+    {
+        renderables.push_back(BenchmarkRenderable(Real(rng() % 10000)));
+        passes.push_back(tech->getPass(rng() % numPasses));
+    }
+
+    const QueuedRenderableCollection::OrganisationMode modes[] = {
+        QueuedRenderableCollection::OM_PASS_GROUP, QueuedRenderableCollection::OM_SORT_DESCENDING};
+    for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); ++m)
+    {
+        QueuedRenderableCollection collection;
+        collection.addOrganisationMode(modes[m]);
+
+        double time = Benchmarks::timeIterations(20, [&]() {
+            collection.clear();
+            for (size_t i = 0; i < numRenderables; ++i)
+                collection.addRenderable(passes[i], &renderables[i]);
+            collection.sort(NULL);
+
+            CountingVisitor visitor;
+            collection.acceptVisitor(&visitor, modes[m]);
+        });
+
+        Benchmarks::report("RenderQueueSorting",
+                           StringConverter::toString(numRenderables) + " renderables, " +
+                               (m == 0 ? StringConverter::toString(numPasses) + " passes grouped"
+                                       : String("sorted by depth")),
+                           time);
+    }
+
+    MaterialManager::getSingleton().remove(mat);
+}
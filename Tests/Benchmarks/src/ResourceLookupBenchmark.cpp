@@ -0,0 +1,97 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include "Benchmark.h"
+
+#include "OgreMeshManager.h"
+#include "OgreResourceGroupManager.h"
+#include "OgreStringConverter.h"
+
+#include <thread>
+
+using namespace Ogre;
+
+/** Looking up resources by name, by name with a precomputed hash and from several
+    threads at once, as script parsers and background loaders do.
+    Options: resources (created), lookups (per thread and iteration), threads.
+*/
+OGRE_BENCHMARK(ResourceLookup)
+{
+    Benchmarks::HeadlessRoot root;
+
+    const size_t numResources = Benchmarks::getOption("resources", size_t(1000));
+    const size_t numLookups = Benchmarks::getOption("lookups", size_t(100000));
+    const size_t numThreads = Benchmarks::getOption("threads", size_t(4));
+
+    MeshManager& mm = MeshManager::getSingleton();
+    const String& group = ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME;
+    StringVector names;
+    std::vector<uint32> hashes;
+    for (size_t i = 0; i < numResources; ++i)
+    {
+        names.push_back("Lookup/mesh_" + StringConverter::toString(i) + ".mesh");
+        hashes.push_back(ResourceManager::hashName(names.back()));
+        mm.create(names.back(), group);
+    }
+
+    String config = StringConverter::toString(numResources) + " resources, " +
+                    StringConverter::toString(numLookups) + " lookups, ";
+
+    double time = Benchmarks::timeIterations(10, [&]() {
+        for (size_t i = 0; i < numLookups; ++i)
+            mm.getResourceByName(names[i % numResources], group);
+    });
+    Benchmarks::report("ResourceLookup", config + "by name", time);
+
+    time = Benchmarks::timeIterations(10, [&]() {
+        for (size_t i = 0; i < numLookups; ++i)
+        {
+            size_t r = i % numResources;
+            mm.getResourceByName(names[r], hashes[r], group);
+        }
+    });
+    Benchmarks::report("ResourceLookup", config + "by hash", time);
+
+    time = Benchmarks::timeIterations(10, [&]() {
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < numThreads; ++t)
+        {
+            threads.push_back(std::thread([&, t]() {
+                for (size_t i = 0; i < numLookups; ++i)
+                {
+                    size_t r = (i + t * 7) % numResources;
+                    mm.getResourceByName(names[r], hashes[r], group);
+                }
+            }));
+        }
+        for (size_t t = 0; t < threads.size(); ++t)
+            threads[t].join();
+    });
+    Benchmarks::report("ResourceLookup", config + StringConverter::toString(numThreads) +
+                       " threads", time);
+}
@@ -0,0 +1,132 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include "Benchmark.h"
+
+#include "OgreRoot.h"
+#include "OgreSceneManager.h"
+#include "OgreSceneNode.h"
+#include "OgreEntity.h"
+#include "OgreStringConverter.h"
+
+#include <random>
+
+using namespace Ogre;
+
+static void createSceneGraph(SceneManager* sceneMgr, size_t numNodes)
+{
+    // fixed seed, so every run measures the same graph
+    std::minstd_rand rng;
+    std::vector<SceneNode*> nodes(1, sceneMgr->getRootSceneNode());
+
+    for (size_t n = 0; n < numNodes; ++n)
+    {
+        // mostly shallow hierarchies below the root, like characters and their attachments
+        SceneNode* parent = rng() % 4 == 0 ? sceneMgr->getRootSceneNode() : nodes[rng() % nodes.size()];
+        SceneNode* node = parent->createChildSceneNode(
+            Vector3(Real(rng() % 1000), Real(rng() % 1000), Real(rng() % 1000)),
+            Quaternion(Degree(Real(rng() % 360)), Vector3::UNIT_Y));
+        node->attachObject(sceneMgr->createEntity(SceneManager::PT_CUBE));
+        nodes.push_back(node);
+    }
+}
+
+/** Full update of a large scene graph, scaling from 1 thread to all hardware threads. */
+OGRE_BENCHMARK(SceneGraphUpdate)
+{
+    Benchmarks::HeadlessRoot root;
+
+    const size_t nodeCounts[] = {10000, 200000};
+    for (size_t c = 0; c < sizeof(nodeCounts) / sizeof(nodeCounts[0]); ++c)
+    {
+        SceneManager* sceneMgr = Root::getSingleton().createSceneManager();
+        createSceneGraph(sceneMgr, nodeCounts[c]);
+        sceneMgr->_updateSceneGraph(NULL);
+
+        std::vector<size_t> threadCounts = Benchmarks::getThreadCounts();
+        double serialTime = 0;
+        for (size_t t = 0; t < threadCounts.size(); ++t)
+        {
+            size_t threads = threadCounts[t];
+            sceneMgr->setNumWorkerThreads(threads);
+            double time = Benchmarks::timeIterations(20, [sceneMgr]() {
+                // dirty the root, so every node has to be updated
+                sceneMgr->getRootSceneNode()->needUpdate();
+                sceneMgr->_updateSceneGraph(NULL);
+            });
+
+            if (threads == 1)
+                serialTime = time;
+
+            Benchmarks::report("SceneGraphUpdate",
+                               StringConverter::toString(nodeCounts[c]) + " nodes, " +
+                                   StringConverter::toString(threads) + " threads (x" +
+                                   StringConverter::toString(Real(serialTime / time), 3) + ")",
+                               time);
+        }
+
+        Root::getSingleton().destroySceneManager(sceneMgr);
+    }
+}
+
+/** Full update of growing scene graphs, with and without the packed NodeTransformStore. */
+OGRE_BENCHMARK(PackedNodeTransforms)
+{
+    Benchmarks::HeadlessRoot root;
+
+    const size_t nodeCounts[] = {1000, 10000, 100000, 200000};
+    for (size_t c = 0; c < sizeof(nodeCounts) / sizeof(nodeCounts[0]); ++c)
+    {
+        SceneManager* sceneMgr = Root::getSingleton().createSceneManager();
+        createSceneGraph(sceneMgr, nodeCounts[c]);
+
+        double nodeTime = 0;
+        for (int packed = 0; packed < 2; ++packed)
+        {
+            sceneMgr->setNodeTransformStoreEnabled(packed != 0);
+            // builds the packed layout
+            sceneMgr->_updateSceneGraph(NULL);
+
+            double time = Benchmarks::timeIterations(20, [sceneMgr]() {
+                sceneMgr->getRootSceneNode()->needUpdate();
+                sceneMgr->_updateSceneGraph(NULL);
+            });
+
+            if (!packed)
+                nodeTime = time;
+
+            Benchmarks::report("PackedNodeTransforms",
+                               StringConverter::toString(nodeCounts[c]) + " nodes, " +
+                                   (packed ? "packed (x" + StringConverter::toString(Real(nodeTime / time), 3) + ")"
+                                           : String("nodes")),
+                               time);
+        }
+
+        Root::getSingleton().destroySceneManager(sceneMgr);
+    }
+}
@@ -0,0 +1,134 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include "Benchmark.h"
+
+#include "OgreHardwareBufferManager.h"
+#include "OgreMesh.h"
+#include "OgrePlatformInformation.h"
+#include "OgreStringConverter.h"
+#include "OgreVertexIndexData.h"
+#include "OgreWorkerThreadPool.h"
+
+#include <random>
+
+using namespace Ogre;
+
+/** Software skinning of a large mesh with 4 weights per vertex, using the OptimisedUtil
+    implementation picked for this CPU, scaling from 1 thread to all hardware threads. */
+OGRE_BENCHMARK(SoftwareSkinning)
+{
+    Benchmarks::HeadlessRoot root;
+
+    const size_t numVertices = Benchmarks::getOption("vertices", size_t(100000));
+    const size_t numBones = std::min(Benchmarks::getOption("bones", size_t(64)), size_t(256));
+
+    // interleaved source, as exported by most tools
+    VertexData src;
+    src.vertexCount = numVertices;
+    size_t vertexSize = 0;
+    vertexSize += src.vertexDeclaration->addElement(0, vertexSize, VET_FLOAT3, VES_POSITION).getSize();
+    vertexSize += src.vertexDeclaration->addElement(0, vertexSize, VET_FLOAT3, VES_NORMAL).getSize();
+    vertexSize += src.vertexDeclaration->addElement(0, vertexSize, VET_FLOAT4, VES_BLEND_WEIGHTS).getSize();
+    vertexSize += src.vertexDeclaration->addElement(0, vertexSize, VET_UBYTE4, VES_BLEND_INDICES).getSize();
+    HardwareVertexBufferSharedPtr srcBuf = HardwareBufferManager::getSingleton().createVertexBuffer(
+        vertexSize, numVertices, HardwareBuffer::HBU_STATIC);
+    src.vertexBufferBinding->setBinding(0, srcBuf);
+
+    // fixed seed, so every run blends the same mesh
+    std::minstd_rand rng;
+    std::uniform_real_distribution<float> dist(-1, 1);
+    float* pVertex = static_cast<float*>(srcBuf->lock(HardwareBuffer::HBL_DISCARD));
+    for (size_t v = 0; v < numVertices; ++v, pVertex += vertexSize / sizeof(float))
+    {
+        Vector3 norm = Vector3(dist(rng), dist(rng), dist(rng)).normalisedCopy();
+        float weights[4], weightSum = 0;
+        for (int i = 0; i < 4; ++i)
+            weightSum += weights[i] = dist(rng) + 1;
+        uint8* indices = reinterpret_cast<uint8*>(pVertex + 10);
+        for (int i = 0; i < 3; ++i)
+        {
+            pVertex[i] = dist(rng) * 100;
+            pVertex[3 + i] = norm[i];
+        }
+        for (int i = 0; i < 4; ++i)
+        {
+            pVertex[6 + i] = weights[i] / weightSum;
+            indices[i] = uint8(rng() % numBones);
+        }
+    }
+    srcBuf->unlock();
+
+    std::vector<Affine3> bones(numBones);
+    std::vector<const Affine3*> blendMatrices(numBones);
+    for (size_t b = 0; b < numBones; ++b)
+    {
+        bones[b].makeTransform(Vector3(dist(rng), dist(rng), dist(rng)) * 10, Vector3::UNIT_SCALE,
+                               Quaternion(Radian(dist(rng) * 3), Vector3(dist(rng), 1, dist(rng)).normalisedCopy()));
+        blendMatrices[b] = &bones[b];
+    }
+
+    // position and normal in one buffer, as checked out by Entity
+    VertexData dest;
+    dest.vertexCount = numVertices;
+    dest.vertexDeclaration->addElement(0, 0, VET_FLOAT3, VES_POSITION);
+    dest.vertexDeclaration->addElement(0, 12, VET_FLOAT3, VES_NORMAL);
+    dest.vertexBufferBinding->setBinding(0, HardwareBufferManager::getSingleton().createVertexBuffer(
+        24, numVertices, HardwareBuffer::HBU_DYNAMIC));
+
+    const uint features = PlatformInformation::getCpuFeatures();
+    const uint avx2_fma = PlatformInformation::CPU_FEATURE_AVX2 | PlatformInformation::CPU_FEATURE_FMA;
+    String impl = (features & avx2_fma) == avx2_fma && __OGRE_HAVE_AVX2 ? "AVX2/FMA"
+                  : (features & PlatformInformation::CPU_FEATURE_SSE) && __OGRE_HAVE_SSE ? "SSE"
+                  : "general";
+    String config = StringConverter::toString(numVertices) + " vertices, " +
+                    StringConverter::toString(numBones) + " bones, 4 weights, " + impl + ", ";
+
+    std::vector<size_t> threadCounts = Benchmarks::getThreadCounts();
+    for (int blendNormals = 1; blendNormals >= 0; --blendNormals)
+    {
+        double serialTime = 0;
+        for (size_t t = 0; t < threadCounts.size(); ++t)
+        {
+            WorkerThreadPool pool(threadCounts[t]);
+            double time = Benchmarks::timeIterations(50, [&]() {
+                Mesh::softwareVertexBlend(&src, &dest, blendMatrices.data(), numBones, blendNormals != 0,
+                                          threadCounts[t] > 1 ? &pool : NULL);
+            });
+
+            if (threadCounts[t] == 1)
+                serialTime = time;
+
+            Benchmarks::report("SoftwareSkinning",
+                               config + (blendNormals ? "positions and normals, " : "positions, ") +
+                                   StringConverter::toString(threadCounts[t]) + " threads (x" +
+                                   StringConverter::toString(Real(serialTime / time), 3) + ")",
+                               time);
+        }
+    }
+}
@@ -0,0 +1,123 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include "Benchmark.h"
+
+#include "OgreRoot.h"
+#include "OgreStringConverter.h"
+#include "Threading/OgreDefaultWorkQueue.h"
+#include "Threading/OgreWorkStealingWorkQueue.h"
+
+using namespace Ogre;
+
+#if OGRE_THREAD_SUPPORT && OGRE_THREAD_PROVIDER != 3
+namespace
+{
+    /// Small requests with a configurable amount of busy work, like terrain or paging requests
+    struct BusyWorkHandler : public WorkQueue::RequestHandler, public WorkQueue::ResponseHandler
+    {
+        size_t work;
+        size_t numResponses;
+
+        BusyWorkHandler(size_t w) : work(w), numResponses(0) {}
+
+        WorkQueue::Response* handleRequest(const WorkQueue::Request* req, const WorkQueue* srcQ)
+        {
+            uint32 hash = uint32(req->getID());
+            for (size_t i = 0; i < work; ++i)
+                hash = hash * 1664525 + 1013904223;
+            return OGRE_NEW WorkQueue::Response(req, true, Any(hash));
+        }
+
+        void handleResponse(const WorkQueue::Response* res, const WorkQueue* srcQ)
+        {
+            ++numResponses;
+        }
+    };
+
+    /// Time to queue numRequests requests and receive all the responses, in milliseconds
+    double timeRequests(DefaultWorkQueueBase* queue, size_t threads, size_t numRequests, size_t work)
+    {
+        queue->setWorkerThreadCount(threads);
+        queue->setResponseProcessingTimeLimit(0);
+        queue->startup();
+
+        BusyWorkHandler handler(work);
+        uint16 channel = queue->getChannel("Benchmark");
+        queue->addRequestHandler(channel, &handler);
+        queue->addResponseHandler(channel, &handler);
+
+        double time = Benchmarks::timeIterations(1, [&]() {
+            for (size_t i = 0; i < numRequests; ++i)
+                queue->addRequest(channel, 0, Any());
+            while (handler.numResponses < numRequests)
+                queue->processResponses();
+        });
+
+        queue->removeRequestHandler(channel, &handler);
+        queue->removeResponseHandler(channel, &handler);
+        queue->shutdown();
+        return time;
+    }
+}
+
+/** Requests per second through DefaultWorkQueue and WorkStealingWorkQueue, scaling
+    from 1 thread to all hardware threads.
+    Options: requests (per measurement), work (iterations of busy work per request).
+*/
+OGRE_BENCHMARK(WorkQueueThroughput)
+{
+    Benchmarks::HeadlessRoot root;
+
+    size_t numRequests = Benchmarks::getOption("requests", size_t(100000));
+    size_t work = Benchmarks::getOption("work", size_t(500));
+
+    std::vector<size_t> threadCounts = Benchmarks::getThreadCounts();
+    for (size_t t = 0; t < threadCounts.size(); ++t)
+    {
+        size_t threads = threadCounts[t];
+        for (int stealing = 0; stealing < 2; ++stealing)
+        {
+            DefaultWorkQueueBase* queue;
+            if (stealing)
+                queue = OGRE_NEW WorkStealingWorkQueue("Benchmark");
+            else
+                queue = OGRE_NEW DefaultWorkQueue("Benchmark");
+
+            double time = timeRequests(queue, threads, numRequests, work);
+            OGRE_DELETE queue;
+
+            Benchmarks::report("WorkQueueThroughput",
+                               String(stealing ? "stealing, " : "default, ") +
+                                   StringConverter::toString(threads) + " threads (" +
+                                   StringConverter::toString(size_t(numRequests * 1000 / time)) + " req/s)",
+                               time);
+        }
+    }
+}
+#endif
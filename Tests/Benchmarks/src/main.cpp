@@ -0,0 +1,83 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include "Benchmark.h"
+
+#include "OgreLogManager.h"
+
+#include <cstdio>
+
+/** Runs all benchmarks, or the ones given on the command line.
+    Arguments of the form --name=value are options for the benchmarks, see Benchmarks::getOption.
+*/
+int main(int argc, char *argv[])
+{
+    Ogre::LogManager* logMgr = new Ogre::LogManager();
+    logMgr->createLog("OgreBenchmark.log", true, false, true);
+
+    Benchmarks::BenchmarkMap& benchmarks = Benchmarks::getBenchmarks();
+    std::vector<Ogre::String> names;
+    int ret = 0;
+
+    for (int arg = 1; arg < argc; ++arg)
+    {
+        Ogre::String str = argv[arg];
+        if (str.compare(0, 2, "--") != 0)
+        {
+            names.push_back(str);
+            continue;
+        }
+
+        Ogre::String::size_type eq = str.find('=');
+        if (eq == Ogre::String::npos)
+            Benchmarks::getOptions()[str.substr(2)] = "1";
+        else
+            Benchmarks::getOptions()[str.substr(2, eq - 2)] = str.substr(eq + 1);
+    }
+
+    if (names.empty())
+    {
+        for (Benchmarks::BenchmarkMap::iterator i = benchmarks.begin(); i != benchmarks.end(); ++i)
+            i->second();
+    }
+
+    for (size_t n = 0; n < names.size(); ++n)
+    {
+        Benchmarks::BenchmarkMap::iterator i = benchmarks.find(names[n]);
+        if (i == benchmarks.end())
+        {
+            fprintf(stderr, "unknown benchmark: %s\n", names[n].c_str());
+            ret = 1;
+            continue;
+        }
+        i->second();
+    }
+
+    delete logMgr;
+    return ret;
+}
@@ -0,0 +1,83 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include <gtest/gtest.h>
+
+#include "OgreFrustum.h"
+#include "RootWithoutRenderSystemFixture.h"
+
+#include <random>
+using std::minstd_rand;
+
+using namespace Ogre;
+
+typedef RootWithoutRenderSystemFixture FrustumTests;
+TEST_F(FrustumTests, BatchedVisibilityMatchesSingle)
+{
+    Frustum frustum;
+    frustum.setFOVy(Degree(60));
+    frustum.setNearClipDistance(1);
+
+    // cross platform consistent boxes around the frustum, some straddling its planes
+    minstd_rand rng;
+    const size_t numBoxes = 1003; // not a multiple of the batch size
+    std::vector<float> centres, halfSizes;
+    std::vector<AxisAlignedBox> boxes;
+    for (size_t i = 0; i < numBoxes; ++i)
+    {
+        Vector3 centre(Real(rng() % 400) - 200, Real(rng() % 400) - 200, Real(rng() % 400) - 300);
+        Vector3 halfSize(Real(rng() % 50), Real(rng() % 50), Real(rng() % 50));
+        boxes.push_back(AxisAlignedBox(centre - halfSize, centre + halfSize));
+        for (int j = 0; j < 3; ++j)
+        {
+            centres.push_back(float(boxes.back().getCenter()[j]));
+            halfSizes.push_back(float(boxes.back().getHalfSize()[j]));
+        }
+    }
+
+    // finite and infinite far plane
+    const Real farDists[] = {250, 0};
+    for (int f = 0; f < 2; ++f)
+    {
+        frustum.setFarClipDistance(farDists[f]);
+
+        std::vector<uint32> visibility((numBoxes + 31) / 32, 0xdeadbeef);
+        frustum.calculateVisibility(centres.data(), halfSizes.data(), visibility.data(), numBoxes);
+
+        size_t numVisible = 0;
+        for (size_t i = 0; i < numBoxes; ++i)
+        {
+            bool visible = (visibility[i / 32] & (1u << (i % 32))) != 0;
+            EXPECT_EQ(frustum.isVisible(boxes[i]), visible) << "box " << i;
+            numVisible += visible;
+        }
+        // unused bits are cleared
+        EXPECT_EQ(visibility.back() >> (numBoxes % 32), 0u);
+        EXPECT_GT(numVisible, 0u);
+        EXPECT_LT(numVisible, numBoxes);
+    }
+}
@@ -0,0 +1,124 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include <gtest/gtest.h>
+
+#include "OgreGpuProgramParams.h"
+#include "OgreStringConverter.h"
+#include "RootWithoutRenderSystemFixture.h"
+
+using namespace Ogre;
+
+typedef RootWithoutRenderSystemFixture GpuConstantHandles;
+TEST_F(GpuConstantHandles, HashedMapMatchesNames)
+{
+    // the index must not be bypassed through the underlying std::map
+    static_assert(!std::is_convertible<GpuConstantDefinitionMap*,
+                  std::map<String, GpuConstantDefinition>*>::value, "map is exposed");
+
+    GpuConstantDefinitionMap map;
+    for (int i = 0; i < 200; ++i)
+    {
+        GpuConstantDefinition def;
+        def.physicalIndex = i;
+        map.insert(GpuConstantDefinitionMap::value_type("param" + StringConverter::toString(i), def));
+    }
+    map["extra"].physicalIndex = 1000;
+
+    // ordered iteration is unchanged
+    EXPECT_EQ("extra", map.begin()->first);
+    EXPECT_EQ(201u, map.size());
+
+    for (int i = 0; i < 200; i += 2)
+        map.erase("param" + StringConverter::toString(i));
+    GpuConstantDefinitionMap copy(map);
+
+    for (int i = 0; i < 200; ++i)
+    {
+        String name = "param" + StringConverter::toString(i);
+        for (const GpuConstantDefinitionMap* m : {&map, &copy})
+        {
+            GpuConstantDefinitionMap::const_iterator it = m->find(name);
+            if (i % 2)
+            {
+                ASSERT_TRUE(it != m->end()) << name;
+                EXPECT_EQ(size_t(i), it->second.physicalIndex);
+            }
+            else
+                EXPECT_TRUE(it == m->end()) << name;
+        }
+    }
+    EXPECT_EQ(1000u, copy.find("extra")->second.physicalIndex);
+    EXPECT_EQ(0u, copy.count("missing"));
+}
+
+TEST_F(GpuConstantHandles, SetByHandle)
+{
+    auto createConstants = [](size_t firstIndex) {
+        GpuNamedConstantsPtr constants(new GpuNamedConstants());
+        GpuConstantDefinition def;
+        def.constType = GCT_FLOAT4;
+        def.elementSize = 4;
+        def.physicalIndex = firstIndex;
+        constants->map["colour"] = def;
+        def.physicalIndex = firstIndex + 4;
+        constants->map["offset"] = def;
+        constants->floatBufferSize = firstIndex + 8;
+        return constants;
+    };
+
+    GpuNamedConstantsPtr constants = createConstants(0);
+    GpuProgramParametersSharedPtr params(new GpuProgramParameters());
+    params->_setNamedConstants(constants);
+
+    GpuConstantHandle colour = params->getConstantHandle("colour");
+    EXPECT_EQ("colour", colour.getName());
+    params->setNamedConstant(colour, Vector4(1, 2, 3, 4));
+    EXPECT_EQ(Vector4(1, 2, 3, 4), Vector4(params->getFloatPointer(0)));
+
+    // removing another entry invalidates the cached definition, not the handle
+    constants->map.erase("offset");
+    params->setNamedConstant(colour, Vector4(5, 6, 7, 8));
+    EXPECT_EQ(Vector4(5, 6, 7, 8), Vector4(params->getFloatPointer(0)));
+
+    // handles work with parameters backed by other definitions of the same name
+    GpuProgramParametersSharedPtr other(new GpuProgramParameters());
+    other->_setNamedConstants(createConstants(8));
+    other->setNamedConstant(colour, ColourValue(1, 0, 1, 0));
+    EXPECT_EQ(Vector4(1, 0, 1, 0), Vector4(other->getFloatPointer(8)));
+    EXPECT_EQ(Vector4::ZERO, Vector4(other->getFloatPointer(0)));
+
+    other->setNamedAutoConstant(colour, GpuProgramParameters::ACT_SURFACE_DIFFUSE_COLOUR);
+    ASSERT_TRUE(other->findAutoConstantEntry("colour"));
+    EXPECT_EQ(GpuProgramParameters::ACT_SURFACE_DIFFUSE_COLOUR,
+              other->findAutoConstantEntry("colour")->paramType);
+
+    EXPECT_THROW(params->getConstantHandle("missing"), Exception);
+    params->setIgnoreMissingParams(true);
+    GpuConstantHandle missing = params->getConstantHandle("missing");
+    params->setNamedConstant(missing, 1.0f);
+}
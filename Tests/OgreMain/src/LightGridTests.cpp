@@ -0,0 +1,96 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include <gtest/gtest.h>
+
+#include "OgreSceneManager.h"
+#include "OgreSceneNode.h"
+#include "OgreCamera.h"
+#include "OgreLight.h"
+#include "OgreSceneManagerEnumerator.h"
+#include "RootWithoutRenderSystemFixture.h"
+
+#include <random>
+using std::minstd_rand;
+
+using namespace Ogre;
+
+namespace
+{
+    /// exposes the light list update, which normally happens while rendering
+    struct LightTestSceneManager : public DefaultSceneManager
+    {
+        LightTestSceneManager() : DefaultSceneManager("LightTest") {}
+        using DefaultSceneManager::findLightsAffectingFrustum;
+    };
+}
+
+typedef RootWithoutRenderSystemFixture LightGridTests;
+TEST_F(LightGridTests, SameLightsAsLinearScan)
+{
+    LightTestSceneManager mgr;
+    minstd_rand rng;
+
+    for (int i = 0; i < 500; ++i)
+    {
+        Light* l = mgr.createLight();
+        l->setType(i % 50 == 0 ? Light::LT_DIRECTIONAL : i % 5 == 0 ? Light::LT_SPOTLIGHT : Light::LT_POINT);
+        l->setAttenuation(i == 7 ? 100000 : Real(1 + rng() % 30), 1, 0, 0);
+        l->setLightMask(i % 3 ? 0xFFFFFFFF : 0x1);
+        SceneNode* node = mgr.getRootSceneNode()->createChildSceneNode(
+            Vector3(Real(rng() % 400) - 200, Real(rng() % 400) - 200, Real(rng() % 400) - 200));
+        node->setDirection(Vector3(Real(rng() % 3) - 1, 1, 0));
+        node->attachObject(l);
+    }
+    mgr.getRootSceneNode()->_update(true, false);
+
+    Camera* cam = mgr.createCamera("cam");
+    cam->setFOVy(Degree(120));
+    cam->setFarClipDistance(0);
+    mgr.getRootSceneNode()->createChildSceneNode(Vector3(0, 0, 250))->attachObject(cam);
+    mgr.getRootSceneNode()->_update(true, false);
+    mgr.findLightsAffectingFrustum(cam);
+    ASSERT_GT(mgr._getLightsAffectingFrustum().size(), 100u);
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        Vector3 pos(Real(rng() % 400) - 200, Real(rng() % 400) - 200, Real(rng() % 400) - 200);
+        // some objects cover many grid cells
+        Real radius = i % 100 == 0 ? 300 : Real(rng() % 20);
+        uint32 mask = i % 2 ? 0xFFFFFFFF : 0x2;
+
+        LightList linear, grid;
+        mgr.setLightGridEnabled(false);
+        mgr._populateLightList(pos, radius, linear, mask);
+        mgr.setLightGridEnabled(true);
+        mgr._populateLightList(pos, radius, grid, mask);
+
+        ASSERT_EQ(linear.size(), grid.size()) << "object " << i;
+        for (size_t j = 0; j < linear.size(); ++j)
+            EXPECT_EQ(linear[j], grid[j]) << "object " << i << " light " << j;
+    }
+}
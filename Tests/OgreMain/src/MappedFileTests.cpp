@@ -0,0 +1,104 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include <gtest/gtest.h>
+
+#include "OgreMeshManager.h"
+#include "OgreMesh.h"
+#include "OgreSubMesh.h"
+#include "OgreMeshSerializer.h"
+#include "OgreImage.h"
+#include "OgreFileSystem.h"
+#include "OgreFileSystemLayer.h"
+#include "RootWithoutRenderSystemFixture.h"
+
+#include <fstream>
+
+using namespace Ogre;
+
+typedef RootWithoutRenderSystemFixture MappedFiles;
+TEST_F(MappedFiles, LoadInPlace)
+{
+    String dir = mFSLayer->getWritablePath("MappedFilesTest");
+    FileSystemLayer::createDirectory(dir);
+
+    MeshPtr plane = MeshManager::getSingleton().createPlane("MappedPlane", "General",
+                                                            Plane(Vector3::UNIT_Z, 0), 50, 50, 4, 4);
+    MeshSerializer().exportMesh(plane.get(), dir + "/mapped.mesh");
+
+    uint32 pixels[16 * 16];
+    for (uint32 i = 0; i < 16 * 16; ++i)
+        pixels[i] = i * 0x01020304;
+    Image().loadDynamicImage(reinterpret_cast<uchar*>(pixels), 16, 16, PF_A8R8G8B8).save(dir + "/mapped.dds");
+
+    std::ifstream file(dir + "/mapped.dds", std::ios::binary);
+    std::vector<char> fileBytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    file.close();
+
+    ResourceGroupManager::getSingleton().addResourceLocation(dir, "MappedFileSystem", "Mapped");
+
+    DataStreamPtr stream = ResourceGroupManager::getSingleton().openResource("mapped.dds", "Mapped");
+    MappedFileDataStream* mapped = dynamic_cast<MappedFileDataStream*>(stream.get());
+    ASSERT_TRUE(mapped);
+    const uchar* fileData = mapped->getPtr();
+    EXPECT_FALSE(stream->isWriteable());
+
+    // the pixels are used where they are in the file, and stay valid once it was closed
+    Image image;
+    image.load(stream, "dds");
+    EXPECT_GE(image.getData(), fileData);
+    EXPECT_LE(image.getData() + sizeof(pixels), fileData + stream->size());
+    stream.reset();
+    ASSERT_EQ(PF_A8R8G8B8, image.getFormat());
+    EXPECT_EQ(0, memcmp(pixels, image.getData(), sizeof(pixels)));
+
+    // copy on write, the file is left alone
+    Image copy(image);
+    image.getData()[0] = 0xff;
+    EXPECT_EQ(0xff, copy.getData()[0]);
+    file.open(dir + "/mapped.dds", std::ios::binary);
+    EXPECT_EQ(fileBytes, std::vector<char>((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>()));
+    file.close();
+    image.resize(8, 8);
+    EXPECT_EQ(8u, image.getWidth());
+
+    MeshPtr mesh = MeshManager::getSingleton().load("mapped.mesh", "Mapped");
+    VertexData* src = plane->sharedVertexData;
+    VertexData* dst = mesh->sharedVertexData;
+    ASSERT_EQ(src->vertexCount, dst->vertexCount);
+    HardwareVertexBufferSharedPtr srcBuf = src->vertexBufferBinding->getBuffer(0);
+    std::vector<uchar> srcBytes(srcBuf->getSizeInBytes()), dstBytes(srcBuf->getSizeInBytes());
+    srcBuf->readData(0, srcBytes.size(), srcBytes.data());
+    dst->vertexBufferBinding->getBuffer(0)->readData(0, dstBytes.size(), dstBytes.data());
+    EXPECT_EQ(srcBytes, dstBytes);
+    EXPECT_EQ(plane->getSubMesh(0)->indexData->indexCount, mesh->getSubMesh(0)->indexData->indexCount);
+
+    ResourceGroupManager::getSingleton().destroyResourceGroup("Mapped");
+    FileSystemLayer::removeFile(dir + "/mapped.mesh");
+    FileSystemLayer::removeFile(dir + "/mapped.dds");
+    FileSystemLayer::removeDirectory(dir);
+}
@@ -33,6 +33,7 @@ THE SOFTWARE.
 #include "OgreMeshManager.h"
 #include "OgreSubMesh.h"
 #include "OgreMeshSerializer.h"
+#include "OgreMeshFileFormat.h"
 #include "OgreRoot.h"
 #include "OgreException.h"
 #include "OgreArchive.h"
@@ -46,6 +47,7 @@ THE SOFTWARE.
 #include "OgreLodStrategyManager.h"
 #include "OgreSkeleton.h"
 #include "OgreKeyFrame.h"
+#include "OgreCompressedNodeAnimation.h"
 
 
 //#define I_HAVE_LOT_OF_FREE_TIME
@@ -197,11 +199,101 @@ TEST_F(MeshSerializerTests,Skeleton_Version_1_0)
     }
 }
 //--------------------------------------------------------------------------
-TEST_F(MeshSerializerTests,Mesh_Version_1_10)
+TEST_F(MeshSerializerTests,Skeleton_Version_1_11)
+{
+    if (mSkeleton) {
+        for (unsigned short i = 0; i < mSkeleton->getNumAnimations(); ++i)
+            mSkeleton->getAnimation(i)->compressNodeTracks(true);
+
+        SkeletonSerializer skeletonSerializer;
+        // the older formats have no room for the compressed tracks
+        EXPECT_THROW(skeletonSerializer.exportSkeleton(mSkeleton.get(), mSkeletonFullPath, SKELETON_VERSION_1_8),
+                     InvalidParametersException);
+        skeletonSerializer.exportSkeleton(mSkeleton.get(), mSkeletonFullPath, SKELETON_VERSION_1_11);
+
+        std::vector<size_t> sizes;
+        for (unsigned short i = 0; i < mSkeleton->getNumAnimations(); ++i)
+            sizes.push_back(mSkeleton->getAnimation(i)->getCompressedNodeTracks()->calculateSize());
+
+        mSkeleton->reload();
+        ASSERT_EQ(mSkeleton->getNumAnimations(), sizes.size());
+        for (unsigned short i = 0; i < mSkeleton->getNumAnimations(); ++i) {
+            Animation* anim = mSkeleton->getAnimation(i);
+            EXPECT_EQ(anim->getNumNodeTracks(), 0);
+            ASSERT_TRUE(anim->getCompressedNodeTracks());
+            EXPECT_EQ(anim->getCompressedNodeTracks()->calculateSize(), sizes[i]);
+        }
+    }
+}
+//--------------------------------------------------------------------------
+TEST_F(MeshSerializerTests,Mesh_Version_2_0)
 {
     testMesh(MESH_VERSION_LATEST);
 }
 //--------------------------------------------------------------------------
+TEST_F(MeshSerializerTests,Mesh_Version_2_0_FlippedEndian)
+{
+    // byte swapped buffers, read from a file stream instead of memory
+    Serializer::Endian endian =
+        OGRE_ENDIAN == OGRE_ENDIAN_BIG ? Serializer::ENDIAN_LITTLE : Serializer::ENDIAN_BIG;
+    MeshSerializer serializer;
+    serializer.exportMesh(mOrigMesh.get(), mMeshFullPath, MESH_VERSION_2_0, endian);
+
+    std::ifstream* f = OGRE_NEW_T(std::ifstream, MEMCATEGORY_GENERAL)(
+        mMeshFullPath.c_str(), std::ios::binary | std::ios::in);
+    DataStreamPtr stream(OGRE_NEW FileStreamDataStream(f));
+    MeshPtr mesh = MeshManager::getSingleton().createManual("flipped.mesh", mMesh->getGroup());
+    serializer.importMesh(stream, mesh.get());
+
+    // not loaded as a resource, so only compare the buffers
+    assertVertexDataClone(mOrigMesh->sharedVertexData, mesh->sharedVertexData);
+    ASSERT_EQ(mOrigMesh->getNumSubMeshes(), mesh->getNumSubMeshes());
+    for (unsigned short i = 0; i < mesh->getNumSubMeshes(); ++i)
+    {
+        SubMesh* a = mOrigMesh->getSubMesh(i);
+        SubMesh* b = mesh->getSubMesh(i);
+        assertIndexDataClone(a->indexData, b->indexData);
+        if (!a->useSharedVertices)
+            assertVertexDataClone(a->vertexData, b->vertexData);
+    }
+}
+//--------------------------------------------------------------------------
+TEST_F(MeshSerializerTests,Mesh_Version_2_0_BufferDataTable)
+{
+    MeshSerializer serializer;
+    serializer.exportMesh(mOrigMesh.get(), mMeshFullPath, MESH_VERSION_2_0);
+    std::ifstream ifs(mMeshFullPath.c_str(), std::ios::binary);
+    std::vector<char> bytes((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+
+    // M_BUFFER_DATA follows the file header: id, length, numBuffers, alignment, offset, size...
+    size_t chunk = sizeof(uint16) + strlen("[MeshSerializer_v2.0]") + 1;
+    ASSERT_GT(bytes.size(), chunk + 22);
+    uint16 id;
+    uint32 length, numBuffers, offset;
+    memcpy(&id, &bytes[chunk], sizeof(id));
+    memcpy(&length, &bytes[chunk + 2], sizeof(length));
+    memcpy(&numBuffers, &bytes[chunk + 6], sizeof(numBuffers));
+    memcpy(&offset, &bytes[chunk + 14], sizeof(offset));
+    ASSERT_EQ(M_BUFFER_DATA, id);
+    ASSERT_GT(numBuffers, 0u);
+
+    // offsets are relative to the chunk, the data is aligned within the file
+    EXPECT_LT(offset, length);
+    EXPECT_EQ(0u, (chunk + offset) % 16);
+
+    // a table larger than the chunk is rejected before it is allocated
+    numBuffers = 0x7FFFFFFF;
+    memcpy(&bytes[chunk + 6], &numBuffers, sizeof(numBuffers));
+    DataStreamPtr stream(OGRE_NEW MemoryDataStream(&bytes[0], bytes.size()));
+    MeshPtr mesh = MeshManager::getSingleton().createManual("corrupt.mesh", mMesh->getGroup());
+    EXPECT_THROW(serializer.importMesh(stream, mesh.get()), InvalidParametersException);
+}
+//--------------------------------------------------------------------------
+TEST_F(MeshSerializerTests,Mesh_Version_1_10)
+{
+    testMesh(MESH_VERSION_1_10);
+}
+//--------------------------------------------------------------------------
 TEST_F(MeshSerializerTests,Mesh_Version_1_8)
 {
     testMesh(MESH_VERSION_1_8);
@@ -248,6 +340,7 @@ TEST_F(MeshSerializerTests,Mesh_Version_1_2)
             }
             mOrigMesh = mMesh->clone(mMesh->getName() + ".orig.mesh", mMesh->getGroup());
             testMesh_XML();
+            testMesh(MESH_VERSION_2_0);
             testMesh(MESH_VERSION_1_10);
             testMesh(MESH_VERSION_1_8);
             testMesh(MESH_VERSION_1_7);
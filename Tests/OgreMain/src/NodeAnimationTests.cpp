@@ -0,0 +1,150 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include <gtest/gtest.h>
+
+#include "OgreSkeletonManager.h"
+#include "OgreSkeleton.h"
+#include "OgreBone.h"
+#include "OgreAnimation.h"
+#include "OgreAnimationState.h"
+#include "OgreCompressedNodeAnimation.h"
+#include "OgreKeyFrame.h"
+#include "RootWithoutRenderSystemFixture.h"
+
+#include <random>
+
+using namespace Ogre;
+
+typedef RootWithoutRenderSystemFixture CompressedNodeAnimationTests;
+TEST_F(CompressedNodeAnimationTests, MatchesNodeTracks)
+{
+    SkeletonPtr skel = static_pointer_cast<Skeleton>(SkeletonManager::getSingleton().load(
+        "robot.skeleton", ResourceGroupManager::AUTODETECT_RESOURCE_GROUP_NAME));
+
+    for (unsigned short a = 0; a < skel->getNumAnimations(); ++a)
+    {
+        Animation* anim = skel->getAnimation(a);
+        CompressedNodeAnimation compressed(anim);
+        ASSERT_EQ(compressed.getNumTracks(), anim->getNumNodeTracks());
+        EXPECT_LT(compressed.calculateSize(), anim->getNumNodeTracks() * compressed.getNumKeys() *
+                                                  sizeof(TransformKeyFrame));
+
+        size_t numTracks = compressed.getNumTracks();
+        std::vector<Vector3> translations(numTracks), scales(numTracks);
+        std::vector<Quaternion> rotations(numTracks);
+        TransformKeyFrame kf(0, 0);
+        // past the last key, the tracks interpolate towards the first one
+        for (Real t = 0; t < anim->getLength(); t += anim->getLength() / 37)
+        {
+            compressed.sample(t, &translations[0], &rotations[0], &scales[0]);
+            for (size_t i = 0; i < numTracks; ++i)
+            {
+                NodeAnimationTrack* track = anim->getNodeTrack(compressed.getTrackHandle(i));
+                track->getInterpolatedKeyFrame(anim->_getTimeIndex(t), &kf);
+                EXPECT_NEAR(std::abs(kf.getRotation().Dot(rotations[i])), 1, 1e-4);
+                EXPECT_TRUE(kf.getTranslate().positionEquals(translations[i], 1e-2));
+                EXPECT_TRUE(kf.getScale().positionEquals(scales[i], 1e-3));
+            }
+        }
+    }
+
+    // applying the compressed tracks poses the skeleton the same way
+    Animation* anim = skel->getAnimation("Walk");
+    std::vector<Quaternion> orientations;
+    std::vector<Vector3> positions;
+    skel->reset();
+    anim->apply(skel.get(), 0.3f, 0.5f);
+    for (unsigned short i = 0; i < skel->getNumBones(); ++i)
+    {
+        orientations.push_back(skel->getBone(i)->getOrientation());
+        positions.push_back(skel->getBone(i)->getPosition());
+    }
+
+    anim->compressNodeTracks(true);
+    EXPECT_EQ(anim->getNumNodeTracks(), 0);
+    skel->reset();
+    anim->apply(skel.get(), 0.3f + anim->getLength(), 0.5f);
+    for (unsigned short i = 0; i < skel->getNumBones(); ++i)
+    {
+        EXPECT_NEAR(std::abs(orientations[i].Dot(skel->getBone(i)->getOrientation())), 1, 1e-4);
+        EXPECT_TRUE(positions[i].positionEquals(skel->getBone(i)->getPosition(), 1e-2));
+    }
+}
+
+typedef RootWithoutRenderSystemFixture KeyFrameCursors;
+TEST_F(KeyFrameCursors, MatchKeyFrameSearch)
+{
+    // tracks with unaligned keys
+    Animation anim("Unaligned", 10);
+    std::minstd_rand rng;
+    std::uniform_real_distribution<Real> dist(-1, 1);
+    for (unsigned short t = 0; t < 8; ++t)
+    {
+        NodeAnimationTrack* track = anim.createNodeTrack(t);
+        for (Real time = Real(0.01) * t; time < anim.getLength(); time += Real(0.05) + Real(0.05) * dist(rng))
+        {
+            TransformKeyFrame* kf = track->createNodeKeyFrame(time);
+            kf->setTranslate(Vector3(dist(rng), dist(rng), dist(rng)));
+            kf->setRotation(Quaternion(Radian(dist(rng)), Vector3::UNIT_Y));
+        }
+    }
+
+    AnimationState::KeyFrameCursorList cursors;
+    TransformKeyFrame expected(0, 0), actual(0, 0);
+    auto expectSameKeyFrames = [&](Real timePos) {
+        for (unsigned short t = 0; t < anim.getNumNodeTracks(); ++t)
+        {
+            NodeAnimationTrack* track = anim.getNodeTrack(t);
+            track->getInterpolatedKeyFrame(anim._getTimeIndex(timePos), &expected);
+            track->getInterpolatedKeyFrame(anim._getTimeIndex(timePos, &cursors), &actual);
+            EXPECT_EQ(expected.getTranslate(), actual.getTranslate());
+            EXPECT_EQ(expected.getRotation(), actual.getRotation());
+        }
+    };
+
+    // playing forward at various speeds, looping past the end
+    for (Real step : {Real(0.003), Real(0.02), Real(0.4)})
+    {
+        for (Real timePos = 0; timePos < 2 * anim.getLength(); timePos += step)
+            expectSameKeyFrames(timePos);
+    }
+
+    // seeking, and landing exactly on keyframes
+    for (int i = 0; i < 200; ++i)
+        expectSameKeyFrames(anim.getLength() * (dist(rng) + 1) / 2);
+    for (int i = 0; i < 10; ++i)
+        expectSameKeyFrames(anim.getNodeTrack(0)->getKeyFrame(i * 7)->getTime());
+
+    // keyframes removed and added since the cursors were used
+    anim.getNodeTrack(3)->removeAllKeyFrames();
+    anim.getNodeTrack(3)->createNodeKeyFrame(5)->setTranslate(Vector3::UNIT_X);
+    anim.createNodeTrack(8)->createNodeKeyFrame(1)->setTranslate(Vector3::UNIT_Z);
+    for (Real timePos = 0; timePos < anim.getLength(); timePos += Real(0.3))
+        expectSameKeyFrames(timePos);
+    EXPECT_EQ(cursors.size(), 9u);
+}
@@ -71,6 +71,15 @@ public:
     }
 };
 //--------------------------------------------------------------------------
+class Uint64SortFunctor
+{
+public:
+    uint64 operator()(const uint64& p) const
+    {
+        return p;
+    }
+};
+//--------------------------------------------------------------------------
 TEST_F(RadixSortTests,FloatVector)
 {
     std::vector<float> container;
@@ -205,3 +214,28 @@ TEST_F(RadixSortTests,IntVector)
 //--------------------------------------------------------------------------
 
 
+TEST_F(RadixSortTests,Uint64Vector)
+{
+    std::vector<uint64> container;
+    Uint64SortFunctor func;
+    RadixSort<std::vector<uint64>, uint64, uint64> sorter;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        // few distinct upper halves, so the lower half decides the order often
+        uint64 upper = (unsigned int)Math::RangeRandom(0, 8) * 0x10000001u;
+        uint64 lower = (unsigned int)Math::RangeRandom(0, UINT_MAX);
+        container.push_back((upper << 32) | lower);
+    }
+
+    sorter.sort(container, func);
+
+    std::vector<uint64>::iterator v = container.begin();
+    uint64 lastValue = *v++;
+    for (;v != container.end(); ++v)
+    {
+        EXPECT_TRUE(*v >= lastValue);
+        lastValue = *v;
+    }
+}
+//--------------------------------------------------------------------------
@@ -0,0 +1,73 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include <gtest/gtest.h>
+
+#include "OgreRenderCommandList.h"
+#include "OgreGpuProgramParams.h"
+#include "RootWithoutRenderSystemFixture.h"
+
+using namespace Ogre;
+
+typedef RootWithoutRenderSystemFixture RenderCommandLists;
+TEST_F(RenderCommandLists, RecordsAndClears)
+{
+    GpuNamedConstantsPtr constants(new GpuNamedConstants());
+    GpuConstantDefinition def;
+    def.constType = GCT_FLOAT4;
+    def.elementSize = 4;
+    def.physicalIndex = 0;
+    constants->map["colour"] = def;
+    constants->floatBufferSize = 4;
+    GpuProgramParametersSharedPtr params(new GpuProgramParameters());
+    params->_setNamedConstants(constants);
+
+    RenderCommandList list;
+    RenderOperation op;
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        params->setNamedConstant("colour", Vector4(1, 2, 3, 4));
+        list.setCullingMode(CULL_NONE);
+        list.bindGpuProgramParameters(GPT_VERTEX_PROGRAM, params, GPV_ALL);
+        list.setWorldMatrix(Matrix4::IDENTITY);
+        list.render(op);
+        list.render(op);
+
+        ASSERT_EQ(5u, list.getNumCommands());
+        EXPECT_EQ(2u, list.getNumDraws());
+        EXPECT_EQ(RenderCommandList::RCT_SET_CULLING_MODE, list.getCommandType(0));
+        EXPECT_EQ(RenderCommandList::RCT_BIND_GPU_PROGRAM_PARAMETERS, list.getCommandType(1));
+        EXPECT_EQ(RenderCommandList::RCT_RENDER, list.getCommandType(4));
+
+        // the recorded copy is bound in place of the parameters
+        EXPECT_TRUE(params->_getFloatDirtyRange().empty());
+
+        list.clear();
+        EXPECT_EQ(0u, list.getNumCommands());
+        EXPECT_EQ(0u, list.getNumDraws());
+    }
+}
@@ -0,0 +1,164 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include <gtest/gtest.h>
+
+#include "OgreMaterialManager.h"
+#include "OgreTechnique.h"
+#include "OgrePass.h"
+#include "OgreRenderQueueSortingGrouping.h"
+#include "RootWithoutRenderSystemFixture.h"
+
+#include <random>
+using std::minstd_rand;
+
+using namespace Ogre;
+
+namespace
+{
+    /// renderable at a fixed view depth
+    struct DepthRenderable : public Renderable
+    {
+        Real depth;
+        MaterialPtr material;
+        LightList lights;
+
+        explicit DepthRenderable(Real d) : depth(d) {}
+        const MaterialPtr& getMaterial(void) const { return material; }
+        void getRenderOperation(RenderOperation& op) {}
+        void getWorldTransforms(Matrix4* xform) const {}
+        Real getSquaredViewDepth(const Camera* cam) const { return depth; }
+        const LightList& getLights(void) const { return lights; }
+    };
+
+    /// records the order in which a collection is visited
+    struct RecordingVisitor : public QueuedRenderableVisitor
+    {
+        std::vector<RenderablePass> visited;
+        std::vector<std::pair<const Pass*, RenderableList> > groups;
+        void visit(RenderablePass* rp) { visited.push_back(*rp); }
+        void visit(const Pass* p, RenderableList& rs) { groups.push_back(std::make_pair(p, rs)); }
+    };
+
+    struct DepthThenPassLess
+    {
+        bool operator()(const RenderablePass& a, const RenderablePass& b) const
+        {
+            Real adepth = a.renderable->getSquaredViewDepth(NULL);
+            Real bdepth = b.renderable->getSquaredViewDepth(NULL);
+            if (adepth != bdepth)
+                return adepth > bdepth;
+            return a.pass->getHash() < b.pass->getHash();
+        }
+    };
+}
+
+typedef RootWithoutRenderSystemFixture RenderQueueTests;
+TEST_F(RenderQueueTests, RadixSortedDescending)
+{
+    MaterialPtr mat = MaterialManager::getSingleton().create("RadixSortedDescending", ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+    Technique* tech = mat->getTechnique(0);
+    for (int i = 0; i < 3; ++i)
+        tech->createPass();
+
+    // enough items to take the radix sort path, with plenty of equal depths
+    minstd_rand rng;
+    std::vector<DepthRenderable> renderables;
+    for (int i = 0; i < 3000; ++i)
+        renderables.push_back(DepthRenderable(Real(rng() % 500) * 0.25f));
+
+    QueuedRenderableCollection collection;
+    collection.addOrganisationMode(QueuedRenderableCollection::OM_SORT_DESCENDING);
+    std::vector<RenderablePass> expected;
+    for (size_t i = 0; i < renderables.size(); ++i)
+    {
+        Pass* pass = tech->getPass(rng() % tech->getNumPasses());
+        collection.addRenderable(pass, &renderables[i]);
+        expected.push_back(RenderablePass(&renderables[i], pass));
+    }
+    collection.sort(NULL);
+    std::stable_sort(expected.begin(), expected.end(), DepthThenPassLess());
+
+    RecordingVisitor visitor;
+    collection.acceptVisitor(&visitor, QueuedRenderableCollection::OM_SORT_DESCENDING);
+    ASSERT_EQ(expected.size(), visitor.visited.size());
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+        EXPECT_EQ(expected[i].renderable, visitor.visited[i].renderable) << i;
+        EXPECT_EQ(expected[i].pass, visitor.visited[i].pass) << i;
+    }
+}
+
+TEST_F(RenderQueueTests, GroupedByPass)
+{
+    // the passes of both techniques have the same hashes
+    MaterialPtr mat = MaterialManager::getSingleton().create("GroupedByPass", ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+    mat->createTechnique();
+    std::vector<Pass*> passes;
+    for (unsigned short t = 0; t < 2; ++t)
+    {
+        Technique* tech = mat->getTechnique(t);
+        for (unsigned short i = 0; i < 4; ++i)
+            passes.push_back(i < tech->getNumPasses() ? tech->getPass(i) : tech->createPass());
+    }
+
+    minstd_rand rng;
+    std::vector<DepthRenderable> renderables(1000, DepthRenderable(0));
+    std::map<const Pass*, RenderableList> expected;
+
+    QueuedRenderableCollection collection, other;
+    collection.addOrganisationMode(QueuedRenderableCollection::OM_PASS_GROUP);
+    other.addOrganisationMode(QueuedRenderableCollection::OM_PASS_GROUP);
+    for (size_t i = 0; i < renderables.size(); ++i)
+    {
+        Pass* pass = passes[rng() % passes.size()];
+        (i < 800 ? collection : other).addRenderable(pass, &renderables[i]);
+        expected[pass].push_back(&renderables[i]);
+    }
+    collection.merge(other);
+    collection.removePassGroup(passes[5]);
+    expected.erase(passes[5]);
+    collection.sort(NULL);
+
+    RecordingVisitor visitor;
+    collection.acceptVisitor(&visitor, QueuedRenderableCollection::OM_PASS_GROUP);
+    ASSERT_EQ(expected.size(), visitor.groups.size());
+    for (size_t i = 0; i < visitor.groups.size(); ++i)
+    {
+        // every pass once, ordered by hash then address, renderables in the order they were added
+        const Pass* pass = visitor.groups[i].first;
+        if (i > 0)
+        {
+            const Pass* prev = visitor.groups[i - 1].first;
+            EXPECT_LE(prev->getHash(), pass->getHash());
+            if (prev->getHash() == pass->getHash())
+                EXPECT_LT(prev, pass);
+        }
+        EXPECT_EQ(expected[pass], visitor.groups[i].second);
+        expected.erase(pass);
+    }
+}
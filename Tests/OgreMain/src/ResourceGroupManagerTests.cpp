@@ -0,0 +1,178 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include <gtest/gtest.h>
+
+#include "OgreMeshManager.h"
+#include "OgreMesh.h"
+#include "OgreMeshSerializer.h"
+#include "OgreArchiveManager.h"
+#include "OgreFileSystemLayer.h"
+#include "RootWithoutRenderSystemFixture.h"
+
+#include <thread>
+#include <fstream>
+
+using namespace Ogre;
+
+namespace {
+    struct LoadOrderRecorder : public ResourceGroupListener
+    {
+        std::vector<String> loaded;
+        size_t notPrepared;
+        bool otherThread;
+        std::thread::id mainThread;
+        LoadOrderRecorder() : notPrepared(0), otherThread(false), mainThread(std::this_thread::get_id()) {}
+
+        void resourceLoadStarted(const ResourcePtr& resource)
+        {
+            loaded.push_back(resource->getName());
+            notPrepared += resource->getLoadingState() != Resource::LOADSTATE_PREPARED;
+            otherThread |= std::this_thread::get_id() != mainThread;
+        }
+    };
+}
+typedef RootWithoutRenderSystemFixture ParallelResourceLoading;
+TEST_F(ParallelResourceLoading, PreparesConcurrently)
+{
+    String dir = mFSLayer->getWritablePath("ParallelLoadingTest");
+    FileSystemLayer::createDirectory(dir);
+
+    MeshPtr plane = MeshManager::getSingleton().createPlane("ParallelPlane", "General",
+                                                            Plane(Vector3::UNIT_Z, 0), 50, 50, 4, 4);
+    const int numMeshes = 16;
+    for (int i = 0; i < numMeshes; ++i)
+        MeshSerializer().exportMesh(plane.get(), dir + "/parallel" + StringConverter::toString(i) + ".mesh");
+
+    ResourceGroupManager& rgm = ResourceGroupManager::getSingleton();
+    rgm.setNumWorkerThreads(4);
+#if OGRE_THREAD_SUPPORT == 1 || OGRE_THREAD_SUPPORT == 2
+    ASSERT_EQ(4u, rgm.getNumWorkerThreads());
+    const size_t expectedNotPrepared = 0;
+#else
+    // the resource system is not thread safe, so everything stays on this thread
+    EXPECT_EQ(1u, rgm.getNumWorkerThreads());
+    const size_t expectedNotPrepared = numMeshes;
+#endif
+    rgm.addResourceLocation(dir, "FileSystem", "Parallel");
+    for (int i = 0; i < numMeshes; ++i)
+        MeshManager::getSingleton().create("parallel" + StringConverter::toString(i) + ".mesh", "Parallel");
+
+    LoadOrderRecorder recorder;
+    rgm.addResourceGroupListener(&recorder);
+    rgm.loadResourceGroup("Parallel");
+    rgm.removeResourceGroupListener(&recorder);
+
+    // loaded in the usual order on this thread, after being prepared up front if threaded
+    ASSERT_EQ(size_t(numMeshes), recorder.loaded.size());
+    EXPECT_EQ(expectedNotPrepared, recorder.notPrepared);
+    EXPECT_FALSE(recorder.otherThread);
+    for (int i = 0; i < numMeshes; ++i)
+    {
+        MeshPtr mesh = MeshManager::getSingleton().getByName(recorder.loaded[i], "Parallel");
+        EXPECT_TRUE(mesh->isLoaded());
+        EXPECT_EQ(plane->sharedVertexData->vertexCount, mesh->sharedVertexData->vertexCount);
+    }
+
+    // failures are reported by the serial load
+    MeshManager::getSingleton().create("missing.mesh", "Parallel");
+    EXPECT_THROW(rgm.loadResourceGroup("Parallel"), FileNotFoundException);
+
+    rgm.setNumWorkerThreads(1);
+    EXPECT_EQ(1u, rgm.getNumWorkerThreads());
+    rgm.destroyResourceGroup("Parallel");
+    for (int i = 0; i < numMeshes; ++i)
+        FileSystemLayer::removeFile(dir + "/parallel" + StringConverter::toString(i) + ".mesh");
+    FileSystemLayer::removeDirectory(dir);
+}
+
+typedef RootWithoutRenderSystemFixture ResourceIndexCache;
+TEST_F(ResourceIndexCache, SkipsScanningUnchangedLocations)
+{
+    String dir = mFSLayer->getWritablePath("IndexCacheTest");
+    String cacheDir = mFSLayer->getWritablePath("IndexCacheTestCache");
+    FileSystemLayer::createDirectory(dir);
+    FileSystemLayer::createDirectory(dir + "/sub");
+    FileSystemLayer::createDirectory(cacheDir);
+    std::ofstream(dir + "/a.txt") << "a";
+    std::ofstream(dir + "/sub/b.txt") << "b";
+
+    ResourceGroupManager& rgm = ResourceGroupManager::getSingleton();
+    rgm.setIndexCachePath(cacheDir);
+
+    rgm.addResourceLocation(dir, "FileSystem", "Indexed", true);
+    FileInfoListPtr scanned = rgm.findResourceFileInfo("Indexed", "*.txt");
+    rgm.removeResourceLocation(dir, "Indexed");
+
+    Archive* cache = ArchiveManager::getSingleton().load(cacheDir, "FileSystem", true);
+    StringVectorPtr cacheFiles = cache->find("*.index");
+    ArchiveManager::getSingleton().unload(cache);
+    ASSERT_EQ(1u, cacheFiles->size());
+
+    // read back, the same as scanning
+    rgm.addResourceLocation(dir, "FileSystem", "Indexed", true);
+    FileInfoListPtr cached = rgm.findResourceFileInfo("Indexed", "*.txt");
+    ASSERT_EQ(2u, cached->size());
+    ASSERT_EQ(scanned->size(), cached->size());
+    for (size_t i = 0; i < cached->size(); ++i)
+    {
+        EXPECT_EQ(scanned->at(i).filename, cached->at(i).filename);
+        EXPECT_EQ(scanned->at(i).path, cached->at(i).path);
+        EXPECT_EQ(scanned->at(i).basename, cached->at(i).basename);
+        EXPECT_EQ(scanned->at(i).uncompressedSize, cached->at(i).uncompressedSize);
+    }
+    EXPECT_TRUE(rgm.resourceExists("Indexed", "sub/b.txt"));
+    EXPECT_EQ(1u, rgm.findResourceFileInfo("Indexed", "sub/*")->size());
+    EXPECT_EQ(rgm.openResource("sub/b.txt", "Indexed")->getAsString(), "b");
+    rgm.removeResourceLocation(dir, "Indexed");
+
+    // rewritten in place, which leaves the directory alone
+    std::ofstream(dir + "/sub/b.txt") << "bb";
+    rgm.addResourceLocation(dir, "FileSystem", "Indexed", true);
+    cached = rgm.findResourceFileInfo("Indexed", "sub/*");
+    ASSERT_EQ(1u, cached->size());
+    EXPECT_EQ(2u, cached->at(0).uncompressedSize);
+    rgm.removeResourceLocation(dir, "Indexed");
+
+    // modification times have a resolution of a second
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    std::ofstream(dir + "/sub/c.txt") << "c";
+
+    rgm.addResourceLocation(dir, "FileSystem", "Indexed", true);
+    EXPECT_TRUE(rgm.resourceExists("Indexed", "sub/c.txt"));
+    EXPECT_EQ(3u, rgm.findResourceFileInfo("Indexed", "*.txt")->size());
+
+    rgm.setIndexCachePath(BLANKSTRING);
+    rgm.destroyResourceGroup("Indexed");
+    FileSystemLayer::removeFile(cacheDir + "/" + cacheFiles->at(0));
+    FileSystemLayer::removeDirectory(cacheDir);
+    FileSystemLayer::removeFile(dir + "/sub/b.txt");
+    FileSystemLayer::removeFile(dir + "/sub/c.txt");
+    FileSystemLayer::removeDirectory(dir + "/sub");
+    FileSystemLayer::removeFile(dir + "/a.txt");
+    FileSystemLayer::removeDirectory(dir);
+}
@@ -0,0 +1,103 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include <gtest/gtest.h>
+
+#include "OgreMeshManager.h"
+#include "OgreMesh.h"
+#include "RootWithoutRenderSystemFixture.h"
+
+#include <thread>
+
+using namespace Ogre;
+
+typedef RootWithoutRenderSystemFixture ResourceLookups;
+TEST_F(ResourceLookups, ShardedNameIndex)
+{
+    ResourceGroupManager& rgm = ResourceGroupManager::getSingleton();
+    MeshManager& mm = MeshManager::getSingleton();
+    rgm.createResourceGroup("Pooled", false);
+
+    ResourcePtr global = mm.create("shared.mesh", "General");
+    ResourcePtr pooled = mm.create("shared.mesh", "Pooled");
+    ResourcePtr pooledOnly = mm.create("pooled.mesh", "Pooled");
+
+    EXPECT_EQ(global, mm.getResourceByName("shared.mesh", "General"));
+    EXPECT_EQ(pooled, mm.getResourceByName("shared.mesh", "Pooled"));
+    const String& autodetect = ResourceGroupManager::AUTODETECT_RESOURCE_GROUP_NAME;
+    EXPECT_EQ(global, mm.getResourceByName("shared.mesh", autodetect));
+    EXPECT_EQ(pooledOnly, mm.getResourceByName("pooled.mesh", autodetect));
+    EXPECT_EQ(pooledOnly, mm.getResourceByName("pooled.mesh", "Pooled"));
+#if OGRE_RESOURCEMANAGER_STRICT
+    EXPECT_FALSE(mm.getResourceByName("pooled.mesh", "General"));
+#endif
+    EXPECT_FALSE(mm.getResourceByName("missing.mesh", "General"));
+    EXPECT_THROW(mm.getResourceByName("shared.mesh", "NoSuchGroup"), ItemIdentityException);
+
+    // held by several groups only, the first group by name wins regardless of the creation order
+    const char* groups[] = {"Zulu", "Alpha", "Mike"};
+    ResourcePtr multi[3];
+    for (int i = 0; i < 3; ++i)
+    {
+        rgm.createResourceGroup(groups[i], false);
+        multi[i] = mm.create("multi.mesh", groups[i]);
+    }
+    EXPECT_EQ(multi[1], mm.getResourceByName("multi.mesh", autodetect));
+    for (int i = 0; i < 3; ++i)
+        rgm.destroyResourceGroup(groups[i]);
+
+    uint32 hash = ResourceManager::hashName("shared.mesh");
+    EXPECT_EQ(pooled, mm.getResourceByName("shared.mesh", hash, "Pooled"));
+    EXPECT_EQ(global, mm.getResourceByName("shared.mesh", hash, "General"));
+
+    // concurrent lookups
+    std::vector<std::thread> threads;
+    std::vector<int> failures(4, 0);
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.push_back(std::thread([&, t]() {
+            for (int i = 0; i < 10000; ++i)
+                failures[t] += mm.getResourceByName("shared.mesh", hash, "Pooled") != pooled;
+        }));
+    }
+    for (size_t t = 0; t < threads.size(); ++t)
+        threads[t].join();
+    EXPECT_EQ(0, failures[0] + failures[1] + failures[2] + failures[3]);
+
+    mm.remove(pooled);
+    EXPECT_NE(pooled, mm.getResourceByName("shared.mesh", "Pooled"));
+    mm.remove(global);
+    EXPECT_FALSE(mm.getResourceByName("shared.mesh", autodetect));
+
+    // groups created later are looked up again
+    rgm.destroyResourceGroup("Pooled");
+    EXPECT_FALSE(mm.getResourceByName("pooled.mesh", autodetect));
+    rgm.createResourceGroup("Pooled", true);
+    ResourcePtr nowGlobal = mm.create("pooled.mesh", "Pooled");
+    EXPECT_EQ(nowGlobal, mm.getResourceByName("pooled.mesh", "General"));
+    rgm.destroyResourceGroup("Pooled");
+}
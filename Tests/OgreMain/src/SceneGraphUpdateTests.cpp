@@ -0,0 +1,247 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include <gtest/gtest.h>
+
+#include "OgreRoot.h"
+#include "OgreSceneNode.h"
+#include "OgreEntity.h"
+#include "OgreCamera.h"
+#include "OgreRibbonTrail.h"
+#include "OgreStringConverter.h"
+#include "RootWithoutRenderSystemFixture.h"
+
+#include <random>
+using std::minstd_rand;
+
+using namespace Ogre;
+
+static std::vector<SceneNode*> createRandomHierarchy(SceneManager* mgr, Entity* ent, size_t nodeCount)
+{
+    // we want cross platform consistent sequence
+    minstd_rand rng;
+    std::vector<SceneNode*> nodes(1, mgr->getRootSceneNode());
+
+    for (size_t n = 0; n < nodeCount; ++n)
+    {
+        // favour recent nodes as parents to get some depth
+        size_t parent = nodes.size() - 1 - rng() % std::min<size_t>(nodes.size(), 64);
+        SceneNode* node = nodes[parent]->createChildSceneNode(
+            Vector3(rng() % 200, rng() % 200, rng() % 200) - Vector3(100, 100, 100),
+            Quaternion(Degree(Real(rng() % 360)), Vector3::UNIT_Y));
+        node->setScale(Vector3(Real(1 + rng() % 3)));
+        if (n % 3 == 0)
+            node->attachObject(ent->clone(StringConverter::toString(n)));
+        nodes.push_back(node);
+    }
+    return nodes;
+}
+
+static void expectSameTransforms(SceneNode* a, SceneNode* b)
+{
+    ASSERT_EQ(a->numChildren(), b->numChildren());
+    // results must be bit identical, not just close
+    EXPECT_TRUE(!memcmp(&a->_getDerivedPosition(), &b->_getDerivedPosition(), sizeof(Vector3)));
+    EXPECT_TRUE(!memcmp(&a->_getDerivedOrientation(), &b->_getDerivedOrientation(), sizeof(Quaternion)));
+    EXPECT_TRUE(!memcmp(&a->_getDerivedScale(), &b->_getDerivedScale(), sizeof(Vector3)));
+    EXPECT_TRUE(!memcmp(&a->_getFullTransform(), &b->_getFullTransform(), sizeof(Affine3)));
+    EXPECT_EQ(a->_getWorldAABB().isNull(), b->_getWorldAABB().isNull());
+    if (!a->_getWorldAABB().isNull())
+    {
+        EXPECT_TRUE(!memcmp(&a->_getWorldAABB().getMinimum(), &b->_getWorldAABB().getMinimum(), sizeof(Vector3)));
+        EXPECT_TRUE(!memcmp(&a->_getWorldAABB().getMaximum(), &b->_getWorldAABB().getMaximum(), sizeof(Vector3)));
+    }
+
+    for (unsigned short i = 0; i < a->numChildren(); ++i)
+        expectSameTransforms(static_cast<SceneNode*>(a->getChild(i)), static_cast<SceneNode*>(b->getChild(i)));
+}
+
+typedef RootWithoutRenderSystemFixture SceneGraphUpdate;
+TEST_F(SceneGraphUpdate, ParallelMatchesSerial)
+{
+    SceneManager* serial = mRoot->createSceneManager();
+    SceneManager* parallel = mRoot->createSceneManager();
+    parallel->setNumWorkerThreads(4);
+
+    createRandomHierarchy(serial, serial->createEntity("sphere.mesh"), 2000);
+    createRandomHierarchy(parallel, parallel->createEntity("sphere.mesh"), 2000);
+
+    serial->_updateSceneGraph(NULL);
+    parallel->_updateSceneGraph(NULL);
+    expectSameTransforms(serial->getRootSceneNode(), parallel->getRootSceneNode());
+
+    // partial update, only some branches are out of date
+    SceneManager* mgrs[] = {serial, parallel};
+    for (int m = 0; m < 2; ++m)
+    {
+        SceneNode* node = mgrs[m]->getRootSceneNode();
+        while (node->numChildren())
+        {
+            node->translate(Vector3::UNIT_X);
+            node = static_cast<SceneNode*>(node->getChild(node->numChildren() - 1));
+        }
+    }
+
+    serial->_updateSceneGraph(NULL);
+    parallel->_updateSceneGraph(NULL);
+    expectSameTransforms(serial->getRootSceneNode(), parallel->getRootSceneNode());
+}
+
+TEST_F(SceneGraphUpdate, ParallelWithRibbonTrail)
+{
+    SceneManager* mgr = mRoot->createSceneManager();
+    mgr->setNumWorkerThreads(4);
+
+    // one chain per node, spread over many branches so that the node listeners
+    // of the trail queue updates from all threads
+    const size_t numNodes = 256;
+    RibbonTrail* trail = mgr->createRibbonTrail();
+    trail->setNumberOfChains(numNodes);
+    trail->setMaxChainElements(4);
+    trail->setTrailLength(400);
+    mgr->getRootSceneNode()->attachObject(trail);
+
+    std::vector<SceneNode*> nodes;
+    for (size_t i = 0; i < numNodes; ++i)
+    {
+        nodes.push_back(mgr->getRootSceneNode()->createChildSceneNode(Vector3(Real(i), 0, 0)));
+        trail->addNode(nodes.back());
+    }
+
+    for (int frame = 0; frame < 20; ++frame)
+    {
+        for (size_t i = 0; i < numNodes; ++i)
+            nodes[i]->translate(Vector3::UNIT_Y * 5);
+        mgr->_updateSceneGraph(NULL);
+    }
+
+    // the queued update of the root picks up the bounds of the trail
+    mgr->_updateSceneGraph(NULL);
+    const AxisAlignedBox& box = mgr->getRootSceneNode()->_getWorldAABB();
+    for (size_t i = 0; i < numNodes; ++i)
+        EXPECT_TRUE(box.contains(nodes[i]->_getDerivedPosition())) << i;
+}
+
+namespace
+{
+    /// counts how often it was queued, as nothing can be rendered without a render system
+    class QueueCountingObject : public MovableObject
+    {
+        AxisAlignedBox mBox;
+    public:
+        int queued;
+        QueueCountingObject() : mBox(-Vector3::UNIT_SCALE, Vector3::UNIT_SCALE), queued(0) {}
+        const String& getMovableType(void) const
+        {
+            static String type = "QueueCountingObject";
+            return type;
+        }
+        const AxisAlignedBox& getBoundingBox(void) const { return mBox; }
+        Real getBoundingRadius(void) const { return Math::Sqrt(3); }
+        void _updateRenderQueue(RenderQueue* queue) { ++queued; }
+        bool _canQueueConcurrently(void) const { return true; }
+        void visitRenderables(Renderable::Visitor* visitor, bool debugRenderables) {}
+    };
+}
+
+TEST_F(SceneGraphUpdate, ParallelCullingMatchesSerial)
+{
+    SceneManager* mgr = mRoot->createSceneManager();
+    mgr->setNumWorkerThreads(4);
+
+    std::vector<SceneNode*> nodes = createRandomHierarchy(mgr, mgr->createEntity("sphere.mesh"), 2000);
+    std::vector<QueueCountingObject> objects(nodes.size());
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+        nodes[i]->detachAllObjects();
+        nodes[i]->attachObject(&objects[i]);
+    }
+
+    Camera* cam = mgr->createCamera("cam");
+    mgr->getRootSceneNode()->createChildSceneNode(Vector3(0, 0, 50))->attachObject(cam);
+    mgr->_updateSceneGraph(cam);
+
+    VisibleObjectsBoundsInfo bounds[2];
+    for (int i = 0; i < 2; ++i)
+    {
+        mgr->setParallelCullingEnabled(i == 1);
+        bounds[i].reset();
+        mgr->_findVisibleObjects(cam, &bounds[i], false);
+    }
+
+    size_t visible = 0;
+    for (size_t i = 0; i < objects.size(); ++i)
+    {
+        // queued by both or none
+        EXPECT_EQ(objects[i].queued % 2, 0);
+        visible += objects[i].queued != 0;
+    }
+    EXPECT_GT(visible, 0u);
+    EXPECT_LT(visible, objects.size());
+    EXPECT_EQ(bounds[0].aabb, bounds[1].aabb);
+    EXPECT_EQ(bounds[0].minDistance, bounds[1].minDistance);
+    EXPECT_EQ(bounds[0].maxDistance, bounds[1].maxDistance);
+
+    for (size_t i = 0; i < nodes.size(); ++i)
+        nodes[i]->detachAllObjects();
+}
+
+TEST_F(SceneGraphUpdate, PackedTransformsMatchNodes)
+{
+    SceneManager* mgrs[] = {mRoot->createSceneManager(), mRoot->createSceneManager()};
+    mgrs[1]->setNodeTransformStoreEnabled(true);
+
+    std::vector<SceneNode*> nodes[2];
+    for (int m = 0; m < 2; ++m)
+    {
+        nodes[m] = createRandomHierarchy(mgrs[m], mgrs[m]->createEntity("sphere.mesh"), 2000);
+        // some nodes not inheriting from their parent
+        nodes[m][10]->setInheritOrientation(false);
+        nodes[m][20]->setInheritScale(false);
+        mgrs[m]->_updateSceneGraph(NULL);
+    }
+    expectSameTransforms(mgrs[0]->getRootSceneNode(), mgrs[1]->getRootSceneNode());
+
+    // partial update
+    for (int m = 0; m < 2; ++m)
+    {
+        for (size_t i = 0; i < nodes[m].size(); i += 50)
+            nodes[m][i]->roll(Degree(10));
+        mgrs[m]->_updateSceneGraph(NULL);
+    }
+    expectSameTransforms(mgrs[0]->getRootSceneNode(), mgrs[1]->getRootSceneNode());
+
+    // changed hierarchy
+    for (int m = 0; m < 2; ++m)
+    {
+        nodes[m][30]->getParentSceneNode()->removeChild(nodes[m][30]);
+        nodes[m][1000]->addChild(nodes[m][30]);
+        mgrs[m]->destroySceneNode(nodes[m][40]);
+        mgrs[m]->_updateSceneGraph(NULL);
+    }
+    expectSameTransforms(mgrs[0]->getRootSceneNode(), mgrs[1]->getRootSceneNode());
+}
@@ -0,0 +1,282 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include <gtest/gtest.h>
+
+#include "OgreSceneNode.h"
+#include "OgreEntity.h"
+#include "OgreCamera.h"
+#include "OgreSceneManagerEnumerator.h"
+#include "OgreSkeletonInstance.h"
+#include "OgreBone.h"
+#include "OgreAnimationState.h"
+#include "OgreHardwareBufferManager.h"
+#include "OgreMesh.h"
+#include "OgreWorkerThreadPool.h"
+#include "RootWithoutRenderSystemFixture.h"
+
+#include <random>
+
+using namespace Ogre;
+
+namespace
+{
+    /// exposes the skeletal animation stage, which otherwise runs as part of rendering
+    struct SkeletalAnimationSceneManager : public DefaultSceneManager
+    {
+        SkeletalAnimationSceneManager() : DefaultSceneManager("SkeletalAnimation") {}
+        using SceneManager::updateSkeletalAnimations;
+    };
+
+    void expectSamePose(Entity* a, Entity* b)
+    {
+        ASSERT_EQ(a->_getNumBoneMatrices(), b->_getNumBoneMatrices());
+        for (unsigned short i = 0; i < a->_getNumBoneMatrices(); ++i)
+            EXPECT_EQ(a->_getBoneMatrices()[i], b->_getBoneMatrices()[i]);
+
+        for (unsigned short i = 0; i < a->getSkeleton()->getNumBones(); ++i)
+        {
+            EXPECT_EQ(a->getSkeleton()->getBone(i)->_getDerivedPosition(),
+                      b->getSkeleton()->getBone(i)->_getDerivedPosition());
+            EXPECT_EQ(a->getSkeleton()->getBone(i)->_getDerivedOrientation(),
+                      b->getSkeleton()->getBone(i)->_getDerivedOrientation());
+        }
+    }
+}
+
+typedef RootWithoutRenderSystemFixture SkeletalAnimationStage;
+TEST_F(SkeletalAnimationStage, MatchesLazyUpdate)
+{
+    SkeletalAnimationSceneManager mgr;
+    mgr.setNumWorkerThreads(4);
+
+    // pairs of entities in identical states, the last one blending in a second animation
+    const int numEntities = 8;
+    Entity* staged[numEntities];
+    Entity* lazy[numEntities];
+    for (int i = 0; i < numEntities; ++i)
+    {
+        staged[i] = mgr.createEntity("robot.mesh");
+        mgr.getRootSceneNode()->createChildSceneNode()->attachObject(staged[i]);
+        // not in the scene, so left to be updated as when queued
+        lazy[i] = mgr.createEntity("robot.mesh");
+
+        Entity* entities[] = {staged[i], lazy[i]};
+        for (int e = 0; e < 2; ++e)
+        {
+            AnimationState* walk = entities[e]->getAnimationState("Walk");
+            walk->setEnabled(true);
+            walk->setTimePosition(0.1f * (i / 2));
+            if (i == numEntities - 1)
+            {
+                AnimationState* shoot = entities[e]->getAnimationState("Shoot");
+                shoot->setEnabled(true);
+                shoot->setWeight(0.5f);
+            }
+        }
+    }
+
+    Entity* shared = mgr.createEntity("robot.mesh");
+    mgr.getRootSceneNode()->createChildSceneNode()->attachObject(shared);
+    shared->shareSkeletonInstanceWith(staged[0]);
+
+    mgr.updateSkeletalAnimations();
+
+    for (int i = 0; i < numEntities; ++i)
+    {
+        // already up to date
+        EXPECT_FALSE(staged[i]->_updateBoneMatrices());
+        EXPECT_TRUE(lazy[i]->_updateBoneMatrices());
+        expectSamePose(staged[i], lazy[i]);
+    }
+    expectSamePose(shared, lazy[0]);
+}
+
+typedef RootWithoutRenderSystemFixture AnimationLod;
+TEST_F(AnimationLod, SpreadsDistantSkeletonsAcrossFrames)
+{
+    SkeletalAnimationSceneManager mgr;
+    Camera* cam = mgr.createCamera("cam");
+    mgr.getRootSceneNode()->attachObject(cam);
+
+    const int numEntities = 4;
+    Entity* entities[numEntities];
+    SceneNode* nodes[numEntities];
+    for (int i = 0; i < numEntities; ++i)
+    {
+        entities[i] = mgr.createEntity("robot.mesh");
+        nodes[i] = mgr.getRootSceneNode()->createChildSceneNode(Vector3(0, 0, -2000));
+        nodes[i]->attachObject(entities[i]);
+        // different poses, so none is copied from another
+        entities[i]->getAnimationState("Walk")->setEnabled(true);
+        entities[i]->getAnimationState("Walk")->setTimePosition(0.1f * i);
+        // every numEntities frames beyond 500 units
+        entities[i]->setAnimationLodLevels(std::vector<Real>(1, 500),
+                                           std::vector<ushort>(1, numEntities));
+    }
+    size_t numBones = entities[0]->getSkeleton()->getNumBones();
+
+    for (int frame = 0; frame < 3 * numEntities; ++frame)
+    {
+        if (frame == 2 * numEntities)
+        {
+            // close by, back to every frame
+            for (int i = 0; i < numEntities; ++i)
+                nodes[i]->setPosition(0, 0, -100);
+        }
+
+        mgr.getRootSceneNode()->_update(true, false);
+        std::vector<Affine3> before[numEntities];
+        bool held[numEntities];
+        for (int i = 0; i < numEntities; ++i)
+        {
+            entities[i]->_notifyCurrentCamera(cam);
+            entities[i]->getAnimationState("Walk")->addTime(0.1f);
+            held[i] = entities[i]->_isAnimationLodHeld();
+            before[i].assign(entities[i]->_getBoneMatrices(),
+                             entities[i]->_getBoneMatrices() + entities[i]->_getNumBoneMatrices());
+        }
+
+        mgr.resetAnimationStats();
+        mgr.updateSkeletalAnimations();
+
+        // all evaluated initially, then one of them per frame
+        size_t expected = frame == 0 || frame >= 2 * numEntities ? numEntities : 1;
+        EXPECT_EQ(expected, mgr.getNumSkeletonsEvaluated());
+        EXPECT_EQ(expected * numBones, mgr.getNumBonesEvaluated());
+
+        for (int i = 0; i < numEntities; ++i)
+        {
+            // either evaluated by the stage already or held
+            EXPECT_FALSE(entities[i]->_updateBoneMatrices());
+            if (held[i])
+            {
+                std::vector<Affine3> after(entities[i]->_getBoneMatrices(),
+                                           entities[i]->_getBoneMatrices() + entities[i]->_getNumBoneMatrices());
+                EXPECT_EQ(before[i], after);
+            }
+        }
+
+        mRoot->_fireFrameRenderingQueued();
+    }
+}
+
+typedef RootWithoutRenderSystemFixture SoftwareSkinning;
+TEST_F(SoftwareSkinning, MatchesReferenceBlend)
+{
+    // interleaved source, as exported by most tools
+    const size_t numVertices = 1001; // not a multiple of the thread count
+    VertexData src;
+    src.vertexCount = numVertices;
+    size_t offset = 0;
+    offset += src.vertexDeclaration->addElement(0, offset, VET_FLOAT3, VES_POSITION).getSize();
+    offset += src.vertexDeclaration->addElement(0, offset, VET_FLOAT3, VES_NORMAL).getSize();
+    offset += src.vertexDeclaration->addElement(0, offset, VET_FLOAT4, VES_BLEND_WEIGHTS).getSize();
+    offset += src.vertexDeclaration->addElement(0, offset, VET_UBYTE4, VES_BLEND_INDICES).getSize();
+    src.vertexBufferBinding->setBinding(0, HardwareBufferManager::getSingleton().createVertexBuffer(
+        offset, numVertices, HardwareBuffer::HBU_STATIC));
+
+    std::minstd_rand rng;
+    std::uniform_real_distribution<float> dist(-1, 1);
+    struct SrcVertex
+    {
+        float pos[3], norm[3], weights[4];
+        uint8 indices[4];
+    };
+    std::vector<SrcVertex> vertices(numVertices);
+    for (SrcVertex& v : vertices)
+    {
+        Vector3 norm(dist(rng), dist(rng), dist(rng) + 2);
+        norm.normalise();
+        float weightSum = 0;
+        for (int i = 0; i < 3; ++i)
+        {
+            v.pos[i] = dist(rng) * 10;
+            v.norm[i] = norm[i];
+        }
+        for (int i = 0; i < 4; ++i)
+        {
+            v.weights[i] = dist(rng) + 1;
+            v.indices[i] = uint8(rng() % 8);
+            weightSum += v.weights[i];
+        }
+        for (float& w : v.weights)
+            w /= weightSum;
+    }
+    src.vertexBufferBinding->getBuffer(0)->writeData(0, numVertices * sizeof(SrcVertex), vertices.data());
+
+    Affine3 bones[8];
+    const Affine3* blendMatrices[8];
+    for (int b = 0; b < 8; ++b)
+    {
+        bones[b].makeTransform(Vector3(dist(rng), dist(rng), dist(rng)) * 5, Vector3(dist(rng) + 2),
+                               Quaternion(Radian(dist(rng) * 3), Vector3(dist(rng), 1, dist(rng)).normalisedCopy()));
+        blendMatrices[b] = &bones[b];
+    }
+
+    auto createTarget = [numVertices]() {
+        VertexData* dest = new VertexData;
+        dest->vertexCount = numVertices;
+        dest->vertexDeclaration->addElement(0, 0, VET_FLOAT3, VES_POSITION);
+        dest->vertexDeclaration->addElement(0, 12, VET_FLOAT3, VES_NORMAL);
+        dest->vertexBufferBinding->setBinding(0, HardwareBufferManager::getSingleton().createVertexBuffer(
+            24, numVertices, HardwareBuffer::HBU_STATIC));
+        return dest;
+    };
+    std::unique_ptr<VertexData> single(createTarget()), split(createTarget());
+    WorkerThreadPool pool(4);
+
+    for (bool blendNormals : {true, false})
+    {
+        Mesh::softwareVertexBlend(&src, single.get(), blendMatrices, 8, blendNormals);
+        Mesh::softwareVertexBlend(&src, split.get(), blendMatrices, 8, blendNormals, &pool);
+
+        std::vector<float> singleResult(numVertices * 6), splitResult(numVertices * 6);
+        single->vertexBufferBinding->getBuffer(0)->readData(0, numVertices * 24, singleResult.data());
+        split->vertexBufferBinding->getBuffer(0)->readData(0, numVertices * 24, splitResult.data());
+        EXPECT_EQ(singleResult, splitResult);
+
+        for (size_t i = 0; i < numVertices; ++i)
+        {
+            const SrcVertex& v = vertices[i];
+            Vector3 pos(Vector3::ZERO), norm(Vector3::ZERO);
+            for (int w = 0; w < 4; ++w)
+            {
+                pos += bones[v.indices[w]] * Vector3(v.pos) * v.weights[w];
+                norm += bones[v.indices[w]].linear() * Vector3(v.norm) * v.weights[w];
+            }
+            norm.normalise();
+
+            for (int c = 0; c < 3; ++c)
+            {
+                EXPECT_NEAR(pos[c], singleResult[i * 6 + c], 1e-4f * 50) << "vertex " << i;
+                if (blendNormals)
+                    EXPECT_NEAR(norm[c], singleResult[i * 6 + 3 + c], 1e-3f) << "vertex " << i;
+            }
+        }
+    }
+}
@@ -0,0 +1,142 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include <gtest/gtest.h>
+
+#include "OgreDefaultHardwareBufferManager.h"
+#include "OgreStreamingBufferAllocator.h"
+#include "RootWithoutRenderSystemFixture.h"
+
+using namespace Ogre;
+
+typedef RootWithoutRenderSystemFixture StreamingBuffers;
+TEST_F(StreamingBuffers, RingFencedByFrame)
+{
+    DefaultHardwareBufferManagerBase mgr;
+    StreamingBufferAllocator streaming(&mgr);
+    streaming.setFramesInFlight(2);
+    streaming.setInitialSize(16 * sizeof(uint32));
+
+    HardwareVertexBufferSharedPtr buf, first;
+    size_t start;
+    uint32* data = static_cast<uint32*>(streaming.allocateVertices(sizeof(uint32), 8, first, start));
+    EXPECT_EQ(0u, start);
+    EXPECT_EQ(16u, first->getNumVertices());
+    for (uint32 i = 0; i < 8; ++i)
+        data[i] = i;
+    streaming.flush();
+
+    // written through the persistent mapping, no lock involved
+    uint32 readBack[8];
+    first->readData(0, sizeof(readBack), readBack);
+    EXPECT_EQ(7u, readBack[7]);
+    EXPECT_FALSE(first->isLocked());
+    streaming._notifyFrameEnded();
+
+    streaming.allocateVertices(sizeof(uint32), 8, buf, start);
+    EXPECT_EQ(first, buf);
+    EXPECT_EQ(8u, start);
+    streaming._notifyFrameEnded();
+
+    // the space of the first frame is free again, the second one is still in flight
+    EXPECT_FALSE(streaming.isAllocationValid(0));
+    EXPECT_TRUE(streaming.isAllocationValid(1));
+    streaming.allocateVertices(sizeof(uint32), 8, buf, start);
+    EXPECT_EQ(first, buf);
+    EXPECT_EQ(0u, start);
+
+    // a full ring is replaced by a bigger one, the old buffer keeps its data
+    streaming.allocateVertices(sizeof(uint32), 1, buf, start);
+    EXPECT_NE(first, buf);
+    EXPECT_EQ(0u, start);
+    EXPECT_EQ(32u, buf->getNumVertices());
+
+    // one ring per vertex size and index type
+    HardwareIndexBufferSharedPtr ibuf;
+    streaming.allocateVertices(12, 4, buf, start);
+    streaming.allocateIndexes(HardwareIndexBuffer::IT_16BIT, 6, ibuf, start);
+    EXPECT_EQ(HardwareIndexBuffer::IT_16BIT, ibuf->getType());
+    EXPECT_EQ(3u, streaming.getBufferCount());
+
+    streaming._releaseBuffers();
+    EXPECT_EQ(0u, streaming.getBufferCount());
+}
+
+namespace
+{
+    /// Counts the uploads of a buffer which can not be mapped persistently
+    struct UnmappedVertexBuffer : public DefaultHardwareVertexBuffer
+    {
+        size_t writes;
+        UnmappedVertexBuffer(HardwareBufferManagerBase* mgr, size_t vertexSize, size_t numVertices)
+            : DefaultHardwareVertexBuffer(mgr, vertexSize, numVertices, HBU_DYNAMIC_WRITE_ONLY), writes(0)
+        {
+        }
+        void* _getPersistentMapping(void) { return NULL; }
+        void writeData(size_t offset, size_t length, const void* pSource, bool discardWholeBuffer = false)
+        {
+            ++writes;
+            DefaultHardwareVertexBuffer::writeData(offset, length, pSource, discardWholeBuffer);
+        }
+    };
+
+    struct UnmappedBufferManager : public DefaultHardwareBufferManagerBase
+    {
+        HardwareVertexBufferSharedPtr createVertexBuffer(size_t vertexSize, size_t numVerts,
+                                                         HardwareBuffer::Usage usage, bool useShadowBuffer = false)
+        {
+            return HardwareVertexBufferSharedPtr(new UnmappedVertexBuffer(this, vertexSize, numVerts));
+        }
+    };
+}
+TEST_F(StreamingBuffers, StagesUnmappedBuffers)
+{
+    UnmappedBufferManager mgr;
+    StreamingBufferAllocator streaming(&mgr);
+
+    HardwareVertexBufferSharedPtr buf;
+    size_t start;
+    for (uint32 i = 0; i < 4; ++i)
+    {
+        uint32* data = static_cast<uint32*>(streaming.allocateVertices(sizeof(uint32), 2, buf, start));
+        EXPECT_EQ(i * 2, start);
+        data[0] = data[1] = i;
+    }
+
+    // the allocations of the frame are uploaded at once
+    UnmappedVertexBuffer* unmapped = static_cast<UnmappedVertexBuffer*>(buf.get());
+    EXPECT_EQ(0u, unmapped->writes);
+    streaming.flush();
+    EXPECT_EQ(1u, unmapped->writes);
+    streaming.flush();
+    EXPECT_EQ(1u, unmapped->writes);
+
+    uint32 readBack[8];
+    buf->readData(0, sizeof(readBack), readBack);
+    EXPECT_EQ(0u, readBack[0]);
+    EXPECT_EQ(3u, readBack[7]);
+}
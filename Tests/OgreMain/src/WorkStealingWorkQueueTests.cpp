@@ -0,0 +1,179 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include <gtest/gtest.h>
+
+#include "Threading/OgreWorkStealingWorkQueue.h"
+#include "OgreTimer.h"
+#include "RootWithoutRenderSystemFixture.h"
+
+using namespace Ogre;
+
+#if OGRE_THREAD_SUPPORT && OGRE_THREAD_PROVIDER != 3
+struct CountingRequestHandler : public WorkQueue::RequestHandler, public WorkQueue::ResponseHandler
+{
+    std::vector<WorkQueue::RequestID> responses;
+    AtomicScalar<size_t> aborted;
+    size_t failures;
+
+    CountingRequestHandler() : aborted(0), failures(0) {}
+
+    bool canHandleRequest(const WorkQueue::Request* req, const WorkQueue* srcQ)
+    {
+        if (req->getAborted())
+            ++aborted;
+        return WorkQueue::RequestHandler::canHandleRequest(req, srcQ);
+    }
+
+    WorkQueue::Response* handleRequest(const WorkQueue::Request* req, const WorkQueue* srcQ)
+    {
+        // requests of type 1 fail until they run out of retries
+        bool success = req->getType() != 1 || req->getRetryCount() == 0;
+        return OGRE_NEW WorkQueue::Response(req, success, Any(req->getID() * 2));
+    }
+
+    void handleResponse(const WorkQueue::Response* res, const WorkQueue* srcQ)
+    {
+        if (!res->succeeded())
+            ++failures;
+        EXPECT_EQ(res->getRequest()->getID() * 2, any_cast<WorkQueue::RequestID>(res->getData()));
+        responses.push_back(res->getRequest()->getID());
+    }
+
+    void waitForResponses(WorkQueue* queue, size_t count)
+    {
+        Timer timer;
+        while (responses.size() + aborted < count && timer.getMilliseconds() < 10000)
+            queue->processResponses();
+    }
+};
+
+typedef RootWithoutRenderSystemFixture WorkStealingWorkQueueTests;
+TEST_F(WorkStealingWorkQueueTests, ProcessesAllRequests)
+{
+    WorkStealingWorkQueue queue;
+    queue.setWorkerThreadCount(4);
+    queue.setResponseProcessingTimeLimit(0);
+    queue.startup();
+
+    CountingRequestHandler handler;
+    uint16 channel = queue.getChannel("Test");
+    queue.addRequestHandler(channel, &handler);
+    queue.addResponseHandler(channel, &handler);
+
+    std::set<WorkQueue::RequestID> ids;
+    for (int i = 0; i < 2000; ++i)
+        ids.insert(queue.addRequest(channel, i % 2, Any(), 2));
+    // synchronous requests are answered right away
+    ids.insert(queue.addRequest(channel, 0, Any(), 0, true));
+    EXPECT_EQ(ids.size(), handler.responses.size() + 2000);
+
+    handler.waitForResponses(&queue, ids.size());
+
+    EXPECT_EQ(ids, std::set<WorkQueue::RequestID>(handler.responses.begin(), handler.responses.end()));
+    EXPECT_EQ(ids.size(), handler.responses.size());
+    EXPECT_EQ(0u, handler.failures);
+
+    queue.removeRequestHandler(channel, &handler);
+    queue.removeResponseHandler(channel, &handler);
+}
+
+TEST_F(WorkStealingWorkQueueTests, ChannelPriorities)
+{
+    WorkStealingWorkQueue queue;
+    queue.setWorkerThreadCount(1);
+    queue.setResponseProcessingTimeLimit(0);
+
+    CountingRequestHandler handler;
+    uint16 low = queue.getChannel("Low");
+    uint16 high = queue.getChannel("High");
+    queue.setChannelPriority(high, 2);
+    EXPECT_EQ(2, queue.getChannelPriority(high));
+    EXPECT_EQ(0, queue.getChannelPriority(low));
+
+    std::vector<WorkQueue::RequestID> lowIds, highIds;
+    for (uint16 channel = low; channel <= high; ++channel)
+    {
+        queue.addRequestHandler(channel, &handler);
+        queue.addResponseHandler(channel, &handler);
+    }
+
+    // queued before the workers start, so they are all pending at once
+    for (int i = 0; i < 100; ++i)
+    {
+        lowIds.push_back(queue.addRequest(low, 0, Any()));
+        highIds.push_back(queue.addRequest(high, 0, Any()));
+    }
+    queue.startup();
+    handler.waitForResponses(&queue, 200);
+
+    ASSERT_EQ(200u, handler.responses.size());
+    EXPECT_EQ(highIds, std::vector<WorkQueue::RequestID>(handler.responses.begin(), handler.responses.begin() + 100));
+    EXPECT_EQ(lowIds, std::vector<WorkQueue::RequestID>(handler.responses.begin() + 100, handler.responses.end()));
+
+    for (uint16 channel = low; channel <= high; ++channel)
+        queue.removeRequestHandler(channel, &handler);
+}
+
+TEST_F(WorkStealingWorkQueueTests, AbortPendingRequests)
+{
+    WorkStealingWorkQueue queue;
+    queue.setWorkerThreadCount(2);
+    queue.setResponseProcessingTimeLimit(0);
+
+    CountingRequestHandler handler;
+    uint16 kept = queue.getChannel("Kept");
+    uint16 dropped = queue.getChannel("Dropped");
+    for (uint16 channel = kept; channel <= dropped; ++channel)
+    {
+        queue.addRequestHandler(channel, &handler);
+        queue.addResponseHandler(channel, &handler);
+    }
+
+    WorkQueue::RequestID single = queue.addRequest(kept, 0, Any());
+    for (int i = 0; i < 50; ++i)
+    {
+        queue.addRequest(kept, 0, Any());
+        queue.addRequest(dropped, 0, Any());
+    }
+
+    EXPECT_TRUE(queue.abortPendingRequest(single));
+    EXPECT_FALSE(queue.abortPendingRequest(12345));
+    queue.abortPendingRequestsByChannel(dropped);
+
+    queue.startup();
+    handler.waitForResponses(&queue, 101);
+
+    // aborted requests are not handled
+    EXPECT_EQ(50u, handler.responses.size());
+    EXPECT_EQ(51u, handler.aborted);
+    EXPECT_EQ(handler.responses.end(), std::find(handler.responses.begin(), handler.responses.end(), single));
+
+    for (uint16 channel = kept; channel <= dropped; ++channel)
+        queue.removeRequestHandler(channel, &handler);
+}
+#endif
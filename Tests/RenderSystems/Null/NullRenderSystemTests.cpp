@@ -0,0 +1,403 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include "OgreRoot.h"
+#include "OgreSceneManager.h"
+#include "OgreSceneNode.h"
+#include "OgreCamera.h"
+#include "OgreEntity.h"
+#include "OgreMeshManager.h"
+#include "OgreRenderWindow.h"
+#include "OgreViewport.h"
+#include "OgreMaterialManager.h"
+#include "OgreTechnique.h"
+#include "OgrePass.h"
+#include "OgreGpuProgramManager.h"
+#include "OgreBillboardSet.h"
+#include "OgreStreamingBufferAllocator.h"
+#include "OgreRenderCommandList.h"
+#include "OgreWorkerThreadPool.h"
+#include "OgreMesh.h"
+#include "OgreSubMesh.h"
+#include "OgreNullPlugin.h"
+#include "OgreNullRenderSystem.h"
+
+#include <gtest/gtest.h>
+
+using namespace Ogre;
+
+class NullRenderSystemTests : public ::testing::Test
+{
+public:
+    Root* mRoot;
+    NullPlugin* mPlugin;
+    NullRenderSystem* mRenderSystem;
+    RenderWindow* mWindow;
+
+    virtual void SetUp()
+    {
+        mRoot = OGRE_NEW Root("");
+        mPlugin = OGRE_NEW NullPlugin();
+        mRoot->installPlugin(mPlugin);
+
+        mRenderSystem = static_cast<NullRenderSystem*>(
+            mRoot->getRenderSystemByName("Null Rendering Subsystem"));
+        mRoot->setRenderSystem(mRenderSystem);
+        mRoot->initialise(false);
+        mWindow = mRoot->createRenderWindow("NullRenderSystemTests", 320, 240, false);
+    }
+
+    virtual void TearDown()
+    {
+        OGRE_DELETE mRoot;
+        OGRE_DELETE mPlugin;
+    }
+};
+//--------------------------------------------------------------------------
+TEST_F(NullRenderSystemTests, Capabilities)
+{
+    ASSERT_TRUE(mRenderSystem);
+    const RenderSystemCapabilities* caps = mRenderSystem->getCapabilities();
+    ASSERT_TRUE(caps);
+    EXPECT_TRUE(caps->hasCapability(RSC_FIXED_FUNCTION));
+    EXPECT_TRUE(caps->hasCapability(RSC_HWRENDER_TO_TEXTURE));
+    EXPECT_EQ(mWindow->getWidth(), 320u);
+    EXPECT_EQ(mWindow->getHeight(), 240u);
+}
+//--------------------------------------------------------------------------
+TEST_F(NullRenderSystemTests, RenderOneFrame)
+{
+    SceneManager* sceneMgr = mRoot->createSceneManager();
+    Camera* cam = sceneMgr->createCamera("Camera");
+    cam->setNearClipDistance(1);
+    SceneNode* camNode = sceneMgr->getRootSceneNode()->createChildSceneNode();
+    camNode->attachObject(cam);
+    camNode->setPosition(0, 0, 100);
+    mWindow->addViewport(cam);
+
+    MeshManager::getSingleton().createPlane("NullPlane", ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME,
+                                            Plane(Vector3::UNIT_Z, 0), 50, 50);
+    Entity* ent = sceneMgr->createEntity("NullPlane");
+    sceneMgr->getRootSceneNode()->attachObject(ent);
+
+    // first frame uploads the plane geometry
+    ASSERT_TRUE(mRoot->renderOneFrame());
+    NullRenderSystem::FrameStats first = mRenderSystem->getLastFrameStats();
+    EXPECT_GE(first.drawCalls, 1u);
+    EXPECT_GT(first.stateChanges, 0u);
+
+    // nothing changed, so the second frame draws the same without uploading
+    ASSERT_TRUE(mRoot->renderOneFrame());
+    NullRenderSystem::FrameStats second = mRenderSystem->getLastFrameStats();
+    EXPECT_EQ(second.drawCalls, first.drawCalls);
+    EXPECT_EQ(second.bytesUploaded, 0u);
+}
+//--------------------------------------------------------------------------
+TEST_F(NullRenderSystemTests, CountsUploads)
+{
+    // flush the uploads done while initialising
+    ASSERT_TRUE(mRoot->renderOneFrame());
+    EXPECT_EQ(mRenderSystem->getFrameStats().bytesUploaded, 0u);
+
+    HardwareVertexBufferSharedPtr vbuf = HardwareBufferManager::getSingleton().createVertexBuffer(
+        12, 16, HardwareBuffer::HBU_STATIC_WRITE_ONLY);
+    float data[48] = {0};
+    vbuf->writeData(0, sizeof(data), data);
+    EXPECT_EQ(mRenderSystem->getFrameStats().bytesUploaded, sizeof(data));
+
+    ASSERT_TRUE(mRoot->renderOneFrame());
+    EXPECT_EQ(mRenderSystem->getLastFrameStats().bytesUploaded, sizeof(data));
+    EXPECT_EQ(mRenderSystem->getFrameStats().bytesUploaded, 0u);
+}
+//--------------------------------------------------------------------------
+TEST_F(NullRenderSystemTests, StageTiming)
+{
+    SceneManager* sceneMgr = mRoot->createSceneManager();
+    Camera* cam = sceneMgr->createCamera("Camera");
+    cam->setNearClipDistance(1);
+    SceneNode* camNode = sceneMgr->getRootSceneNode()->createChildSceneNode();
+    camNode->attachObject(cam);
+    camNode->setPosition(0, 0, 500);
+    mWindow->addViewport(cam);
+
+    for (int i = 0; i < 10; ++i)
+    {
+        sceneMgr->getRootSceneNode()
+            ->createChildSceneNode(Vector3(Real(i * 20 - 100), 0, 0))
+            ->attachObject(sceneMgr->createEntity(SceneManager::PT_CUBE));
+    }
+
+    // not measured unless enabled
+    ASSERT_TRUE(mRoot->renderOneFrame());
+    for (int s = 0; s < SceneManager::FS_COUNT; ++s)
+        EXPECT_EQ(sceneMgr->getStageTime(SceneManager::FrameStage(s)), 0u);
+
+    sceneMgr->setStageTimingEnabled(true);
+    ASSERT_TRUE(mRoot->renderOneFrame());
+    EXPECT_GT(sceneMgr->getStageTime(SceneManager::FS_UPDATE_SCENE_GRAPH), 0u);
+    EXPECT_GT(sceneMgr->getStageTime(SceneManager::FS_QUEUEING), 0u);
+    EXPECT_GT(sceneMgr->getStageTime(SceneManager::FS_SORTING), 0u);
+
+    sceneMgr->resetStageTimes();
+    for (int s = 0; s < SceneManager::FS_COUNT; ++s)
+        EXPECT_EQ(sceneMgr->getStageTime(SceneManager::FrameStage(s)), 0u);
+}
+//--------------------------------------------------------------------------
+TEST_F(NullRenderSystemTests, SkipsUnchangedAutoConstants)
+{
+    SceneManager* sceneMgr = mRoot->createSceneManager();
+    Camera* cam = sceneMgr->createCamera("Camera");
+    cam->setNearClipDistance(1);
+    SceneNode* camNode = sceneMgr->getRootSceneNode()->createChildSceneNode();
+    camNode->attachObject(cam);
+    camNode->setPosition(0, 0, 500);
+    mWindow->addViewport(cam);
+
+    const String& group = ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME;
+    GpuProgramPtr vp = GpuProgramManager::getSingleton().createProgramFromString(
+        "AutoConstantsVP", group, "null", GPT_VERTEX_PROGRAM, "null");
+    GpuProgramParametersSharedPtr defaults = vp->getDefaultParameters();
+    defaults->setAutoConstant(0, GpuProgramParameters::ACT_VIEWPROJ_MATRIX);
+    defaults->setAutoConstant(4, GpuProgramParameters::ACT_WORLD_MATRIX);
+
+    // transparent, so the pass is set again for every object
+    MaterialPtr mat = MaterialManager::getSingleton().create("AutoConstants", group);
+    Pass* pass = mat->getTechnique(0)->getPass(0);
+    pass->setVertexProgram(vp->getName());
+    pass->setSceneBlending(SBT_TRANSPARENT_ALPHA);
+    pass->setDepthWriteEnabled(false);
+
+    const int numObjects = 10;
+    for (int i = 0; i < numObjects; ++i)
+    {
+        Entity* ent = sceneMgr->createEntity(SceneManager::PT_CUBE);
+        ent->setMaterial(mat);
+        sceneMgr->getRootSceneNode()
+            ->createChildSceneNode(Vector3(Real(i * 20 - 100), 0, Real(-i)))
+            ->attachObject(ent);
+    }
+
+    ASSERT_TRUE(mRoot->renderOneFrame());
+    ASSERT_TRUE(mRoot->renderOneFrame());
+    size_t tracked = mRenderSystem->getLastFrameStats().constantBytesUploaded;
+    GpuProgramParametersSharedPtr params = pass->getVertexProgramParameters();
+    FloatConstantList trackedValues = params->getFloatConstantList();
+
+    sceneMgr->setAutoParamChangeTrackingEnabled(false);
+    ASSERT_TRUE(mRoot->renderOneFrame());
+    size_t untracked = mRenderSystem->getLastFrameStats().constantBytesUploaded;
+
+    // the view projection matrix is written once per frame instead of once per object
+    EXPECT_EQ(untracked - tracked, (numObjects - 1) * 16 * sizeof(float));
+    EXPECT_EQ(trackedValues, params->getFloatConstantList());
+}
+
+TEST_F(NullRenderSystemTests, BatchesPerObjectConstants)
+{
+    SceneManager* sceneMgr = mRoot->createSceneManager();
+    Camera* cam = sceneMgr->createCamera("Camera");
+    cam->setNearClipDistance(1);
+    SceneNode* camNode = sceneMgr->getRootSceneNode()->createChildSceneNode();
+    camNode->attachObject(cam);
+    camNode->setPosition(0, 0, 500);
+    mWindow->addViewport(cam);
+
+    const String& group = ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME;
+    GpuProgramPtr vp = GpuProgramManager::getSingleton().createProgramFromString(
+        "PerObjectVP", group, "null", GPT_VERTEX_PROGRAM, "null");
+    GpuProgramParametersSharedPtr defaults = vp->getDefaultParameters();
+    defaults->setAutoConstant(0, GpuProgramParameters::ACT_VIEWPROJ_MATRIX);
+    defaults->setAutoConstant(4, GpuProgramParameters::ACT_WORLD_MATRIX);
+
+    // opaque, so all objects are grouped under the pass
+    MaterialPtr mat = MaterialManager::getSingleton().create("PerObject", group);
+    mat->getTechnique(0)->getPass(0)->setVertexProgram(vp->getName());
+
+    const int numObjects = 10;
+    for (int i = 0; i < numObjects; ++i)
+    {
+        Entity* ent = sceneMgr->createEntity(SceneManager::PT_CUBE);
+        ent->setMaterial(mat);
+        sceneMgr->getRootSceneNode()
+            ->createChildSceneNode(Vector3(Real(i * 20 - 100), 0, 0))
+            ->attachObject(ent);
+    }
+
+    EXPECT_FALSE(sceneMgr->isPerObjectConstantBatchingEnabled());
+    sceneMgr->setPerObjectConstantBatchingEnabled(true);
+    ASSERT_TRUE(mRoot->renderOneFrame());
+    ASSERT_TRUE(mRoot->renderOneFrame());
+    NullRenderSystem::FrameStats batched = mRenderSystem->getLastFrameStats();
+
+    sceneMgr->setPerObjectConstantBatchingEnabled(false);
+    ASSERT_TRUE(mRoot->renderOneFrame());
+    NullRenderSystem::FrameStats single = mRenderSystem->getLastFrameStats();
+
+    EXPECT_EQ(size_t(numObjects), batched.drawCalls);
+    EXPECT_EQ(single.drawCalls, batched.drawCalls);
+
+    // one bind of the shared constants, then only the block offset changes per draw
+    EXPECT_EQ(1u, batched.constantBinds);
+    EXPECT_EQ(size_t(numObjects), batched.constantBlockBinds);
+    EXPECT_EQ(size_t(numObjects), single.constantBinds);
+    EXPECT_EQ(0u, single.constantBlockBinds);
+
+    // every world matrix is uploaded once, padded to the block alignment
+    EXPECT_GE(batched.constantBytesUploaded, numObjects * 256u);
+}
+//--------------------------------------------------------------------------
+TEST_F(NullRenderSystemTests, StreamsBillboards)
+{
+    SceneManager* sceneMgr = mRoot->createSceneManager();
+    Camera* cam = sceneMgr->createCamera("Camera");
+    cam->setNearClipDistance(1);
+    SceneNode* camNode = sceneMgr->getRootSceneNode()->createChildSceneNode();
+    camNode->attachObject(cam);
+    camNode->setPosition(0, 0, 500);
+    mWindow->addViewport(cam);
+
+    const int numSets = 10;
+    const int numBillboards = 20;
+    std::vector<BillboardSet*> sets;
+    for (int i = 0; i < numSets; ++i)
+    {
+        BillboardSet* bbs = sceneMgr->createBillboardSet(numBillboards);
+        for (int b = 0; b < numBillboards; ++b)
+            bbs->createBillboard(Real(b), 0, 0);
+        sceneMgr->getRootSceneNode()
+            ->createChildSceneNode(Vector3(Real(i * 20 - 100), 0, 0))
+            ->attachObject(bbs);
+        sets.push_back(bbs);
+    }
+
+    StreamingBufferAllocator& streaming = HardwareBufferManager::getSingleton().getStreamingBuffers();
+    EXPECT_FALSE(streaming.isEnabled());
+    streaming.setEnabled(true);
+    ASSERT_TRUE(mRoot->renderOneFrame());
+    ASSERT_TRUE(mRoot->renderOneFrame());
+    NullRenderSystem::FrameStats streamed = mRenderSystem->getLastFrameStats();
+    EXPECT_EQ(1u, streaming.getBufferCount());
+
+    streaming.setEnabled(false);
+    for (size_t i = 0; i < sets.size(); ++i)
+        sets[i]->_releaseManualHardwareResources();
+    ASSERT_TRUE(mRoot->renderOneFrame());
+    ASSERT_TRUE(mRoot->renderOneFrame());
+    NullRenderSystem::FrameStats locked = mRenderSystem->getLastFrameStats();
+
+    EXPECT_EQ(size_t(numSets), streamed.drawCalls);
+    EXPECT_EQ(locked.drawCalls, streamed.drawCalls);
+
+    // the same vertices are uploaded, but with a single flush instead of a lock per set
+    EXPECT_EQ(0u, streamed.bufferLocks);
+    EXPECT_EQ(size_t(numSets), locked.bufferLocks);
+    EXPECT_EQ(locked.bytesUploaded, streamed.bytesUploaded);
+}
+//--------------------------------------------------------------------------
+TEST_F(NullRenderSystemTests, ReplaysCommandLists)
+{
+    const String& group = ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME;
+    GpuProgramPtr vp = GpuProgramManager::getSingleton().createProgramFromString(
+        "CommandListVP", group, "null", GPT_VERTEX_PROGRAM, "null");
+    vp->load();
+
+    MeshPtr plane = MeshManager::getSingleton().createPlane("CommandListPlane", group,
+                                                            Plane(Vector3::UNIT_Z, 0), 50, 50);
+    RenderOperation op;
+    plane->getSubMesh(0)->_getRenderOperation(op);
+
+    const size_t numObjects = 100;
+    const size_t numThreads = 4;
+
+    // what the objects would do in immediate mode
+    GpuProgramParametersSharedPtr params = vp->createParameters();
+    NullRenderSystem::FrameStats before = mRenderSystem->getFrameStats();
+    mRenderSystem->bindGpuProgram(vp.get());
+    for (size_t i = 0; i < numObjects; ++i)
+    {
+        params->setConstant(0, Vector4(Real(i)));
+        mRenderSystem->bindGpuProgramParameters(GPT_VERTEX_PROGRAM, params, GPV_ALL);
+        mRenderSystem->_setCullingMode(i % 2 ? CULL_CLOCKWISE : CULL_NONE);
+        mRenderSystem->_render(op);
+    }
+    NullRenderSystem::FrameStats immediate = mRenderSystem->getFrameStats();
+
+    // every thread records a consecutive part of the objects into its own list
+    struct RecordTask : public UniformScalableTask
+    {
+        GpuProgram* program;
+        const RenderOperation* op;
+        size_t numObjects;
+        std::vector<RenderCommandList> lists;
+        std::vector<GpuProgramParametersSharedPtr> params;
+
+        void execute(size_t threadIdx, size_t numThreads)
+        {
+            RenderCommandList& list = lists[threadIdx];
+            GpuProgramParametersSharedPtr& p = params[threadIdx];
+            if (threadIdx == 0)
+                list.bindGpuProgram(program);
+            for (size_t i = threadIdx * numObjects / numThreads;
+                 i < (threadIdx + 1) * numObjects / numThreads; ++i)
+            {
+                p->setConstant(0, Vector4(Real(i)));
+                list.bindGpuProgramParameters(GPT_VERTEX_PROGRAM, p, GPV_ALL);
+                list.setCullingMode(i % 2 ? CULL_CLOCKWISE : CULL_NONE);
+                list.render(*op);
+            }
+        }
+    } task;
+    task.program = vp.get();
+    task.op = &op;
+    task.numObjects = numObjects;
+    task.lists.resize(numThreads);
+    for (size_t t = 0; t < numThreads; ++t)
+        task.params.push_back(vp->createParameters());
+
+    WorkerThreadPool pool(numThreads);
+    for (int frame = 0; frame < 2; ++frame)
+    {
+        for (size_t t = 0; t < numThreads; ++t)
+            task.lists[t].clear();
+        pool.execute(&task);
+
+        NullRenderSystem::FrameStats start = mRenderSystem->getFrameStats();
+        for (size_t t = 0; t < numThreads; ++t)
+            mRenderSystem->_executeCommandList(task.lists[t]);
+        const NullRenderSystem::FrameStats& replayed = mRenderSystem->getFrameStats();
+
+        // the replay issues exactly the work of the immediate calls
+        EXPECT_EQ(immediate.drawCalls - before.drawCalls, replayed.drawCalls - start.drawCalls);
+        EXPECT_EQ(immediate.stateChanges - before.stateChanges, replayed.stateChanges - start.stateChanges);
+        EXPECT_EQ(immediate.constantBinds - before.constantBinds, replayed.constantBinds - start.constantBinds);
+        EXPECT_EQ(immediate.constantBytesUploaded - before.constantBytesUploaded,
+                  replayed.constantBytesUploaded - start.constantBytesUploaded);
+        EXPECT_EQ(numThreads, replayed.commandListsExecuted - start.commandListsExecuted);
+        EXPECT_EQ(1 + numObjects * 3, replayed.commandsExecuted - start.commandsExecuted);
+    }
+}